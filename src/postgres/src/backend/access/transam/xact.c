@@ -3961,6 +3961,13 @@ DefineSavepoint(const char *name)
 {
 	TransactionState s = CurrentTransactionState;
 
+	/*
+	 * Errors of writes buffered before the subtransaction starts must not be
+	 * reported inside of it, i.e. caught by an exception block.
+	 */
+	if (IsYugaByteEnabled())
+		YBFlushBufferedOperations();
+
 	/*
 	 * Workers synchronize transaction state at the beginning of each parallel
 	 * operation, so we can't account for new subtransactions after that
@@ -4048,6 +4055,13 @@ ReleaseSavepoint(const char *name)
 	TransactionState target,
 				xact;
 
+	/*
+	 * Errors of writes buffered inside the subtransaction must be reported
+	 * before it is released, i.e. caught by its exception block.
+	 */
+	if (IsYugaByteEnabled())
+		YBFlushBufferedOperations();
+
 	/*
 	 * Workers synchronize transaction state at the beginning of each parallel
 	 * operation, so we can't account for transaction state change after that
@@ -4282,6 +4296,13 @@ BeginInternalSubTransaction(const char *name)
 {
 	TransactionState s = CurrentTransactionState;
 
+	/*
+	 * Errors of writes buffered before the subtransaction starts must not be
+	 * reported inside of it, i.e. caught by an exception block.
+	 */
+	if (IsYugaByteEnabled())
+		YBFlushBufferedOperations();
+
 	/*
 	 * Workers synchronize transaction state at the beginning of each parallel
 	 * operation, so we can't account for new subtransactions after that
@@ -4353,6 +4374,13 @@ ReleaseCurrentSubTransaction(void)
 {
 	TransactionState s = CurrentTransactionState;
 
+	/*
+	 * Errors of writes buffered inside the subtransaction must be reported
+	 * before it is released, i.e. caught by its exception block.
+	 */
+	if (IsYugaByteEnabled())
+		YBFlushBufferedOperations();
+
 	/*
 	 * Workers synchronize transaction state at the beginning of each parallel
 	 * operation, so we can't account for commit of subtransactions after that
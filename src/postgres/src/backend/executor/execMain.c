@@ -159,8 +159,27 @@ standard_ExecutorStart(QueryDesc *queryDesc, int eflags)
 	Assert(queryDesc->estate == NULL);
 
 	if (IsYugaByteEnabled())
+	{
 		YBBeginOperationsBuffering();
 
+		/*
+		 * Outside of an explicit transaction block, a plain SELECT that calls
+		 * no volatile functions can be served from a consistent snapshot
+		 * without starting a distributed transaction.  If it writes anyway,
+		 * pggate restarts it in a regular transaction.
+		 */
+		if (!IsTransactionBlock())
+		{
+			PlannedStmt *plannedstmt = queryDesc->plannedstmt;
+			bool		read_only_stmt = queryDesc->operation == CMD_SELECT &&
+										 plannedstmt->rowMarks == NIL &&
+										 !plannedstmt->hasModifyingCTE &&
+										 plannedstmt->ybNoVolatileFunctions;
+
+			HandleYBStatus(YBCPgSetTransactionReadOnlyStmt(read_only_stmt));
+		}
+	}
+
 	/*
 	 * If the transaction is read-only, we need to check if any writes are
 	 * planned to non-temporary tables.  EXPLAIN is considered read-only.
@@ -59,6 +59,8 @@
 #include "utils/lsyscache.h"
 #include "utils/syscache.h"
 
+#include "pg_yb_utils.h"
+
 
 /* GUC parameters */
 double		cursor_tuple_fraction = DEFAULT_CURSOR_TUPLE_FRACTION;
@@ -276,6 +278,7 @@ standard_planner(Query *parse, int cursorOptions, ParamListInfo boundParams)
 	Plan	   *top_plan;
 	ListCell   *lp,
 			   *lr;
+	bool		yb_no_volatile_functions = false;
 
 	/*
 	 * Set up global state for this planner invocation.  This data is needed
@@ -353,6 +356,15 @@ standard_planner(Query *parse, int cursorOptions, ParamListInfo boundParams)
 		glob->parallelModeOK = false;
 	}
 
+	/*
+	 * YugaByte: a SELECT can still write through the functions it calls.
+	 * Non-volatile functions are executed with a read-only snapshot and may
+	 * not modify the database, so only volatile functions are a concern.
+	 * The check is done before planning, since planning modifies the tree.
+	 */
+	if (IsYugaByteEnabled() && parse->commandType == CMD_SELECT)
+		yb_no_volatile_functions = !contain_volatile_functions((Node *) parse);
+
 	/*
 	 * glob->parallelModeNeeded is normally set to false here and changed to
 	 * true during plan creation if a Gather or Gather Merge plan is actually
@@ -517,6 +529,7 @@ standard_planner(Query *parse, int cursorOptions, ParamListInfo boundParams)
 	result->transientPlan = glob->transientPlan;
 	result->dependsOnRole = glob->dependsOnRole;
 	result->parallelModeNeeded = glob->parallelModeNeeded;
+	result->ybNoVolatileFunctions = yb_no_volatile_functions;
 	result->planTree = top_plan;
 	result->rtable = glob->finalrtable;
 	result->resultRelations = glob->resultRelations;
@@ -367,7 +367,7 @@ YBCCommitTransaction()
 	if (!IsYugaByteEnabled())
 		return;
 
-	HandleYBStatus(YBCPgFlushBufferedOperations());
+	/* Buffered operations are flushed as part of the commit. */
 	HandleYBStatus(YBCPgCommitTransaction());
 }
 
@@ -908,3 +908,7 @@ void YBResetOperationsBuffering() {
 	buffering_nesting_level = 0;
 	YBCPgResetOperationsBuffering();
 }
+
+void YBFlushBufferedOperations() {
+	HandleYBStatus(YBCPgFlushBufferedOperations());
+}
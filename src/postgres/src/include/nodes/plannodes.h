@@ -59,6 +59,9 @@ typedef struct PlannedStmt
 
 	bool		parallelModeNeeded; /* parallel mode required to execute? */
 
+	bool		ybNoVolatileFunctions;	/* SELECT that calls no volatile
+										 * functions, so it cannot write */
+
 	int			jitFlags;		/* which forms of JIT should be performed */
 
 	struct Plan *planTree;		/* tree of Plan nodes */
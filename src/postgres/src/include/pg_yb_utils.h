@@ -301,5 +301,6 @@ void YBDecrementDdlNestingLevel(bool success);
 extern void YBBeginOperationsBuffering();
 extern void YBEndOperationsBuffering();
 extern void YBResetOperationsBuffering();
+extern void YBFlushBufferedOperations();
 
 #endif /* PG_YB_UTILS_H */
@@ -29,6 +29,7 @@
 
 #include "yb/util/cast.h"
 #include "yb/util/debug-util.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/yb_pg_errcodes.h"
 
@@ -52,6 +53,7 @@ METRIC_DEFINE_histogram(
     "Microseconds spent before sending the request to the server", 60000000LU, 2);
 DECLARE_bool(rpc_dump_all_traces);
 DECLARE_bool(collect_end_to_end_traces);
+DECLARE_bool(subscribe_to_tablet_location_changes);
 
 DEFINE_bool(forward_redis_requests, true, "If false, the redis op will not be served if it's not "
             "a local request. The op response will be set to the redis error "
@@ -63,6 +65,14 @@ DEFINE_bool(detect_duplicates_for_retryable_requests, true,
             "Enable tracking of write requests that prevents the same write from being applied "
                 "twice.");
 
+DEFINE_bool(strong_reads_from_closest_replica, false,
+            "If true, strongly consistent non-transactional reads are sent to the closest replica "
+            "instead of the tablet leader. Followers serve them using the read index of the "
+            "leader, so tablet servers should run with --follower_read_index. Retries always go "
+            "to the leader.");
+TAG_FLAG(strong_reads_from_closest_replica, advanced);
+TAG_FLAG(strong_reads_from_closest_replica, runtime);
+
 DEFINE_CAPABILITY(PickReadTimeAtTabletServer, 0x8284d67b);
 
 using namespace std::placeholders;
@@ -89,6 +99,16 @@ bool IsTracingEnabled() {
 
 namespace {
 
+bool ReadFromClosestReplica(const AsyncRpcData& data, YBConsistencyLevel consistency_level) {
+  if (consistency_level == YBConsistencyLevel::CONSISTENT_PREFIX) {
+    return true;
+  }
+  return FLAGS_strong_reads_from_closest_replica &&
+         consistency_level == YBConsistencyLevel::STRONG &&
+         data.ops.front()->yb_op->read_only() &&
+         data.batcher->transaction_metadata().transaction_id.IsNil();
+}
+
 bool LocalTabletServerOnly(const InFlightOps& ops) {
   const auto op_type = ops.front()->yb_op->type();
   return ((op_type == YBOperation::Type::REDIS_READ || op_type == YBOperation::Type::REDIS_WRITE) &&
@@ -110,7 +130,7 @@ AsyncRpc::AsyncRpc(AsyncRpcData* data, YBConsistencyLevel yb_consistency_level)
       batcher_(data->batcher),
       trace_(new Trace),
       tablet_invoker_(LocalTabletServerOnly(data->ops),
-                      yb_consistency_level == YBConsistencyLevel::CONSISTENT_PREFIX,
+                      ReadFromClosestReplica(*data, yb_consistency_level),
                       data->batcher->client_,
                       this,
                       this,
@@ -345,9 +365,24 @@ void AsyncRpcBase<Req, Resp>::SendRpcToTserver(int attempt_num) {
   }
 
   req_.set_rejection_score(batcher_->RejectionScore(attempt_num));
+  if (FLAGS_subscribe_to_tablet_location_changes) {
+    tablet_invoker_.FillLocationChangesRequest(req_.mutable_location_changes());
+  } else {
+    req_.clear_location_changes();
+  }
   AsyncRpc::SendRpcToTserver(attempt_num);
 }
 
+template <class Req, class Resp>
+void AsyncRpcBase<Req, Resp>::Finished(const Status& status) {
+  // Apply location changes before handling the response, so a retry after NOT_THE_LEADER goes
+  // directly to the new leader.
+  if (status.ok() && resp_.has_location_changes()) {
+    tablet_invoker_.ProcessLocationChanges(resp_.location_changes());
+  }
+  AsyncRpc::Finished(status);
+}
+
 WriteRpc::WriteRpc(AsyncRpcData* data)
     : AsyncRpcBase(data, YBConsistencyLevel::STRONG) {
 
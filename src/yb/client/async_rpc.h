@@ -133,6 +133,7 @@ class AsyncRpcBase : public AsyncRpc {
   // Returns `true` if caller should continue processing response, `false` otherwise.
   bool CommonResponseCheck(const Status& status);
   void SendRpcToTserver(int attempt_num) override;
+  void Finished(const Status& status) override;
 
  protected: // TODO replace with private
   const tserver::TabletServerErrorPB* response_error() const override {
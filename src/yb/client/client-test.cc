@@ -101,6 +101,7 @@ DECLARE_int32(log_inject_latency_ms_mean);
 DECLARE_int32(log_inject_latency_ms_stddev);
 DECLARE_int32(master_inject_latency_on_tablet_lookups_ms);
 DECLARE_int32(max_create_tablets_per_ts);
+DECLARE_int32(meta_cache_prefetch_batch_size);
 DECLARE_int32(TEST_scanner_inject_latency_on_each_batch_ms);
 DECLARE_int32(scanner_max_batch_size_bytes);
 DECLARE_int32(scanner_ttl_ms);
@@ -110,6 +111,7 @@ DECLARE_int32(replication_factor);
 DEFINE_int32(test_scan_num_rows, 1000, "Number of rows to insert and scan");
 DECLARE_int32(min_backoff_ms_exponent);
 DECLARE_int32(max_backoff_ms_exponent);
+DECLARE_string(meta_cache_snapshot_path);
 
 METRIC_DECLARE_counter(rpcs_queue_overflow);
 
@@ -1750,6 +1752,50 @@ TEST_F(ClientTest, TestMasterLookupPermits) {
             client_->data_->meta_cache_->master_lookup_sem_.GetValue());
 }
 
+// Checks that locations of all tablets are prefetched in batches, and that a client could be warmed
+// up by the snapshot of prefetched locations. Both clients should find all tablets without master.
+TEST_F(ClientTest, PrefetchTableLocations) {
+  FLAGS_meta_cache_prefetch_batch_size = 3;
+  TableHandle table;
+  ASSERT_NO_FATALS(CreateTable(YBTableName(YQL_DATABASE_CQL, "prefetch"), 10, &table));
+
+  auto master_addr = yb::ToString(cluster_->mini_master()->bound_rpc_addr());
+  auto prefetch_client = ASSERT_RESULT(YBClientBuilder()
+      .add_master_server_addr(master_addr)
+      .Build());
+  shared_ptr<YBTable> prefetch_table;
+  ASSERT_OK(prefetch_client->OpenTable(table->name(), &prefetch_table));
+  Synchronizer sync;
+  prefetch_client->PrefetchTableLocations(
+      prefetch_table.get(), CoarseMonoClock::Now() + 30s, sync.AsStdStatusCallback());
+  ASSERT_OK(sync.Wait());
+
+  auto snapshot_path = GetTestPath("meta_cache_snapshot");
+  ASSERT_OK(prefetch_client->SaveMetaCacheSnapshot(snapshot_path));
+
+  FLAGS_meta_cache_snapshot_path = snapshot_path;
+  auto warm_client = ASSERT_RESULT(YBClientBuilder()
+      .add_master_server_addr(master_addr)
+      .Build());
+  shared_ptr<YBTable> warm_table;
+  ASSERT_OK(warm_client->OpenTable(table->name(), &warm_table));
+
+  DontVerifyClusterBeforeNextTearDown();
+  cluster_->mini_master()->Shutdown();
+
+  std::vector<std::pair<YBClient*, YBTable*>> clients = {
+      {prefetch_client.get(), prefetch_table.get()}, {warm_client.get(), warm_table.get()}};
+  for (const auto& client_and_table : clients) {
+    auto* yb_table = client_and_table.second;
+    ASSERT_EQ(10, yb_table->GetPartitionCount());
+    for (const auto& partition : yb_table->GetPartitions()) {
+      auto tablet = ASSERT_RESULT(client_and_table.first->data_->meta_cache_
+          ->LookupTabletByKeyFuture(yb_table, partition, CoarseMonoClock::Now() + 1s).get());
+      ASSERT_EQ(partition, tablet->partition().partition_key_start());
+    }
+  }
+}
+
 // Define callback for deadlock simulation, as well as various helper methods.
 namespace {
 
@@ -73,6 +73,7 @@
 #include "yb/util/oid_generator.h"
 #include "yb/util/tsan_util.h"
 #include "yb/util/crypt.h"
+#include "yb/util/env.h"
 
 using yb::master::AlterTableRequestPB;
 using yb::master::AlterTableRequestPB_Step;
@@ -169,6 +170,12 @@ TAG_FLAG(client_suppress_created_logs, hidden);
 DEFINE_test_flag(int32, yb_num_total_tablets, 0,
                  "The total number of tablets per table when a table is created.");
 
+DEFINE_string(meta_cache_snapshot_path, "",
+              "Path to the tablet location cache snapshot, saved by SaveMetaCacheSnapshot, that is "
+              "loaded by the client on startup, so first requests do not wait for master "
+              "lookups.");
+TAG_FLAG(meta_cache_snapshot_path, advanced);
+
 namespace yb {
 namespace client {
 
@@ -386,6 +393,13 @@ Status YBClientBuilder::DoBuild(rpc::Messenger* messenger, std::unique_ptr<YBCli
 
   c->data_->meta_cache_.reset(new MetaCache(c.get()));
   c->data_->dns_resolver_.reset(new DnsResolver());
+  if (!FLAGS_meta_cache_snapshot_path.empty()) {
+    auto status = c->data_->meta_cache_->LoadSnapshot(
+        Env::Default(), FLAGS_meta_cache_snapshot_path);
+    if (!status.ok() && !status.IsNotFound()) {
+      LOG(WARNING) << "Failed to load meta cache snapshot: " << status;
+    }
+  }
 
   // Init local host names used for locality decisions.
   RETURN_NOT_OK_PREPEND(c->data_->InitLocalHostNames(),
@@ -1403,6 +1417,16 @@ void YBClient::LookupTabletById(const std::string& tablet_id,
       tablet_id, deadline, std::move(callback), use_cache);
 }
 
+void YBClient::PrefetchTableLocations(const YBTable* table,
+                                      CoarseTimePoint deadline,
+                                      StdStatusCallback callback) {
+  data_->meta_cache_->PrefetchTableLocations(table, deadline, std::move(callback));
+}
+
+Status YBClient::SaveMetaCacheSnapshot(const std::string& path) {
+  return data_->meta_cache_->SaveSnapshot(Env::Default(), path);
+}
+
 HostPort YBClient::GetMasterLeaderAddress() {
   return data_->leader_master_hostport();
 }
@@ -655,6 +655,16 @@ class YBClient {
                         LookupTabletCallback callback,
                         UseCache use_cache);
 
+  // Fetches locations of all tablets of the table into the tablet location cache, using few large
+  // master requests instead of one request per group of tablets.
+  void PrefetchTableLocations(const YBTable* table,
+                              CoarseTimePoint deadline,
+                              StdStatusCallback callback);
+
+  // Saves the tablet location cache to the file at 'path'. Clients built with
+  // --meta_cache_snapshot_path pointing to this file load it on startup.
+  CHECKED_STATUS SaveMetaCacheSnapshot(const std::string& path);
+
   rpc::Messenger* messenger() const;
 
   const scoped_refptr<MetricEntity>& metric_entity() const;
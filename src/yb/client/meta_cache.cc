@@ -32,6 +32,7 @@
 
 #include "yb/client/meta_cache.h"
 
+#include <algorithm>
 #include <shared_mutex>
 #include <mutex>
 
@@ -51,12 +52,14 @@
 #include "yb/master/master.proxy.h"
 #include "yb/rpc/messenger.h"
 #include "yb/rpc/rpc.h"
+#include "yb/tserver/tserver.pb.h"
 #include "yb/tserver/tserver_service.proxy.h"
 
 #include "yb/util/algorithm_util.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/net/dns_resolver.h"
 #include "yb/util/net/net_util.h"
+#include "yb/util/pb_util.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/shared_lock.h"
 
@@ -76,6 +79,18 @@ DEFINE_test_flag(bool, verify_all_replicas_alive, false,
 DEFINE_int32(retry_failed_replica_ms, 60 * 1000,
              "Time in milliseconds to wait for before retrying a failed replica");
 
+DEFINE_int32(meta_cache_prefetch_batch_size, 1000,
+             "Number of tablet locations requested from master in one RPC, when prefetching "
+             "locations of all tablets of a table.");
+TAG_FLAG(meta_cache_prefetch_batch_size, advanced);
+TAG_FLAG(meta_cache_prefetch_batch_size, runtime);
+
+DEFINE_int32(meta_cache_prefetch_min_tablets, 256,
+             "The first lookup of a table with at least this number of tablets prefetches "
+             "locations of all its tablets, instead of one group of tablets. 0 to disable.");
+TAG_FLAG(meta_cache_prefetch_min_tablets, advanced);
+TAG_FLAG(meta_cache_prefetch_min_tablets, runtime);
+
 METRIC_DEFINE_histogram(
   server, dns_resolve_latency_during_init_proxy,
   "yb.client.MetaCache.InitProxy DNS Resolve",
@@ -113,6 +128,28 @@ const size_t kPartitionGroupSize = 64;
 const size_t kPartitionGroupSize = 4;
 #endif
 
+// Restores full ts_info of replicas from ts_infos, when locations are in compact format, i.e.
+// replicas have only permanent_uuid in ts_info.
+void ExpandCompactTSInfos(
+    const google::protobuf::RepeatedPtrField<TSInfoPB>& ts_infos,
+    google::protobuf::RepeatedPtrField<TabletLocationsPB>* locations) {
+  if (ts_infos.empty()) {
+    return;
+  }
+  std::unordered_map<Slice, const TSInfoPB*, Slice::Hash> ts_infos_by_uuid;
+  for (const auto& ts_info : ts_infos) {
+    ts_infos_by_uuid.emplace(ts_info.permanent_uuid(), &ts_info);
+  }
+  for (auto& loc : *locations) {
+    for (auto& replica : *loc.mutable_replicas()) {
+      auto it = ts_infos_by_uuid.find(replica.ts_info().permanent_uuid());
+      if (it != ts_infos_by_uuid.end()) {
+        *replica.mutable_ts_info() = *it->second;
+      }
+    }
+  }
+}
+
 } // namespace
 
 ////////////////////////////////////////////////////////////
@@ -202,6 +239,38 @@ const google::protobuf::RepeatedPtrField<HostPortPB>&
   return private_rpc_hostports_;
 }
 
+void RemoteTabletServer::FillLocationChangesRequest(
+    tserver::TabletLocationChangesRequestPB* req) const {
+  SharedLock<rw_spinlock> lock(mutex_);
+  if (location_changes_sequence_number_ >= 0) {
+    req->set_instance_id(location_changes_instance_id_);
+    req->set_last_sequence_number(location_changes_sequence_number_);
+  }
+}
+
+int RemoteTabletServer::UpdateLocationChanges(
+    const tserver::TabletLocationChangesPB& changes, bool* overflow) {
+  std::lock_guard<rw_spinlock> lock(mutex_);
+  int result = 0;
+  *overflow = false;
+  if (changes.instance_id() == location_changes_instance_id_ &&
+      location_changes_sequence_number_ >= 0) {
+    for (auto it = changes.changes().rbegin(); it != changes.changes().rend(); ++it) {
+      if (it->sequence_number() <= location_changes_sequence_number_) {
+        break;
+      }
+      ++result;
+    }
+    if (changes.last_sequence_number() < location_changes_sequence_number_) {
+      return result;
+    }
+  }
+  *overflow = changes.overflow() && location_changes_sequence_number_ >= 0;
+  location_changes_instance_id_ = changes.instance_id();
+  location_changes_sequence_number_ = changes.last_sequence_number();
+  return result;
+}
+
 shared_ptr<TabletServerServiceProxy> RemoteTabletServer::proxy() const {
   SharedLock<rw_spinlock> lock(mutex_);
   return proxy_;
@@ -245,6 +314,17 @@ bool RemoteTabletServer::HasCapability(CapabilityId capability) const {
   return std::binary_search(capabilities_.begin(), capabilities_.end(), capability);
 }
 
+void RemoteTabletServer::ToPB(master::TSInfoPB* pb) const {
+  pb->set_permanent_uuid(uuid_);
+  SharedLock<rw_spinlock> lock(mutex_);
+  *pb->mutable_private_rpc_addresses() = private_rpc_hostports_;
+  *pb->mutable_broadcast_addresses() = public_rpc_hostports_;
+  *pb->mutable_cloud_info() = cloud_info_pb_;
+  for (auto capability : capabilities_) {
+    pb->add_capabilities(capability);
+  }
+}
+
 ////////////////////////////////////////////////////////////
 
 RemoteTablet::~RemoteTablet() {
@@ -475,6 +555,19 @@ std::string RemoteTablet::ReplicasAsStringUnlocked() const {
   return replicas_str;
 }
 
+void RemoteTablet::ToPB(master::TabletLocationsPB* pb) const {
+  pb->set_tablet_id(tablet_id_);
+  partition_.ToPB(pb->mutable_partition());
+  pb->set_split_depth(split_depth_);
+  SharedLock<rw_spinlock> lock(mutex_);
+  pb->set_stale(stale_);
+  for (const auto& replica : replicas_) {
+    auto* replica_pb = pb->add_replicas();
+    replica_pb->mutable_ts_info()->set_permanent_uuid(replica.ts->permanent_uuid());
+    replica_pb->set_role(replica.role);
+  }
+}
+
 std::string RemoteTablet::ToString() const {
   return YB_CLASS_TO_STRING(tablet_id, partition, split_depth);
 }
@@ -964,6 +1057,47 @@ void MetaCache::MaybeUpdateClientRequests(const TableData& table_data, const Rem
   tablet_requests[tablet.tablet_id()].request_id_seq = requests_it->second.request_id_seq;
 }
 
+void MetaCache::ProcessLocationChanges(
+    RemoteTabletServer* ts, const tserver::TabletLocationChangesPB& pb) {
+  bool overflow = false;
+  const int num_new_changes = ts->UpdateLocationChanges(pb, &overflow);
+  if (num_new_changes == 0 && !overflow) {
+    return;
+  }
+
+  SharedLock<decltype(mutex_)> lock(mutex_);
+  if (overflow) {
+    VLOG(1) << "Lost location changes from " << ts->permanent_uuid()
+            << ", marking its tablets stale";
+    for (const auto& id_and_tablet : tablets_by_id_) {
+      const auto& tablet = id_and_tablet.second;
+      auto replicas = tablet->GetRemoteTabletServers(IncludeFailedReplicas::kTrue);
+      if (std::find(replicas.begin(), replicas.end(), ts) != replicas.end()) {
+        tablet->MarkStale();
+      }
+    }
+  }
+  for (int i = pb.changes_size() - num_new_changes; i != pb.changes_size(); ++i) {
+    const auto& change = pb.changes(i);
+    auto tablet = FindPtrOrNull(tablets_by_id_, change.tablet_id());
+    if (!tablet) {
+      continue;
+    }
+    VLOG(2) << tablet->LogPrefix() << "Location change from " << ts->permanent_uuid() << ": "
+            << change.ShortDebugString();
+    if (change.split()) {
+      tablet->MarkAsSplit();
+      tablet->MarkStale();
+      continue;
+    }
+    auto it = ts_cache_.find(change.leader_uuid());
+    if (it == ts_cache_.end() || !tablet->MarkTServerAsLeader(it->second.get())) {
+      // Leader is not among known replicas of the tablet, so replicas should be refreshed.
+      tablet->MarkStale();
+    }
+  }
+}
+
 void MetaCache::InvalidateTableCache(const TableId& table_id) {
   std::vector<LookupTabletCallback> to_notify;
 
@@ -1136,6 +1270,7 @@ class LookupByKeyRpc : public LookupRpc {
     req_.mutable_table()->set_table_id(table_->id());
     req_.set_partition_key_start(partition_group_start_);
     req_.set_max_returned_locations(kPartitionGroupSize);
+    req_.set_compact_ts_info(true);
 
     // The end partition key is left unset intentionally so that we'll prefetch
     // some additional tablets.
@@ -1146,6 +1281,7 @@ class LookupByKeyRpc : public LookupRpc {
 
  private:
   void Finished(const Status& status) override {
+    ExpandCompactTSInfos(resp_.ts_infos(), resp_.mutable_tablet_locations());
     const auto table_partitions_version = table_->GetPartitionsVersion();
     VLOG_WITH_FUNC(4) << Format(
         "Received table $0 partitions version: $1, ours is: $2", table_->id(),
@@ -1182,6 +1318,82 @@ class LookupByKeyRpc : public LookupRpc {
   GetTableLocationsResponsePB resp_;
 };
 
+// Fetches one batch of locations of all tablets of the table, starting from the specified
+// partition. See MetaCache::PrefetchTableLocations.
+class PrefetchTableLocationsRpc : public LookupRpc {
+ public:
+  PrefetchTableLocationsRpc(const scoped_refptr<MetaCache>& meta_cache,
+                            const YBTable* table,
+                            MetaCache::PartitionKey partition_start,
+                            CoarseTimePoint deadline,
+                            Messenger* messenger,
+                            rpc::ProxyCache* proxy_cache)
+      : LookupRpc(meta_cache, deadline, messenger, proxy_cache),
+        table_(table->shared_from_this()),
+        partition_start_(std::move(partition_start)) {
+  }
+
+  std::string ToString() const override {
+    return Format("PrefetchTableLocations($0, $1, $2)",
+                  table_->name(), Slice(partition_start_).ToDebugHexString(), num_attempts());
+  }
+
+  void DoSendRpc() override {
+    req_.mutable_table()->set_table_id(table_->id());
+    req_.set_partition_key_start(partition_start_);
+    req_.set_max_returned_locations(std::max(FLAGS_meta_cache_prefetch_batch_size, 1));
+    req_.set_compact_ts_info(true);
+
+    master_proxy()->GetTableLocationsAsync(
+        req_, &resp_, mutable_retrier()->mutable_controller(),
+        std::bind(&PrefetchTableLocationsRpc::Finished, this, Status::OK()));
+  }
+
+ private:
+  void Finished(const Status& status) override {
+    ExpandCompactTSInfos(resp_.ts_infos(), resp_.mutable_tablet_locations());
+    const auto table_partitions_version = table_->GetPartitionsVersion();
+    if (status.ok() && !resp_.has_error() &&
+        resp_.partitions_version() != table_partitions_version) {
+      DoFinished(
+          STATUS_EC_FORMAT(
+              TryAgain, ClientError(ClientErrorCode::kTablePartitionsAreStale),
+              "Received table $0 partitions version: $1, ours is: $2", table_->id(),
+              resp_.partitions_version(), table_partitions_version),
+          resp_, nullptr /* partition_group_start */);
+      return;
+    }
+    DoFinished(status, resp_, nullptr /* partition_group_start */);
+  }
+
+  void Notify(const Result<RemoteTabletPtr>& result) override {
+    if (!result.ok()) {
+      meta_cache()->PrefetchBatchDone(
+          table_, result.status(), std::string(), retrier().deadline());
+      return;
+    }
+    // DoFinished does not notify about success when there are no locations in the response.
+    const auto& next_partition_start = resp_.tablet_locations(
+        resp_.tablet_locations_size() - 1).partition().partition_key_end();
+    meta_cache()->PrefetchBatchDone(
+        table_, Status::OK(),
+        next_partition_start > partition_start_ ? next_partition_start : std::string(),
+        retrier().deadline());
+  }
+
+  // Table to prefetch.
+  std::shared_ptr<const YBTable> table_;
+
+  // Encoded partition key to start this batch from.
+  MetaCache::PartitionKey partition_start_;
+
+  // Request body.
+  GetTableLocationsRequestPB req_;
+
+  // Response body.
+  GetTableLocationsResponsePB resp_;
+};
+
 RemoteTabletPtr MetaCache::LookupTabletByKeyFastPathUnlocked(const YBTable* table,
                                                              const std::string& partition_key) {
   auto it = tables_.find(table->id());
@@ -1251,6 +1463,7 @@ void MetaCache::LookupTabletByKey(const YBTable* table,
 
   const std::string& partition_group_start =
       table->FindPartitionStart(partition_start, kPartitionGroupSize);
+  bool start_prefetch = false;
   {
     std::unique_lock<boost::shared_mutex> lock(mutex_);
     if (FastLookupTabletByKeyUnlocked(table, partition_start, callback, &lock)) {
@@ -1258,21 +1471,108 @@ void MetaCache::LookupTabletByKey(const YBTable* table,
     }
 
     auto& table_data = tables_[table->id()];
-    auto& lookup = table_data.tablet_lookups_by_group[partition_group_start];
-    bool was_empty = lookup.empty();
-    lookup[partition_start].push_back({std::move(callback), deadline});
-    if (!was_empty) {
-      VLOG_WITH_FUNC(4) << "Lookups were not empty for partition_group_start: "
-                        << Slice(partition_group_start).ToDebugHexString();
-      return;
+    if (table_data.prefetch_in_progress || ShouldPrefetchUnlocked(table, table_data)) {
+      // Wait for the prefetch instead of looking up this group of partitions separately.
+      table_data.prefetch_waiters.push_back({partition_key, std::move(callback), deadline});
+      if (table_data.prefetch_in_progress) {
+        return;
+      }
+      table_data.prefetch_in_progress = true;
+      start_prefetch = true;
+    } else {
+      auto& lookup = table_data.tablet_lookups_by_group[partition_group_start];
+      bool was_empty = lookup.empty();
+      lookup[partition_start].push_back({std::move(callback), deadline});
+      if (!was_empty) {
+        VLOG_WITH_FUNC(4) << "Lookups were not empty for partition_group_start: "
+                          << Slice(partition_group_start).ToDebugHexString();
+        return;
+      }
     }
   }
 
+  if (start_prefetch) {
+    VLOG_WITH_FUNC(2) << "Prefetching locations of " << table->GetPartitionCount()
+                      << " tablets of table " << table->id();
+    StartPrefetch(table, std::string(), deadline);
+    return;
+  }
+
   rpc::StartRpc<LookupByKeyRpc>(
       this, table, partition_group_start, deadline, client_->data_->messenger_,
       client_->data_->proxy_cache_.get());
 }
 
+bool MetaCache::ShouldPrefetchUnlocked(const YBTable* table, const TableData& table_data) const {
+  return FLAGS_meta_cache_prefetch_min_tablets > 0 &&
+         !table_data.prefetch_failed &&
+         table_data.tablets_by_partition.empty() &&
+         table->GetPartitionCount() >= FLAGS_meta_cache_prefetch_min_tablets;
+}
+
+void MetaCache::PrefetchTableLocations(const YBTable* table,
+                                       CoarseTimePoint deadline,
+                                       StdStatusCallback callback) {
+  {
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    auto& table_data = tables_[table->id()];
+    table_data.prefetch_callbacks.push_back(std::move(callback));
+    if (table_data.prefetch_in_progress) {
+      return;
+    }
+    table_data.prefetch_in_progress = true;
+  }
+
+  StartPrefetch(table, std::string(), deadline);
+}
+
+void MetaCache::StartPrefetch(
+    const YBTable* table, const std::string& partition_start, CoarseTimePoint deadline) {
+  rpc::StartRpc<PrefetchTableLocationsRpc>(
+      this, table, partition_start, deadline, client_->data_->messenger_,
+      client_->data_->proxy_cache_.get());
+}
+
+void MetaCache::PrefetchBatchDone(
+    const std::shared_ptr<const YBTable>& table, const Status& status,
+    const std::string& next_partition_start, CoarseTimePoint deadline) {
+  auto result = status;
+  if (result.ok() && !next_partition_start.empty() && CoarseMonoClock::Now() >= deadline) {
+    result = STATUS_FORMAT(TimedOut, "Prefetch of table $0 locations timed out", table->id());
+  }
+  const bool done = !result.ok() || next_partition_start.empty();
+  VLOG_WITH_FUNC(2) << "Table: " << table->id() << ", status: " << result
+                    << ", next partition: " << Slice(next_partition_start).ToDebugHexString();
+
+  std::vector<StdStatusCallback> callbacks;
+  std::vector<PrefetchWaiter> waiters;
+  {
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    auto& table_data = tables_[table->id()];
+    waiters.swap(table_data.prefetch_waiters);
+    if (done) {
+      table_data.prefetch_in_progress = false;
+      table_data.prefetch_failed = !result.ok();
+      callbacks.swap(table_data.prefetch_callbacks);
+    }
+  }
+
+  if (!done) {
+    StartPrefetch(table.get(), next_partition_start, deadline);
+  }
+
+  for (const auto& callback : callbacks) {
+    callback(result);
+  }
+
+  // Waiters for tablets from the processed batch are served from the cache, others wait for the
+  // next batch. After the prefetch is done, remaining waiters are looked up as usual.
+  for (auto& waiter : waiters) {
+    LookupTabletByKey(
+        table.get(), waiter.partition_key, waiter.deadline, std::move(waiter.callback));
+  }
+}
+
 RemoteTabletPtr MetaCache::LookupTabletByIdFastPath(const TabletId& tablet_id) {
   SharedLock<decltype(mutex_)> lock(mutex_);
   auto it = tablets_by_id_.find(tablet_id);
@@ -1316,6 +1616,72 @@ void MetaCache::MarkTSFailed(RemoteTabletServer* ts,
   }
 }
 
+Status MetaCache::SaveSnapshot(Env* env, const std::string& path) {
+  master::TabletLocationsSnapshotPB pb;
+  size_t num_tablets = 0;
+  {
+    SharedLock<decltype(mutex_)> lock(mutex_);
+    std::unordered_set<std::string> saved_tservers;
+    for (const auto& p : ts_cache_) {
+      // The local tablet server could be registered without addresses.
+      if (p.second->private_rpc_hostports().empty() && p.second->public_rpc_hostports().empty()) {
+        continue;
+      }
+      p.second->ToPB(pb.add_ts_infos());
+      saved_tservers.insert(p.first);
+    }
+    for (const auto& p : tables_) {
+      master::TabletLocationsSnapshotPB::TablePB* table_pb = nullptr;
+      for (const auto& partition_and_tablet : p.second.tablets_by_partition) {
+        const auto& tablet = partition_and_tablet.second;
+        if (tablet->stale()) {
+          continue;
+        }
+        if (!table_pb) {
+          table_pb = pb.add_tables();
+          table_pb->set_table_id(p.first);
+        }
+        auto* loc = table_pb->add_tablet_locations();
+        tablet->ToPB(loc);
+        loc->set_table_id(p.first);
+        loc->add_table_ids(p.first);
+        auto* replicas = loc->mutable_replicas();
+        replicas->erase(
+            std::remove_if(replicas->begin(), replicas->end(), [&saved_tservers](const auto& r) {
+              return saved_tservers.count(r.ts_info().permanent_uuid()) == 0;
+            }),
+            replicas->end());
+        ++num_tablets;
+      }
+    }
+  }
+
+  RETURN_NOT_OK(pb_util::WritePBContainerToPath(
+      env, path, pb, pb_util::OVERWRITE, pb_util::NO_SYNC));
+  LOG(INFO) << "Saved " << num_tablets << " tablet locations of " << pb.tables_size()
+            << " tables to " << path;
+  return Status::OK();
+}
+
+Status MetaCache::LoadSnapshot(Env* env, const std::string& path) {
+  master::TabletLocationsSnapshotPB pb;
+  RETURN_NOT_OK(pb_util::ReadPBContainerFromPath(env, path, &pb));
+
+  size_t num_tablets = 0;
+  for (auto& table_pb : *pb.mutable_tables()) {
+    if (table_pb.tablet_locations().empty()) {
+      continue;
+    }
+    ExpandCompactTSInfos(pb.ts_infos(), table_pb.mutable_tablet_locations());
+    RETURN_NOT_OK(ProcessTabletLocations(
+        table_pb.tablet_locations(), nullptr /* partition_group_start */));
+    num_tablets += table_pb.tablet_locations().size();
+  }
+  LOG(INFO) << "Loaded " << num_tablets << " tablet locations of " << pb.tables_size()
+            << " tables from " << path;
+  return Status::OK();
+}
+
 bool MetaCache::AcquireMasterLookupPermit() {
   return master_lookup_sem_.TryAcquire();
 }
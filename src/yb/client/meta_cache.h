@@ -67,6 +67,7 @@
 
 namespace yb {
 
+class Env;
 class Histogram;
 class YBPartialRow;
 
@@ -76,6 +77,10 @@ class TabletServerServiceProxy;
 // A local tablet server with methods that can be invoked directly and without blocking.
 class GetTabletStatusRequestPB;
 class GetTabletStatusResponsePB;
+class GetTransactionStatusRequestPB;
+class GetTransactionStatusResponsePB;
+class TabletLocationChangesPB;
+class TabletLocationChangesRequestPB;
 
 class LocalTabletServer {
  public:
@@ -86,6 +91,13 @@ class LocalTabletServer {
                                          GetTabletStatusResponsePB* resp) const = 0;
 
   virtual bool LeaderAndReady(const TabletId& tablet_id, bool allow_stale = false) const = 0;
+
+  // Answers transaction status request using transaction coordinator of the local tablet.
+  // Fails if the tablet is not hosted here or its peer is not a leader with a valid lease,
+  // so caller should fall back to regular RPC in this case.
+  virtual CHECKED_STATUS GetTransactionStatus(const GetTransactionStatusRequestPB* req,
+                                              CoarseTimePoint deadline,
+                                              GetTransactionStatusResponsePB* resp) const = 0;
 };
 
 } // namespace tserver
@@ -108,6 +120,7 @@ namespace internal {
 class LookupRpc;
 class LookupByKeyRpc;
 class LookupByIdRpc;
+class PrefetchTableLocationsRpc;
 
 // The information cached about a given tablet server in the cluster.
 //
@@ -157,6 +170,17 @@ class RemoteTabletServer {
 
   bool HasCapability(CapabilityId capability) const;
 
+  // Fills the subscription to tablet location changes observed by this tablet server, with the
+  // last change received from it.
+  void FillLocationChangesRequest(tserver::TabletLocationChangesRequestPB* req) const;
+
+  // Remembers the last change received from this tablet server. Returns the number of changes
+  // from 'changes' that were not received before, they are at the end of 'changes'.
+  // Sets 'overflow' when 'changes' reports lost changes and is not older than already received.
+  int UpdateLocationChanges(const tserver::TabletLocationChangesPB& changes, bool* overflow);
+
+  void ToPB(master::TSInfoPB* pb) const;
+
  private:
   mutable rw_spinlock mutex_;
   const std::string uuid_;
@@ -169,6 +193,10 @@ class RemoteTabletServer {
   const tserver::LocalTabletServer* const local_tserver_ = nullptr;
   scoped_refptr<Histogram> dns_resolve_histogram_;
   std::vector<CapabilityId> capabilities_;
+  // Instance of the tablet server and sequence number of the last tablet location change received
+  // from it.
+  uint64_t location_changes_instance_id_ = 0;
+  int64_t location_changes_sequence_number_ = -1;
 
   DISALLOW_COPY_AND_ASSIGN(RemoteTabletServer);
 };
@@ -306,6 +334,10 @@ class RemoteTablet : public RefCountedThreadSafe<RemoteTablet> {
   // See TabletLocationsPB::split_depth.
   uint64 split_depth() const { return split_depth_; }
 
+  // Fills tablet id, partition and replicas of the tablet. Only permanent_uuid is filled in
+  // ts_info of replicas.
+  void ToPB(master::TabletLocationsPB* pb) const;
+
  private:
   // Same as ReplicasAsString(), except that the caller must hold mutex_.
   std::string ReplicasAsStringUnlocked() const;
@@ -374,6 +406,23 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
                         LookupTabletCallback callback,
                         UseCache use_cache);
 
+  // Fetches locations of all tablets of the table from master, using batches of
+  // FLAGS_meta_cache_prefetch_batch_size tablets. Concurrent prefetches of the same table are
+  // coalesced into one. Lookups of the table that miss the cache while prefetch is in progress
+  // wait for it, and are retried after each received batch.
+  //
+  // NOTE: the memory referenced by 'table' must remain valid until 'callback' is invoked.
+  void PrefetchTableLocations(const YBTable* table,
+                              CoarseTimePoint deadline,
+                              StdStatusCallback callback);
+
+  // Saves locations of all cached tablets to the file at 'path'.
+  CHECKED_STATUS SaveSnapshot(Env* env, const std::string& path);
+
+  // Populates the cache with tablet locations saved by SaveSnapshot. Locations from the snapshot
+  // could be outdated, in this case they are refreshed like any other outdated cache entry.
+  CHECKED_STATUS LoadSnapshot(Env* env, const std::string& path);
+
   // Return the local tablet server if available.
   RemoteTabletServer* local_tserver() const {
     return local_tserver_;
@@ -403,10 +452,18 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
 
   void InvalidateTableCache(const TableId& table_id);
 
+  // Applies tablet location changes piggybacked by the tablet server on a response. New leaders are
+  // marked in cached tablets, so requests go to them without retries. Split tablets and tablets
+  // whose new leader is unknown are marked stale, so they are refreshed on the next lookup.
+  // When the tablet server lost some of the changes, all cached tablets with a replica on it are
+  // marked stale.
+  void ProcessLocationChanges(RemoteTabletServer* ts, const tserver::TabletLocationChangesPB& pb);
+
  private:
   friend class LookupRpc;
   friend class LookupByKeyRpc;
   friend class LookupByIdRpc;
+  friend class PrefetchTableLocationsRpc;
 
   FRIEND_TEST(client::ClientTest, TestMasterLookupPermits);
 
@@ -422,6 +479,13 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
     }
   };
 
+  // Lookup by partition key, waiting for table locations prefetch.
+  struct PrefetchWaiter {
+    std::string partition_key;
+    LookupTabletCallback callback;
+    CoarseTimePoint deadline;
+  };
+
   typedef std::unordered_map<std::string, std::vector<LookupData>> PartitionToLookupData;
   typedef std::string PartitionKey;
   typedef std::string PartitionGroupKey;
@@ -434,6 +498,13 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
     // partition start key.
     std::map<PartitionKey, std::vector<RemoteTabletPtr>> split_tablets;
     bool stale = false;
+    // Whether locations of all tablets of the table are being fetched by
+    // PrefetchTableLocationsRpc.
+    bool prefetch_in_progress = false;
+    // Whether the last prefetch failed, in this case lookups do not start prefetch anymore.
+    bool prefetch_failed = false;
+    std::vector<StdStatusCallback> prefetch_callbacks;
+    std::vector<PrefetchWaiter> prefetch_waiters;
   };
 
   // Lookup the given tablet by key, only consulting local information.
@@ -455,6 +526,20 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
   void LookupFailed(
       const YBTable* table, const std::string& partition_group_start, const Status& status);
 
+  // Whether the first lookup of the table should prefetch locations of all its tablets.
+  bool ShouldPrefetchUnlocked(const YBTable* table, const TableData& table_data) const
+      REQUIRES_SHARED(mutex_);
+
+  void StartPrefetch(
+      const YBTable* table, const std::string& partition_start, CoarseTimePoint deadline);
+
+  // Called when a batch of prefetched tablet locations has been processed, or prefetch failed.
+  // Continues prefetch from next_partition_start if it is not empty, otherwise completes it.
+  // Lookups waiting for prefetch are retried in both cases.
+  void PrefetchBatchDone(
+      const std::shared_ptr<const YBTable>& table, const Status& status,
+      const std::string& next_partition_start, CoarseTimePoint deadline);
+
   template <class Lock>
   bool FastLookupTabletByKeyUnlocked(
       const YBTable* table,
@@ -23,6 +23,7 @@
 #include "yb/master/master_util.h"
 
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_peer.h"
 
 #include "yb/tserver/mini_tablet_server.h"
@@ -32,6 +33,7 @@
 #include "yb/util/backoff_waiter.h"
 #include "yb/util/curl_util.h"
 #include "yb/util/jsonreader.h"
+#include "yb/util/metrics.h"
 #include "yb/util/random.h"
 #include "yb/util/random_util.h"
 #include "yb/util/tostring.h"
@@ -44,6 +46,8 @@ DECLARE_bool(rocksdb_disable_compactions);
 DECLARE_int32(yb_num_shards_per_tserver);
 DECLARE_int64(db_block_cache_size_bytes);
 DECLARE_bool(flush_rocksdb_on_shutdown);
+DECLARE_bool(follower_read_index);
+DECLARE_bool(strong_reads_from_closest_replica);
 
 using namespace std::literals;
 
@@ -1260,6 +1264,34 @@ TEST_F(QLDmlTest, ReadFollower) {
   ASSERT_TRUE(missing_rows.empty()) << "Missing rows: " << yb::ToString(missing_rows);
 }
 
+// Strong reads sent to the closest replica should observe every write acknowledged before them,
+// even when they are served by a follower.
+TEST_F(QLDmlTest, StrongReadFromFollower) {
+  FLAGS_follower_read_index = true;
+  FLAGS_strong_reads_from_closest_replica = true;
+  constexpr int kNumRows = RegularBuildVsSanitizers(500, 100);
+
+  auto session = NewSession();
+  for (size_t i = 0; i != kNumRows; ++i) {
+    InsertRow(session, KeyForIndex(i), ValueForIndex(i));
+    ASSERT_OK(session->Flush());
+    auto row = ReadRow(session, KeyForIndex(i));
+    ASSERT_OK(row);
+    ASSERT_EQ(*row, ValueForIndex(i));
+  }
+
+  // Only followers count reads served using the read index of the leader.
+  int64_t follower_reads = 0;
+  for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kAll)) {
+    auto tablet = peer->shared_tablet();
+    if (tablet) {
+      follower_reads += tablet->metrics()->follower_read_index_reads->value();
+    }
+  }
+  LOG(INFO) << "Reads served by followers: " << follower_reads;
+  ASSERT_GT(follower_reads, 0);
+}
+
 TEST_F(QLDmlTest, DeletePartialRangeKey) {
   auto session = NewSession();
   RowKey row_key{1, "a", 2, "b"};
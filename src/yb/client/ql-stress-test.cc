@@ -21,6 +21,7 @@
 
 #include "yb/common/ql_value.h"
 
+#include "yb/consensus/consensus_meta.h"
 #include "yb/consensus/log_reader.h"
 #include "yb/consensus/raft_consensus.h"
 #include "yb/consensus/replica_state.h"
@@ -67,6 +68,9 @@ DECLARE_uint64(log_segment_size_bytes);
 DECLARE_uint64(sst_files_soft_limit);
 DECLARE_uint64(sst_files_hard_limit);
 DECLARE_int32(log_min_seconds_to_retain);
+DECLARE_int32(log_min_segments_to_retain);
+DECLARE_int32(retryable_request_timeout_secs);
+DECLARE_int32(retryable_requests_flush_interval_ms);
 DECLARE_int64(remote_bootstrap_rate_limit_bytes_per_sec);
 DECLARE_int64(db_write_buffer_size);
 DECLARE_int32(log_cache_size_limit_mb);
@@ -483,12 +487,172 @@ TEST_F_EX(QLStressTest, Increment, QLStressTestIntValue) {
 }
 
 class QLStressTestSingleTablet : public QLStressTest {
+ protected:
+  std::vector<tablet::TabletPeerPtr> TablePeers() {
+    std::vector<tablet::TabletPeerPtr> result;
+    for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kAll)) {
+      if (peer->tablet() && peer->consensus() &&
+          peer->tablet()->metadata()->table_id() == table_.table()->id()) {
+        result.push_back(peer);
+      }
+    }
+    return result;
+  }
+
+  // Returns number of replicated retryable requests for each peer of the table.
+  std::map<std::string, size_t> ReplicatedRetryableRequestCounts() {
+    std::map<std::string, size_t> result;
+    for (const auto& peer : TablePeers()) {
+      auto raft_consensus = down_cast<consensus::RaftConsensus*>(peer->consensus());
+      result[peer->permanent_uuid()] = raft_consensus->TEST_CountRetryableRequests().replicated;
+    }
+    return result;
+  }
+
+  // Waits until all peers of the table flushed retryable requests up to the last logged op id.
+  CHECKED_STATUS WaitRetryableRequestsFlushed() {
+    auto peers = TablePeers();
+    if (peers.empty()) {
+      return STATUS(IllegalState, "No peers");
+    }
+    auto last_op_id = down_cast<consensus::RaftConsensus*>(
+        peers[0]->consensus())->GetLatestOpIdFromLog();
+    return WaitFor([&peers, last_op_id] {
+      for (const auto& peer : peers) {
+        auto raft_consensus = down_cast<consensus::RaftConsensus*>(peer->consensus());
+        if (raft_consensus->MinRetryableRequestOpId() < last_op_id) {
+          return false;
+        }
+      }
+      return true;
+    }, 15s, "Retryable requests flushed");
+  }
+
  private:
   int NumTablets() override {
     return 1;
   }
 };
 
+// Checks that replicated retryable requests are restored from the persisted snapshot after
+// restart, when the log segments that contained them were already garbage collected.
+TEST_F_EX(QLStressTest, PersistRetryableRequests, QLStressTestSingleTablet) {
+  FLAGS_retryable_requests_flush_interval_ms = 100;
+  // Retryable requests alone would retain the whole log, and bootstrap would read all of it.
+  FLAGS_retryable_request_timeout_secs = 600;
+  FLAGS_log_segment_size_bytes = 32_KB;
+  FLAGS_log_min_seconds_to_retain = 0;
+  FLAGS_log_min_segments_to_retain = 1;
+
+  auto session = NewSession();
+  const std::string kValuePadding(100, 'x');
+  int key = 0;
+  int num_segments = 0;
+  while (num_segments < 4) {
+    ASSERT_OK(WriteRow(session, key, Format("value_$0_$1", key, kValuePadding)));
+    ++key;
+    num_segments = 0;
+    for (const auto& peer : TablePeers()) {
+      num_segments = std::max(num_segments, peer->log()->num_segments());
+    }
+  }
+
+  auto peers = TablePeers();
+  ASSERT_EQ(peers.size(), 3);
+  ASSERT_OK(cluster_->FlushTablets());
+  ASSERT_OK(WaitRetryableRequestsFlushed());
+
+  ASSERT_OK(cluster_->CleanTabletLogs());
+  for (const auto& peer : peers) {
+    ASSERT_LT(peer->log()->num_segments(), num_segments) << peer->permanent_uuid();
+  }
+
+  auto counts_before_restart = ReplicatedRetryableRequestCounts();
+  for (const auto& p : counts_before_restart) {
+    ASSERT_GT(p.second, 0) << p.first;
+  }
+  peers.clear();
+
+  ASSERT_OK(cluster_->RestartSync());
+
+  std::map<std::string, size_t> counts_after_restart;
+  ASSERT_OK(WaitFor([&] {
+    counts_after_restart = ReplicatedRetryableRequestCounts();
+    return counts_after_restart.size() == counts_before_restart.size();
+  }, 30s, "Tablet peers started"));
+  ASSERT_EQ(counts_before_restart, counts_after_restart);
+
+  ASSERT_OK(WriteRow(session, key, "value_after_restart"));
+}
+
+// Checks that retryable requests snapshot of a tombstoned replica is deleted, so it is not used
+// after the replica is remotely bootstrapped and restarted.
+TEST_F_EX(QLStressTest, PersistRetryableRequestsTombstone, QLStressTestSingleTablet) {
+  FLAGS_retryable_requests_flush_interval_ms = 100;
+
+  auto session = NewSession();
+  int key = 0;
+  for (; key != 100; ++key) {
+    ASSERT_OK(WriteRow(session, key, Format("value_$0", key)));
+  }
+  ASSERT_OK(WaitRetryableRequestsFlushed());
+
+  TabletId tablet_id;
+  std::string follower_uuid;
+  for (const auto& peer : TablePeers()) {
+    if (peer->LeaderStatus() == consensus::LeaderStatus::NOT_LEADER) {
+      tablet_id = peer->tablet_id();
+      follower_uuid = peer->permanent_uuid();
+      break;
+    }
+  }
+  ASSERT_FALSE(follower_uuid.empty());
+  tserver::TabletServer* follower_server = nullptr;
+  for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+    auto* server = cluster_->mini_tablet_server(i)->server();
+    if (server->permanent_uuid() == follower_uuid) {
+      follower_server = server;
+    }
+  }
+  ASSERT_NE(follower_server, nullptr);
+  auto* fs_manager = follower_server->fs_manager();
+  consensus::RetryableRequestsPB snapshot;
+  ASSERT_OK(consensus::ConsensusMetadata::LoadRetryableRequests(
+      fs_manager, tablet_id, &snapshot));
+
+  LOG(INFO) << "Tombstoning " << tablet_id << " on " << follower_uuid;
+  boost::optional<tserver::TabletServerErrorPB::Code> error_code;
+  ASSERT_OK(follower_server->tablet_manager()->DeleteTablet(
+      tablet_id, tablet::TABLET_DATA_TOMBSTONED, boost::none, &error_code));
+  auto status = consensus::ConsensusMetadata::LoadRetryableRequests(
+      fs_manager, tablet_id, &snapshot);
+  ASSERT_TRUE(status.IsNotFound()) << status;
+
+  // Leader remotely bootstraps the tombstoned replica when it sends new operations to it.
+  for (; key != 200; ++key) {
+    ASSERT_OK(WriteRow(session, key, Format("value_$0", key)));
+  }
+  ASSERT_OK(WaitFor([this, &follower_uuid] {
+    return ReplicatedRetryableRequestCounts().count(follower_uuid) != 0;
+  }, 30s, "Follower remotely bootstrapped"));
+  ASSERT_OK(WaitRetryableRequestsFlushed());
+
+  auto counts_before_restart = ReplicatedRetryableRequestCounts();
+  ASSERT_EQ(counts_before_restart.size(), 3);
+  ASSERT_OK(cluster_->RestartSync());
+
+  std::map<std::string, size_t> counts_after_restart;
+  ASSERT_OK(WaitFor([&] {
+    counts_after_restart = ReplicatedRetryableRequestCounts();
+    return counts_after_restart.size() == counts_before_restart.size();
+  }, 30s, "Tablet peers started"));
+  ASSERT_EQ(counts_before_restart, counts_after_restart);
+
+  for (int i = 0; i != key; ++i) {
+    ASSERT_EQ(ASSERT_RESULT(ReadRow(session, i)).string_value(), Format("value_$0", i));
+  }
+}
+
 // This test has the following scenario:
 // Add some operations to the old leader, but don't add to other nodes.
 // Switch leadership to a new leader, but don't accept updates from new leader by old leader.
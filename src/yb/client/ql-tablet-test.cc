@@ -28,6 +28,8 @@
 
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/consensus.pb.h"
+#include "yb/consensus/raft_consensus.h"
+#include "yb/consensus/replica_state.h"
 
 #include "yb/docdb/consensus_frontier.h"
 
@@ -77,6 +79,9 @@ DECLARE_uint64(sst_files_soft_limit);
 DECLARE_int32(timestamp_history_retention_interval_sec);
 DECLARE_int32(raft_heartbeat_interval_ms);
 DECLARE_int32(history_cutoff_propagation_interval_ms);
+DECLARE_int32(raft_quiescence_idle_heartbeats);
+DECLARE_bool(follower_apply_async);
+DECLARE_int32(follower_apply_max_queued_ops);
 
 namespace yb {
 namespace client {
@@ -532,6 +537,100 @@ TEST_F(QLTabletTest, LeaderLease) {
   ASSERT_TRUE(status.IsIOError()) << "Status: " << status;
 }
 
+TEST_F(QLTabletTest, Quiescence) {
+  SetAtomicFlag(3, &FLAGS_raft_quiescence_idle_heartbeats);
+
+  TableHandle table;
+  CreateTable(kTable1Name, &table);
+
+  FillTable(0, kTotalKeys, table);
+
+  std::unordered_map<TabletId, std::string> leaders;
+  for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kLeaders)) {
+    leaders.emplace(peer->tablet_id(), peer->permanent_uuid());
+  }
+
+  ASSERT_OK(WaitFor([this] {
+    for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kNonLeaders)) {
+      if (!peer->raft_consensus()->quiescent()) {
+        return false;
+      }
+    }
+    return true;
+  }, 10s * kTimeMultiplier, "Followers quiescent"));
+
+  // Stay quiescent for several election timeouts, followers should not start elections.
+  std::this_thread::sleep_for(FLAGS_raft_heartbeat_interval_ms * 10ms);
+
+  // Lease heartbeats keep leaders ready to serve, without waking up followers.
+  for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kLeaders)) {
+    if (leaders.count(peer->tablet_id())) {
+      ASSERT_EQ(peer->consensus()->GetLeaderState().status,
+                consensus::LeaderStatus::LEADER_AND_READY) << peer->tablet_id();
+    }
+  }
+  for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kNonLeaders)) {
+    if (leaders.count(peer->tablet_id())) {
+      ASSERT_TRUE(peer->raft_consensus()->quiescent()) << peer->tablet_id();
+    }
+  }
+
+  // Write should wake up quiescent groups.
+  FillTable(kTotalKeys, 2 * kTotalKeys, table);
+  VerifyTable(0, 2 * kTotalKeys, table);
+
+  for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kLeaders)) {
+    auto it = leaders.find(peer->tablet_id());
+    if (it != leaders.end()) {
+      ASSERT_EQ(it->second, peer->permanent_uuid()) << "Leader changed for " << peer->tablet_id();
+    }
+  }
+}
+
+TEST_F(QLTabletTest, FollowerApplyAsync) {
+  SetAtomicFlag(true, &FLAGS_follower_apply_async);
+
+  TableHandle table;
+  CreateTable(kTable1Name, &table);
+
+  FillTable(0, kTotalKeys, table);
+
+  auto wait_queued_applies = [this] {
+    return WaitFor([this] {
+      for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kAll)) {
+        if (peer->raft_consensus()->GetReplicaStateForTests()->NumQueuedApplies() != 0) {
+          return false;
+        }
+      }
+      return true;
+    }, 10s * kTimeMultiplier, "Queued applies complete");
+  };
+  ASSERT_OK(wait_queued_applies());
+
+  // Writes should be applied by the apply task on followers.
+  size_t num_async_applied_ops = 0;
+  for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kNonLeaders)) {
+    num_async_applied_ops +=
+        peer->raft_consensus()->GetReplicaStateForTests()->TEST_NumAsyncAppliedOps();
+  }
+  ASSERT_GT(num_async_applied_ops, 0);
+
+  // Former followers should have all operations applied when they become leaders.
+  StepDownAllTablets(cluster_.get());
+  VerifyTable(0, kTotalKeys, table);
+
+  FillTable(kTotalKeys, 2 * kTotalKeys, table);
+  VerifyTable(0, 2 * kTotalKeys, table);
+
+  // Followers with a full apply queue do not accept new operations, so the leader sends them
+  // again later, and followers still receive all of them.
+  SetAtomicFlag(1, &FLAGS_follower_apply_max_queued_ops);
+  FillTable(2 * kTotalKeys, 3 * kTotalKeys, table);
+  ASSERT_OK(wait_queued_applies());
+  StepDownAllTablets(cluster_.get());
+  VerifyTable(0, 3 * kTotalKeys, table);
+}
+
 // This test tries to catch situation when some entries were applied and flushed in RocksDB,
 // but is not present in persistent logs.
 //
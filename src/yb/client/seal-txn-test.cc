@@ -11,20 +11,25 @@
 // under the License.
 //
 
+#include <thread>
+
 #include "yb/client/session.h"
 #include "yb/client/transaction.h"
 #include "yb/client/txn-test-base.h"
 
 #include "yb/tablet/tablet_peer.h"
+#include "yb/tablet/transaction_participant.h"
 
 #include "yb/tserver/mini_tablet_server.h"
 #include "yb/tserver/tablet_server.h"
+#include "yb/tserver/tserver_service.pb.h"
 
 using namespace std::literals;
 
 DECLARE_bool(enable_load_balancing);
 DECLARE_bool(enable_transaction_sealing);
 DECLARE_bool(TEST_fail_on_replicated_batch_idx_set_in_txn_record);
+DECLARE_int32(TEST_transaction_inject_prepare_delay_ms);
 DECLARE_int32(TEST_write_rejection_percentage);
 DECLARE_int64(transaction_rpc_timeout_ms);
 
@@ -144,5 +149,96 @@ TEST_F(SealTxnTest, Update) {
   CheckNoRunningTransactions();
 }
 
+// Commit is requested while operations are not yet prepared, so seal record should be postponed
+// until they are, otherwise it would not list all involved tablets.
+TEST_F(SealTxnTest, SealPostponedUntilPrepared) {
+  FLAGS_TEST_transaction_inject_prepare_delay_ms = 500;
+
+  auto txn = CreateTransaction();
+  auto session = CreateSession(txn);
+  ASSERT_OK(WriteRows(session, /* transaction = */ 0, WriteOpType::INSERT, Flush::kFalse));
+  std::future<Status> flush_future;
+  std::thread flush_thread([session, &flush_future] {
+    flush_future = session->FlushFuture();
+  });
+  std::this_thread::sleep_for(100ms);
+  auto commit_future = txn->CommitFuture(CoarseTimePoint(), SealOnly::kTrue);
+  flush_thread.join();
+  ASSERT_OK(flush_future.get());
+  ASSERT_OK(commit_future.get());
+  LOG(INFO) << "Committed: " << txn->id();
+  FLAGS_TEST_transaction_inject_prepare_delay_ms = 0;
+
+  ASSERT_NO_FATALS(VerifyData());
+  ASSERT_OK(cluster_->RestartSync());
+  CheckNoRunningTransactions();
+}
+
+// Participant should abort sealed transaction when coordinator requires more batches than it has
+// replicated, or when it does not know the transaction at all.
+TEST_F(SealTxnTest, AbortSealedAtParticipant) {
+  auto txn = CreateTransaction();
+  auto session = CreateSession(txn);
+  ASSERT_OK(WriteRows(session));
+
+  size_t num_participants = 0;
+  for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kLeaders)) {
+    auto* participant = peer->tablet()->transaction_participant();
+    if (!participant) {
+      continue;
+    }
+    auto term = peer->LeaderTerm();
+
+    tserver::GetTransactionStatusAtParticipantResponsePB resp;
+    participant->GetStatus(
+        TransactionId::GenerateRandom(), /* required_num_replicated_batches= */ 1, term, &resp,
+        /* context= */ nullptr);
+    ASSERT_TRUE(resp.aborted()) << resp.ShortDebugString();
+
+    if (participant->TEST_TransactionReplicatedBatches(txn->id()).CountSet() == 0) {
+      continue;
+    }
+    ++num_participants;
+
+    resp.Clear();
+    participant->GetStatus(
+        txn->id(), /* required_num_replicated_batches= */ 1, term, &resp, /* context= */ nullptr);
+    ASSERT_FALSE(resp.aborted()) << resp.ShortDebugString();
+    ASSERT_EQ(resp.num_replicated_batches(), 1);
+
+    resp.Clear();
+    participant->GetStatus(
+        txn->id(), /* required_num_replicated_batches= */ 2, term, &resp, /* context= */ nullptr);
+    ASSERT_TRUE(resp.aborted()) << resp.ShortDebugString();
+  }
+  ASSERT_GT(num_participants, 0);
+
+  txn->Abort();
+  CheckNoRunningTransactions();
+}
+
+// Batch listed in seal record is never replicated, so coordinator should resolve the transaction
+// by asking participants, and abort it.
+TEST_F(SealTxnTest, AbortSealedIfNotReplicated) {
+  auto txn = CreateTransaction();
+  auto session = CreateSession(txn);
+  ASSERT_OK(WriteRows(session));
+
+  FLAGS_TEST_write_rejection_percentage = 100;
+  session->SetTimeout(3s * kTimeMultiplier);
+  ASSERT_OK(WriteRows(session, /* transaction = */ 0, WriteOpType::UPDATE, Flush::kFalse));
+  auto flush_future = session->FlushFuture();
+  auto commit_future = txn->CommitFuture(CoarseTimePoint(), SealOnly::kTrue);
+  ASSERT_NOK(flush_future.get());
+  FLAGS_TEST_write_rejection_percentage = 0;
+  ASSERT_NOK(commit_future.get());
+
+  // Rows inserted by the first batch should be aborted as well.
+  ASSERT_OK(WaitFor([this]() -> Result<bool> {
+    return VERIFY_RESULT(SelectAllRows(CreateSession())).empty();
+  }, 10s * kTimeMultiplier, "Sealed transaction aborted"));
+  CheckNoRunningTransactions();
+}
+
 } // namespace client
 } // namespace yb
@@ -32,6 +32,13 @@ DEFINE_int32(force_lookup_cache_refresh_secs, 0, "When non-zero, specifies how o
              "GetTabletLocations request to the master leader to update the tablet replicas cache. "
              "This request is only sent if we are processing a ConsistentPrefix read.");
 
+DEFINE_bool(subscribe_to_tablet_location_changes, true,
+            "Whether reads and writes ask tablet servers to piggyback tablet leader changes and "
+            "splits on responses, so the client updates its tablet locations cache without "
+            "waiting for failed requests.");
+TAG_FLAG(subscribe_to_tablet_location_changes, advanced);
+TAG_FLAG(subscribe_to_tablet_location_changes, runtime);
+
 using namespace std::placeholders;
 
 namespace yb {
@@ -389,6 +396,20 @@ bool TabletInvoker::IsLocalCall() const {
   return current_ts_ != nullptr && current_ts_->IsLocal();
 }
 
+void TabletInvoker::FillLocationChangesRequest(
+    tserver::TabletLocationChangesRequestPB* req) const {
+  req->Clear();
+  if (current_ts_) {
+    current_ts_->FillLocationChangesRequest(req);
+  }
+}
+
+void TabletInvoker::ProcessLocationChanges(const tserver::TabletLocationChangesPB& changes) {
+  if (current_ts_) {
+    client_->data_->meta_cache_->ProcessLocationChanges(current_ts_, changes);
+  }
+}
+
 std::shared_ptr<tserver::TabletServerServiceProxy> TabletInvoker::proxy() const {
   return current_ts_->proxy();
 }
@@ -72,6 +72,12 @@ class TabletInvoker {
 
   bool IsLocalCall() const;
 
+  // Subscribes the request to tablet location changes observed by the current tablet server.
+  void FillLocationChangesRequest(tserver::TabletLocationChangesRequestPB* req) const;
+
+  // Applies tablet location changes received from the current tablet server to the meta cache.
+  void ProcessLocationChanges(const tserver::TabletLocationChangesPB& changes);
+
   const RemoteTabletPtr& tablet() const { return tablet_; }
   std::shared_ptr<tserver::TabletServerServiceProxy> proxy() const;
   ::yb::HostPort ProxyEndpoint() const;
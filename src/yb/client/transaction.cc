@@ -15,6 +15,7 @@
 
 #include "yb/client/transaction.h"
 
+#include <thread>
 #include <unordered_set>
 
 #include "yb/client/async_rpc.h"
@@ -53,6 +54,9 @@ DECLARE_uint64(max_clock_skew_usec);
 DEFINE_test_flag(int32, transaction_inject_flushed_delay_ms, 0,
                  "Inject delay before processing flushed operations by transaction.");
 
+DEFINE_test_flag(int32, transaction_inject_prepare_delay_ms, 0,
+                 "Inject delay before initial preparing of operations by transaction.");
+
 namespace yb {
 namespace client {
 
@@ -195,12 +199,20 @@ class YBTransaction::Impl final {
     VLOG_WITH_PREFIX(2) << "Prepare(" << AsString(ops) << ", " << force_consistent_read << ", "
                         << initial << ")";
 
+    if (initial && FLAGS_TEST_transaction_inject_prepare_delay_ms > 0) {
+      std::this_thread::sleep_for(FLAGS_TEST_transaction_inject_prepare_delay_ms * 1ms);
+    }
+
     bool has_tablets_without_metadata = false;
+    Waiter seal_waiter;
     {
       std::unique_lock<std::mutex> lock(mutex_);
       const bool defer = !ready_;
 
       int num_tablets = 0;
+      if (initial) {
+        not_prepared_requests_ -= std::min(not_prepared_requests_, ops.size());
+      }
       if (!defer || initial) {
         for (auto op_it = ops.begin(); op_it != ops.end();) {
           ++num_tablets;
@@ -245,6 +257,15 @@ class YBTransaction::Impl final {
       // For snapshot isolation, if read time was not yet picked, we have to choose it now, if there
       // multiple tablets that will process first request.
       SetReadTimeIfNeeded(num_tablets > 1 || force_consistent_read);
+
+      if (not_prepared_requests_ == 0 && seal_waiter_) {
+        seal_waiter = std::move(seal_waiter_);
+        seal_waiter_ = nullptr;
+      }
+    }
+
+    if (seal_waiter) {
+      seal_waiter(Status::OK());
     }
 
     VLOG_WITH_PREFIX(3) << "Prepare, has_tablets_without_metadata: "
@@ -263,6 +284,7 @@ class YBTransaction::Impl final {
   void ExpectOperations(size_t count) {
     std::lock_guard<std::mutex> lock(mutex_);
     running_requests_ += count;
+    not_prepared_requests_ += count;
   }
 
   void Flushed(
@@ -276,6 +298,7 @@ class YBTransaction::Impl final {
     }
 
     boost::optional<Status> notify_commit_status;
+    Waiter seal_waiter;
     bool abort = false;
     {
       std::lock_guard<std::mutex> lock(mutex_);
@@ -319,6 +342,12 @@ class YBTransaction::Impl final {
           }
         }
         SetError(status, &lock);
+        if (seal_waiter_) {
+          // Seal record was not sent yet, so transaction could be safely aborted.
+          seal_waiter = std::move(seal_waiter_);
+          seal_waiter_ = nullptr;
+          abort = true;
+        }
       }
 
       if (running_requests_ == 0 && commit_replicated_) {
@@ -326,6 +355,10 @@ class YBTransaction::Impl final {
       }
     }
 
+    if (seal_waiter) {
+      seal_waiter(status);
+    }
+
     if (notify_commit_status) {
       VLOG_WITH_PREFIX(4) << "Sealing done: " << *notify_commit_status;
       commit_callback_(*notify_commit_status);
@@ -602,16 +635,28 @@ class YBTransaction::Impl final {
     }
 
     tserver::UpdateTransactionRequestPB req;
-    req.set_tablet_id(status_tablet_->tablet_id());
-    req.set_propagated_hybrid_time(manager_->Now().ToUint64());
-    auto& state = *req.mutable_state();
-    state.set_transaction_id(metadata_.transaction_id.data(), metadata_.transaction_id.size());
-    state.set_status(seal_only ? TransactionStatus::SEALED : TransactionStatus::COMMITTED);
-    state.mutable_tablets()->Reserve(tablets_.size());
-    for (const auto& tablet : tablets_) {
-      state.add_tablets(tablet.first);
-      if (seal_only) {
-        state.add_tablet_batches(tablet.second.num_batches);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      // Seal record should contain all batches of this transaction, so we have to wait until
+      // all pipelined operations are prepared, i.e. assigned to their tablets.
+      if (seal_only && not_prepared_requests_ != 0) {
+        VLOG_WITH_PREFIX(4) << "Seal postponed, not prepared requests: "
+                            << not_prepared_requests_;
+        seal_waiter_ = std::bind(&Impl::DoCommit, this, deadline, seal_only, _1, transaction);
+        return;
+      }
+
+      req.set_tablet_id(status_tablet_->tablet_id());
+      req.set_propagated_hybrid_time(manager_->Now().ToUint64());
+      auto& state = *req.mutable_state();
+      state.set_transaction_id(metadata_.transaction_id.data(), metadata_.transaction_id.size());
+      state.set_status(seal_only ? TransactionStatus::SEALED : TransactionStatus::COMMITTED);
+      state.mutable_tablets()->Reserve(tablets_.size());
+      for (const auto& tablet : tablets_) {
+        state.add_tablets(tablet.first);
+        if (seal_only) {
+          state.add_tablet_batches(tablet.second.num_batches);
+        }
       }
     }
 
@@ -684,6 +729,8 @@ class YBTransaction::Impl final {
       if (running_requests_ != 0) {
         return;
       }
+      // Some of the pipelined batches could fail while seal record was replicating.
+      actual_status = status_;
     }
     VLOG_WITH_PREFIX(4) << "Commit done: " << actual_status;
     commit_callback_(actual_status);
@@ -982,8 +1029,13 @@ class YBTransaction::Impl final {
   std::promise<TransactionMetadata> metadata_promise_;
   std::shared_future<TransactionMetadata> metadata_future_;
   size_t running_requests_ = 0;
+  // Number of expected operations that were not yet prepared, i.e. we don't know which tablets
+  // they will be sent to.
+  size_t not_prepared_requests_ = 0;
   // Set to true after commit record is replicated. Used only during transaction sealing.
   bool commit_replicated_ = false;
+  // Sends seal record when all expected operations are prepared.
+  Waiter seal_waiter_;
 };
 
 CoarseTimePoint AdjustDeadline(CoarseTimePoint deadline) {
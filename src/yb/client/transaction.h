@@ -52,6 +52,8 @@ struct ChildTransactionData {
 
 // SealOnly is a special commit mode.
 // I.e. sealed transaction will be committed after seal record and all write batches are replicated.
+// It allows to send seal record in parallel with the last write batches, i.e. while there are
+// running requests. Commit callback is invoked when transaction is committed this way.
 YB_STRONGLY_TYPED_BOOL(SealOnly);
 
 // YBTransaction is a representation of a single transaction.
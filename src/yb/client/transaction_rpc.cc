@@ -21,18 +21,60 @@
 #include "yb/client/meta_cache.h"
 #include "yb/client/tablet_rpc.h"
 
+#include "yb/rpc/messenger.h"
 #include "yb/rpc/rpc.h"
+#include "yb/rpc/thread_pool.h"
 
 #include "yb/tserver/tserver_service.pb.h"
 #include "yb/tserver/tserver_service.proxy.h"
 
+#include "yb/util/flag_tags.h"
+
 using namespace std::literals;
 
+DEFINE_bool(transaction_rpc_use_local_tserver, false,
+            "Serve transaction RPCs that target a tablet hosted by the local tablet server by "
+            "direct function calls executed in the RPC worker pool, without going through the RPC "
+            "service queue.");
+TAG_FLAG(transaction_rpc_use_local_tserver, advanced);
+TAG_FLAG(transaction_rpc_use_local_tserver, runtime);
+
 namespace yb {
 namespace client {
 
 namespace {
 
+// By default transaction RPCs don't have local implementation.
+template <class Request>
+bool SupportsLocalCall(const Request& request) {
+  return false;
+}
+
+bool SupportsLocalCall(const tserver::GetTransactionStatusRequestPB& request) {
+  return true;
+}
+
+template <class Request, class Response>
+bool InvokeLocal(const tserver::LocalTabletServer* local_tserver,
+                 const Request& request,
+                 Response* response,
+                 CoarseTimePoint deadline) {
+  return false;
+}
+
+bool InvokeLocal(const tserver::LocalTabletServer* local_tserver,
+                 const tserver::GetTransactionStatusRequestPB& request,
+                 tserver::GetTransactionStatusResponsePB* response,
+                 CoarseTimePoint deadline) {
+  auto status = local_tserver->GetTransactionStatus(&request, deadline, response);
+  if (!status.ok()) {
+    VLOG(4) << "Local GetTransactionStatus failed, falling back to RPC: " << status;
+    response->Clear();
+    return false;
+  }
+  return true;
+}
+
 class TransactionRpcBase : public rpc::Rpc, public internal::TabletRpc {
  public:
   TransactionRpcBase(CoarseTimePoint deadline,
@@ -72,20 +114,77 @@ class TransactionRpcBase : public rpc::Rpc, public internal::TabletRpc {
   }
 
  private:
+  // Serves the call using local tablet server in the RPC worker pool, i.e. on the same kind of
+  // thread that would handle the RPC. The local call could block, for instance while coordinator
+  // resolves status of a sealed transaction, so it should not be executed by the caller, that
+  // could be a reactor thread. Also the callback is never invoked in the context of the caller,
+  // that could hold locks or be in the middle of registering this RPC.
+  class LocalCallTask : public rpc::ThreadPoolTask {
+   public:
+    void Prepare(std::shared_ptr<TransactionRpcBase> rpc,
+                 const tserver::LocalTabletServer* local_tserver,
+                 rpc::RpcController* controller) {
+      rpc_ = std::move(rpc);
+      local_tserver_ = local_tserver;
+      controller_ = controller;
+    }
+
+    void Run() override {
+      served_ = rpc_->InvokeLocal(local_tserver_);
+    }
+
+    void Done(const Status& status) override {
+      auto rpc = std::move(rpc_);
+      if (!status.ok()) {
+        rpc->Finished(status);
+      } else if (served_) {
+        rpc->Finished(Status::OK());
+      } else {
+        rpc->InvokeRemote(controller_);
+      }
+    }
+
+   private:
+    std::shared_ptr<TransactionRpcBase> rpc_;
+    const tserver::LocalTabletServer* local_tserver_ = nullptr;
+    rpc::RpcController* controller_ = nullptr;
+    bool served_ = false;
+  };
+
   void SendRpcToTserver(int attempt_num) override {
+    auto* controller = PrepareController();
+    const auto* local_tserver =
+        invoker_.IsLocalCall() ? invoker_.current_ts().local_tserver() : nullptr;
+    if (local_tserver && FLAGS_transaction_rpc_use_local_tserver && SupportsLocalCall()) {
+      local_call_task_.Prepare(
+          std::static_pointer_cast<TransactionRpcBase>(shared_from_this()), local_tserver,
+          controller);
+      // When the pool is shutting down, the task is completed with the failure status.
+      retrier().messenger()->ThreadPool().Enqueue(&local_call_task_);
+      return;
+    }
+    InvokeRemote(controller);
+  }
+
+  void InvokeRemote(rpc::RpcController* controller) {
     InvokeAsync(invoker_.proxy().get(),
-                PrepareController(),
+                controller,
                 std::bind(&TransactionRpcBase::Finished, this, Status::OK()));
   }
 
   virtual void InvokeCallback(const Status& status) = 0;
   virtual const TabletId& tablet_id() const = 0;
+  virtual bool SupportsLocalCall() const = 0;
+  // Tries to serve the call using local tablet server. Returns true when response was filled.
+  // Could block, so it should not be invoked on a reactor thread.
+  virtual bool InvokeLocal(const tserver::LocalTabletServer* local_tserver) = 0;
   virtual void InvokeAsync(tserver::TabletServerServiceProxy* proxy,
                            rpc::RpcController* controller,
                            rpc::ResponseCallback callback) = 0;
 
   TracePtr trace_;
   internal::TabletInvoker invoker_;
+  LocalCallTask local_call_task_;
 };
 
 // UpdateTransactionRpc is used to call UpdateTransaction remote method of appropriate tablet.
@@ -121,6 +220,15 @@ class TransactionRpc : public TransactionRpcBase {
     Traits::CallCallback(callback_, status, resp_);
   }
 
+  bool SupportsLocalCall() const override {
+    return client::SupportsLocalCall(req_);
+  }
+
+  bool InvokeLocal(const tserver::LocalTabletServer* local_tserver) override {
+    return local_tserver != nullptr &&
+           client::InvokeLocal(local_tserver, req_, &resp_, deadline());
+  }
+
   void InvokeAsync(tserver::TabletServerServiceProxy* proxy,
                    rpc::RpcController* controller,
                    rpc::ResponseCallback callback) override {
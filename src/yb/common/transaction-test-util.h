@@ -61,8 +61,17 @@ class TransactionStatusManagerMock : public TransactionStatusManager {
     return HybridTime::kMin;
   }
 
+  IntentKeyRangesPtr LiveIntentKeyRanges() const override {
+    return live_intent_key_ranges_;
+  }
+
+  void SetLiveIntentKeyRanges(IntentKeyRangesPtr ranges) {
+    live_intent_key_ranges_ = std::move(ranges);
+  }
+
  private:
   std::unordered_map<TransactionId, HybridTime, TransactionIdHash> txn_commit_time_;
+  IntentKeyRangesPtr live_intent_key_ranges_;
 };
 
 } // namespace yb
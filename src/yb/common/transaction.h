@@ -102,6 +102,21 @@ struct StatusRequest {
   }
 };
 
+// Half open range [begin, end) of encoded intent keys that could contain strong intents of
+// running transactions.
+struct IntentKeyRange {
+  std::string begin;
+  std::string end;
+
+  std::string ToString() const {
+    return Format("[$0, $1)", Slice(begin).ToDebugHexString(), Slice(end).ToDebugHexString());
+  }
+};
+
+// Sorted non overlapping ranges.
+typedef std::vector<IntentKeyRange> IntentKeyRanges;
+typedef std::shared_ptr<const IntentKeyRanges> IntentKeyRangesPtr;
+
 class RequestScope;
 
 class TransactionStatusManager {
@@ -139,6 +154,12 @@ class TransactionStatusManager {
   // Returns minimal running hybrid time of all running transactions.
   virtual HybridTime MinRunningHybridTime() const = 0;
 
+  // Returns ranges of keys that could contain strong intents of running transactions, or nullptr
+  // if they are unknown. Intents DB does not have to be checked for keys outside of these ranges.
+  virtual IntentKeyRangesPtr LiveIntentKeyRanges() const {
+    return nullptr;
+  }
+
  private:
   friend class RequestScope;
 
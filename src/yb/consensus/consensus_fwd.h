@@ -51,6 +51,11 @@ typedef std::unique_ptr<ConsensusServiceProxy> ConsensusServiceProxyPtr;
 class LeaderElection;
 typedef scoped_refptr<LeaderElection> LeaderElectionPtr;
 
+class MultiRaftHeartbeatBatcher;
+typedef std::shared_ptr<MultiRaftHeartbeatBatcher> MultiRaftHeartbeatBatcherPtr;
+
+class MultiRaftManager;
+
 class PeerProxy;
 typedef std::unique_ptr<PeerProxy> PeerProxyPtr;
 
@@ -36,9 +36,11 @@
 #include <gtest/gtest.h>
 
 #include "yb/common/wire_protocol.h"
+#include "yb/consensus/consensus.pb.h"
 #include "yb/consensus/metadata.pb.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/consensus/quorum_util.h"
+#include "yb/consensus/retryable_requests.h"
 #include "yb/fs/fs_manager.h"
 #include "yb/gutil/gscoped_ptr.h"
 #include "yb/util/net/net_util.h"
@@ -302,5 +304,68 @@ TEST_F(ConsensusMetadataTest, TestMergeCommittedConsensusStatePB) {
   ASSERT_NO_FATALS(AssertConsensusMergeExpected(*cmeta, remote_state, 2, ""));
 }
 
+namespace {
+
+ReplicateMsg MakeWriteReplicate(int64_t index, RetryableRequestId request_id) {
+  ReplicateMsg msg;
+  msg.mutable_id()->set_term(kInitialTerm);
+  msg.mutable_id()->set_index(index);
+  msg.set_op_type(WRITE_OP);
+  auto* write_request = msg.mutable_write_request();
+  write_request->set_client_id1(1);
+  write_request->set_client_id2(2);
+  write_request->set_request_id(request_id);
+  write_request->set_min_running_request_id(0);
+  return msg;
+}
+
+} // namespace
+
+// Test that replicated retryable requests survive a flush and load, and that requests covered
+// by the loaded snapshot are not bootstrapped again.
+TEST_F(ConsensusMetadataTest, TestRetryableRequestsPersistence) {
+  std::unique_ptr<ConsensusMetadata> cmeta;
+  ASSERT_OK(ConsensusMetadata::Create(&fs_manager_, kTabletId, fs_manager_.uuid(),
+                                      config_, kInitialTerm, &cmeta));
+
+  RetryableRequestsPB loaded_pb;
+  ASSERT_TRUE(ConsensusMetadata::LoadRetryableRequests(
+      &fs_manager_, kTabletId, &loaded_pb).IsNotFound());
+
+  RetryableRequests retryable_requests;
+  auto now = retryable_requests.Clock().Now();
+  // Request ids 1..3 form a single range, request id 5 starts another one.
+  retryable_requests.Bootstrap(MakeWriteReplicate(1, 1), now);
+  retryable_requests.Bootstrap(MakeWriteReplicate(2, 2), now);
+  retryable_requests.Bootstrap(MakeWriteReplicate(3, 3), now);
+  retryable_requests.Bootstrap(MakeWriteReplicate(4, 5), now);
+  ASSERT_EQ(2, retryable_requests.TEST_Counts().replicated);
+
+  RetryableRequestsPB pb;
+  retryable_requests.ToPB(&pb);
+  ASSERT_EQ(yb::OpId(kInitialTerm, 4), yb::OpId::FromPB(pb.last_op_id()));
+  ASSERT_OK(cmeta->FlushRetryableRequests(pb));
+
+  ASSERT_OK(ConsensusMetadata::LoadRetryableRequests(&fs_manager_, kTabletId, &loaded_pb));
+  RetryableRequests restored;
+  ASSERT_OK(restored.FromPB(loaded_pb));
+  ASSERT_NOK(restored.FromPB(loaded_pb));
+  ASSERT_EQ(2, restored.TEST_Counts().replicated);
+
+  RetryableRequestsPB restored_pb;
+  restored.ToPB(&restored_pb);
+  ASSERT_EQ(pb.ShortDebugString(), restored_pb.ShortDebugString());
+
+  // Op id covered by the snapshot is ignored, the next one is added.
+  restored.Bootstrap(MakeWriteReplicate(4, 10), now);
+  ASSERT_EQ(2, restored.TEST_Counts().replicated);
+  restored.Bootstrap(MakeWriteReplicate(5, 10), now);
+  ASSERT_EQ(3, restored.TEST_Counts().replicated);
+
+  ASSERT_OK(ConsensusMetadata::DeleteOnDiskData(&fs_manager_, kTabletId));
+  ASSERT_TRUE(ConsensusMetadata::LoadRetryableRequests(
+      &fs_manager_, kTabletId, &loaded_pb).IsNotFound());
+}
+
 } // namespace consensus
 } // namespace yb
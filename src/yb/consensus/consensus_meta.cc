@@ -70,6 +70,10 @@ RaftPeerPB::Role UnpackRole(ConsensusMetadata::PackedRoleAndTerm role_and_term)
   return static_cast<RaftPeerPB::Role>(role_and_term & ((1 << kBitsPerPackedRole) - 1));
 }
 
+std::string RetryableRequestsPath(FsManager* fs_manager, const std::string& tablet_id) {
+  return fs_manager->GetConsensusMetadataPath(tablet_id) + ".retryable_requests";
+}
+
 } // anonymous namespace
 
 Status ConsensusMetadata::Create(FsManager* fs_manager,
@@ -109,6 +113,34 @@ Status ConsensusMetadata::DeleteOnDiskData(FsManager* fs_manager, const string&
   LOG(INFO) << "T " << tablet_id << " Deleting consensus metadata";
   RETURN_NOT_OK_PREPEND(env->DeleteFile(cmeta_path),
                         "Unable to delete consensus metadata file for tablet " + tablet_id);
+  return DeleteRetryableRequests(fs_manager, tablet_id);
+}
+
+Status ConsensusMetadata::DeleteRetryableRequests(
+    FsManager* fs_manager, const std::string& tablet_id) {
+  auto path = RetryableRequestsPath(fs_manager, tablet_id);
+  Env* env = fs_manager->env();
+  if (!env->FileExists(path)) {
+    return Status::OK();
+  }
+  RETURN_NOT_OK_PREPEND(env->DeleteFile(path),
+                        "Unable to delete retryable requests file for tablet " + tablet_id);
+  return Status::OK();
+}
+
+Status ConsensusMetadata::LoadRetryableRequests(
+    FsManager* fs_manager, const std::string& tablet_id, RetryableRequestsPB* pb) {
+  return pb_util::ReadPBContainerFromPath(
+      fs_manager->env(), RetryableRequestsPath(fs_manager, tablet_id), pb);
+}
+
+Status ConsensusMetadata::FlushRetryableRequests(const RetryableRequestsPB& pb) {
+  SCOPED_LOG_SLOW_EXECUTION_PREFIX(WARNING, 500, LogPrefix(), "flushing retryable requests");
+  auto path = RetryableRequestsPath(fs_manager_, tablet_id_);
+  RETURN_NOT_OK_PREPEND(pb_util::WritePBContainerToPath(
+      fs_manager_->env(), path, pb, pb_util::OVERWRITE, pb_util::SYNC),
+          Substitute("Unable to write retryable requests file for tablet $0 to path $1",
+                     tablet_id_, path));
   return Status::OK();
 }
 
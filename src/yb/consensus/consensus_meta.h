@@ -94,6 +94,20 @@ class ConsensusMetadata {
   // disk.
   static CHECKED_STATUS DeleteOnDiskData(FsManager* fs_manager, const std::string& tablet_id);
 
+  // Delete snapshot of replicated retryable requests, it is not valid for a new incarnation of the
+  // tablet data, e.g. after tombstoning or remote bootstrap.
+  static CHECKED_STATUS DeleteRetryableRequests(
+      FsManager* fs_manager, const std::string& tablet_id);
+
+  // Load snapshot of replicated retryable requests stored next to consensus metadata.
+  // Returns Status::NotFound if it was never flushed.
+  static CHECKED_STATUS LoadRetryableRequests(
+      FsManager* fs_manager, const std::string& tablet_id, RetryableRequestsPB* pb);
+
+  // Persist snapshot of replicated retryable requests. Does not touch the consensus metadata
+  // protobuf, so could be invoked concurrently with its modifications.
+  CHECKED_STATUS FlushRetryableRequests(const RetryableRequestsPB& pb);
+
   // Accessors for current term.
   const int64_t current_term() const;
   void set_current_term(int64_t term);
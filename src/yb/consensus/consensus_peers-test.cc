@@ -54,6 +54,9 @@
 
 using namespace std::chrono_literals;
 
+DECLARE_int32(raft_heartbeat_interval_ms);
+DECLARE_int32(raft_observer_batch_interval_ms);
+
 METRIC_DECLARE_entity(tablet);
 
 namespace yb {
@@ -413,5 +416,41 @@ TEST_F(ConsensusPeersTest, TestDontSendOneRpcPerWriteWhenPeerIsDown) {
   ASSERT_LT(mock_proxy->update_count() - initial_update_count, 5);
 }
 
+TEST_F(ConsensusPeersTest, BatchShippingToObserver) {
+  FLAGS_raft_heartbeat_interval_ms = 3600 * 1000;
+  FLAGS_raft_observer_batch_interval_ms = 3600 * 1000;
+
+  auto config = BuildRaftConfigPBForTests(2);
+  config.mutable_peers(1)->set_member_type(RaftPeerPB::OBSERVER);
+  message_queue_->SetLeaderMode(MinimumOpId(), MinimumOpId().term(), config);
+
+  std::shared_ptr<Peer> remote_peer;
+  auto se = ScopeExit([&remote_peer] {
+    remote_peer->Close();
+  });
+  auto proxy = NewRemotePeer(kFollowerUuid, &remote_peer);
+
+  AppendReplicateMessagesToQueue(message_queue_.get(), clock_, 1, 10);
+  remote_peer->SetTermForTest(2);
+  ASSERT_OK(remote_peer->SignalRequest(RequestTriggerMode::kAlwaysSend));
+  ASSERT_OK(WaitFor([proxy] {
+    return proxy->proxy()->last_received().index() == 10;
+  }, 30s, "Initial ops shipped to observer"));
+
+  // Writes appended within the batch interval are not shipped on their own.
+  for (int i = 11; i <= 20; ++i) {
+    AppendReplicateMessagesToQueue(message_queue_.get(), clock_, i, /* count */ 1);
+    ASSERT_OK(remote_peer->SignalRequest(RequestTriggerMode::kNonEmptyOnly));
+  }
+  std::this_thread::sleep_for(500ms);
+  ASSERT_NO_FATALS(CheckLastRemoteEntry(proxy, 1, 10));
+
+  // The next heartbeat ships all accumulated ops.
+  ASSERT_OK(remote_peer->SignalRequest(RequestTriggerMode::kAlwaysSend));
+  ASSERT_OK(WaitFor([proxy] {
+    return proxy->proxy()->last_received().index() == 20;
+  }, 30s, "Accumulated ops shipped to observer"));
+}
+
 }  // namespace consensus
 }  // namespace yb
@@ -49,6 +49,7 @@
 #include "yb/consensus/consensus_meta.h"
 #include "yb/consensus/consensus_queue.h"
 #include "yb/consensus/log.h"
+#include "yb/consensus/multi_raft_batcher.h"
 #include "yb/consensus/replicate_msgs_holder.h"
 
 #include "yb/gutil/strings/substitute.h"
@@ -58,6 +59,7 @@
 #include "yb/tserver/tserver.pb.h"
 #include "yb/tserver/tserver_error.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/backoff_waiter.h"
 #include "yb/util/fault_injection.h"
 #include "yb/util/flag_tags.h"
@@ -81,7 +83,26 @@ DEFINE_int32(max_wait_for_processresponse_before_closing_ms,
              "finish before returning proceding to close the Peer and return");
 TAG_FLAG(max_wait_for_processresponse_before_closing_ms, advanced);
 
+DEFINE_int32(raft_quiescence_idle_heartbeats, 0,
+             "Number of consecutive heartbeats to an idle, fully caught up peer after which the "
+             "leader only sends it heartbeats needed to keep the leader lease, at half of the "
+             "lease duration, until the next write. The follower disables its failure detector "
+             "for this time. 0 disables quiescence.");
+TAG_FLAG(raft_quiescence_idle_heartbeats, advanced);
+TAG_FLAG(raft_quiescence_idle_heartbeats, runtime);
+
+DEFINE_int32(raft_observer_batch_interval_ms, 0,
+             "Minimum interval between write-triggered requests sent by the leader to an OBSERVER "
+             "(read replica). Operations written in between are accumulated and shipped together "
+             "with the next request or heartbeat. 0 ships operations to observers as soon as they "
+             "are appended.");
+TAG_FLAG(raft_observer_batch_interval_ms, advanced);
+TAG_FLAG(raft_observer_batch_interval_ms, runtime);
+
 DECLARE_int32(raft_heartbeat_interval_ms);
+DECLARE_bool(enable_multi_raft_heartbeat_batcher);
+DECLARE_int32(leader_lease_duration_ms);
+DECLARE_int32(ht_lease_duration_ms);
 
 DEFINE_test_flag(double, fault_crash_on_leader_request_fraction, 0.0,
                  "Fraction of the time when the leader will crash just before sending an "
@@ -112,6 +133,22 @@ using rpc::PeriodicTimer;
 using rpc::RpcController;
 using strings::Substitute;
 
+namespace {
+
+// Interval between heartbeats to a quiescent peer. They keep the leader lease and hybrid time
+// lease alive, so reads are not blocked waiting for the lease after an idle period.
+MonoDelta QuiescentHeartbeatInterval() {
+  auto lease_ms = GetAtomicFlag(&FLAGS_leader_lease_duration_ms);
+  const auto ht_lease_ms = GetAtomicFlag(&FLAGS_ht_lease_duration_ms);
+  if (ht_lease_ms > 0) {
+    lease_ms = std::min(lease_ms, ht_lease_ms);
+  }
+  return MonoDelta::FromMilliseconds(
+      std::max(lease_ms / 2, GetAtomicFlag(&FLAGS_raft_heartbeat_interval_ms)));
+}
+
+} // namespace
+
 Peer::Peer(
     const RaftPeerPB& peer_pb, string tablet_id, string leader_uuid, PeerProxyPtr proxy,
     PeerMessageQueue* queue, ThreadPoolToken* raft_pool_token, Consensus* consensus,
@@ -193,6 +230,17 @@ Status Peer::SignalRequest(RequestTriggerMode trigger_mode) {
   return status;
 }
 
+void Peer::Wake() {
+  if (!quiescent_.exchange(false, std::memory_order_acq_rel)) {
+    return;
+  }
+
+  VLOG_WITH_PREFIX(2) << "Waking up quiescent peer";
+  // Revert the heartbeater to its regular period.
+  heartbeater_->Snooze();
+  WARN_NOT_OK(SignalRequest(RequestTriggerMode::kAlwaysSend), "Failed to wake up peer");
+}
+
 void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
   auto retain_self = shared_from_this();
   DCHECK(performing_mutex_.is_locked()) << "Cannot send request";
@@ -203,6 +251,16 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
     return;
   }
 
+  // Read replicas don't take part in commit, so there is no need to ship every write to them as
+  // soon as it is appended. Let operations accumulate and ship them as a larger batch.
+  if (trigger_mode == RequestTriggerMode::kNonEmptyOnly &&
+      member_type_ == RaftPeerPB::OBSERVER && !quiescent_.load(std::memory_order_acquire)) {
+    auto batch_interval = GetAtomicFlag(&FLAGS_raft_observer_batch_interval_ms) * 1ms;
+    if (CoarseMonoClock::Now() < last_request_time_ + batch_interval) {
+      return;
+    }
+  }
+
   // The peer has no pending request nor is sending: send the request.
   bool needs_remote_bootstrap = false;
   bool last_exchange_successful = false;
@@ -215,6 +273,7 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
       &member_type, &last_exchange_successful);
   int64_t commit_index_after = request_.has_committed_op_id() ?
       request_.committed_op_id().index() : kMinimumOpIdIndex;
+  member_type_ = member_type;
 
   if (PREDICT_FALSE(!s.ok())) {
     LOG_WITH_PREFIX(INFO) << "Could not obtain request from queue for peer: " << s;
@@ -288,6 +347,33 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
 
   const bool req_has_ops = (request_.ops_size() > 0) || (commit_index_after > commit_index_before);
 
+  request_.clear_quiescent();
+  if (req_has_ops || !last_exchange_successful) {
+    idle_heartbeats_ = 0;
+    if (quiescent_.exchange(false, std::memory_order_acq_rel)) {
+      VLOG_WITH_PREFIX(2) << "Waking up quiescent peer";
+      heartbeater_->Snooze();
+    }
+  } else if (trigger_mode == RequestTriggerMode::kAlwaysSend &&
+             quiescent_.load(std::memory_order_acquire)) {
+    // Quiescent peer only gets heartbeats that keep the leader lease alive.
+    const auto interval = QuiescentHeartbeatInterval();
+    if (CoarseMonoClock::Now() - last_request_time_ < interval.ToSteadyDuration() / 2) {
+      // Heartbeater fired on its regular period right after the peer became quiescent.
+      return;
+    }
+    request_.set_quiescent(true);
+    heartbeater_->Snooze(interval);
+  } else if (trigger_mode == RequestTriggerMode::kAlwaysSend) {
+    const auto idle_heartbeats_limit = GetAtomicFlag(&FLAGS_raft_quiescence_idle_heartbeats);
+    if (idle_heartbeats_limit <= 0 || !queue_->IsPeerIdle(peer_pb_.permanent_uuid())) {
+      idle_heartbeats_ = 0;
+    } else if (++idle_heartbeats_ >= idle_heartbeats_limit) {
+      request_.set_quiescent(true);
+      idle_heartbeats_ = 0;
+    }
+  }
+
   // If the queue is empty, check if we were told to send a status-only message (which is what
   // happens during heartbeats). If not, just return.
   if (PREDICT_FALSE(!req_has_ops && trigger_mode == RequestTriggerMode::kNonEmptyOnly)) {
@@ -298,6 +384,7 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
   if (req_has_ops) {
     heartbeater_->Snooze();
   }
+  last_request_time_ = CoarseMonoClock::Now();
 
   MAYBE_FAULT(FLAGS_TEST_fault_crash_on_leader_request_fraction);
 
@@ -308,6 +395,17 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
   // condition. When rest of this function is running in parallel to ProcessResponse.
   msgs_holder.ReleaseOps();
 
+  // Heartbeats could be combined with heartbeats of other tablets to the same server.
+  // The flag is set before sending, because the response could be processed before
+  // HeartbeatAsync returns.
+  heartbeat_batched_ = !req_has_ops;
+  if (heartbeat_batched_ &&
+      proxy_->HeartbeatAsync(&request_, &response_,
+                             std::bind(&Peer::ProcessResponseWithStatus, retain_self, _1))) {
+    return;
+  }
+  heartbeat_batched_ = false;
+
   controller_.set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolHigh);
   proxy_->UpdateAsync(&request_, trigger_mode, &response_, &controller_,
                       std::bind(&Peer::ProcessResponse, retain_self));
@@ -324,11 +422,15 @@ std::unique_lock<simple_spinlock> Peer::StartProcessingUnlocked() {
 }
 
 void Peer::ProcessResponse() {
+  Status status = controller_.status();
+  controller_.Reset();
+  ProcessResponseWithStatus(status);
+}
+
+void Peer::ProcessResponseWithStatus(const Status& status) {
   request_.mutable_ops()->ExtractSubrange(0, request_.ops().size(), nullptr /* elements */);
 
   DCHECK(performing_mutex_.is_locked()) << "Got a response when nothing was pending";
-  Status status = controller_.status();
-  controller_.Reset();
 
   auto performing_lock = LockPerforming(std::adopt_lock);
 
@@ -400,8 +502,20 @@ void Peer::ProcessResponse() {
   }
 
   failed_attempts_ = 0;
+  if (heartbeat_batched_) {
+    queue_->DiscardLatencySample(peer_pb_.permanent_uuid());
+  }
   bool more_pending = queue_->ResponseFromPeer(peer_pb_.permanent_uuid(), response_);
 
+  if (request_.quiescent() && !more_pending && !response_.status().has_error()) {
+    // Peer disabled its failure detector, so only heartbeats that keep the leader lease alive
+    // should be sent to it until the next write.
+    if (!quiescent_.exchange(true, std::memory_order_acq_rel)) {
+      VLOG_WITH_PREFIX(2) << "Peer became quiescent";
+      heartbeater_->Snooze(QuiescentHeartbeatInterval());
+    }
+  }
+
   if (more_pending) {
     processing_lock.unlock();
     performing_lock.release();
@@ -499,8 +613,10 @@ Peer::~Peer() {
   CHECK_EQ(state_, kPeerClosed) << "Peer cannot be implicitly closed";
 }
 
-RpcPeerProxy::RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy)
-    : hostport_(std::move(hostport)), consensus_proxy_(std::move(consensus_proxy)) {
+RpcPeerProxy::RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy,
+                           MultiRaftHeartbeatBatcherPtr heartbeat_batcher)
+    : hostport_(std::move(hostport)), consensus_proxy_(std::move(consensus_proxy)),
+      heartbeat_batcher_(std::move(heartbeat_batcher)) {
 }
 
 void RpcPeerProxy::UpdateAsync(const ConsensusRequestPB* request,
@@ -512,6 +628,15 @@ void RpcPeerProxy::UpdateAsync(const ConsensusRequestPB* request,
   consensus_proxy_->UpdateConsensusAsync(*request, response, controller, callback);
 }
 
+bool RpcPeerProxy::HeartbeatAsync(const ConsensusRequestPB* request,
+                                  ConsensusResponsePB* response,
+                                  StatusFunctor callback) {
+  if (!heartbeat_batcher_ || !FLAGS_enable_multi_raft_heartbeat_batcher) {
+    return false;
+  }
+  return heartbeat_batcher_->AddRequestToBatch(*request, response, std::move(callback));
+}
+
 void RpcPeerProxy::RequestConsensusVoteAsync(const VoteRequestPB* request,
                                              VoteResponsePB* response,
                                              rpc::RpcController* controller,
@@ -544,13 +669,18 @@ void RpcPeerProxy::StartRemoteBootstrap(const StartRemoteBootstrapRequestPB* req
 RpcPeerProxy::~RpcPeerProxy() {}
 
 RpcPeerProxyFactory::RpcPeerProxyFactory(
-    Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from)
-    : messenger_(messenger), proxy_cache_(proxy_cache), from_(std::move(from)) {}
+    Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from,
+    MultiRaftManager* multi_raft_manager)
+    : messenger_(messenger), proxy_cache_(proxy_cache), from_(std::move(from)),
+      multi_raft_manager_(multi_raft_manager) {}
 
 PeerProxyPtr RpcPeerProxyFactory::NewProxy(const RaftPeerPB& peer_pb) {
   auto hostport = HostPortFromPB(DesiredHostPort(peer_pb, from_));
   auto proxy = std::make_unique<ConsensusServiceProxy>(proxy_cache_, hostport);
-  return std::make_unique<RpcPeerProxy>(std::move(hostport), std::move(proxy));
+  auto heartbeat_batcher = multi_raft_manager_
+      ? multi_raft_manager_->AddOrGetBatcher(hostport) : nullptr;
+  return std::make_unique<RpcPeerProxy>(
+      std::move(hostport), std::move(proxy), std::move(heartbeat_batcher));
 }
 
 RpcPeerProxyFactory::~RpcPeerProxyFactory() {}
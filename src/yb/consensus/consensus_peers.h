@@ -49,9 +49,11 @@
 #include "yb/util/atomic.h"
 #include "yb/util/countdown_latch.h"
 #include "yb/util/locks.h"
+#include "yb/util/monotime.h"
 #include "yb/util/net/net_util.h"
 #include "yb/util/semaphore.h"
 #include "yb/util/status.h"
+#include "yb/util/status_callback.h"
 
 namespace yb {
 class HostPort;
@@ -133,6 +135,14 @@ class Peer : public std::enable_shared_from_this<Peer> {
   // Signals that this peer has a new request to replicate/store.
   CHECKED_STATUS SignalRequest(RequestTriggerMode trigger_mode);
 
+  // Resumes heartbeats to a quiescent peer, so the peer re-enables its failure detector.
+  // Does nothing if the peer is not quiescent.
+  void Wake();
+
+  bool quiescent() const {
+    return quiescent_.load(std::memory_order_acquire);
+  }
+
   const RaftPeerPB& peer_pb() const { return peer_pb_; }
 
   // Returns the PeerProxy if this is a remote peer or NULL if it
@@ -179,6 +189,10 @@ class Peer : public std::enable_shared_from_this<Peer> {
   // requires IO or may block.
   void ProcessResponse();
 
+  // Same as ProcessResponse, but the status of the exchange is provided explicitly. Used for
+  // heartbeats that were sent as a part of a batch.
+  void ProcessResponseWithStatus(const Status& status);
+
   // Fetch the desired remote bootstrap request from the queue and send it to the peer. The callback
   // goes to ProcessRemoteBootstrapResponse().
   //
@@ -232,6 +246,22 @@ class Peer : public std::enable_shared_from_this<Peer> {
   // peers whenever we go more than 'FLAGS_raft_heartbeat_interval_ms' without sending actual data.
   std::shared_ptr<rpc::PeriodicTimer> heartbeater_;
 
+  // Number of consecutive heartbeats sent while the peer was idle.
+  int idle_heartbeats_ = 0;
+
+  // Set when the peer acknowledged a quiescent heartbeat. Until the next write or Wake() call,
+  // heartbeats are only sent to keep the leader lease alive, at a lower rate.
+  std::atomic<bool> quiescent_{false};
+
+  // Member type of the peer as of the last request built for it, and the time that request was
+  // sent. Used to batch shipping of operations to observers.
+  RaftPeerPB::MemberType member_type_ = RaftPeerPB::UNKNOWN_MEMBER_TYPE;
+  CoarseTimePoint last_request_time_;
+
+  // Whether the outstanding request is a heartbeat sent as a part of a batch. Its round trip
+  // includes the time it waited for the batch to be sent, so it does not measure link latency.
+  bool heartbeat_batched_ = false;
+
   // Thread pool used to construct requests to this peer.
   ThreadPoolToken* raft_pool_token_;
 
@@ -263,6 +293,15 @@ class PeerProxy {
                            rpc::RpcController* controller,
                            const rpc::ResponseCallback& callback) = 0;
 
+  // Sends a request without operations, i.e. heartbeat, to a remote peer. Heartbeats to the same
+  // server could be combined into a single RPC. Returns false if this proxy does not batch
+  // heartbeats, in this case UpdateAsync should be used.
+  virtual bool HeartbeatAsync(const ConsensusRequestPB* request,
+                              ConsensusResponsePB* response,
+                              StatusFunctor callback) {
+    return false;
+  }
+
   // Sends a RequestConsensusVote to a remote peer.
   virtual void RequestConsensusVoteAsync(const VoteRequestPB* request,
                                          VoteResponsePB* response,
@@ -313,7 +352,8 @@ class PeerProxyFactory {
 // PeerProxy implementation that does RPC calls
 class RpcPeerProxy : public PeerProxy {
  public:
-  RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy);
+  RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy,
+               MultiRaftHeartbeatBatcherPtr heartbeat_batcher = nullptr);
 
   virtual void UpdateAsync(const ConsensusRequestPB* request,
                            RequestTriggerMode trigger_mode,
@@ -321,6 +361,10 @@ class RpcPeerProxy : public PeerProxy {
                            rpc::RpcController* controller,
                            const rpc::ResponseCallback& callback) override;
 
+  bool HeartbeatAsync(const ConsensusRequestPB* request,
+                      ConsensusResponsePB* response,
+                      StatusFunctor callback) override;
+
   virtual void RequestConsensusVoteAsync(const VoteRequestPB* request,
                                          VoteResponsePB* response,
                                          rpc::RpcController* controller,
@@ -346,12 +390,14 @@ class RpcPeerProxy : public PeerProxy {
  private:
   HostPort hostport_;
   ConsensusServiceProxyPtr consensus_proxy_;
+  MultiRaftHeartbeatBatcherPtr heartbeat_batcher_;
 };
 
 // PeerProxyFactory implementation that generates RPCPeerProxies
 class RpcPeerProxyFactory : public PeerProxyFactory {
  public:
-  RpcPeerProxyFactory(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from);
+  RpcPeerProxyFactory(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from,
+                      MultiRaftManager* multi_raft_manager = nullptr);
 
   PeerProxyPtr NewProxy(const RaftPeerPB& peer_pb) override;
 
@@ -363,6 +409,7 @@ class RpcPeerProxyFactory : public PeerProxyFactory {
   rpc::Messenger* messenger_ = nullptr;
   rpc::ProxyCache* const proxy_cache_;
   const CloudInfoPB from_;
+  MultiRaftManager* const multi_raft_manager_;
 };
 
 // Query the consensus service at last known host/port that is specified in 'remote_peer' and set
@@ -54,6 +54,7 @@
 #include "yb/util/threadpool.h"
 
 DECLARE_bool(enable_data_block_fsync);
+DECLARE_bool(consensus_adaptive_batch_size);
 DECLARE_int32(consensus_max_batch_size_bytes);
 
 METRIC_DECLARE_entity(tablet);
@@ -345,6 +346,143 @@ TEST_F(ConsensusQueueTest, TestGetPagedMessages) {
   ASSERT_FALSE(queue_->ResponseFromPeer(response.responder_uuid(), response));
 }
 
+// Tests that batches sent to a lagging peer grow when the link to it has high latency.
+TEST_F(ConsensusQueueTest, TestAdaptiveBatchSize) {
+  google::FlagSaver saver;
+  FLAGS_consensus_adaptive_batch_size = true;
+  FLAGS_consensus_max_batch_size_bytes = 1024 * 10;
+  const auto kLatency = 50ms;
+  // Transfer of the batch takes half of the latency, so the bandwidth-delay product is much
+  // bigger than the batch.
+  const auto kRoundTripTime = kLatency * 3 / 2;
+
+  queue_->Init(MinimumOpId());
+  queue_->SetLeaderMode(MinimumOpId(), MinimumOpId().term(), BuildRaftConfigPBForTests(2));
+
+  ConsensusRequestPB request;
+  ConsensusResponsePB response;
+  response.set_responder_uuid(kPeerUuid);
+  ASSERT_TRUE(UpdatePeerWatermarkToOp(&request, &response, MinimumOpId(), MinimumOpId()));
+
+  ReplicateMsgsHolder refs;
+  bool needs_remote_bootstrap;
+  // Heartbeat provides latency of the link.
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+  ASSERT_EQ(request.ops_size(), 0);
+  SleepFor(kLatency);
+  SetLastReceivedAndLastCommitted(&response, MinimumOpId());
+  queue_->ResponseFromPeer(response.responder_uuid(), response);
+  ASSERT_TRUE(queue_->GetTrackedPeerForTests(kPeerUuid).min_rtt >= kLatency);
+
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, 1, kNumMessages, 1024);
+
+  int last_ops_size = 0;
+  for (int i = 0; i < 3; i++) {
+    ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+    ASSERT_FALSE(needs_remote_bootstrap);
+    LOG(INFO) << "Number of ops in request: " << request.ops_size();
+    // Batch size is expected to double with each round trip, until all ops fit.
+    ASSERT_GT(request.ops_size(), last_ops_size);
+    last_ops_size = request.ops_size();
+    SleepFor(kRoundTripTime);
+    SetLastReceivedAndLastCommitted(&response, request.ops(request.ops_size() - 1).id());
+    ASSERT_TRUE(queue_->ResponseFromPeer(response.responder_uuid(), response));
+  }
+  ASSERT_GT(queue_->GetTrackedPeerForTests(kPeerUuid).batch_size_bytes,
+            FLAGS_consensus_max_batch_size_bytes);
+}
+
+// Tests that adaptive batch size converges to the bandwidth-delay product based target instead of
+// growing without bound, and shrinks when the link bandwidth drops.
+TEST_F(ConsensusQueueTest, TestAdaptiveBatchSizeConverges) {
+  google::FlagSaver saver;
+  FLAGS_consensus_adaptive_batch_size = true;
+  FLAGS_consensus_max_batch_size_bytes = 1024 * 10;
+  const auto kLatency = 50ms;
+  const int64_t kBandwidth = 1024 * 1024;
+
+  PeerMessageQueue::TrackedPeer peer(kPeerUuid);
+  auto now = CoarseMonoClock::Now();
+
+  // Simulates sending a full batch over the link with specified bandwidth and returns its size.
+  auto send_batch = [&peer, &now, kLatency](int64_t bandwidth_bytes_per_sec) {
+    auto batch_bytes = peer.MaxBatchSize();
+    peer.last_request_send_time = now;
+    peer.last_batch_bytes = batch_bytes;
+    now += kLatency + std::chrono::microseconds(batch_bytes * 1000000 / bandwidth_bytes_per_sec);
+    peer.UpdateBatchSize(now);
+    return batch_bytes;
+  };
+
+  // Latency is unknown, so the batch size is not changed.
+  ASSERT_EQ(send_batch(kBandwidth), FLAGS_consensus_max_batch_size_bytes);
+  ASSERT_EQ(send_batch(kBandwidth), FLAGS_consensus_max_batch_size_bytes);
+
+  peer.last_request_send_time = now;
+  peer.last_request_is_heartbeat = true;
+  now += kLatency;
+  peer.UpdateBatchSize(now);
+  ASSERT_TRUE(peer.min_rtt == kLatency);
+
+  for (auto bandwidth : {kBandwidth, kBandwidth / 10}) {
+    SCOPED_TRACE(Format("Bandwidth: $0", bandwidth));
+    // Batch sent during a round trip is 4 times bigger than the bandwidth-delay product.
+    const auto target = static_cast<int64_t>(4 * bandwidth * ToSeconds(kLatency));
+    const bool grows = peer.MaxBatchSize() < target;
+    int64_t last_batch_bytes = peer.MaxBatchSize();
+    for (int i = 0; i != 30; ++i) {
+      auto batch_bytes = send_batch(bandwidth);
+      if (grows) {
+        ASSERT_GE(batch_bytes, last_batch_bytes);
+        ASSERT_LE(batch_bytes, target * 11 / 10);
+      } else {
+        ASSERT_LE(batch_bytes, last_batch_bytes);
+      }
+      last_batch_bytes = batch_bytes;
+    }
+    // Batch size stays flat once the target is reached.
+    ASSERT_NEAR(last_batch_bytes, target, target / 10);
+    ASSERT_NEAR(send_batch(bandwidth), last_batch_bytes, last_batch_bytes / 100);
+  }
+}
+
+// Tests that a low round trip time sample stops affecting the link latency estimate after a while.
+TEST_F(ConsensusQueueTest, TestMinRttExpires) {
+  PeerMessageQueue::TrackedPeer peer(kPeerUuid);
+  auto now = CoarseMonoClock::Now();
+
+  auto heartbeat = [&peer, &now](CoarseDuration rtt) {
+    peer.last_request_send_time = now;
+    peer.last_request_is_heartbeat = true;
+    now += rtt;
+    peer.UpdateBatchSize(now);
+  };
+
+  heartbeat(1ms);
+  ASSERT_TRUE(peer.min_rtt == 1ms);
+  // Route changed, so latency is higher now.
+  for (int i = 0; i != 100; ++i) {
+    heartbeat(20ms);
+    now += 500ms;
+    if (peer.min_rtt == 20ms) {
+      break;
+    }
+    // Old sample is kept for at least one window.
+    ASSERT_TRUE(peer.min_rtt == 1ms);
+    ASSERT_LT(i, 50);
+  }
+  ASSERT_TRUE(peer.min_rtt == 20ms);
+
+  // Lower sample is taken immediately.
+  heartbeat(10ms);
+  ASSERT_TRUE(peer.min_rtt == 10ms);
+
+  // After a long pause without samples, the old ones are forgotten.
+  now += 1h;
+  heartbeat(30ms);
+  ASSERT_TRUE(peer.min_rtt == 30ms);
+}
+
 TEST_F(ConsensusQueueTest, TestPeersDontAckBeyondWatermarks) {
   queue_->Init(MinimumOpId());
   queue_->SetLeaderMode(MinimumOpId(), MinimumOpId().term(), BuildRaftConfigPBForTests(3));
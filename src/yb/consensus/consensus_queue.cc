@@ -86,6 +86,19 @@ DEFINE_int32(consensus_max_batch_size_bytes, 4_MB,
 TAG_FLAG(consensus_max_batch_size_bytes, advanced);
 TAG_FLAG(consensus_max_batch_size_bytes, runtime);
 
+DEFINE_bool(consensus_adaptive_batch_size, false,
+            "Whether to size batches of operations sent to a lagging peer by the bandwidth-delay "
+            "product of the link to it, measured from round trip times of previous batches. "
+            "consensus_max_batch_size_bytes is used as the lower bound in this case.");
+TAG_FLAG(consensus_adaptive_batch_size, advanced);
+TAG_FLAG(consensus_adaptive_batch_size, runtime);
+
+DEFINE_int32(consensus_max_adaptive_batch_size_bytes, 32_MB,
+             "Upper bound for adaptive batch size, see consensus_adaptive_batch_size. It is also "
+             "limited by rpc_max_message_size.");
+TAG_FLAG(consensus_max_adaptive_batch_size_bytes, advanced);
+TAG_FLAG(consensus_max_adaptive_batch_size_bytes, runtime);
+
 DEFINE_int32(follower_unavailable_considered_failed_sec, 900,
              "Seconds that a leader is unable to successfully heartbeat to a "
              "follower after which the follower is considered to be failed and "
@@ -121,6 +134,20 @@ namespace {
 
 constexpr const auto kMinRpcThrottleThresholdBytes = 16;
 
+// Only one request is outstanding to a peer, so the link is idle for one round trip after each
+// batch. Sending this many bandwidth-delay products per batch keeps it busy ~80% of the time.
+constexpr int kAdaptiveBatchBdpMultiplier = 4;
+
+// Weight of the new sample in the exponentially weighted moving average of bandwidth.
+constexpr double kBandwidthSampleWeight = 0.25;
+
+// Bandwidth sample is limited by this many batch sizes per round trip time.
+constexpr int kMaxBandwidthToThroughputRatio = 8;
+
+// Link latency is the min heartbeat round trip time over the last one or two windows of this
+// length, so a single low sample or a route change does not affect it forever.
+constexpr auto kMinRttWindow = std::chrono::seconds(10);
+
 static bool RpcThrottleThresholdBytesValidator(const char* flagname, int32_t value) {
   if (value > 0) {
     if (value < kMinRpcThrottleThresholdBytes) {
@@ -181,6 +208,65 @@ void PeerMessageQueue::TrackedPeer::ResetLeaderLeases() {
   leader_ht_lease_expiration.Reset();
 }
 
+void PeerMessageQueue::TrackedPeer::UpdateBatchSize(CoarseTimePoint now) {
+  auto rtt = now - last_request_send_time;
+  auto batch_bytes = last_batch_bytes;
+  last_batch_bytes = 0;
+  if (last_request_is_heartbeat) {
+    last_request_is_heartbeat = false;
+    UpdateMinRtt(now, rtt);
+    return;
+  }
+  // Round trip time of full batches includes their transfer time, so latency is taken from
+  // heartbeats only. Without it transfer time could not be separated from latency.
+  if (batch_bytes == 0 || min_rtt == CoarseDuration::zero()) {
+    return;
+  }
+  // Time spent pushing the batch through the link on top of its latency. It is bounded from
+  // below, so a noisy sample close to min_rtt does not produce an unbounded bandwidth estimate.
+  auto transfer_time = std::max<CoarseDuration>(
+      rtt - min_rtt, rtt / kMaxBandwidthToThroughputRatio);
+  auto bandwidth = batch_bytes / ToSeconds(transfer_time);
+  bandwidth_bytes_per_sec = bandwidth_bytes_per_sec == 0
+      ? bandwidth
+      : bandwidth_bytes_per_sec * (1 - kBandwidthSampleWeight) +
+            bandwidth * kBandwidthSampleWeight;
+
+  auto target = static_cast<int64_t>(
+      bandwidth_bytes_per_sec * ToSeconds(min_rtt) * kAdaptiveBatchBdpMultiplier);
+  // Grow at most twice per round trip, so overestimated bandwidth gets corrected by samples of
+  // bigger batches before we send too much.
+  batch_size_bytes = std::min(target, 2 * MaxBatchSize());
+}
+
+void PeerMessageQueue::TrackedPeer::UpdateMinRtt(CoarseTimePoint now, CoarseDuration rtt) {
+  auto window_age = now - min_rtt_window_start;
+  if (min_rtt_window_start == CoarseTimePoint() || window_age >= 2 * kMinRttWindow) {
+    // No samples in the previous window, forget everything.
+    prev_window_min_rtt = CoarseDuration::zero();
+    window_min_rtt = rtt;
+    min_rtt_window_start = now;
+  } else if (window_age >= kMinRttWindow) {
+    prev_window_min_rtt = window_min_rtt;
+    window_min_rtt = rtt;
+    min_rtt_window_start = now;
+  } else {
+    window_min_rtt = std::min(window_min_rtt, rtt);
+  }
+  min_rtt = prev_window_min_rtt == CoarseDuration::zero()
+      ? window_min_rtt : std::min(window_min_rtt, prev_window_min_rtt);
+}
+
+int64_t PeerMessageQueue::TrackedPeer::MaxBatchSize() const {
+  int64_t lower_bound = FLAGS_consensus_max_batch_size_bytes;
+  if (!FLAGS_consensus_adaptive_batch_size) {
+    return lower_bound;
+  }
+  int64_t upper_bound = std::min<int64_t>(
+      FLAGS_consensus_max_adaptive_batch_size_bytes, FLAGS_rpc_max_message_size - 1_KB);
+  return std::max(lower_bound, std::min(batch_size_bytes, upper_bound));
+}
+
 #define INSTANTIATE_METRIC(x) \
   x.Instantiate(metric_entity, 0)
 PeerMessageQueue::Metrics::Metrics(const scoped_refptr<MetricEntity>& metric_entity)
@@ -429,6 +515,7 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
   bool is_new;
   int64_t next_index;
   int64_t to_index;
+  int64_t max_batch_size;
   HybridTime propagated_safe_time;
 
   // Should be before now_ht, i.e. not greater than propagated_hybrid_time.
@@ -497,6 +584,7 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
     *needs_remote_bootstrap = peer->needs_remote_bootstrap;
 
     next_index = peer->next_index;
+    max_batch_size = peer->MaxBatchSize();
     if (FLAGS_enable_consensus_exponential_backoff && peer->last_num_messages_sent >= 0) {
       // Previous request to peer has not been acked. Reduce number of entries to be sent
       // in this attempt using exponential backoff. Note that to_index is inclusive.
@@ -540,8 +628,8 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
   // point.
   if (!is_new) {
     // The batch of messages to send to the peer.
-    int max_batch_size = FLAGS_consensus_max_batch_size_bytes - request->ByteSize();
-    auto result = ReadFromLogCache(next_index - 1, to_index, max_batch_size, uuid);
+    auto result = ReadFromLogCache(
+        next_index - 1, to_index, max_batch_size - request->ByteSize(), uuid);
     if (PREDICT_FALSE(!result.ok())) {
       if (PREDICT_TRUE(result.status().IsNotFound())) {
         std::string msg = Format("The logs necessary to catch up peer $0 have been "
@@ -581,6 +669,14 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
       }
 
       peer->last_num_messages_sent = result->messages.size();
+      // Heartbeats are used to measure the link latency, and full batches its bandwidth. Other
+      // batches are limited by the write rate on the leader rather than by the link.
+      peer->last_request_send_time = CoarseMonoClock::Now();
+      peer->last_request_is_heartbeat =
+          FLAGS_consensus_adaptive_batch_size && result->messages.empty();
+      peer->last_batch_bytes =
+          FLAGS_consensus_adaptive_batch_size && result->have_more_messages && to_index == 0
+              ? request->ByteSize() : 0;
     }
 
     ScopedTrackedConsumption consumption;
@@ -1001,6 +1097,16 @@ void PeerMessageQueue::NotifyPeerIsResponsiveDespiteError(const std::string& pee
   peer->last_successful_communication_time = MonoTime::Now();
 }
 
+void PeerMessageQueue::DiscardLatencySample(const std::string& peer_uuid) {
+  if (!FLAGS_consensus_adaptive_batch_size) {
+    return;
+  }
+  LockGuard l(queue_lock_);
+  TrackedPeer* peer = FindPtrOrNull(peers_map_, peer_uuid);
+  if (!peer) return;
+  peer->last_request_is_heartbeat = false;
+}
+
 bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
                                         const ConsensusResponsePB& response) {
   DCHECK(response.IsInitialized()) << "Error: Uninitialized: "
@@ -1133,6 +1239,9 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
 
     peer->is_last_exchange_successful = true;
     peer->num_sst_files = response.num_sst_files();
+    if (peer->last_batch_bytes > 0 || peer->last_request_is_heartbeat) {
+      peer->UpdateBatchSize(CoarseMonoClock::Now());
+    }
 
     if (response.has_responder_term()) {
       // The peer must have responded with a term that is greater than or equal to the last known
@@ -1423,6 +1532,19 @@ bool PeerMessageQueue::PeerAcceptedOurLease(const std::string& uuid) const {
   return peer->leader_lease_expiration.last_received != CoarseTimePoint();
 }
 
+bool PeerMessageQueue::IsPeerIdle(const std::string& uuid) const {
+  std::lock_guard<simple_spinlock> lock(queue_lock_);
+  TrackedPeer* peer = FindPtrOrNull(peers_map_, uuid);
+  if (peer == nullptr || queue_state_.mode != Mode::LEADER) {
+    return false;
+  }
+
+  return peer->is_last_exchange_successful &&
+         OpIdEquals(queue_state_.committed_op_id, queue_state_.last_appended) &&
+         OpIdEquals(peer->last_received, queue_state_.last_appended) &&
+         peer->last_known_committed_idx == queue_state_.committed_op_id.index();
+}
+
 bool PeerMessageQueue::CanPeerBecomeLeader(const std::string& peer_uuid) const {
   std::lock_guard<simple_spinlock> lock(queue_lock_);
   TrackedPeer* peer = FindPtrOrNull(peers_map_, peer_uuid);
@@ -1430,6 +1552,11 @@ bool PeerMessageQueue::CanPeerBecomeLeader(const std::string& peer_uuid) const {
     LOG(ERROR) << "Invalid peer UUID: " << peer_uuid;
     return false;
   }
+  if (queue_state_.active_config &&
+      IsRaftConfigWitness(peer_uuid, *queue_state_.active_config)) {
+    LOG(INFO) << "Peer " << peer_uuid << " cannot become Leader as it is a witness";
+    return false;
+  }
   const bool peer_can_be_leader =
       !OpIdLessThan(peer->last_received, queue_state_.majority_replicated_op_id);
   if (!peer_can_be_leader) {
@@ -1451,6 +1578,10 @@ string PeerMessageQueue::GetUpToDatePeer() const {
       if (local_peer_uuid_ == entry.first) {
         continue;
       }
+      if (queue_state_.active_config &&
+          IsRaftConfigWitness(entry.first, *queue_state_.active_config)) {
+        continue;
+      }
       if (OpIdBiggerThan(highest_op_id, entry.second->last_received)) {
         continue;
       } else if (OpIdEquals(highest_op_id, entry.second->last_received)) {
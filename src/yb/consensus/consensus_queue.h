@@ -53,6 +53,7 @@
 #include "yb/gutil/ref_counted.h"
 
 #include "yb/util/locks.h"
+#include "yb/util/monotime.h"
 #include "yb/util/status.h"
 #include "yb/util/result.h"
 
@@ -133,6 +134,17 @@ class PeerMessageQueue {
 
     void ResetLeaderLeases();
 
+    // Updates latency estimate of the link to this peer after a heartbeat sent at
+    // last_request_send_time was acked. Or updates bandwidth estimate and recalculates
+    // batch_size_bytes if it was a full batch of operations.
+    void UpdateBatchSize(CoarseTimePoint now);
+
+    // Adds heartbeat round trip time sample acked at now to the windowed min_rtt.
+    void UpdateMinRtt(CoarseTimePoint now, CoarseDuration rtt);
+
+    // Max size of the next batch of operations sent to this peer.
+    int64_t MaxBatchSize() const;
+
     // UUID of the peer.
     const std::string uuid;
 
@@ -181,6 +193,29 @@ class PeerMessageQueue {
 
     uint64_t num_sst_files = 0;
 
+    // Adaptive batch size state, used when consensus_adaptive_batch_size is set.
+    // When the last request was sent to the peer.
+    CoarseTimePoint last_request_send_time;
+    // Size of the last request when it was a full batch of operations, zero otherwise.
+    int64_t last_batch_bytes = 0;
+    // Whether the last request was a heartbeat, i.e. did not contain operations.
+    bool last_request_is_heartbeat = false;
+
+    // Min heartbeat round trip time to the peer over the current and previous windows, i.e. link
+    // latency estimate. Zero if no heartbeat was acked yet.
+    CoarseDuration min_rtt = CoarseDuration::zero();
+    // Min round trip time in the current window and when it was started, and min round trip time
+    // in the previous window, zero if there were no samples in it.
+    CoarseDuration window_min_rtt = CoarseDuration::zero();
+    CoarseTimePoint min_rtt_window_start;
+    CoarseDuration prev_window_min_rtt = CoarseDuration::zero();
+
+    // Estimated bandwidth of the link to the peer, excluding latency.
+    double bandwidth_bytes_per_sec = 0;
+
+    // Batch size calculated from bandwidth-delay product, zero if not calculated yet.
+    int64_t batch_size_bytes = 0;
+
    private:
     // The last term we saw from a given peer.
     // This is only used for sanity checking that a peer doesn't
@@ -286,6 +321,10 @@ class PeerMessageQueue {
   // is alive, even if it may not be fully up and running or able to accept updates.
   void NotifyPeerIsResponsiveDespiteError(const std::string& peer_uuid);
 
+  // Tells the queue that the last request to the peer spent some time waiting before it was sent,
+  // e.g. in a heartbeat batch, so its round trip should not be used as a link latency sample.
+  void DiscardLatencySample(const std::string& peer_uuid);
+
   // Updates the request queue with the latest response of a peer, returns whether this peer has
   // more requests pending.
   virtual bool ResponseFromPeer(const std::string& peer_uuid,
@@ -308,6 +347,10 @@ class PeerMessageQueue {
   // Returns true if specified peer accepted our lease request.
   bool PeerAcceptedOurLease(const std::string& uuid) const;
 
+  // Returns true if specified peer is idle: the last exchange with it was successful, it received
+  // all operations appended to the queue and knows that all of them are committed.
+  bool IsPeerIdle(const std::string& uuid) const;
+
   // Returns a copy of the TrackedPeer with 'uuid' or crashes if the peer is not being tracked.
   TrackedPeer GetTrackedPeerForTests(std::string uuid);
 
@@ -46,12 +46,14 @@
 #include "yb/consensus/opid_util.h"
 #include "yb/gutil/stl_util.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/util/file_system_posix.h"
 #include "yb/util/random.h"
 
 DEFINE_int32(num_batches, 10000,
              "Number of batches to write to/read from the Log in TestWriteManyBatches");
 
 DECLARE_int32(log_min_segments_to_retain);
+DECLARE_bool(log_mmap_closed_segments);
 DECLARE_bool(never_fsync);
 DECLARE_bool(writable_file_use_fsync);
 DECLARE_int32(o_direct_block_alignment_bytes);
@@ -477,6 +479,46 @@ TEST_F(LogTest, TestSegmentRollover) {
   ASSERT_EQ(num_entries, total_read);
 }
 
+TEST_F(LogTest, TestReadMmappedClosedSegments) {
+  FLAGS_log_mmap_closed_segments = true;
+  BuildLog();
+  log_->SetMaxSegmentSizeForTests(990);
+  const int kNumEntriesPerBatch = 100;
+
+  OpId op_id = MakeOpId(1, 1);
+  int num_entries = 0;
+
+  SegmentSequence segments;
+  ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+
+  while (segments.size() < 3) {
+    ASSERT_OK(AppendNoOps(&op_id, kNumEntriesPerBatch));
+    num_entries += kNumEntriesPerBatch;
+    ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+  }
+
+  // Segments that were rolled over are mapped, the one being written is read with pread.
+  auto check_segments = [&segments, num_entries](size_t num_mapped) {
+    size_t total_read = 0;
+    for (size_t i = 0; i != segments.size(); ++i) {
+      ASSERT_EQ(i < num_mapped, dynamic_cast<PosixMmapRandomAccessFile*>(
+          segments[i]->readable_file().get()) != nullptr) << "Segment: " << i;
+      auto read_entries = segments[i]->ReadEntries();
+      ASSERT_OK(read_entries.status);
+      total_read += read_entries.entries.size();
+    }
+    ASSERT_EQ(num_entries, total_read);
+  };
+  ASSERT_NO_FATALS(check_segments(segments.size() - 1));
+  ASSERT_OK(log_->Close());
+
+  std::unique_ptr<LogReader> reader;
+  ASSERT_OK(LogReader::Open(fs_manager_->env(), nullptr, kTestTablet, tablet_wal_path_,
+                            fs_manager_->uuid(), nullptr, &reader));
+  ASSERT_OK(reader->GetSegmentsSnapshot(&segments));
+  ASSERT_NO_FATALS(check_segments(segments.size()));
+}
+
 TEST_F(LogTest, TestWriteAndReadToAndFromInProgressSegment) {
   const int kNumEntries = 4;
   BuildLog();
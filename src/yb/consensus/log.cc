@@ -168,7 +168,6 @@ namespace yb {
 namespace log {
 
 using consensus::OpId;
-using env_util::OpenFileForRandom;
 using std::shared_ptr;
 using std::unique_ptr;
 using strings::Substitute;
@@ -1199,8 +1198,7 @@ Status Log::ReplaceSegmentInReaderUnlocked() {
   // We should never switch to a new segment if we wrote nothing to the old one.
   CHECK(active_segment_->IsClosed());
   shared_ptr<RandomAccessFile> readable_file;
-  RETURN_NOT_OK(OpenFileForRandom(
-      get_env(), active_segment_->path(), &readable_file));
+  RETURN_NOT_OK(OpenClosedSegmentFile(get_env(), active_segment_->path(), &readable_file));
 
   scoped_refptr<ReadableLogSegment> readable_segment(
       new ReadableLogSegment(active_segment_->path(), readable_file));
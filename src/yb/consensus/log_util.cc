@@ -48,11 +48,13 @@
 #include "yb/gutil/strings/substitute.h"
 #include "yb/gutil/strings/util.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/coding-inl.h"
 #include "yb/util/coding.h"
 #include "yb/util/crc.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/env_util.h"
+#include "yb/util/file_system_posix.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/pb_util.h"
 #include "yb/util/size_literals.h"
@@ -87,6 +89,18 @@ DEFINE_bool(log_async_preallocate_segments, true,
             "Whether the WAL segments preallocation should happen asynchronously");
 TAG_FLAG(log_async_preallocate_segments, advanced);
 
+DEFINE_bool(log_mmap_closed_segments, false,
+            "Whether closed WAL segments are memory mapped for reading. Entries read for follower "
+            "catch-up and CDC are then parsed directly from the mapping instead of being copied "
+            "into a heap buffer first.");
+TAG_FLAG(log_mmap_closed_segments, advanced);
+TAG_FLAG(log_mmap_closed_segments, runtime);
+
+DEFINE_int32(log_mmap_readahead_kb, 1024,
+             "Size of the window ahead of the last read that is prefetched when reading a memory "
+             "mapped WAL segment. 0 disables the prefetch.");
+TAG_FLAG(log_mmap_readahead_kb, advanced);
+
 DECLARE_string(fs_data_dirs);
 
 DEFINE_bool(require_durable_wal_write, false, "Whether durable WAL write is required."
@@ -140,12 +154,31 @@ LogOptions::LogOptions()
       env(Env::Default()) {
 }
 
+Status OpenClosedSegmentFile(Env* env, const string& path,
+                             shared_ptr<RandomAccessFile>* readable_file) {
+  RETURN_NOT_OK(env_util::OpenFileForRandom(env, path, readable_file));
+  if (!GetAtomicFlag(&FLAGS_log_mmap_closed_segments) || (*readable_file)->IsEncrypted()) {
+    return Status::OK();
+  }
+
+  std::unique_ptr<RandomAccessFile> mmap_file;
+  auto status = PosixMmapRandomAccessFile::Open(
+      path, std::max(FLAGS_log_mmap_readahead_kb, 0) * 1_KB, &mmap_file);
+  if (!status.ok()) {
+    // Fall back to regular reads, e.g. for empty files or environments without a real file.
+    VLOG(1) << "Unable to map wal segment " << path << ": " << status;
+    return Status::OK();
+  }
+  readable_file->reset(mmap_file.release());
+  return Status::OK();
+}
+
 Status ReadableLogSegment::Open(Env* env,
                                 const string& path,
                                 scoped_refptr<ReadableLogSegment>* segment) {
   VLOG(1) << "Parsing wal segment: " << path;
   shared_ptr<RandomAccessFile> readable_file;
-  RETURN_NOT_OK_PREPEND(env_util::OpenFileForRandom(env, path, &readable_file),
+  RETURN_NOT_OK_PREPEND(OpenClosedSegmentFile(env, path, &readable_file),
                         "Unable to open file for reading");
 
   segment->reset(new ReadableLogSegment(path, readable_file));
@@ -157,6 +157,12 @@ struct FirstEntryMetadata {
 // log_segment_size_mb flag, which defaults to 64). Upon reaching this size
 // segments are rolled over and the Log continues in a new segment.
 
+// Opens the file of a log segment that is no longer written to for random reads. If
+// --log_mmap_closed_segments is set and the file is not encrypted, the file is memory mapped, so
+// entries are parsed from the page cache without an intermediate copy.
+CHECKED_STATUS OpenClosedSegmentFile(Env* env, const std::string& path,
+                                     std::shared_ptr<RandomAccessFile>* readable_file);
+
 // A readable log segment for recovery and follower catch-up.
 class ReadableLogSegment : public RefCountedThreadSafe<ReadableLogSegment> {
  public:
@@ -0,0 +1,187 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/multi_raft_batcher.h"
+
+#include <vector>
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include "yb/consensus/consensus.pb.h"
+#include "yb/consensus/consensus.proxy.h"
+
+#include "yb/rpc/messenger.h"
+#include "yb/rpc/rpc_controller.h"
+
+#include "yb/util/debug-util.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/format.h"
+
+using namespace std::literals;
+using namespace std::placeholders;
+
+DEFINE_bool(enable_multi_raft_heartbeat_batcher, false,
+            "Combine Raft heartbeats of all tablets sent to the same tablet server into a single "
+            "MultiRaftUpdateConsensus RPC.");
+TAG_FLAG(enable_multi_raft_heartbeat_batcher, advanced);
+TAG_FLAG(enable_multi_raft_heartbeat_batcher, runtime);
+
+DEFINE_int32(multi_raft_heartbeat_interval_ms, 50,
+             "Maximum time a heartbeat is held by the batcher waiting for other heartbeats to "
+             "the same tablet server.");
+TAG_FLAG(multi_raft_heartbeat_interval_ms, advanced);
+
+DEFINE_int32(multi_raft_batch_size, 512,
+             "Maximum number of heartbeats in a single MultiRaftUpdateConsensus RPC.");
+TAG_FLAG(multi_raft_batch_size, advanced);
+
+DECLARE_int32(consensus_rpc_timeout_ms);
+
+namespace yb {
+namespace consensus {
+
+struct MultiRaftHeartbeatBatcher::Batch {
+  MultiRaftConsensusRequestPB request;
+  MultiRaftConsensusResponsePB response;
+  rpc::RpcController controller;
+  std::vector<std::pair<ConsensusResponsePB*, StatusFunctor>> callbacks;
+};
+
+MultiRaftHeartbeatBatcher::MultiRaftHeartbeatBatcher(
+    const HostPort& hostport, rpc::ProxyCache* proxy_cache, rpc::Messenger* messenger)
+    : hostport_(hostport),
+      messenger_(messenger),
+      proxy_(std::make_unique<ConsensusServiceProxy>(proxy_cache, hostport)) {
+}
+
+MultiRaftHeartbeatBatcher::~MultiRaftHeartbeatBatcher() {
+  // Timer and RPC callbacks hold reference to batcher, so there could be no pending batch.
+  DCHECK(!current_batch_);
+}
+
+bool MultiRaftHeartbeatBatcher::AddRequestToBatch(const ConsensusRequestPB& request,
+                                                  ConsensusResponsePB* response,
+                                                  StatusFunctor callback) {
+  if (unsupported_.load(std::memory_order_acquire)) {
+    return false;
+  }
+
+  BatchPtr new_batch;
+  BatchPtr full_batch;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!current_batch_) {
+      current_batch_ = std::make_shared<Batch>();
+      new_batch = current_batch_;
+    }
+    current_batch_->request.add_consensus_request()->CopyFrom(request);
+    current_batch_->callbacks.emplace_back(response, std::move(callback));
+    if (current_batch_->callbacks.size() >=
+            static_cast<size_t>(FLAGS_multi_raft_batch_size)) {
+      full_batch = std::move(current_batch_);
+    }
+  }
+
+  if (new_batch) {
+    auto task_id = messenger_->ScheduleOnReactor(
+        std::bind(&MultiRaftHeartbeatBatcher::BatchTimerFired, shared_from_this(), new_batch, _1),
+        FLAGS_multi_raft_heartbeat_interval_ms * 1ms, SOURCE_LOCATION(), messenger_);
+    if (task_id == rpc::kInvalidTaskId) {
+      BatchTimerFired(new_batch, STATUS(Aborted, "Failed to schedule heartbeat batch"));
+    }
+  }
+  if (full_batch) {
+    SendBatch(full_batch);
+  }
+  return true;
+}
+
+void MultiRaftHeartbeatBatcher::BatchTimerFired(const BatchPtr& batch, const Status& status) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Batch was already sent because it reached the size limit.
+    if (current_batch_ != batch) {
+      return;
+    }
+    current_batch_.reset();
+  }
+
+  if (!status.ok()) {
+    for (const auto& entry : batch->callbacks) {
+      entry.second(status);
+    }
+    return;
+  }
+
+  SendBatch(batch);
+}
+
+void MultiRaftHeartbeatBatcher::SendBatch(const BatchPtr& batch) {
+  VLOG(4) << "Sending " << batch->callbacks.size() << " heartbeats to " << hostport_;
+
+  batch->controller.set_timeout(FLAGS_consensus_rpc_timeout_ms * 1ms);
+  batch->controller.set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolHigh);
+  proxy_->MultiRaftUpdateConsensusAsync(
+      batch->request, &batch->response, &batch->controller,
+      std::bind(&MultiRaftHeartbeatBatcher::BatchResponseReceived, shared_from_this(), batch));
+}
+
+void MultiRaftHeartbeatBatcher::BatchResponseReceived(const BatchPtr& batch) {
+  auto status = batch->controller.status();
+  if (!status.ok()) {
+    const auto* error = batch->controller.error_response();
+    if (status.IsRemoteError() && error &&
+        error->code() == rpc::ErrorStatusPB::ERROR_NO_SUCH_METHOD) {
+      LOG(WARNING) << hostport_ << " does not support batched heartbeats, "
+                   << "falling back to UpdateConsensus: " << status;
+      unsupported_.store(true, std::memory_order_release);
+    }
+  } else if (static_cast<size_t>(batch->response.consensus_response_size()) !=
+                 batch->callbacks.size()) {
+    status = STATUS_FORMAT(
+        IllegalState, "Wrong number of responses from $0: $1, while $2 expected",
+        hostport_, batch->response.consensus_response_size(), batch->callbacks.size());
+    LOG(DFATAL) << status;
+  }
+
+  for (size_t i = 0; i != batch->callbacks.size(); ++i) {
+    auto& entry = batch->callbacks[i];
+    if (status.ok()) {
+      entry.first->Swap(batch->response.mutable_consensus_response(i));
+    }
+    entry.second(status);
+  }
+}
+
+MultiRaftManager::MultiRaftManager(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache)
+    : messenger_(messenger), proxy_cache_(proxy_cache) {
+}
+
+MultiRaftHeartbeatBatcherPtr MultiRaftManager::AddOrGetBatcher(const HostPort& hostport) {
+  if (!FLAGS_enable_multi_raft_heartbeat_batcher) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& weak_batcher = batchers_[hostport];
+  auto batcher = weak_batcher.lock();
+  if (!batcher) {
+    batcher = std::make_shared<MultiRaftHeartbeatBatcher>(hostport, proxy_cache_, messenger_);
+    weak_batcher = batcher;
+  }
+  return batcher;
+}
+
+} // namespace consensus
+} // namespace yb
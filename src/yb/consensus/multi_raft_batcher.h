@@ -0,0 +1,101 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_CONSENSUS_MULTI_RAFT_BATCHER_H
+#define YB_CONSENSUS_MULTI_RAFT_BATCHER_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "yb/consensus/consensus_fwd.h"
+
+#include "yb/rpc/rpc_fwd.h"
+
+#include "yb/util/net/net_util.h"
+#include "yb/util/status_callback.h"
+
+namespace yb {
+namespace consensus {
+
+class ConsensusRequestPB;
+class ConsensusResponsePB;
+
+// Combines heartbeats, i.e. consensus requests without operations, of all tablets that
+// send them to the same server into a single MultiRaftUpdateConsensus RPC.
+//
+// Heartbeat is added to the current batch, which is sent after multi_raft_heartbeat_interval_ms
+// or as soon as it contains multi_raft_batch_size requests.
+class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftHeartbeatBatcher> {
+ public:
+  MultiRaftHeartbeatBatcher(const HostPort& hostport,
+                            rpc::ProxyCache* proxy_cache,
+                            rpc::Messenger* messenger);
+
+  ~MultiRaftHeartbeatBatcher();
+
+  // Adds copy of request to the batch. Response is filled and callback is invoked when the batch
+  // RPC completes. Returns false if the destination server does not support batched heartbeats,
+  // so the request should be sent as a regular UpdateConsensus RPC.
+  bool AddRequestToBatch(const ConsensusRequestPB& request,
+                         ConsensusResponsePB* response,
+                         StatusFunctor callback);
+
+  const HostPort& hostport() const {
+    return hostport_;
+  }
+
+ private:
+  struct Batch;
+  typedef std::shared_ptr<Batch> BatchPtr;
+
+  void SendBatch(const BatchPtr& batch);
+  void BatchTimerFired(const BatchPtr& batch, const Status& status);
+  void BatchResponseReceived(const BatchPtr& batch);
+
+  const HostPort hostport_;
+  rpc::Messenger* const messenger_;
+  std::unique_ptr<ConsensusServiceProxy> proxy_;
+
+  std::mutex mutex_;
+  // Batch that collects new requests. nullptr if there are no pending requests.
+  BatchPtr current_batch_;
+
+  // Set when destination server responded that it does not support batched heartbeats.
+  std::atomic<bool> unsupported_{false};
+};
+
+typedef std::shared_ptr<MultiRaftHeartbeatBatcher> MultiRaftHeartbeatBatcherPtr;
+
+// Server wide registry of heartbeat batchers, one per destination server.
+class MultiRaftManager {
+ public:
+  MultiRaftManager(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache);
+
+  // Returns batcher for the specified destination, creating it when necessary.
+  // Returns nullptr if heartbeat batching is disabled.
+  MultiRaftHeartbeatBatcherPtr AddOrGetBatcher(const HostPort& hostport);
+
+ private:
+  rpc::Messenger* const messenger_;
+  rpc::ProxyCache* const proxy_cache_;
+
+  std::mutex mutex_;
+  std::unordered_map<HostPort, std::weak_ptr<MultiRaftHeartbeatBatcher>, HostPortHash> batchers_;
+};
+
+} // namespace consensus
+} // namespace yb
+
+#endif // YB_CONSENSUS_MULTI_RAFT_BATCHER_H
@@ -107,6 +107,13 @@ void PeerManager::SignalRequest(RequestTriggerMode trigger_mode) {
   }
 }
 
+void PeerManager::Wake() {
+  std::lock_guard<simple_spinlock> lock(lock_);
+  for (const auto& entry : peers_) {
+    entry.second->Wake();
+  }
+}
+
 void PeerManager::Close() {
   std::lock_guard<simple_spinlock> lock(lock_);
   for (const auto& entry : peers_) {
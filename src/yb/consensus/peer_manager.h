@@ -82,6 +82,9 @@ class PeerManager {
   // Signals all peers of the current configuration that there is a new request pending.
   virtual void SignalRequest(RequestTriggerMode trigger_mode);
 
+  // Resumes heartbeats to all quiescent peers.
+  virtual void Wake();
+
   // Closes all peers.
   virtual void Close();
 
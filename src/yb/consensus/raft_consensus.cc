@@ -216,6 +216,17 @@ using std::weak_ptr;
 using strings::Substitute;
 using tserver::TabletServerErrorPB;
 
+namespace {
+
+// How often the retryable requests flusher checks retryable_requests_flush_interval_ms.
+const MonoDelta kRetryableRequestsFlushCheckPeriod = MonoDelta::FromSeconds(1);
+
+} // namespace
+
+bool WitnessSkipsOperation(OperationType op_type) {
+  return op_type == WRITE_OP || op_type == UPDATE_TRANSACTION_OP;
+}
+
 struct RaftConsensus::LeaderRequest {
   std::string leader_uuid;
   yb::OpId preceding_op_id;
@@ -244,9 +255,10 @@ shared_ptr<RaftConsensus> RaftConsensus::Create(
     TableType table_type,
     ThreadPool* raft_pool,
     RetryableRequests* retryable_requests,
-    const yb::OpId& split_op_id) {
+    const yb::OpId& split_op_id,
+    MultiRaftManager* multi_raft_manager) {
   auto rpc_factory = std::make_unique<RpcPeerProxyFactory>(
-      messenger, proxy_cache, local_peer_pb.cloud_info());
+      messenger, proxy_cache, local_peer_pb.cloud_info(), multi_raft_manager);
 
   // The message queue that keeps track of which operations need to be replicated
   // where.
@@ -297,7 +309,8 @@ shared_ptr<RaftConsensus> RaftConsensus::Create(
       mark_dirty_clbk,
       table_type,
       retryable_requests,
-      split_op_id);
+      split_op_id,
+      raft_pool->NewToken(ThreadPool::ExecutionMode::SERIAL));
 }
 
 RaftConsensus::RaftConsensus(
@@ -313,8 +326,10 @@ RaftConsensus::RaftConsensus(
     Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
     TableType table_type,
     RetryableRequests* retryable_requests,
-    const yb::OpId& split_op_id)
+    const yb::OpId& split_op_id,
+    std::unique_ptr<ThreadPoolToken> apply_pool_token)
     : raft_pool_token_(std::move(raft_pool_token)),
+      apply_pool_token_(std::move(apply_pool_token)),
       log_(log),
       clock_(clock),
       peer_proxy_factory_(std::move(proxy_factory)),
@@ -347,7 +362,9 @@ RaftConsensus::RaftConsensus(
       this,
       retryable_requests,
       split_op_id,
-      std::bind(&PeerMessageQueue::TrackOperationsMemory, queue_.get(), _1));
+      std::bind(&PeerMessageQueue::TrackOperationsMemory, queue_.get(), _1),
+      apply_pool_token_.get(),
+      metric_entity);
 
   peer_manager_->SetConsensus(this);
 }
@@ -371,6 +388,19 @@ Status RaftConsensus::Start(const ConsensusBootstrapInfo& info) {
       },
       MinimumElectionTimeout());
 
+  // Messenger is absent in tests that use a local peer proxy factory.
+  if (peer_proxy_factory_->messenger()) {
+    retryable_requests_flusher_ = PeriodicTimer::Create(
+        peer_proxy_factory_->messenger(),
+        [w]() {
+          if (auto consensus = w.lock()) {
+            consensus->ScheduleRetryableRequestsFlush();
+          }
+        },
+        kRetryableRequestsFlushCheckPeriod);
+    retryable_requests_flusher_->Start();
+  }
+
   {
     ReplicaState::UniqueLock lock;
     RETURN_NOT_OK(state_->LockForStart(&lock));
@@ -488,6 +518,10 @@ Status RaftConsensus::DoStartElection(const LeaderElectionData& data, PreElected
                             << ", active_role=" << active_role;
       return Status::OK();
     }
+    if (PREDICT_FALSE(state_->IsWitness())) {
+      SnoozeFailureDetector(DO_NOT_LOG);
+      return STATUS_FORMAT(IllegalState, "Not starting $0: Node is a witness", election_name);
+    }
     if (PREDICT_FALSE(active_role == RaftPeerPB::NON_PARTICIPANT)) {
       // Avoid excessive election noise while in this state.
       SnoozeFailureDetector(DO_NOT_LOG);
@@ -880,6 +914,11 @@ void RaftConsensus::ReportFailureDetectedTask() {
     }
   }
 
+  if (state_->IsWitness()) {
+    VLOG_WITH_PREFIX(1) << "ReportFailDetected: Witness does not start elections";
+    return;
+  }
+
   // Start an election.
   LOG_WITH_PREFIX(INFO) << "ReportFailDetected: Starting NORMAL_ELECTION...";
   Status s = StartElection({ElectionMode::NORMAL_ELECTION});
@@ -902,7 +941,12 @@ Status RaftConsensus::BecomeLeaderUnlocked() {
                "tablet", tablet_id());
   LOG_WITH_PREFIX(INFO) << "Becoming Leader. State: " << state_->ToStringUnlocked();
 
+  if (PREDICT_FALSE(state_->IsWitness())) {
+    return STATUS(IllegalState, "Witness cannot become leader");
+  }
+
   // Disable FD while we are leader.
+  quiescent_.store(false, std::memory_order_release);
   DisableFailureDetector();
 
   // Don't vote for anyone if we're a leader.
@@ -953,6 +997,7 @@ Status RaftConsensus::BecomeReplicaUnlocked(
   state_->ClearLeaderUnlocked();
 
   // FD should be running while we are a follower.
+  quiescent_.store(false, std::memory_order_release);
   EnableFailureDetector(initial_fd_wait);
 
   // Now that we're a replica, we can allow voting for other nodes.
@@ -1207,6 +1252,10 @@ void RaftConsensus::NotifyFailedFollower(const string& uuid,
               state_->LogPrefix() + "Unable to start RemoteFollowerTask");
 }
 
+bool RaftConsensus::IsWitness() const {
+  return state_->IsWitness();
+}
+
 void RaftConsensus::TryRemoveFollowerTask(const string& uuid,
                                           const RaftConfigPB& committed_config,
                                           const std::string& reason) {
@@ -1323,6 +1372,11 @@ Status RaftConsensus::StartReplicaOperationUnlocked(
 
   VLOG_WITH_PREFIX(1) << "Starting operation: " << msg->id().ShortDebugString();
   scoped_refptr<ConsensusRound> round(new ConsensusRound(this, msg));
+  if (state_->IsWitness() && WitnessSkipsOperation(msg->op_type())) {
+    // A witness only keeps the operation in its log, the tablet never sees it.
+    round->SetConsensusReplicatedCallback([](const Status&, int64_t, OpIds*) {});
+    return state_->AddPendingOperation(round);
+  }
   ConsensusRound* round_ptr = round.get();
   RETURN_NOT_OK(state_->context()->StartReplicaOperation(round, propagated_safe_time));
   return state_->AddPendingOperation(round_ptr);
@@ -1680,7 +1734,19 @@ Result<RaftConsensus::UpdateReplicaResult> RaftConsensus::UpdateReplica(
   // Snooze the failure detector as soon as we decide to accept the message.
   // We are guaranteed to be acting as a FOLLOWER at this point by the above
   // sanity check.
-  SnoozeFailureDetector(DO_NOT_LOG);
+  // When leader marks request as quiescent, it stops heartbeating us until the next write, so
+  // failure detector is disabled until the next request.
+  if (request->quiescent()) {
+    if (!quiescent_.exchange(true, std::memory_order_acq_rel)) {
+      VLOG_WITH_PREFIX(2) << "Leader " << deduped_req.leader_uuid << " made group quiescent";
+      DisableFailureDetector();
+    }
+  } else if (quiescent_.exchange(false, std::memory_order_acq_rel)) {
+    VLOG_WITH_PREFIX(2) << "Leader " << deduped_req.leader_uuid << " woke up group";
+    EnableFailureDetector();
+  } else {
+    SnoozeFailureDetector(DO_NOT_LOG);
+  }
 
   auto now = MonoTime::Now();
   last_message_from_leader_time_ = now;
@@ -1756,6 +1822,19 @@ Result<bool> RaftConsensus::EnqueuePreparesUnlocked(const ConsensusRequestPB& re
                                                     LeaderRequest* deduped_req_ptr,
                                                     ConsensusResponsePB* response) {
   LeaderRequest& deduped_req = *deduped_req_ptr;
+
+  // Back pressure of asynchronous apply. While too many committed operations wait to be applied,
+  // new operations are not accepted. So last received op id does not advance, and the leader
+  // sends them again later. The rest of the request, i.e. committed op id, is still processed.
+  bool operations_dropped = false;
+  if (!deduped_req.messages.empty() && state_->ApplyQueueFull()) {
+    YB_LOG_EVERY_N_SECS(INFO, 5)
+        << state_->LogPrefix() << "Not accepting " << deduped_req.messages.size()
+        << " operations, waiting for " << state_->NumQueuedApplies() << " queued applies";
+    deduped_req.messages.clear();
+    operations_dropped = true;
+  }
+
   TRACE("Triggering prepare for $0 ops", deduped_req.messages.size());
 
   Status prepare_status;
@@ -1768,7 +1847,8 @@ Result<bool> RaftConsensus::EnqueuePreparesUnlocked(const ConsensusRequestPB& re
   }
 
   HybridTime propagated_safe_time;
-  if (request.has_propagated_safe_time()) {
+  // Safe time propagated with dropped operations could be used only after they are received.
+  if (request.has_propagated_safe_time() && !operations_dropped) {
     propagated_safe_time = HybridTime(request.propagated_safe_time());
     if (deduped_req.messages.empty()) {
       state_->context()->SetPropagatedSafeTime(propagated_safe_time);
@@ -2338,6 +2418,9 @@ void RaftConsensus::Shutdown() {
 
   CHECK_OK(state_->CancelPendingOperations());
 
+  // Committed operations could not be aborted, so wait until they are applied.
+  state_->WaitForQueuedAppliesToComplete();
+
   {
     ReplicaState::UniqueLock lock;
     CHECK_OK(state_->LockForShutdown(&lock));
@@ -2346,8 +2429,15 @@ void RaftConsensus::Shutdown() {
     LOG_WITH_PREFIX(INFO) << "Raft consensus is shut down!";
   }
 
+  if (retryable_requests_flusher_) {
+    retryable_requests_flusher_->Stop();
+  }
+
   // Shut down things that might acquire locks during destruction.
   raft_pool_token_->Shutdown();
+  if (apply_pool_token_) {
+    apply_pool_token_->Shutdown();
+  }
   // We might not have run Start yet, so make sure we have a FD.
   if (failure_detector_) {
     DisableFailureDetector();
@@ -2594,6 +2684,14 @@ LeaderState RaftConsensus::GetLeaderState(bool allow_stale) const {
   return state_->GetLeaderState(allow_stale);
 }
 
+void RaftConsensus::WakeFromQuiescence(MonoDelta follower_fd_delay) {
+  peer_manager_->Wake();
+  if (quiescent_.exchange(false, std::memory_order_acq_rel)) {
+    LOG_WITH_PREFIX(INFO) << "Waking up quiescent follower";
+    EnableFailureDetector(MinimumElectionTimeout() + follower_fd_delay);
+  }
+}
+
 std::string RaftConsensus::LogPrefix() {
   return state_->LogPrefix();
 }
@@ -2843,6 +2941,13 @@ void RaftConsensus::DoElectionCallback(const LeaderElectionData& data,
     return;
   }
 
+  if (PREDICT_FALSE(state_->IsWitness())) {
+    // Local peer could become a witness while the election was running.
+    LOG_WITH_PREFIX(INFO) << "Leader " << election_name << " won for term "
+                          << result.election_term << " by a witness, ignoring";
+    return;
+  }
+
   if (result.preelection) {
     LOG_WITH_PREFIX(INFO) << "Leader pre-election won for term " << result.election_term;
     lock.unlock();
@@ -3058,6 +3163,27 @@ yb::OpId RaftConsensus::MinRetryableRequestOpId() {
   return state_->MinRetryableRequestOpId();
 }
 
+void RaftConsensus::ScheduleRetryableRequestsFlush() {
+  // Timer callback is invoked on a reactor thread, so the synced write is done in raft pool.
+  // Previous flush could still be in progress if the disk is slow, do not queue another one.
+  bool expected = false;
+  if (!retryable_requests_flush_running_.compare_exchange_strong(
+          expected, true, std::memory_order_acq_rel)) {
+    return;
+  }
+  auto status = raft_pool_token_->SubmitFunc(
+      std::bind(&RaftConsensus::FlushRetryableRequestsTask, shared_from_this()));
+  if (!status.ok()) {
+    retryable_requests_flush_running_.store(false, std::memory_order_release);
+    LOG_WITH_PREFIX(WARNING) << "Unable to start FlushRetryableRequestsTask: " << status;
+  }
+}
+
+void RaftConsensus::FlushRetryableRequestsTask() {
+  state_->FlushRetryableRequests();
+  retryable_requests_flush_running_.store(false, std::memory_order_release);
+}
+
 size_t RaftConsensus::LogCacheSize() {
   return queue_->LogCacheSize();
 }
@@ -87,6 +87,10 @@ YB_STRONGLY_TYPED_BOOL(PreElected);
 
 YB_DEFINE_ENUM(RejectMode, (kNone)(kAll)(kNonEmpty));
 
+// Whether a witness keeps operations of this type only in its log, without applying them to the
+// tablet.
+bool WitnessSkipsOperation(OperationType op_type);
+
 class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
                       public Consensus,
                       public PeerMessageQueueObserver,
@@ -112,7 +116,8 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
     TableType table_type,
     ThreadPool* raft_pool,
     RetryableRequests* retryable_requests,
-    const yb::OpId& split_op_id);
+    const yb::OpId& split_op_id,
+    MultiRaftManager* multi_raft_manager = nullptr);
 
   // Creates RaftConsensus.
   // split_op_id is the ID of split tablet Raft operation requesting split of this tablet or unset.
@@ -132,7 +137,8 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
     Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
     TableType table_type,
     RetryableRequests* retryable_requests,
-    const yb::OpId& split_op_id);
+    const yb::OpId& split_op_id,
+    std::unique_ptr<ThreadPoolToken> apply_pool_token = nullptr);
 
   virtual ~RaftConsensus();
 
@@ -175,6 +181,9 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
 
   LeaderState GetLeaderState(bool allow_stale = false) const override;
 
+  // Whether the local peer is a witness, see RaftPeerPB::is_witness.
+  bool IsWitness() const;
+
   std::string peer_uuid() const override;
 
   std::string tablet_id() const override;
@@ -235,6 +244,16 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
 
   CHECKED_STATUS FlushLogIndex();
 
+  // Wakes up quiescent Raft group, used when liveness of tablet servers changes, or when a read
+  // or write finds that the leader lease has expired.
+  // Leader resumes heartbeats to quiescent peers. Follower re-enables its failure detector, giving
+  // the leader additional follower_fd_delay to resume heartbeats before an election is started.
+  void WakeFromQuiescence(MonoDelta follower_fd_delay = MonoDelta::kZero);
+
+  bool quiescent() const {
+    return quiescent_.load(std::memory_order_acquire);
+  }
+
   CHECKED_STATUS CopyLogTo(const std::string& dest_dir);
 
   RetryableRequestsCounts TEST_CountRetryableRequests();
@@ -579,6 +598,12 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
   // being shut down).
   void ReportFailureDetectedTask();
 
+  // Called by retryable_requests_flusher_, submits FlushRetryableRequestsTask() to raft pool
+  // unless the previous one is still running.
+  void ScheduleRetryableRequestsFlush();
+
+  void FlushRetryableRequestsTask();
+
   // Helper API to check if the pending/committed configuration has a PRE_VOTER. Non-null return
   // string implies there are servers in transit.
   string ServersInTransitionMessage();
@@ -618,6 +643,9 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
   // etc.
   std::unique_ptr<ThreadPoolToken> raft_pool_token_;
 
+  // Serial threadpool token used to apply committed operations on followers.
+  std::unique_ptr<ThreadPoolToken> apply_pool_token_;
+
   scoped_refptr<log::Log> log_;
   scoped_refptr<server::Clock> clock_;
   std::unique_ptr<PeerProxyFactory> peer_proxy_factory_;
@@ -635,6 +663,14 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
 
   std::shared_ptr<rpc::PeriodicTimer> failure_detector_;
 
+  // Periodically persists replicated retryable requests, see FlushRetryableRequestsTask().
+  std::shared_ptr<rpc::PeriodicTimer> retryable_requests_flusher_;
+  std::atomic<bool> retryable_requests_flush_running_{false};
+
+  // Set on follower when leader informed it that the group is quiescent, i.e. no heartbeats will
+  // be sent until the next write. Failure detector is disabled while it is set.
+  std::atomic<bool> quiescent_{false};
+
   // If any RequestVote() RPC arrives before this hybrid time,
   // the request will be ignored. This prevents abandoned or partitioned
   // nodes from disturbing the healthy leader.
@@ -43,6 +43,7 @@
 #include "yb/gutil/strings/join.h"
 #include "yb/gutil/strings/strcat.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/util/atomic.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
@@ -51,6 +52,7 @@
 #include "yb/util/tostring.h"
 #include "yb/util/trace.h"
 #include "yb/util/thread_restrictions.h"
+#include "yb/util/threadpool.h"
 #include "yb/util/enums.h"
 
 using namespace std::literals;
@@ -61,6 +63,41 @@ DEFINE_int32(inject_delay_commit_pre_voter_to_voter_secs, 0,
 TAG_FLAG(inject_delay_commit_pre_voter_to_voter_secs, unsafe);
 TAG_FLAG(inject_delay_commit_pre_voter_to_voter_secs, hidden);
 
+DEFINE_bool(follower_apply_async, false,
+            "Apply committed operations on followers in a separate per tablet task, so "
+            "UpdateConsensus could be acknowledged as soon as operations are appended to the log, "
+            "without waiting for earlier operations to be applied.");
+TAG_FLAG(follower_apply_async, advanced);
+TAG_FLAG(follower_apply_async, runtime);
+
+DEFINE_int32(follower_apply_max_queued_ops, 10000,
+             "Max number of committed operations waiting for asynchronous apply on a follower. "
+             "When it is exceeded, the follower does not accept new operations from the leader, "
+             "so they are sent again later, till queued operations are applied.");
+TAG_FLAG(follower_apply_max_queued_ops, advanced);
+TAG_FLAG(follower_apply_max_queued_ops, runtime);
+
+DEFINE_int32(retryable_requests_flush_interval_ms, 0,
+             "How often to persist replicated retryable requests next to consensus metadata, "
+             "so tablet bootstrap does not have to replay the WAL to restore them and the WAL "
+             "does not have to be retained for them. 0 disables persistence.");
+TAG_FLAG(retryable_requests_flush_interval_ms, advanced);
+TAG_FLAG(retryable_requests_flush_interval_ms, runtime);
+
+METRIC_DEFINE_gauge_int64(tablet, follower_apply_lag_ops, "Follower Apply Lag Operations",
+                          yb::MetricUnit::kOperations,
+                          "Number of committed operations queued for asynchronous apply.");
+
+METRIC_DEFINE_gauge_int64(tablet, follower_apply_lag_ms, "Follower Apply Lag",
+                          yb::MetricUnit::kMilliseconds,
+                          "Time since the oldest operation queued for asynchronous apply was "
+                          "committed.");
+
+METRIC_DEFINE_histogram(tablet, follower_apply_batch_size, "Follower Apply Batch Size",
+                        yb::MetricUnit::kOperations,
+                        "Number of committed operations applied in a single batch.",
+                        100000, 2);
+
 namespace yb {
 namespace consensus {
 
@@ -76,15 +113,23 @@ ReplicaState::ReplicaState(
     ConsensusOptions options, string peer_uuid, std::unique_ptr<ConsensusMetadata> cmeta,
     ConsensusContext* consensus_context, SafeOpIdWaiter* safe_op_id_waiter,
     RetryableRequests* retryable_requests, const yb::OpId& split_op_id,
-    std::function<void(const OpIds&)> applied_ops_tracker)
+    std::function<void(const OpIds&)> applied_ops_tracker,
+    ThreadPoolToken* apply_pool_token,
+    const scoped_refptr<MetricEntity>& metric_entity)
     : options_(std::move(options)),
       peer_uuid_(std::move(peer_uuid)),
       cmeta_(std::move(cmeta)),
       context_(consensus_context),
       safe_op_id_waiter_(safe_op_id_waiter),
       split_op_id_(split_op_id),
-      applied_ops_tracker_(std::move(applied_ops_tracker)) {
+      applied_ops_tracker_(std::move(applied_ops_tracker)),
+      apply_pool_token_(apply_pool_token) {
   CHECK(cmeta_) << "ConsensusMeta passed as NULL";
+  if (metric_entity) {
+    follower_apply_lag_ops_ = METRIC_follower_apply_lag_ops.Instantiate(metric_entity, 0);
+    follower_apply_lag_ms_ = METRIC_follower_apply_lag_ms.Instantiate(metric_entity, 0);
+    follower_apply_batch_size_ = METRIC_follower_apply_batch_size.Instantiate(metric_entity);
+  }
   if (retryable_requests) {
     retryable_requests_ = std::move(*retryable_requests);
   }
@@ -94,11 +139,15 @@ ReplicaState::ReplicaState(
   // Actually we don't need this lock, but GetActiveRoleUnlocked checks that we are holding the
   // lock.
   auto lock = LockForRead();
+  UpdateIsWitnessUnlocked();
   CoarseTimePoint now;
   RefreshLeaderStateCacheUnlocked(&now);
 }
 
 ReplicaState::~ReplicaState() {
+  std::lock_guard<std::mutex> lock(apply_mutex_);
+  LOG_IF_WITH_PREFIX(DFATAL, apply_task_running_)
+      << "Destroying replica state with " << queued_applies_.size() << " queued applies";
 }
 
 Status ReplicaState::StartUnlocked(const OpId& last_id_in_wal) {
@@ -331,6 +380,7 @@ Status ReplicaState::SetPendingConfigUnlocked(const RaftConfigPB& new_config) {
       << "Existing pending config: " << cmeta_->pending_config().ShortDebugString() << "; "
       << "Attempted new pending config: " << new_config.ShortDebugString();
   cmeta_->set_pending_config(new_config);
+  UpdateIsWitnessUnlocked();
   CoarseTimePoint now;
   RefreshLeaderStateCacheUnlocked(&now);
   return Status::OK();
@@ -344,6 +394,7 @@ Status ReplicaState::ClearPendingConfigUnlocked() {
     return STATUS(IllegalState, "Attempt to clear a non-existent pending config.");
   }
   cmeta_->clear_pending_config();
+  UpdateIsWitnessUnlocked();
   CoarseTimePoint now;
   RefreshLeaderStateCacheUnlocked(&now);
   return Status::OK();
@@ -376,6 +427,7 @@ Status ReplicaState::SetCommittedConfigUnlocked(const RaftConfigPB& committed_co
 
   cmeta_->set_committed_config(committed_config);
   cmeta_->clear_pending_config();
+  UpdateIsWitnessUnlocked();
   CoarseTimePoint now;
   RefreshLeaderStateCacheUnlocked(&now);
   CHECK_OK(cmeta_->Flush());
@@ -875,6 +927,15 @@ Status ReplicaState::ApplyPendingOperationsUnlocked(
   OpIds applied_op_ids;
   applied_op_ids.reserve(committed_op_id.index - prev_id.index);
 
+  // Only WRITE_OP and UPDATE_TRANSACTION_OP are queued for asynchronous apply. Other operations
+  // are applied in place, unless earlier operations are still queued. Then they are queued as
+  // well, so all operations are applied in log order. The apply task applies NO_OP and
+  // CHANGE_CONFIG_OP under the lock, so nothing waits for the apply task while holding it.
+  const bool queue_all = apply_pool_token_ && ApplyTaskRunning();
+  const bool queue_writes = queue_all || ShouldQueueWritesUnlocked();
+  QueuedApplies queued_applies;
+  const auto now = CoarseMonoClock::Now();
+
   while (!pending_operations_.empty()) {
     auto round = pending_operations_.front();
     auto current_id = yb::OpId::FromPB(round->id());
@@ -906,6 +967,10 @@ Status ReplicaState::ApplyPendingOperationsUnlocked(
              Format("Bad max allowed: $0, while current: $1", max_allowed_op_id, current_id));
     }
 
+    const bool queue = queue_all || !queued_applies.empty() ||
+        (queue_writes &&
+         (type == OperationType::WRITE_OP || type == OperationType::UPDATE_TRANSACTION_OP));
+
     pending_operations_.pop_front();
     // Set committed configuration.
     if (PREDICT_FALSE(type == OperationType::CHANGE_CONFIG_OP)) {
@@ -913,16 +978,144 @@ Status ReplicaState::ApplyPendingOperationsUnlocked(
     }
 
     prev_id = current_id;
-    NotifyReplicationFinishedUnlocked(round, Status::OK(), leader_term, &applied_op_ids);
+    if (queue) {
+      retryable_requests_.ReplicationFinished(*round->replicate_msg(), Status::OK(), leader_term);
+      queued_applies.push_back(QueuedApply{round, leader_term, now});
+    } else {
+      NotifyReplicationFinishedUnlocked(round, Status::OK(), leader_term, &applied_op_ids);
+    }
   }
 
   SetLastCommittedIndexUnlocked(prev_id);
 
   applied_ops_tracker_(applied_op_ids);
 
+  if (!queued_applies.empty()) {
+    QueueAppliesUnlocked(&queued_applies);
+  }
+
   return Status::OK();
 }
 
+bool ReplicaState::ApplyTaskRunning() const {
+  // Operations should be applied in log order, so when there are queued operations, following
+  // operations should be queued as well. Even if we became leader meanwhile.
+  std::lock_guard<std::mutex> lock(apply_mutex_);
+  return apply_task_running_;
+}
+
+bool ReplicaState::ShouldQueueWritesUnlocked() const {
+  return apply_pool_token_ && GetAtomicFlag(&FLAGS_follower_apply_async) &&
+         GetActiveRoleUnlocked() != RaftPeerPB::LEADER;
+}
+
+bool ReplicaState::ApplyQueueFull() const {
+  const auto max_queued_ops = GetAtomicFlag(&FLAGS_follower_apply_max_queued_ops);
+  if (!apply_pool_token_ || max_queued_ops <= 0) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(apply_mutex_);
+  return num_unapplied_ops_ >= static_cast<size_t>(max_queued_ops);
+}
+
+void ReplicaState::QueueAppliesUnlocked(QueuedApplies* applies) {
+  if (follower_apply_lag_ops_) {
+    follower_apply_lag_ops_->IncrementBy(applies->size());
+  }
+  {
+    std::lock_guard<std::mutex> lock(apply_mutex_);
+    num_unapplied_ops_ += applies->size();
+    if (queued_applies_.empty()) {
+      queued_applies_.swap(*applies);
+    } else {
+      queued_applies_.insert(queued_applies_.end(),
+                             std::make_move_iterator(applies->begin()),
+                             std::make_move_iterator(applies->end()));
+    }
+    if (apply_task_running_) {
+      return;
+    }
+    apply_task_running_ = true;
+  }
+
+  auto status = apply_pool_token_->SubmitFunc(
+      std::bind(&ReplicaState::ApplyQueuedOperations, this, false /* holding_lock */));
+  if (!status.ok()) {
+    // Could happen only during shutdown, apply operations in place.
+    LOG_WITH_PREFIX(WARNING) << "Failed to submit apply task: " << status;
+    ApplyQueuedOperations(true /* holding_lock */);
+  }
+}
+
+void ReplicaState::ApplyQueuedOperations(bool holding_lock) {
+  QueuedApplies applies;
+  OpIds applied_op_ids;
+  for (;;) {
+    applies.clear();
+    {
+      std::lock_guard<std::mutex> lock(apply_mutex_);
+      if (queued_applies_.empty()) {
+        apply_task_running_ = false;
+        if (follower_apply_lag_ms_) {
+          follower_apply_lag_ms_->set_value(0);
+        }
+        apply_cond_.notify_all();
+        return;
+      }
+      applies.swap(queued_applies_);
+    }
+
+    if (follower_apply_lag_ms_) {
+      follower_apply_lag_ms_->set_value(
+          ToMilliseconds(CoarseMonoClock::Now() - applies.front().committed_at));
+    }
+    if (follower_apply_batch_size_) {
+      follower_apply_batch_size_->Increment(applies.size());
+    }
+
+    applied_op_ids.clear();
+    applied_op_ids.reserve(applies.size());
+    for (const auto& apply : applies) {
+      const auto type = apply.round->replicate_msg()->op_type();
+      UniqueLock lock;
+      if (!holding_lock &&
+          (type == OperationType::NO_OP || type == OperationType::CHANGE_CONFIG_OP)) {
+        // Such operations modify replica state, so they are applied under its lock. It is safe,
+        // because the lock holders never wait for the apply task.
+        lock = LockForRead();
+      }
+      apply.round->NotifyReplicationFinished(Status::OK(), apply.leader_term, &applied_op_ids);
+    }
+    applied_ops_tracker_(applied_op_ids);
+    num_async_applied_ops_.fetch_add(applies.size(), std::memory_order_acq_rel);
+
+    if (follower_apply_lag_ops_) {
+      follower_apply_lag_ops_->DecrementBy(applies.size());
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(apply_mutex_);
+      num_unapplied_ops_ -= applies.size();
+    }
+    apply_cond_.notify_all();
+  }
+}
+
+void ReplicaState::WaitForQueuedAppliesToComplete() {
+  ThreadRestrictions::AssertWaitAllowed();
+  std::unique_lock<std::mutex> lock(apply_mutex_);
+  apply_cond_.wait(lock, [this] { return !apply_task_running_; });
+}
+
+size_t ReplicaState::NumQueuedApplies() const {
+  std::lock_guard<std::mutex> lock(apply_mutex_);
+  return num_unapplied_ops_;
+}
+
+size_t ReplicaState::TEST_NumAsyncAppliedOps() const {
+  return num_async_applied_ops_.load(std::memory_order_acquire);
+}
+
 void ReplicaState::ApplyConfigChangeUnlocked(const ConsensusRoundPtr& round) {
   DCHECK(round->replicate_msg()->change_config_record().has_old_config());
   DCHECK(round->replicate_msg()->change_config_record().has_new_config());
@@ -1317,7 +1510,40 @@ yb::OpId ReplicaState::MinRetryableRequestOpId() {
   if (!status.ok()) {
     return yb::OpId(); // return minimal op id, that prevents log from cleaning
   }
-  return retryable_requests_.CleanExpiredReplicatedAndGetMinOpId();
+  // Requests covered by the flushed snapshot do not need the log anymore.
+  return std::max(retryable_requests_.CleanExpiredReplicatedAndGetMinOpId(),
+                  retryable_requests_flushed_op_id_);
+}
+
+void ReplicaState::FlushRetryableRequests() {
+  RetryableRequestsPB retryable_requests_pb;
+  {
+    UniqueLock lock;
+    if (!LockForUpdate(&lock).ok()) {
+      return;
+    }
+    auto flush_interval_ms = GetAtomicFlag(&FLAGS_retryable_requests_flush_interval_ms);
+    auto now = CoarseMonoClock::Now();
+    if (flush_interval_ms <= 0 || now < retryable_requests_next_flush_time_) {
+      return;
+    }
+    retryable_requests_next_flush_time_ = now + flush_interval_ms * 1ms;
+    retryable_requests_.ToPB(&retryable_requests_pb);
+    if (yb::OpId::FromPB(retryable_requests_pb.last_op_id()) <=
+            retryable_requests_flushed_op_id_) {
+      return;
+    }
+  }
+
+  // Write the file without holding the lock, cmeta_ pointer does not change after Init.
+  auto status = cmeta_->FlushRetryableRequests(retryable_requests_pb);
+  if (!status.ok()) {
+    LOG_WITH_PREFIX(WARNING) << "Failed to flush retryable requests: " << status;
+    return;
+  }
+  auto lock = LockForRead();
+  retryable_requests_flushed_op_id_ = std::max(
+      retryable_requests_flushed_op_id_, yb::OpId::FromPB(retryable_requests_pb.last_op_id()));
 }
 
 void ReplicaState::NotifyReplicationFinishedUnlocked(
@@ -1345,6 +1571,11 @@ consensus::LeaderState ReplicaState::RefreshLeaderStateCacheUnlocked(CoarseTimeP
   return result;
 }
 
+void ReplicaState::UpdateIsWitnessUnlocked() {
+  is_witness_.store(IsRaftConfigWitness(peer_uuid_, cmeta_->active_config()),
+                    std::memory_order_release);
+}
+
 void ReplicaState::SetLeaderNoOpCommittedUnlocked(bool value) {
   LOG_WITH_PREFIX(INFO)
       << __func__ << "(" << value << "), committed: " << GetCommittedOpIdUnlocked()
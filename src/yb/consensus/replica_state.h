@@ -33,6 +33,7 @@
 #define YB_CONSENSUS_REPLICA_STATE_H
 
 #include <atomic>
+#include <condition_variable>
 #include <deque>
 #include <mutex>
 #include <string>
@@ -51,6 +52,7 @@
 #include "yb/consensus/leader_lease.h"
 #include "yb/gutil/port.h"
 #include "yb/util/locks.h"
+#include "yb/util/metrics.h"
 #include "yb/util/status.h"
 #include "yb/util/enums.h"
 
@@ -59,6 +61,7 @@ namespace yb {
 class HostPort;
 class ReplicaState;
 class ThreadPool;
+class ThreadPoolToken;
 
 namespace consensus {
 
@@ -114,11 +117,15 @@ class ReplicaState {
   typedef std::unique_lock<std::mutex> UniqueLock;
 
   // split_op_id is the ID of Raft split operation requesting split of this tablet or unset.
+  // If apply_pool_token is specified, it should be a serial token that is used to apply
+  // committed operations on followers asynchronously, see follower_apply_async.
   ReplicaState(
       ConsensusOptions options, std::string peer_uuid, std::unique_ptr<ConsensusMetadata> cmeta,
       ConsensusContext* consensus_context, SafeOpIdWaiter* safe_op_id_waiter,
       RetryableRequests* retryable_requests, const yb::OpId& split_op_id,
-      std::function<void(const OpIds&)> applied_ops_tracker);
+      std::function<void(const OpIds&)> applied_ops_tracker,
+      ThreadPoolToken* apply_pool_token = nullptr,
+      const scoped_refptr<MetricEntity>& metric_entity = nullptr);
 
   ~ReplicaState();
 
@@ -194,6 +201,11 @@ class ReplicaState {
   // committed.
   bool IsConfigChangePendingUnlocked() const;
 
+  // Whether the local peer is a witness in the active config.
+  bool IsWitness() const {
+    return is_witness_.load(std::memory_order_acquire);
+  }
+
   // Inverse of IsConfigChangePendingUnlocked(): returns OK if there is
   // currently *no* configuration change pending, and IllegalState is there *is* a
   // configuration change pending.
@@ -327,6 +339,19 @@ class ReplicaState {
   // to complete. This does not cancel transactions being applied.
   CHECKED_STATUS CancelPendingOperations();
 
+  // Waits until all committed operations queued for asynchronous apply are applied.
+  void WaitForQueuedAppliesToComplete();
+
+  // Returns the number of committed operations queued for asynchronous apply and not yet applied.
+  size_t NumQueuedApplies() const;
+
+  // Returns true if follower_apply_max_queued_ops committed operations are waiting for
+  // asynchronous apply, so new operations should not be accepted from the leader.
+  bool ApplyQueueFull() const;
+
+  // Returns the number of operations applied by the asynchronous apply task.
+  size_t TEST_NumAsyncAppliedOps() const;
+
   // API to dump pending transactions. Added to debug ENG-520.
   void DumpPendingOperationsUnlocked();
 
@@ -407,8 +432,14 @@ class ReplicaState {
   // The on-disk size of the consensus metadata.
   uint64_t OnDiskSize() const;
 
+  // Returns min op id that should be retained in the log for retryable requests.
   yb::OpId MinRetryableRequestOpId();
 
+  // Persists a snapshot of replicated retryable requests if retryable_requests_flush_interval_ms
+  // passed since the previous one. Performs synced IO, so should not be invoked from a reactor or
+  // while holding the replica state lock.
+  void FlushRetryableRequests();
+
   RestartSafeCoarseMonoClock& Clock();
 
   RetryableRequestsCounts TEST_CountRetryableRequests();
@@ -435,9 +466,35 @@ class ReplicaState {
       const ConsensusRoundPtr& round, const Status& status, int64_t leader_term,
       OpIds* applied_op_ids);
 
+  struct QueuedApply {
+    ConsensusRoundPtr round;
+    int64_t leader_term;
+    CoarseTimePoint committed_at;
+  };
+  typedef std::vector<QueuedApply> QueuedApplies;
+
+  // Returns true if the apply task is submitted or running, i.e. all committed operations should
+  // be queued.
+  bool ApplyTaskRunning() const;
+
+  // Returns true if committed write operations should be queued for asynchronous apply instead
+  // of being applied by the caller.
+  bool ShouldQueueWritesUnlocked() const;
+
+  // Queues committed operations for asynchronous apply, starting apply task if necessary.
+  void QueueAppliesUnlocked(QueuedApplies* applies);
+
+  // Apply task, applies queued operations in batches until the queue is empty.
+  // holding_lock is true when it is invoked in place by a holder of the replica state lock.
+  void ApplyQueuedOperations(bool holding_lock);
+
   consensus::LeaderState RefreshLeaderStateCacheUnlocked(
       CoarseTimePoint* now) const ATTRIBUTE_NONNULL(2);
 
+  // Updates is_witness_ from the active config. Should be called before refreshing leader state
+  // cache whenever the active config changes.
+  void UpdateIsWitnessUnlocked();
+
   PendingOperations::iterator FindPendingOperation(int64_t index);
 
   const ConsensusOptions options_;
@@ -526,12 +583,46 @@ class ReplicaState {
 
   RetryableRequests retryable_requests_;
 
+  // Op id of the last flushed snapshot of retryable requests, and when to flush the next one.
+  yb::OpId retryable_requests_flushed_op_id_;
+  CoarseTimePoint retryable_requests_next_flush_time_;
+
+  std::atomic<bool> is_witness_{false};
+
   // This leader is ready to serve only if NoOp was successfully committed
   // after the new leader successful election.
   bool leader_no_op_committed_ = false;
 
   std::function<void(const OpIds&)> applied_ops_tracker_;
 
+  // Serial token used to apply committed operations asynchronously, could be null.
+  ThreadPoolToken* const apply_pool_token_;
+
+  mutable std::mutex apply_mutex_;
+  std::condition_variable apply_cond_;
+
+  // Committed operations waiting for asynchronous apply, in log order.
+  QueuedApplies queued_applies_;
+
+  // Whether apply task is submitted or running. While it is set, all committed operations should
+  // be queued, so they are applied in log order.
+  bool apply_task_running_ = false;
+
+  // Number of queued operations that are not applied yet, including the batch that is being
+  // applied by the apply task.
+  size_t num_unapplied_ops_ = 0;
+
+  std::atomic<size_t> num_async_applied_ops_{0};
+
+  // Number of committed operations that are not applied yet.
+  scoped_refptr<AtomicGauge<int64_t>> follower_apply_lag_ops_;
+
+  // Time passed since the oldest not yet applied operation was committed.
+  scoped_refptr<AtomicGauge<int64_t>> follower_apply_lag_ms_;
+
+  // Number of operations applied by a single iteration of the apply task.
+  scoped_refptr<Histogram> follower_apply_batch_size_;
+
   struct LeaderStateCache {
     static constexpr size_t kStatusBits = 3;
     static_assert(kLeaderStatusMapSize <= (1 << kStatusBits),
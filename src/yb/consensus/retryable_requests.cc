@@ -20,6 +20,7 @@
 
 #include "yb/common/wire_protocol.h"
 #include "yb/consensus/consensus.h"
+#include "yb/consensus/metadata.pb.h"
 
 #include "yb/util/atomic.h"
 #include "yb/util/metrics.h"
@@ -344,6 +345,11 @@ class RetryableRequests::Impl {
       return;
     }
 
+    if (data.op_id() <= restored_op_id_) {
+      // Already restored from snapshot.
+      return;
+    }
+
     auto& client_retryable_requests = clients_[data.client_id()];
     auto& running_indexed_by_request_id = client_retryable_requests.running.get<RequestIdIndex>();
     if (running_indexed_by_request_id.count(data.request_id()) != 0) {
@@ -367,6 +373,59 @@ class RetryableRequests::Impl {
     return clock_;
   }
 
+  void ToPB(RetryableRequestsPB* pb) const {
+    last_replicated_op_id_.ToPB(pb->mutable_last_op_id());
+    for (const auto& p : clients_) {
+      if (p.second.replicated.empty()) {
+        continue;
+      }
+      auto* client = pb->add_clients();
+      auto client_id = p.first.ToUInt64Pair();
+      client->set_client_id1(client_id.first);
+      client->set_client_id2(client_id.second);
+      client->set_min_running_request_id(p.second.min_running_request_id);
+      for (const auto& range : p.second.replicated) {
+        auto* range_pb = client->add_ranges();
+        range_pb->set_first_id(range.first_id);
+        range_pb->set_last_id(range.last_id);
+        range.min_op_id.ToPB(range_pb->mutable_min_op_id());
+        range_pb->set_min_time(range.min_time.ToUInt64());
+        range_pb->set_max_time(range.max_time.ToUInt64());
+      }
+    }
+  }
+
+  CHECKED_STATUS FromPB(const RetryableRequestsPB& pb) {
+    SCHECK(clients_.empty(), IllegalState, "Retryable requests already loaded");
+    // Build into a separate map, so a corrupted snapshot leaves the state untouched.
+    decltype(clients_) clients;
+    size_t num_ranges = 0;
+    for (const auto& client : pb.clients()) {
+      auto& client_retryable_requests =
+          clients[ClientId(client.client_id1(), client.client_id2())];
+      client_retryable_requests.min_running_request_id = client.min_running_request_id();
+      for (const auto& range_pb : client.ranges()) {
+        ReplicatedRetryableRequestRange range(
+            range_pb.first_id(), yb::OpId::FromPB(range_pb.min_op_id()),
+            RestartSafeCoarseTimePoint::FromUInt64(range_pb.min_time()));
+        range.last_id = range_pb.last_id();
+        range.InsertTime(RestartSafeCoarseTimePoint::FromUInt64(range_pb.max_time()));
+        if (!client_retryable_requests.replicated.insert(range).second) {
+          return STATUS_FORMAT(Corruption, "Duplicate retryable request range: $0", range);
+        }
+        ++num_ranges;
+      }
+    }
+    clients_ = std::move(clients);
+    if (replicated_request_ranges_gauge_) {
+      replicated_request_ranges_gauge_->IncrementBy(num_ranges);
+    }
+    restored_op_id_ = yb::OpId::FromPB(pb.last_op_id());
+    last_replicated_op_id_ = restored_op_id_;
+    VLOG_WITH_PREFIX(1) << "Restored " << clients_.size() << " clients up to " << restored_op_id_;
+    return Status::OK();
+  }
+
   void SetMetricEntity(const scoped_refptr<MetricEntity>& metric_entity) {
     running_requests_gauge_ = METRIC_running_retryable_requests.Instantiate(metric_entity, 0);
     replicated_request_ranges_gauge_ = METRIC_replicated_retryable_request_ranges.Instantiate(
@@ -411,6 +470,7 @@ class RetryableRequests::Impl {
 
   void AddReplicated(yb::OpId op_id, const ReplicateData& data, RestartSafeCoarseTimePoint time,
                      ClientRetryableRequests* client) {
+    last_replicated_op_id_ = std::max(last_replicated_op_id_, op_id);
     auto request_id = data.request_id();
     auto& replicated_indexed_by_last_id = client->replicated.get<LastIdIndex>();
     auto request_it = replicated_indexed_by_last_id.lower_bound(request_id);
@@ -532,6 +592,10 @@ class RetryableRequests::Impl {
   const std::string log_prefix_;
   std::unordered_map<ClientId, ClientRetryableRequests, ClientIdHash> clients_;
   RestartSafeCoarseMonoClock clock_;
+  // Op id of the last replicated request.
+  yb::OpId last_replicated_op_id_;
+  // Op id of the snapshot this state was restored from.
+  yb::OpId restored_op_id_;
   scoped_refptr<AtomicGauge<int64_t>> running_requests_gauge_;
   scoped_refptr<AtomicGauge<int64_t>> replicated_request_ranges_gauge_;
 };
@@ -572,6 +636,14 @@ RestartSafeCoarseMonoClock& RetryableRequests::Clock() {
   return impl_->Clock();
 }
 
+void RetryableRequests::ToPB(RetryableRequestsPB* pb) const {
+  impl_->ToPB(pb);
+}
+
+Status RetryableRequests::FromPB(const RetryableRequestsPB& pb) {
+  return impl_->FromPB(pb);
+}
+
 RetryableRequestsCounts RetryableRequests::TEST_Counts() {
   return impl_->TEST_Counts();
 }
@@ -26,6 +26,8 @@ struct OpId;
 
 namespace consensus {
 
+class RetryableRequestsPB;
+
 struct RetryableRequestsCounts {
   size_t running = 0;
   size_t replicated = 0;
@@ -58,6 +60,13 @@ class RetryableRequests {
 
   RestartSafeCoarseMonoClock& Clock();
 
+  // Fills snapshot of replicated requests, running requests are not included.
+  void ToPB(RetryableRequestsPB* pb) const;
+
+  // Restores replicated requests from snapshot, should be invoked before tablet bootstrap.
+  // Requests with op id not greater than snapshot op id are ignored by Bootstrap after that.
+  CHECKED_STATUS FromPB(const RetryableRequestsPB& pb);
+
   // Returns number or running requests and number of ranges of replicated requests.
   RetryableRequestsCounts TEST_Counts();
 
@@ -2677,6 +2677,30 @@ TEST_F(DocDBTest, MergingIterator) {
   VerifySubDocument(SubDocKey(key2), ht, "\"value2\"");
 }
 
+TEST_F(DocDBTest, StrongIntentKeyRange) {
+  KeyValueWriteBatchPB put_batch;
+  ASSERT_TRUE(StrongIntentKeyRange(put_batch).end.empty());
+
+  DocKey key1(123, PrimitiveValues("key1"), PrimitiveValues());
+  DocKey key2(234, PrimitiveValues("key2"), PrimitiveValues());
+  auto key1_encoded = key1.Encode().ToStringBuffer();
+  auto key2_encoded = key2.Encode().ToStringBuffer();
+  for (const auto& key : {SubDocKey(key2, PrimitiveValue("subkey")).Encode(),
+                          SubDocKey(key1).Encode()}) {
+    put_batch.add_write_pairs()->set_key(key.ToStringBuffer());
+  }
+
+  auto range = StrongIntentKeyRange(put_batch);
+  ASSERT_EQ(key1_encoded, range.begin);
+  ASSERT_EQ(key2_encoded + ValueTypeAsChar::kMaxByte, range.end);
+
+  put_batch.add_write_pairs()->set_key(std::string());
+  range = StrongIntentKeyRange(put_batch);
+  auto whole_range = WholeIntentKeyRange();
+  ASSERT_EQ(whole_range.begin, range.begin);
+  ASSERT_EQ(whole_range.end, range.end);
+}
+
 TEST_F(DocDBTest, SetPrimitiveWithInitMarker) {
   // Both required and optional init marker should be ok.
   for (auto init_marker_behavior : kInitMarkerBehaviorList) {
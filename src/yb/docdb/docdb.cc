@@ -767,6 +767,38 @@ void PrepareTransactionWriteBatch(
   helper.Finish();
 }
 
+IntentKeyRange StrongIntentKeyRange(const KeyValueWriteBatchPB& put_batch) {
+  IntentKeyRange result;
+  for (const auto& kv_pair : put_batch.write_pairs()) {
+    // All intents for subkeys of the document are placed between the encoded doc key and the
+    // encoded doc key followed by kMaxByte.
+    const Slice key(kv_pair.key());
+    auto doc_key_size = DocKey::EncodedSize(key, DocKeyPart::kWholeDocKey);
+    if (!doc_key_size.ok() || *doc_key_size == 0) {
+      return WholeIntentKeyRange();
+    }
+    const Slice doc_key(key.data(), *doc_key_size);
+    if (result.end.empty()) {
+      result.begin = doc_key.ToBuffer();
+      result.end = result.begin;
+      result.end.push_back(ValueTypeAsChar::kMaxByte);
+      continue;
+    }
+    if (doc_key.compare(result.begin) < 0) {
+      result.begin = doc_key.ToBuffer();
+    }
+    if (doc_key.compare(result.end) >= 0) {
+      result.end = doc_key.ToBuffer();
+      result.end.push_back(ValueTypeAsChar::kMaxByte);
+    }
+  }
+  return result;
+}
+
+IntentKeyRange WholeIntentKeyRange() {
+  return IntentKeyRange{std::string(), std::string(1, ValueTypeAsChar::kHighest)};
+}
+
 // ------------------------------------------------------------------------------------------------
 // Standalone functions
 // ------------------------------------------------------------------------------------------------
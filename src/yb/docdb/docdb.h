@@ -189,6 +189,13 @@ void PrepareTransactionWriteBatch(
     const Slice& replicated_batches_state,
     IntraTxnWriteId* write_id);
 
+// Returns range of intent keys that contains strong intents written by
+// PrepareTransactionWriteBatch for put_batch.
+IntentKeyRange StrongIntentKeyRange(const docdb::KeyValueWriteBatchPB& put_batch);
+
+// Returns range that contains all intent keys.
+IntentKeyRange WholeIntentKeyRange();
+
 CHECKED_STATUS PrepareApplyIntentsBatch(
     const TransactionId& transaction_id, HybridTime commit_ht, const KeyBounds* key_bounds,
     rocksdb::WriteBatch* regular_batch,
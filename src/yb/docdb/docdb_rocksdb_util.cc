@@ -480,7 +480,9 @@ void InitRocksDBOptions(
     options->compaction_options_universal.min_merge_width =
         FLAGS_rocksdb_universal_compaction_min_merge_width;
     options->compaction_size_threshold_bytes = FLAGS_rocksdb_compaction_size_threshold_bytes;
-    if (FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec > 0) {
+    if (tablet_options.rate_limiter) {
+      options->rate_limiter = tablet_options.rate_limiter;
+    } else if (FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec > 0) {
       options->rate_limiter.reset(
           rocksdb::NewGenericRateLimiter(FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec));
     }
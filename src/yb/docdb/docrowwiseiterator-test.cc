@@ -1223,5 +1223,84 @@ TEST_F(DocRowwiseIteratorTest, ScanWithinTheSameTxn) {
   ASSERT_EQ(intents_db_options_.statistics->getTickerCount(rocksdb::Tickers::NUMBER_DB_SEEK), 6);
 }
 
+TEST_F(DocRowwiseIteratorTest, SkipIntentSeekOutsideLiveIntentKeyRanges) {
+  SetTransactionIsolationLevel(IsolationLevel::SNAPSHOT_ISOLATION);
+
+  TransactionStatusManagerMock txn_status_manager;
+
+  Result<TransactionId> txn = FullyDecodeTransactionId("0000000000000001");
+  ASSERT_OK(txn);
+
+  SetCurrentTransactionId(*txn);
+  ASSERT_OK(SetPrimitive(
+      DocPath(kEncodedDocKey1, PrimitiveValue(30_ColId)),
+      PrimitiveValue("row1_c_t1"), HybridTime::FromMicros(500)));
+  ASSERT_OK(SetPrimitive(
+      DocPath(kEncodedDocKey2, PrimitiveValue(30_ColId)),
+      PrimitiveValue("row2_c_t1"), HybridTime::FromMicros(500)));
+
+  ResetCurrentTransactionId();
+  ASSERT_OK(SetPrimitive(
+      DocPath(kEncodedDocKey1, PrimitiveValue(40_ColId)),
+      PrimitiveValue(10000), HybridTime::FromMicros(1000)));
+  ASSERT_OK(SetPrimitive(
+      DocPath(kEncodedDocKey2, PrimitiveValue(40_ColId)),
+      PrimitiveValue(20000), HybridTime::FromMicros(1000)));
+
+  const auto txn_context = TransactionOperationContext(*txn, &txn_status_manager);
+  const Schema &projection = kProjectionForIteratorTests;
+  auto* statistics = intents_db_options_.statistics.get();
+
+  // Scans all rows and returns values of column 30 and number of intents DB seeks performed.
+  auto scan = [&]() -> Result<std::pair<std::vector<std::string>, uint64_t>> {
+    auto seeks_before = statistics->getTickerCount(rocksdb::Tickers::NUMBER_DB_SEEK);
+    DocRowwiseIterator iter(
+        projection, kSchemaForIteratorTests, txn_context, doc_db(),
+        CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(2000));
+    RETURN_NOT_OK(iter.Init());
+    std::vector<std::string> result;
+    QLTableRow row;
+    QLValue value;
+    while (VERIFY_RESULT(iter.HasNext())) {
+      RETURN_NOT_OK(iter.NextRow(&row));
+      RETURN_NOT_OK(row.GetValue(projection.column_id(0), &value));
+      result.push_back(value.IsNull() ? "null" : value.string_value());
+    }
+    return std::make_pair(
+        result, statistics->getTickerCount(rocksdb::Tickers::NUMBER_DB_SEEK) - seeks_before);
+  };
+
+  auto doc_key_range = [](const KeyBytes& doc_key) {
+    IntentKeyRange range{doc_key.ToStringBuffer(), doc_key.ToStringBuffer()};
+    range.end.push_back(ValueTypeAsChar::kMaxByte);
+    return range;
+  };
+
+  // Ranges are unknown, so intents DB is always checked.
+  auto full_scan = ASSERT_RESULT(scan());
+  ASSERT_EQ(full_scan.first, std::vector<std::string>({"row1_c_t1", "row2_c_t1"}));
+
+  // Live intents are inside of the ranges, so the same data is read.
+  txn_status_manager.SetLiveIntentKeyRanges(std::make_shared<IntentKeyRanges>(
+      IntentKeyRanges{doc_key_range(kEncodedDocKey1), doc_key_range(kEncodedDocKey2)}));
+  auto covered_scan = ASSERT_RESULT(scan());
+  ASSERT_EQ(covered_scan.first, full_scan.first);
+  ASSERT_LE(covered_scan.second, full_scan.second);
+
+  // Intents of the second row are outside of the ranges, so they are not looked up. Real ranges
+  // always cover live intents, here it is used to check that seeks are actually skipped.
+  txn_status_manager.SetLiveIntentKeyRanges(std::make_shared<IntentKeyRanges>(
+      IntentKeyRanges{doc_key_range(kEncodedDocKey1)}));
+  auto partial_scan = ASSERT_RESULT(scan());
+  ASSERT_EQ(partial_scan.first, std::vector<std::string>({"row1_c_t1", "null"}));
+  ASSERT_LT(partial_scan.second, full_scan.second);
+
+  // No live intents at all.
+  txn_status_manager.SetLiveIntentKeyRanges(std::make_shared<IntentKeyRanges>());
+  auto empty_scan = ASSERT_RESULT(scan());
+  ASSERT_EQ(empty_scan.first, std::vector<std::string>({"null", "null"}));
+  ASSERT_LE(empty_scan.second, partial_scan.second);
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -13,6 +13,7 @@
 
 #include "yb/docdb/intent_aware_iterator.h"
 
+#include <algorithm>
 #include <future>
 #include <thread>
 #include <boost/optional/optional_io.hpp>
@@ -303,6 +304,7 @@ IntentAwareIterator::IntentAwareIterator(
                                                 rocksdb::kDefaultQueryId,
                                                 nullptr /* file_filter */,
                                                 &intent_upperbound_);
+    intent_key_ranges_ = txn_op_context->txn_status_manager.LiveIntentKeyRanges();
   }
   // WARNING: Is is important for regular DB iterator to be created after intents DB iterator,
   // otherwise consistency could break, for example in following scenario:
@@ -435,6 +437,7 @@ void IntentAwareIterator::SeekToLastDocKey() {
   iter_.SeekToLast();
   SkipFutureRecords(Direction::kBackward);
   if (intent_iter_.Initialized()) {
+    intent_seek_deferred_ = false;
     ResetIntentUpperbound();
     intent_iter_.SeekToLast();
     SeekToSuitableIntent<Direction::kBackward>();
@@ -494,6 +497,7 @@ Status IntentAwareIterator::NextFullValue(
 
   found_record = false;
   if (intent_iter_.Initialized()) {
+    SeekIntentIterIfDeferred();
     while ((found_record = IsIntentForTheSameKey(intent_iter_.key(), key_data.key)) &&
            IsMergeRecord(v = intent_iter_.value())) {
       intent_iter_.Next();
@@ -526,6 +530,7 @@ bool IntentAwareIterator::PreparePrev(const Slice& key) {
   SkipFutureRecords(Direction::kBackward);
 
   if (intent_iter_.Initialized()) {
+    intent_seek_deferred_ = false;
     ResetIntentUpperbound();
     ROCKSDB_SEEK(&intent_iter_, GetIntentPrefixForKeyWithoutHt(key));
     if (intent_iter_.Valid()) {
@@ -590,6 +595,49 @@ void IntentAwareIterator::SeekToLatestDocKeyInternal() {
   Seek(Slice(subdockey_slice.data(), *dockey_size));
 }
 
+bool IntentAwareIterator::SkipIntentSeek(const Slice& key) {
+  if (!intent_key_ranges_) {
+    return false;
+  }
+  // When seek is already deferred, intent iterator is logically positioned at the deferred key,
+  // so forward seek to smaller key would not move it.
+  const Slice target =
+      intent_seek_deferred_ && deferred_intent_seek_key_.AsSlice().compare(key) > 0
+          ? deferred_intent_seek_key_.AsSlice() : key;
+  // Find first range that ends after target.
+  auto it = std::upper_bound(
+      intent_key_ranges_->begin(), intent_key_ranges_->end(), target,
+      [](const Slice& lhs, const IntentKeyRange& rhs) { return lhs.compare(rhs.end) < 0; });
+  if (it != intent_key_ranges_->end()) {
+    // Suitable intent could not be placed before start of the range.
+    const Slice range_begin(it->begin);
+    const Slice next_intent_key = target.compare(range_begin) < 0 ? range_begin : target;
+    if ((intent_upperbound_.empty() || next_intent_key.compare(intent_upperbound_) < 0) &&
+        SatisfyBounds(next_intent_key)) {
+      return false;
+    }
+  }
+  VLOG(4) << __func__ << "(" << target.ToDebugHexString() << "), no intents till "
+          << (it != intent_key_ranges_->end() ? Slice(it->begin).ToDebugHexString() : "end");
+  if (!intent_seek_deferred_ || target.data() != deferred_intent_seek_key_.data()) {
+    deferred_intent_seek_key_.Reset(target);
+    intent_seek_deferred_ = true;
+  }
+  resolved_intent_state_ = ResolvedIntentState::kNoIntent;
+  resolved_intent_txn_dht_ = DocHybridTime::kMin;
+  intent_dht_from_same_txn_ = DocHybridTime::kMin;
+  return true;
+}
+
+void IntentAwareIterator::SeekIntentIterIfDeferred() {
+  if (!intent_seek_deferred_) {
+    return;
+  }
+  intent_seek_deferred_ = false;
+  VLOG(4) << __func__ << ", seek: " << DebugDumpKeyToStr(deferred_intent_seek_key_);
+  ROCKSDB_SEEK(&intent_iter_, deferred_intent_seek_key_);
+}
+
 void IntentAwareIterator::SeekIntentIterIfNeeded() {
   if (seek_intent_iter_needed_ == SeekIntentIterNeeded::kNoNeed || !status_.ok()) {
     return;
@@ -603,9 +651,13 @@ void IntentAwareIterator::SeekIntentIterIfNeeded() {
       break;
     case SeekIntentIterNeeded::kSeek:
       VLOG(4) << __func__ << ", seek: " << SubDocKey::DebugSliceToString(seek_key_buffer_);
+      seek_intent_iter_needed_ = SeekIntentIterNeeded::kNoNeed;
+      intent_seek_deferred_ = false;
+      if (SkipIntentSeek(seek_key_buffer_.AsSlice())) {
+        return;
+      }
       ROCKSDB_SEEK(&intent_iter_, seek_key_buffer_);
       SeekToSuitableIntent<Direction::kForward>();
-      seek_intent_iter_needed_ = SeekIntentIterNeeded::kNoNeed;
       return;
     case SeekIntentIterNeeded::kSeekForward:
       SeekForwardToSuitableIntent();
@@ -769,6 +821,14 @@ void IntentAwareIterator::SeekForwardToSuitableIntent() {
     }
   }
 
+  if (SkipIntentSeek(seek_key_buffer_.AsSlice())) {
+    return;
+  }
+  if (intent_seek_deferred_ && deferred_intent_seek_key_.CompareTo(seek_key_buffer_) < 0) {
+    // Deferred seek is superseded by seek to the further key.
+    intent_seek_deferred_ = false;
+  }
+  SeekIntentIterIfDeferred();
   docdb::SeekForward(seek_key_buffer_.AsSlice(), &intent_iter_);
   SeekToSuitableIntent<Direction::kForward>();
 }
@@ -1127,6 +1187,12 @@ void IntentAwareIterator::SkipFutureIntents() {
       return;
     }
   }
+  if (intent_seek_deferred_) {
+    if (SkipIntentSeek(deferred_intent_seek_key_.AsSlice())) {
+      return;
+    }
+    SeekIntentIterIfDeferred();
+  }
   SeekToSuitableIntent<Direction::kForward>();
 }
 
@@ -268,6 +268,15 @@ class IntentAwareIterator {
 
   void SeekIntentIterIfNeeded();
 
+  // Checks whether intent iterator seek to the specified key could be skipped, because there are
+  // no suitable intents between key and intent iterator bounds according to intent_key_ranges_.
+  // In this case resolved intent is reset and seek is deferred till intent iterator is actually
+  // used. Returns true if seek was skipped.
+  bool SkipIntentSeek(const Slice& key);
+
+  // Performs intent iterator seek deferred by SkipIntentSeek, if any.
+  void SeekIntentIterIfDeferred();
+
   // Does initial steps for prev doc key/sub doc key seek.
   // Returns true if prepare succeed.
   bool PreparePrev(const Slice& key);
@@ -332,6 +341,13 @@ class IntentAwareIterator {
   // Reusable buffer to prepare seek key to avoid reallocating temporary buffers in critical paths.
   KeyBytes seek_key_buffer_;
   Slice seek_key_prefix_;
+
+  // Ranges of keys that could contain strong intents, nullptr when unknown.
+  IntentKeyRangesPtr intent_key_ranges_;
+
+  // Key that intent iterator should be positioned at, when its seek was deferred.
+  KeyBytes deferred_intent_seek_key_;
+  bool intent_seek_deferred_ = false;
 };
 
 // Utility class that controls stack of prefixes in IntentAwareIterator.
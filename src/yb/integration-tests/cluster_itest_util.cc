@@ -898,7 +898,8 @@ Status AddServer(const TServerDetails* leader,
                  const boost::optional<int64_t>& cas_config_opid_index,
                  const MonoDelta& timeout,
                  TabletServerErrorPB::Code* error_code,
-                 bool retry) {
+                 bool retry,
+                 bool is_witness) {
   ChangeConfigRequestPB req;
   ChangeConfigResponsePB resp;
   RpcController rpc;
@@ -910,6 +911,9 @@ Status AddServer(const TServerDetails* leader,
   RaftPeerPB* peer = req.mutable_server();
   peer->set_permanent_uuid(replica_to_add->uuid());
   peer->set_member_type(member_type);
+  if (is_witness) {
+    peer->set_is_witness(true);
+  }
   CopyRegistration(replica_to_add->registration.common(), peer);
   if (cas_config_opid_index) {
     req.set_cas_config_opid_index(*cas_config_opid_index);
@@ -336,6 +336,7 @@ Status WriteSimpleTestRow(const TServerDetails* replica,
 
 // Run a ConfigChange to ADD_SERVER on 'replica_to_add'.
 // The RPC request is sent to 'leader'.
+// If 'is_witness' is true, the replica is added as a witness.
 Status AddServer(const TServerDetails* leader,
                  const TabletId& tablet_id,
                  const TServerDetails* replica_to_add,
@@ -343,7 +344,8 @@ Status AddServer(const TServerDetails* leader,
                  const boost::optional<int64_t>& cas_config_opid_index,
                  const MonoDelta& timeout,
                  tserver::TabletServerErrorPB::Code* error_code = nullptr,
-                 bool retry = true);
+                 bool retry = true,
+                 bool is_witness = false);
 
 // Run a ConfigChange to REMOVE_SERVER on 'replica_to_remove'.
 // The RPC request is sent to 'leader'.
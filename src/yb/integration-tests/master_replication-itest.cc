@@ -30,6 +30,8 @@
 // under the License.
 //
 
+#include <map>
+#include <string>
 #include <vector>
 
 #include <gflags/gflags.h>
@@ -44,10 +46,15 @@
 #include "yb/master/catalog_manager.h"
 #include "yb/master/master.h"
 #include "yb/master/mini_master.h"
+#include "yb/master/sys_catalog-internal.h"
 #include "yb/util/test_util.h"
 
 using std::vector;
 
+using namespace std::literals;
+
+DECLARE_bool(catalog_manager_use_entry_cache);
+
 namespace yb {
 namespace master {
 
@@ -64,9 +71,28 @@ using std::shared_ptr;
 const std::string kKeyspaceName("my_keyspace");
 const YBTableName kTableName1(YQL_DATABASE_CQL, kKeyspaceName, "testMasterReplication-1");
 const YBTableName kTableName2(YQL_DATABASE_CQL, kKeyspaceName, "testMasterReplication-2");
+const YBTableName kTableName3(YQL_DATABASE_CQL, kKeyspaceName, "testMasterReplication-3");
 
 const int kNumTabletServerReplicas = 3;
 
+// Collects raw sys catalog entries of the specified type.
+class RawEntriesVisitor : public VisitorBase {
+ public:
+  explicit RawEntriesVisitor(int entry_type) : entry_type_(entry_type) {}
+
+  int entry_type() const override { return entry_type_; }
+
+  CHECKED_STATUS Visit(Slice id, Slice data) override {
+    entries[id.ToBuffer()] = data.ToBuffer();
+    return Status::OK();
+  }
+
+  std::map<std::string, std::string> entries;
+
+ private:
+  const int entry_type_;
+};
+
 class MasterReplicationTest : public YBMiniClusterTestBase<MiniCluster> {
  public:
   MasterReplicationTest() {
@@ -139,6 +165,36 @@ class MasterReplicationTest : public YBMiniClusterTestBase<MiniCluster> {
     ASSERT_TRUE(::util::gtl::contains(tables.begin(), tables.end(), table_name));
   }
 
+  // Waits until catalog entry cache of every running master, leader or follower, contains the
+  // same tables and tablets as its sys catalog.
+  CHECKED_STATUS WaitForCatalogEntryCachesInSync() {
+    return WaitFor([this]() -> Result<bool> {
+      for (int i = 0; i < num_masters_; ++i) {
+        auto* master = cluster_->mini_master(i)->master();
+        if (master->IsShutdown()) {
+          continue;
+        }
+        auto* catalog_manager = master->catalog_manager();
+        for (int entry_type : {SysRowEntry::TABLE, SysRowEntry::TABLET}) {
+          RawEntriesVisitor cache_visitor(entry_type);
+          if (!VERIFY_RESULT(catalog_manager->catalog_entry_cache().Visit(&cache_visitor))) {
+            LOG(INFO) << "Catalog entry cache of master " << i << " is not loaded";
+            return false;
+          }
+          RawEntriesVisitor scan_visitor(entry_type);
+          RETURN_NOT_OK(catalog_manager->sys_catalog()->Visit(&scan_visitor));
+          if (cache_visitor.entries != scan_visitor.entries) {
+            LOG(INFO) << "Catalog entry cache of master " << i << " has "
+                      << cache_visitor.entries.size() << " entries of type " << entry_type
+                      << ", while sys catalog has " << scan_visitor.entries.size();
+            return false;
+          }
+        }
+      }
+      return true;
+    }, 30s, "Catalog entry caches in sync");
+  }
+
   void VerifyMasterRestart() {
     LOG(INFO) << "Check that all " << num_masters_ << " masters are up first.";
     for (int i = 0; i < num_masters_; ++i) {
@@ -246,5 +302,35 @@ TEST_F(MasterReplicationTest, TestCycleThroughAllMasters) {
   ASSERT_OK(ThreadJoiner(start_thread.get()).Join());
 }
 
+class MasterReplicationEntryCacheTest : public MasterReplicationTest {
+ public:
+  void SetUp() override {
+    FLAGS_catalog_manager_use_entry_cache = true;
+    MasterReplicationTest::SetUp();
+  }
+};
+
+// Check that followers keep catalog entry cache up to date with replicated writes, so the new
+// leader loads the same tables and tablets from it after failover.
+TEST_F(MasterReplicationEntryCacheTest, TestCatalogEntryCacheFailover) {
+  auto client = ASSERT_RESULT(CreateClient());
+  ASSERT_OK(CreateTable(client.get(), kTableName1));
+  ASSERT_OK(CreateTable(client.get(), kTableName2));
+  ASSERT_OK(client->DeleteTable(kTableName1));
+  ASSERT_OK(WaitForCatalogEntryCachesInSync());
+
+  auto* old_leader = cluster_->leader_mini_master();
+  old_leader->Shutdown();
+
+  client = ASSERT_RESULT(CreateClient());
+  ASSERT_NO_FATALS(VerifyTableExists(client.get(), kTableName2));
+  ASSERT_OK(CreateTable(client.get(), kTableName3));
+  ASSERT_OK(WaitForCatalogEntryCachesInSync());
+
+  // Restarted master loads its cache during bootstrap and catches up as a follower.
+  ASSERT_OK(old_leader->Start());
+  ASSERT_OK(WaitForCatalogEntryCachesInSync());
+}
+
 }  // namespace master
 }  // namespace yb
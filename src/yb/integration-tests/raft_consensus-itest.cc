@@ -68,6 +68,8 @@
 #include "yb/server/server_base.pb.h"
 #include "yb/server/hybrid_clock.h"
 
+#include "yb/tserver/remote_bootstrap.proxy.h"
+
 #include "yb/util/opid.pb.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/size_literals.h"
@@ -3266,5 +3268,94 @@ TEST_F(RaftConsensusITest, DisruptiveServerAndSlowWAL) {
   }
 }
 
+// Witness votes and commits operations, but never becomes leader and never serves remote bootstrap.
+TEST_F(RaftConsensusITest, Witness) {
+  const MonoDelta kTimeout = 10s;
+  vector<string> ts_flags = { "--enable_leader_failure_detection=false"s };
+  vector<string> master_flags = { "--catalog_manager_wait_for_new_tablets_to_elect_leader=false"s };
+  ASSERT_NO_FATALS(BuildAndStart(ts_flags, master_flags));
+
+  vector<TServerDetails*> tservers = TServerDetailsVector(tablet_servers_);
+  ASSERT_EQ(3, tservers.size());
+  TServerDetails* leader = tservers[0];
+  TServerDetails* voter = tservers[1];
+  TServerDetails* witness = tservers[2];
+
+  ASSERT_OK(StartElection(leader, tablet_id_, kTimeout));
+  int64_t min_index = 1;
+  ASSERT_OK(WaitForServersToAgree(kTimeout, tablet_servers_, tablet_id_, min_index, &min_index));
+  ASSERT_OK(WaitUntilCommittedOpIdIndexIsAtLeast(&min_index, leader, tablet_id_, kTimeout));
+
+  // Kill the master, so we can change the config without interference.
+  cluster_->master()->Shutdown();
+
+  // Add the last server back as a witness.
+  ASSERT_OK(RemoveServer(leader, tablet_id_, witness, boost::none, kTimeout));
+  ASSERT_OK(DeleteTablet(witness, tablet_id_, tablet::TABLET_DATA_TOMBSTONED, boost::none,
+                         kTimeout));
+  ASSERT_OK(AddServer(leader, tablet_id_, witness, RaftPeerPB::PRE_VOTER, boost::none, kTimeout,
+                      nullptr /* error_code */, true /* retry */, true /* is_witness */));
+  ASSERT_OK(WaitUntilCommittedConfigNumVotersIs(3, leader, tablet_id_, kTimeout));
+
+  consensus::ConsensusStatePB cstate;
+  ASSERT_OK(itest::GetConsensusState(
+      leader, tablet_id_, consensus::CONSENSUS_CONFIG_COMMITTED, kTimeout, &cstate));
+  for (const auto& peer : cstate.config().peers()) {
+    ASSERT_EQ(peer.permanent_uuid() == witness->uuid(), peer.is_witness());
+  }
+
+  // Witness refuses to become leader on its own.
+  ASSERT_NOK(StartElection(witness, tablet_id_, kTimeout));
+
+  // Witness does not have the data, so it could not be a remote bootstrap source.
+  {
+    rpc::MessengerBuilder builder("test builder");
+    builder.set_num_reactors(1);
+    auto messenger = rpc::CreateAutoShutdownMessengerHolder(ASSERT_RESULT(builder.Build()));
+    rpc::ProxyCache proxy_cache(messenger.get());
+    RemoteBootstrapServiceProxy proxy(
+        &proxy_cache, HostPortFromPB(witness->registration.common().private_rpc_addresses(0)));
+    BeginRemoteBootstrapSessionRequestPB req;
+    req.set_tablet_id(tablet_id_);
+    req.set_requestor_uuid(voter->uuid());
+    BeginRemoteBootstrapSessionResponsePB resp;
+    rpc::RpcController controller;
+    controller.set_timeout(kTimeout);
+    auto status = proxy.BeginRemoteBootstrapSession(req, &resp, &controller);
+    ASSERT_TRUE(status.IsRemoteError()) << status;
+    ASSERT_STR_CONTAINS(status.ToString(), "witness");
+  }
+
+  // Operations are committed by leader and witness only.
+  auto* voter_ts = cluster_->tablet_server_by_uuid(voter->uuid());
+  ASSERT_OK(voter_ts->Pause());
+  for (int key = 0; key != 10; ++key) {
+    ASSERT_OK(WriteSimpleTestRow(leader, tablet_id_, key, key, "witness", kTimeout));
+  }
+  OpId committed_op_id;
+  ASSERT_OK(GetLastOpIdForReplica(
+      tablet_id_, leader, consensus::COMMITTED_OPID, kTimeout, &committed_op_id));
+
+  // When the leader is lost, the lagging voter could not get the vote of the witness, and the
+  // witness does not take over, even though it has all committed operations.
+  auto* leader_ts = cluster_->tablet_server_by_uuid(leader->uuid());
+  leader_ts->Shutdown();
+  ASSERT_OK(voter_ts->Resume());
+  ASSERT_OK(StartElection(voter, tablet_id_, kTimeout));
+  ASSERT_NOK(WaitUntilLeader(voter, tablet_id_, 5s));
+  ASSERT_NOK(StartElection(witness, tablet_id_, kTimeout));
+  ASSERT_NOK(WaitUntilLeader(witness, tablet_id_, 1s));
+
+  // The group is available again once the old leader is back.
+  ASSERT_OK(leader_ts->Restart());
+  ASSERT_OK(StartElection(leader, tablet_id_, kTimeout));
+  ASSERT_OK(WaitUntilLeader(leader, tablet_id_, 30s));
+
+  int64_t voter_committed_index = committed_op_id.index();
+  ASSERT_OK(WaitUntilCommittedOpIdIndexIsAtLeast(
+      &voter_committed_index, voter, tablet_id_, kTimeout));
+  ASSERT_OK(WriteSimpleTestRow(leader, tablet_id_, 10, 10, "witness", kTimeout));
+}
+
     }  // namespace tserver
 }  // namespace yb
@@ -27,6 +27,7 @@
 #include "yb/integration-tests/test_workload.h"
 
 #include "yb/master/catalog_manager.h"
+#include "yb/master/tablet_split_manager.h"
 
 #include "yb/yql/cql/ql/util/statement_result.h"
 
@@ -55,6 +56,9 @@ DECLARE_int32(heartbeat_interval_ms);
 DECLARE_int32(leader_lease_duration_ms);
 DECLARE_int32(raft_heartbeat_interval_ms);
 DECLARE_double(leader_failure_max_missed_heartbeat_periods);
+DECLARE_int64(tablet_split_size_threshold_bytes);
+DECLARE_int32(tablet_split_max_outstanding_per_table);
+DECLARE_int32(tablet_split_max_outstanding_per_tserver);
 
 namespace yb {
 
@@ -588,7 +592,8 @@ TEST_F(TabletSplitITest, SplitTabletDuringReadWriteLoad) {
     LOG(INFO) << "Middle hash key: " << doc_key_hash;
     const auto partition_split_key = PartitionSchema::EncodeMultiColumnHashValue(doc_key_hash);
 
-    ASSERT_OK(catalog_mgr.SplitTablet(source_tablet_id, encoded_split_key, partition_split_key));
+    ASSERT_RESULT(catalog_mgr.SplitTablet(
+        source_tablet_id, encoded_split_key, partition_split_key));
   }
 
   ASSERT_NO_FATALS(WaitForTabletSplitCompletion(kNumTablets, kNumTablets));
@@ -623,6 +628,75 @@ TEST_F(TabletSplitITest, SplitTabletDuringReadWriteLoad) {
   ASSERT_OK(cluster_->RestartSync());
 }
 
+TEST_F(TabletSplitITest, AutomaticSplitLimitsOutstandingSplits) {
+  constexpr auto kNumTablets = 3;
+
+  FLAGS_db_write_buffer_size = 20_KB;
+
+  TestWorkload workload(cluster_.get());
+  workload.set_table_name(client::kTableName);
+  workload.set_write_timeout_millis(MonoDelta(kRpcTimeout).ToMilliseconds());
+  workload.set_num_tablets(kNumTablets);
+  workload.set_num_write_threads(2);
+  workload.set_write_batch_size(50);
+  workload.set_payload_bytes(16);
+  workload.set_sequential_write(true);
+  workload.Setup();
+
+  std::vector<tablet::TabletPeerPtr> peers;
+  AssertLoggedWaitFor([this, &peers] {
+    peers = ListTabletPeers(cluster_.get(), ListPeersFilter::kLeaders);
+    return peers.size() == kNumTablets;
+  }, 60s, "Waiting for leaders ...");
+
+  workload.Start();
+  for (const auto& peer : peers) {
+    AssertLoggedWaitFor(
+        [&peer] {
+          return peer->tablet()->TEST_db()->GetCurrentVersionDataSstFilesSize() >
+                 15 * FLAGS_db_write_buffer_size;
+    }, 40s * kTimeMultiplier, Format("Writing data to split (tablet $0) ...", peer->tablet_id()));
+  }
+  workload.StopAndJoin();
+
+  // Each tablet has replicas on all tservers, so only the per table limit matters here.
+  FLAGS_tablet_split_max_outstanding_per_table = 1;
+  FLAGS_tablet_split_max_outstanding_per_tserver = kNumTablets;
+  FLAGS_tablet_split_size_threshold_bytes = 10 * FLAGS_db_write_buffer_size;
+
+  auto& leader_master = *ASSERT_NOTNULL(cluster_->leader_mini_master()->master());
+  auto& split_manager = *ASSERT_NOTNULL(leader_master.tablet_split_manager());
+
+  AssertLoggedWaitFor([this, &split_manager] {
+    EXPECT_LE(split_manager.NumOutstandingSplits(), 1U);
+    size_t num_split = 0;
+    for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kAll)) {
+      num_split += peer->tablet() &&
+                   peer->tablet()->metadata()->tablet_data_state() ==
+                       tablet::TabletDataState::TABLET_DATA_SPLIT_COMPLETED;
+    }
+    return num_split == kNumTablets * cluster_->num_tablet_servers();
+  }, 120s * kTimeMultiplier, "Waiting for automatic splits ...");
+
+  // Tablet servers trigger full compaction of the new tablets, so they stop counting against the
+  // per tserver limit.
+  AssertLoggedWaitFor([this] {
+    for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kAll)) {
+      const auto tablet = peer->shared_tablet();
+      if (tablet && tablet->doc_db().key_bounds->IsInitialized() &&
+          tablet->metadata()->tablet_data_state() == tablet::TabletDataState::TABLET_DATA_READY &&
+          !tablet->metadata()->has_been_fully_compacted()) {
+        return false;
+      }
+    }
+    return true;
+  }, 60s * kTimeMultiplier, "Waiting for post split compactions ...");
+
+  FLAGS_tablet_split_size_threshold_bytes = 0;
+  ASSERT_NO_FATALS(WaitForTabletSplitCompletion(kNumTablets, kNumTablets));
+  ASSERT_NO_FATALS(CheckTableKeysInRange(workload.rows_inserted()));
+}
+
 namespace {
 
 PB_ENUM_FORMATTERS(IsolationLevel);
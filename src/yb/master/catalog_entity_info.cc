@@ -65,6 +65,7 @@ void TabletReplica::UpdateFrom(const TabletReplica& source) {
   state = source.state;
   role = source.role;
   member_type = source.member_type;
+  is_witness = source.is_witness;
   time_updated = MonoTime::Now();
 }
 
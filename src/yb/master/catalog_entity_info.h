@@ -57,6 +57,8 @@ struct TabletReplica {
   tablet::RaftGroupStatePB state;
   consensus::RaftPeerPB::Role role;
   consensus::RaftPeerPB::MemberType member_type;
+  // Witness replica keeps only the log and should not be moved or made leader by load balancer.
+  bool is_witness = false;
   MonoTime time_updated;
 
   TabletReplica() : time_updated(MonoTime::Now()) {}
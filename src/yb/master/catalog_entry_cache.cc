@@ -0,0 +1,136 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/master/catalog_entry_cache.h"
+
+#include <algorithm>
+
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/value.h"
+
+#include "yb/master/sys_catalog-internal.h"
+#include "yb/master/sys_catalog_writer.h"
+
+#include "yb/tablet/tablet.h"
+
+METRIC_DEFINE_counter(
+  server, catalog_entry_cache_disabled,
+  "yb.master.CatalogEntryCache Disabled",
+  yb::MetricUnit::kUnits,
+  "Number of times the catalog entry cache was disabled till reload, because it failed to "
+  "apply a sys catalog write.");
+
+namespace yb {
+namespace master {
+
+CatalogEntryCache::CatalogEntryCache(std::vector<int8_t> entry_types)
+    : entry_types_(std::move(entry_types)) {}
+
+void CatalogEntryCache::InitMetrics(const scoped_refptr<MetricEntity>& metric_entity) {
+  disabled_counter_ = METRIC_catalog_entry_cache_disabled.Instantiate(metric_entity);
+}
+
+Status CatalogEntryCache::Load(tablet::Tablet* tablet) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  loaded_ = false;
+  entries_.clear();
+  for (auto entry_type : entry_types_) {
+    auto& entries = entries_[entry_type];
+    RETURN_NOT_OK(EnumerateSysCatalog(tablet, *tablet->schema(), entry_type,
+        [&entries](const Slice& id, const Slice& data) {
+      entries[id.ToBuffer()] = data.ToBuffer();
+      return Status::OK();
+    }));
+    LOG(INFO) << "Loaded " << entries.size() << " sys catalog entries of type "
+              << static_cast<int>(entry_type) << " into catalog entry cache";
+  }
+  loaded_ = true;
+  return Status::OK();
+}
+
+Status CatalogEntryCache::ApplyWritePair(const Slice& key, const Slice& value) {
+  auto status = DoApplyWritePair(key, value);
+  if (!status.ok()) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (loaded_) {
+      LOG(WARNING) << "Catalog entry cache disabled till reload, failed to apply write pair: "
+                   << status;
+      loaded_ = false;
+      if (disabled_counter_) {
+        disabled_counter_->Increment();
+      }
+    }
+  }
+  return status;
+}
+
+Status CatalogEntryCache::DoApplyWritePair(const Slice& key, const Slice& value) {
+  docdb::SubDocKey sub_doc_key;
+  RETURN_NOT_OK(sub_doc_key.FullyDecodeFrom(key, docdb::HybridTimeRequired::kFalse));
+
+  const auto& doc_key = sub_doc_key.doc_key();
+  if (doc_key.has_cotable_id() || doc_key.range_group().size() != 2 ||
+      doc_key.range_group()[0].value_type() != docdb::ValueType::kInt32) {
+    return Status::OK();
+  }
+
+  const int8_t entry_type = doc_key.range_group()[0].GetInt32();
+  if (std::find(entry_types_.begin(), entry_types_.end(), entry_type) == entry_types_.end()) {
+    return Status::OK();
+  }
+
+  docdb::Value decoded_value;
+  RETURN_NOT_OK(decoded_value.Decode(value));
+  const auto value_type = decoded_value.primitive_value().value_type();
+  const auto& id = doc_key.range_group()[1].GetString();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& entries = entries_[entry_type];
+  if (value_type == docdb::ValueType::kTombstone) {
+    entries.erase(id);
+  } else if (value_type == docdb::ValueType::kString) {
+    entries[id] = decoded_value.primitive_value().GetString();
+  }
+  // Other values, like the liveness column, do not affect the entry data.
+  return Status::OK();
+}
+
+Result<bool> CatalogEntryCache::Visit(VisitorBase* visitor) {
+  std::vector<std::pair<std::string, std::string>> entries;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!loaded_) {
+      return false;
+    }
+    auto it = entries_.find(visitor->entry_type());
+    if (it == entries_.end()) {
+      return false;
+    }
+    entries.assign(it->second.begin(), it->second.end());
+  }
+
+  // Entries are visited without holding the mutex, so applying writes is not blocked by loaders.
+  for (const auto& entry : entries) {
+    RETURN_NOT_OK(visitor->Visit(entry.first, entry.second));
+  }
+  return true;
+}
+
+size_t CatalogEntryCache::NumEntries(int8_t entry_type) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(entry_type);
+  return it != entries_.end() ? it->second.size() : 0;
+}
+
+} // namespace master
+} // namespace yb
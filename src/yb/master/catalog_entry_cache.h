@@ -0,0 +1,79 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_MASTER_CATALOG_ENTRY_CACHE_H
+#define YB_MASTER_CATALOG_ENTRY_CACHE_H
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "yb/gutil/thread_annotations.h"
+#include "yb/tablet/sys_catalog_write_listener.h"
+#include "yb/util/metrics.h"
+#include "yb/util/result.h"
+
+namespace yb {
+namespace master {
+
+class VisitorBase;
+
+// Keeps raw sys catalog entries of the specified types in memory, on every master. Entries are
+// loaded when the sys catalog tablet is bootstrapped, and then kept up to date by applying write
+// pairs replicated to this master, whether it is leader or follower.
+//
+// So a master that becomes leader could reload its in-memory catalog from this cache, instead of
+// scanning the sys catalog tablet.
+class CatalogEntryCache : public tablet::SysCatalogWriteListener {
+ public:
+  explicit CatalogEntryCache(std::vector<int8_t> entry_types);
+
+  // Instantiates metrics of the cache in the specified entity. Should be called before the cache
+  // is loaded.
+  void InitMetrics(const scoped_refptr<MetricEntity>& metric_entity);
+
+  CHECKED_STATUS Load(tablet::Tablet* tablet) override;
+
+  // If the write pair could not be applied, the cache is marked as not loaded till the next Load,
+  // so entries are read from the sys catalog instead of from the cache that missed the write.
+  CHECKED_STATUS ApplyWritePair(const Slice& key, const Slice& value) override;
+
+  // Passes cached entries of the visitor's entry type to the visitor, in the same order as the
+  // sys catalog scan would do. Returns false if this type of entries is not available in cache,
+  // i.e. the sys catalog should be scanned instead.
+  Result<bool> Visit(VisitorBase* visitor);
+
+  // Number of cached entries of the specified type.
+  size_t NumEntries(int8_t entry_type) const;
+
+ private:
+  CHECKED_STATUS DoApplyWritePair(const Slice& key, const Slice& value);
+
+  // Entry data by entry id.
+  typedef std::map<std::string, std::string> Entries;
+
+  const std::vector<int8_t> entry_types_;
+
+  // Number of times the cache was disabled because of a failed write.
+  scoped_refptr<Counter> disabled_counter_;
+
+  mutable std::mutex mutex_;
+  bool loaded_ GUARDED_BY(mutex_) = false;
+  std::map<int8_t, Entries> entries_ GUARDED_BY(mutex_);
+};
+
+} // namespace master
+} // namespace yb
+
+#endif // YB_MASTER_CATALOG_ENTRY_CACHE_H
@@ -31,7 +31,12 @@
 //
 
 #include "yb/master/catalog_loaders.h"
+
+#include <algorithm>
+#include <memory>
+
 #include "yb/master/master_util.h"
+#include "yb/util/threadpool.h"
 
 namespace yb {
 namespace master {
@@ -41,9 +46,6 @@ namespace master {
 ////////////////////////////////////////////////////////////
 
 Status TableLoader::Visit(const TableId& table_id, const SysTablesEntryPB& metadata) {
-  CHECK(!ContainsKey(*catalog_manager_->table_ids_map_, table_id))
-        << "Table already exists: " << table_id;
-
   // Setup the table info.
   scoped_refptr<TableInfo> table = catalog_manager_->NewTableInfo(table_id);
   auto l = table->LockForWrite();
@@ -56,10 +58,14 @@ Status TableLoader::Visit(const TableId& table_id, const SysTablesEntryPB& metad
 
   // Add the table to the IDs map and to the name map (if the table is not deleted). Do not
   // add Postgres tables to the name map as the table name is not unique in a namespace.
-  auto table_ids_map_checkout = catalog_manager_->table_ids_map_.CheckOut();
-  (*table_ids_map_checkout)[table->id()] = table;
-  if (l->data().table_type() != PGSQL_TABLE_TYPE && !l->data().started_deleting()) {
-    catalog_manager_->table_names_map_[{l->data().namespace_id(), l->data().name()}] = table;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto table_ids_map_checkout = catalog_manager_->table_ids_map_.CheckOut();
+    CHECK(table_ids_map_checkout->emplace(table->id(), table).second)
+        << "Table already exists: " << table_id;
+    if (l->data().table_type() != PGSQL_TABLE_TYPE && !l->data().started_deleting()) {
+      catalog_manager_->table_names_map_[{l->data().namespace_id(), l->data().name()}] = table;
+    }
   }
 
   l->Commit();
@@ -86,11 +92,14 @@ Status TabletLoader::Visit(const TabletId& tablet_id, const SysTabletsEntryPB& m
   l->mutable_data()->pb.CopyFrom(metadata);
 
   // Add the tablet to the tablet manager.
-  auto tablet_map_checkout = catalog_manager_->tablet_map_.CheckOut();
-  auto inserted = tablet_map_checkout->emplace(tablet->tablet_id(), tablet).second;
-  if (!inserted) {
-    return STATUS_FORMAT(
-        IllegalState, "Loaded tablet that already in map: $0", tablet->tablet_id());
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto tablet_map_checkout = catalog_manager_->tablet_map_.CheckOut();
+    auto inserted = tablet_map_checkout->emplace(tablet->tablet_id(), tablet).second;
+    if (!inserted) {
+      return STATUS_FORMAT(
+          IllegalState, "Loaded tablet that already in map: $0", tablet->tablet_id());
+    }
   }
 
   std::vector<TableId> table_ids;
@@ -165,6 +174,7 @@ Status TabletLoader::Visit(const TabletId& tablet_id, const SysTabletsEntryPB& m
 
   // Add the tablet to colocated_tablet_ids_map_ if the tablet is colocated.
   if (catalog_manager_->IsColocatedParentTable(*first_table)) {
+    std::lock_guard<std::mutex> lock(mutex_);
     catalog_manager_->colocated_tablet_ids_map_[first_table->namespace_id()] =
         catalog_manager_->tablet_map_->find(tablet_id)->second;
   }
@@ -384,5 +394,82 @@ Status SysConfigLoader::Visit(const string& config_type, const SysConfigEntryPB&
   return Status::OK();
 }
 
+////////////////////////////////////////////////////////////
+// Parallel Load Visitor
+////////////////////////////////////////////////////////////
+
+ParallelLoadVisitor::ParallelLoadVisitor(
+    VisitorBase* loader, ThreadPool* pool, size_t batch_size, size_t max_batches_in_flight)
+    : loader_(loader), pool_(pool), batch_size_(std::max<size_t>(batch_size, 1)),
+      max_batches_in_flight_(std::max<size_t>(max_batches_in_flight, 1)) {
+  batch_.reserve(batch_size_);
+}
+
+ParallelLoadVisitor::~ParallelLoadVisitor() {
+  WaitBatchesInFlight();
+}
+
+Status ParallelLoadVisitor::Visit(Slice id, Slice data) {
+  batch_.push_back(Entry{id.ToBuffer(), data.ToBuffer()});
+  if (batch_.size() < batch_size_) {
+    return Status::OK();
+  }
+  return SubmitBatch();
+}
+
+Status ParallelLoadVisitor::SubmitBatch() {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] {
+      return batches_in_flight_ < max_batches_in_flight_ || !status_.ok();
+    });
+    RETURN_NOT_OK(status_);
+    ++batches_in_flight_;
+  }
+
+  auto batch = std::make_shared<Batch>(std::move(batch_));
+  batch_.clear();
+  batch_.reserve(batch_size_);
+  auto status = pool_->SubmitFunc([this, batch] { ProcessBatch(*batch); });
+  if (!status.ok()) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    --batches_in_flight_;
+    cond_.notify_all();
+  }
+  return status;
+}
+
+void ParallelLoadVisitor::ProcessBatch(const Batch& batch) {
+  Status status;
+  for (const auto& entry : batch) {
+    status = loader_->Visit(entry.id, entry.data);
+    if (!status.ok()) {
+      break;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!status.ok() && status_.ok()) {
+    status_ = status;
+  }
+  --batches_in_flight_;
+  cond_.notify_all();
+}
+
+void ParallelLoadVisitor::WaitBatchesInFlight() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cond_.wait(lock, [this] { return batches_in_flight_ == 0; });
+}
+
+Status ParallelLoadVisitor::Wait() {
+  Status status;
+  if (!batch_.empty()) {
+    status = SubmitBatch();
+  }
+  WaitBatchesInFlight();
+  std::lock_guard<std::mutex> lock(mutex_);
+  return status_.ok() ? status : status_;
+}
+
 }  // namespace master
 }  // namespace yb
@@ -33,15 +33,21 @@
 #ifndef YB_MASTER_CATALOG_LOADERS_H
 #define YB_MASTER_CATALOG_LOADERS_H
 
+#include <condition_variable>
+#include <mutex>
+
 #include "yb/master/catalog_entity_info.h"
 #include "yb/master/sys_catalog-internal.h"
 
 #include <boost/preprocessor/cat.hpp>
 
 namespace yb {
+
+class ThreadPool;
+
 namespace master {
 
-#define DECLARE_LOADER_CLASS(name, key_type, entry_pb_name) \
+#define DECLARE_LOADER_CLASS_WITH_MEMBERS(name, key_type, entry_pb_name, members) \
   class BOOST_PP_CAT(name, Loader) : \
       public Visitor<BOOST_PP_CAT(BOOST_PP_CAT(Persistent, name), Info)> { \
   public: \
@@ -58,9 +64,19 @@ namespace master {
     \
     int64_t term_; \
     \
+    members \
+    \
     DISALLOW_COPY_AND_ASSIGN(BOOST_PP_CAT(name, Loader)); \
   };
 
+#define DECLARE_LOADER_CLASS(name, key_type, entry_pb_name) \
+  DECLARE_LOADER_CLASS_WITH_MEMBERS(name, key_type, entry_pb_name, )
+
+// Tables and tablets are loaded by ParallelLoadVisitor, so their loaders could be called
+// concurrently. The mutex protects catalog manager maps updated by the loader.
+#define DECLARE_PARALLEL_LOADER_CLASS(name, key_type, entry_pb_name) \
+  DECLARE_LOADER_CLASS_WITH_MEMBERS(name, key_type, entry_pb_name, std::mutex mutex_;)
+
 // We have two naming schemes for Sys...EntryPB classes (plural vs. singluar), hence we need the
 // "entry_pb_suffix" argument to the macro.
 //
@@ -82,8 +98,8 @@ namespace master {
 // SysSnapshotEntryPB
 // SysYSQLCatalogConfigEntryPB
 
-DECLARE_LOADER_CLASS(Table,         TableId,     SysTablesEntryPB);
-DECLARE_LOADER_CLASS(Tablet,        TabletId,    SysTabletsEntryPB);
+DECLARE_PARALLEL_LOADER_CLASS(Table,  TableId,     SysTablesEntryPB);
+DECLARE_PARALLEL_LOADER_CLASS(Tablet, TabletId,    SysTabletsEntryPB);
 DECLARE_LOADER_CLASS(Namespace,     NamespaceId, SysNamespaceEntryPB);
 DECLARE_LOADER_CLASS(UDType,        UDTypeId,    SysUDTypeEntryPB);
 DECLARE_LOADER_CLASS(ClusterConfig, std::string, SysClusterConfigEntryPB);
@@ -91,7 +107,58 @@ DECLARE_LOADER_CLASS(RedisConfig,   std::string, SysRedisConfigEntryPB);
 DECLARE_LOADER_CLASS(Role,          RoleName,    SysRoleEntryPB);
 DECLARE_LOADER_CLASS(SysConfig,     std::string, SysConfigEntryPB);
 
+#undef DECLARE_PARALLEL_LOADER_CLASS
 #undef DECLARE_LOADER_CLASS
+#undef DECLARE_LOADER_CLASS_WITH_MEMBERS
+
+// Passes sys catalog entries to the loader on a thread pool. Entries are read from the sys catalog
+// sequentially and submitted in batches, so parsing of entries and building of in-memory catalog
+// objects is done by multiple threads. The loader should support concurrent calls to Visit.
+class ParallelLoadVisitor : public VisitorBase {
+ public:
+  ParallelLoadVisitor(
+      VisitorBase* loader, ThreadPool* pool, size_t batch_size, size_t max_batches_in_flight);
+
+  // Waits for submitted batches, because they reference the loader.
+  ~ParallelLoadVisitor();
+
+  int entry_type() const override {
+    return loader_->entry_type();
+  }
+
+  CHECKED_STATUS Visit(Slice id, Slice data) override;
+
+  // Submits the remaining entries and waits until all batches are processed. Returns the first
+  // error returned by the loader.
+  CHECKED_STATUS Wait();
+
+ private:
+  struct Entry {
+    std::string id;
+    std::string data;
+  };
+
+  typedef std::vector<Entry> Batch;
+
+  CHECKED_STATUS SubmitBatch();
+
+  void ProcessBatch(const Batch& batch);
+
+  void WaitBatchesInFlight();
+
+  VisitorBase* const loader_;
+  ThreadPool* const pool_;
+  const size_t batch_size_;
+  const size_t max_batches_in_flight_;
+  Batch batch_;
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  size_t batches_in_flight_ = 0;
+  Status status_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelLoadVisitor);
+};
 
 }  // namespace master
 }  // namespace yb
@@ -31,6 +31,9 @@
 //
 
 #include "yb/master/catalog_manager-test_base.h"
+#include "yb/master/cluster_balance_simulator.h"
+
+DECLARE_int32(load_balancer_cost_move_cooldown_secs);
 
 namespace yb {
 namespace master {
@@ -261,5 +264,117 @@ TEST(TestCatalogManager, TestLeaderLoadBalanced) {
 }
 
 
+namespace {
+
+// Cluster of 4 tablet servers with a table of 8 tablets, each tablet server hosts 6 replicas.
+// Both hot tablets are placed on the first 3 tablet servers, so the last one serves only cold
+// tablets.
+std::vector<TabletId> SetupHotTabletsCluster(ClusterLoadBalancerSimulator* sim) {
+  for (int i = 0; i != 4; ++i) {
+    sim->AddTabletServer(Substitute("$0$0$0$0", i), "a");
+  }
+  auto tablets = sim->CreateTable("hot_table", 8, kNumReplicas);
+  for (size_t i = 0; i != tablets.size(); ++i) {
+    sim->SetTabletLoad(tablets[i], i % 4 == 0 ? 1000 : 10);
+  }
+  return tablets;
+}
+
+} // namespace
+
+TEST(TestLoadBalancerCommunity, CostBasedBalancingSpreadsHotTablets) {
+  google::FlagSaver flag_saver;
+  FLAGS_load_balancer_cost_move_cooldown_secs = 0;
+
+  {
+    // Replica counts are balanced, so balancing by count does not move anything.
+    Options options;
+    options.kCostBasedBalancing = false;
+    ClusterLoadBalancerSimulator sim(&options);
+    SetupHotTabletsCluster(&sim);
+    ASSERT_TRUE(ASSERT_RESULT(sim.RunRound()).empty());
+  }
+
+  Options options;
+  options.kCostBasedBalancing = true;
+  ClusterLoadBalancerSimulator sim(&options);
+  SetupHotTabletsCluster(&sim);
+  const auto initial_spread = sim.MaxServerLoad() - sim.MinServerLoad();
+  ASSERT_LT(sim.ServerLoad("3333"), 1000);
+
+  auto num_changes = ASSERT_RESULT(sim.RunUntilBalanced(50));
+  LOG(INFO) << "Changes: " << num_changes << ", load: " << sim.MaxServerLoad() << " - "
+            << sim.MinServerLoad();
+  ASSERT_GT(num_changes, 0);
+  ASSERT_GE(sim.ServerLoad("3333"), 1000);
+  ASSERT_LT(sim.MaxServerLoad() - sim.MinServerLoad(), initial_spread);
+
+  // Once balanced, the balancer should stay idle.
+  ASSERT_TRUE(ASSERT_RESULT(sim.RunRound()).empty());
+}
+
+TEST(TestLoadBalancerCommunity, CostBasedBalancingHysteresis) {
+  Options options;
+  options.kCostBasedBalancing = true;
+  // No move could improve the balance by so much.
+  options.kMinCostImprovementToBalance = 100;
+  ClusterLoadBalancerSimulator sim(&options);
+  SetupHotTabletsCluster(&sim);
+  ASSERT_TRUE(ASSERT_RESULT(sim.RunRound()).empty());
+}
+
+TEST(TestLoadBalancerCommunity, CostBasedBalancingRateLimit) {
+  google::FlagSaver flag_saver;
+  FLAGS_load_balancer_cost_move_cooldown_secs = 3600;
+
+  Options options;
+  options.kCostBasedBalancing = true;
+  ClusterLoadBalancerSimulator sim(&options);
+  SetupHotTabletsCluster(&sim);
+
+  std::unordered_map<TabletId, int> num_adds;
+  for (int round = 0; round != 50; ++round) {
+    auto changes = ASSERT_RESULT(sim.RunRound());
+    if (changes.empty()) {
+      break;
+    }
+    for (const auto& change : changes) {
+      if (change.is_add) {
+        ++num_adds[change.tablet_id];
+      }
+    }
+  }
+  ASSERT_FALSE(num_adds.empty());
+  for (const auto& p : num_adds) {
+    ASSERT_EQ(p.second, 1) << "Tablet " << p.first << " moved more than once during cooldown";
+  }
+}
+
+TEST(TestLoadBalancerCommunity, CostBasedBalancingLeaderOnlyLoad) {
+  Options options;
+  options.kCostBasedBalancing = true;
+  ClusterLoadBalancerSimulator sim(&options);
+  auto tablets = SetupHotTabletsCluster(&sim);
+  // Hot tablets are hot only on their leaders, both of which are on the first tablet server.
+  for (size_t i = 0; i != tablets.size(); i += 4) {
+    sim.SetTabletLoad(tablets[i], 1000, 10);
+  }
+  ASSERT_EQ(sim.LeaderOf(tablets[0]), sim.LeaderOf(tablets[4]));
+
+  // Replicas of hot tablets cost as much as any other replica, so only leaders should be moved.
+  for (int round = 0; round != 50; ++round) {
+    auto changes = ASSERT_RESULT(sim.RunRound());
+    if (changes.empty()) {
+      break;
+    }
+    for (const auto& change : changes) {
+      ASSERT_FALSE(change.is_add) << "Replica of " << change.tablet_id << " added";
+      ASSERT_FALSE(change.should_remove_leader) << "Replica of " << change.tablet_id << " removed";
+    }
+  }
+  ASSERT_NE(sim.LeaderOf(tablets[0]), sim.LeaderOf(tablets[4]));
+}
+
+
 } // namespace master
 } // namespace yb
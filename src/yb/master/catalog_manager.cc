@@ -59,6 +59,7 @@
 
 #include <algorithm>
 #include <bitset>
+#include <condition_variable>
 #include <functional>
 #include <mutex>
 #include <set>
@@ -201,6 +202,29 @@ DEFINE_int32(catalog_manager_report_batch_size, 1,
             "The max number of tablets evaluated in the heartbeat as a single SysCatalog update.");
 TAG_FLAG(catalog_manager_report_batch_size, advanced);
 
+DEFINE_int32(catalog_manager_report_num_shards, 4,
+             "Tablets of a single tablet report are split by table into this number of shards, "
+             "processed in parallel by the heartbeat thread and by the tablet report pool.");
+TAG_FLAG(catalog_manager_report_num_shards, advanced);
+TAG_FLAG(catalog_manager_report_num_shards, runtime);
+
+DEFINE_int32(catalog_manager_load_threads, 8,
+             "Number of threads used to load tables and tablets from the sys catalog into memory, "
+             "when the master becomes leader. 1 to load them sequentially.");
+TAG_FLAG(catalog_manager_load_threads, advanced);
+
+DEFINE_int32(catalog_manager_load_batch_size, 256,
+             "Number of sys catalog entries passed to one loader thread at once, when loading "
+             "tables and tablets in parallel.");
+TAG_FLAG(catalog_manager_load_batch_size, advanced);
+TAG_FLAG(catalog_manager_load_batch_size, runtime);
+
+DEFINE_bool(catalog_manager_use_entry_cache, false,
+            "Keep tables and tablets of the sys catalog in memory on all masters, updating them "
+            "as sys catalog writes are applied, and load them from memory instead of scanning the "
+            "sys catalog when the master becomes leader.");
+TAG_FLAG(catalog_manager_use_entry_cache, advanced);
+
 DEFINE_int32(master_failover_catchup_timeout_ms, 30 * 1000 * yb::kTimeMultiplier,  // 30 sec
              "Amount of time to give a newly-elected leader master to load"
              " the previous master's metadata and become active. If this time"
@@ -535,6 +559,12 @@ CatalogManager::CatalogManager(Master* master)
            .set_max_threads(1)
            .Build(&worker_pool_));
   CHECK_OK(ThreadPoolBuilder("CatalogManagerBGTasks").Build(&background_tasks_thread_pool_));
+  CHECK_OK(ThreadPoolBuilder("tablet-report")
+           .set_max_threads(std::max(FLAGS_catalog_manager_report_num_shards, 1))
+           .Build(&tablet_report_pool_));
+  CHECK_OK(ThreadPoolBuilder("catalog-load")
+           .set_max_threads(std::max(FLAGS_catalog_manager_load_threads, 1))
+           .Build(&catalog_load_pool_));
 
   if (master_) {
     sys_catalog_.reset(new SysCatalogTable(
@@ -561,6 +591,8 @@ Status CatalogManager::Init(bool is_first_run) {
   metric_num_tablet_servers_dead_ =
     METRIC_num_tablet_servers_dead.Instantiate(master_->metric_entity_cluster(), 0);
 
+  catalog_entry_cache_.InitMetrics(master_->metric_entity());
+
   RETURN_NOT_OK_PREPEND(InitSysCatalogAsync(is_first_run),
                         "Failed to initialize sys tables async");
 
@@ -817,11 +849,44 @@ Status CatalogManager::Load(const std::string& title, const int64_t term) {
   LOG(INFO) << __func__ << ": Loading " << title << " into memory.";
   std::unique_ptr<Loader> loader = std::make_unique<Loader>(this, term);
   RETURN_NOT_OK_PREPEND(
-      sys_catalog_->Visit(loader.get()),
+      VisitCatalogEntries(loader.get()),
       "Failed while visiting " + title + " in sys catalog");
   return Status::OK();
 }
 
+template <class Loader>
+Status CatalogManager::LoadInParallel(const std::string& title, const int64_t term) {
+  if (FLAGS_catalog_manager_load_threads <= 1) {
+    return Load<Loader>(title, term);
+  }
+
+  LOG(INFO) << __func__ << ": Loading " << title << " into memory using "
+            << FLAGS_catalog_manager_load_threads << " threads.";
+  std::unique_ptr<Loader> loader = std::make_unique<Loader>(this, term);
+  ParallelLoadVisitor visitor(
+      loader.get(), catalog_load_pool_.get(), FLAGS_catalog_manager_load_batch_size,
+      2 * FLAGS_catalog_manager_load_threads);
+  auto status = VisitCatalogEntries(&visitor);
+  auto wait_status = visitor.Wait();
+  RETURN_NOT_OK_PREPEND(
+      status.ok() ? wait_status : status,
+      "Failed while visiting " + title + " in sys catalog");
+  return Status::OK();
+}
+
+Status CatalogManager::VisitCatalogEntries(VisitorBase* visitor) {
+  if (FLAGS_catalog_manager_use_entry_cache) {
+    auto start = MonoTime::Now();
+    if (VERIFY_RESULT(catalog_entry_cache_.Visit(visitor))) {
+      LOG(INFO) << "Visited " << catalog_entry_cache_.NumEntries(visitor->entry_type())
+                << " cached entries of type " << visitor->entry_type() << " in "
+                << MonoTime::Now() - start;
+      return Status::OK();
+    }
+  }
+  return sys_catalog_->Visit(visitor);
+}
+
 Status CatalogManager::RunLoaders(int64_t term) {
   // Clear the table and tablet state.
   table_names_map_.clear();
@@ -863,8 +928,8 @@ Status CatalogManager::RunLoaders(int64_t term) {
     ts_desc->set_has_tablet_report(false);
   }
 
-  RETURN_NOT_OK(Load<TableLoader>("tables", term));
-  RETURN_NOT_OK(Load<TabletLoader>("tablets", term));
+  RETURN_NOT_OK(LoadInParallel<TableLoader>("tables", term));
+  RETURN_NOT_OK(LoadInParallel<TabletLoader>("tablets", term));
   RETURN_NOT_OK(Load<NamespaceLoader>("namespaces", term));
   RETURN_NOT_OK(Load<UDTypeLoader>("user-defined types", term));
   RETURN_NOT_OK(Load<ClusterConfigLoader>("cluster configuration", term));
@@ -1357,6 +1422,12 @@ void CatalogManager::Shutdown() {
   if (background_tasks_thread_pool_) {
     background_tasks_thread_pool_->Shutdown();
   }
+  if (tablet_report_pool_) {
+    tablet_report_pool_->Shutdown();
+  }
+  if (catalog_load_pool_) {
+    catalog_load_pool_->Shutdown();
+  }
   // Shutdown the Catalog Manager worker (CM<->TS) pool.
   if (worker_pool_) {
     worker_pool_->Shutdown();
@@ -1611,7 +1682,7 @@ Status CatalogManager::TEST_SplitTablet(
   return DoSplitTablet(source_tablet_info, split_hash_code);
 }
 
-Status CatalogManager::DoSplitTablet(
+Result<SplitTabletIds> CatalogManager::DoSplitTablet(
     const scoped_refptr<TabletInfo>& source_tablet_info, const std::string& split_encoded_key,
     const std::string& split_partition_key) {
   if (source_tablet_info->colocated()) {
@@ -1620,12 +1691,10 @@ Status CatalogManager::DoSplitTablet(
         source_tablet_info->tablet_id());
   }
 
-  constexpr auto kNumSplitParts = 2;
-
   std::array<PartitionPB, kNumSplitParts> new_tablets_partition = CreateNewTabletsPartition(
       *source_tablet_info, split_partition_key);
 
-  std::array<TabletId, kNumSplitParts> new_tablet_ids;
+  SplitTabletIds new_tablet_ids;
   for (int i = 0; i < kNumSplitParts; ++i) {
     auto* new_tablet_info = VERIFY_RESULT(
         RegisterNewTabletForSplit(*source_tablet_info, new_tablets_partition[i]));
@@ -1637,7 +1706,7 @@ Status CatalogManager::DoSplitTablet(
   SendSplitTabletRequest(
       source_tablet_info, new_tablet_ids, split_encoded_key, split_partition_key);
 
-  return Status::OK();
+  return new_tablet_ids;
 }
 
 Status CatalogManager::DoSplitTablet(
@@ -1648,7 +1717,8 @@ Status CatalogManager::DoSplitTablet(
 
   const auto split_partition_key = PartitionSchema::EncodeMultiColumnHashValue(split_hash_code);
 
-  return DoSplitTablet(source_tablet_info, split_encoded_key.ToStringBuffer(), split_partition_key);
+  return ResultToStatus(DoSplitTablet(
+      source_tablet_info, split_encoded_key.ToStringBuffer(), split_partition_key));
 }
 
 Result<scoped_refptr<TabletInfo>> CatalogManager::GetTabletInfo(const TabletId& tablet_id) {
@@ -1663,7 +1733,7 @@ Result<scoped_refptr<TabletInfo>> CatalogManager::GetTabletInfo(const TabletId&
   return tablet_info;
 }
 
-Status CatalogManager::SplitTablet(
+Result<SplitTabletIds> CatalogManager::SplitTablet(
     const TabletId& tablet_id, const std::string& split_encoded_key,
     const std::string& split_partition_key) {
   const auto source_tablet_info = VERIFY_RESULT(GetTabletInfo(tablet_id));
@@ -4240,26 +4310,28 @@ Status CatalogManager::ProcessTabletReport(TSDescriptor* ts_desc,
             << ts_desc->permanent_uuid() << "): " << full_report.DebugString();
   }
 
-  if (!ts_desc->has_tablet_report() && full_report.is_incremental()) {
+  if (!ts_desc->has_tablet_report() && !ts_desc->has_partial_tablet_report() &&
+      full_report.is_incremental()) {
     string msg = "Received an incremental tablet report when a full one was needed";
     LOG(WARNING) << "Invalid tablet report from " << ts_desc->permanent_uuid() << ": " << msg;
     // We should respond with success in order to send reply that we need full report.
     return Status::OK();
   }
 
+  if (!ts_desc->UpdateTabletReportSequenceNumber(
+          full_report.sequence_number(), full_report.is_incremental())) {
+    LOG(INFO) << "Ignoring stale tablet report #" << full_report.sequence_number() << " from "
+              << ts_desc->permanent_uuid();
+    return Status::OK();
+  }
+
   // TODO: on a full tablet report, we may want to iterate over the tablets we think
   // the server should have, compare vs the ones being reported, and somehow mark
   // any that have been "lost" (eg somehow the tablet metadata got corrupted or something).
 
-  // Maps a tablet ID to its corresponding tablet report (owned by 'full_report').
-  map<TabletId, const ReportedTabletPB*> reports;
-
-  // Maps a tablet ID to its corresponding tablet report update (owned by
-  // 'full_report_update').
-  map<TabletId, ReportedTabletUpdatesPB*> updates;
-
-  // Maps a tablet ID to its corresponding TabletInfo.
-  map<TabletId, scoped_refptr<TabletInfo>> tablet_infos;
+  // Maps a tablet ID to its TabletInfo, report (owned by 'full_report') and report update (owned
+  // by 'full_report_update').
+  map<TabletId, ReportedTablet> reported_tablets;
 
   // Tablet Deletes to process after the catalog lock below.
   set<TabletId> tablets_to_delete;
@@ -4301,9 +4373,7 @@ Status CatalogManager::ProcessTabletReport(TSDescriptor* ts_desc,
 
       // 1c. Found the tablet, update local state. If multiple tablets with the
       // same ID are in the report, all but the last one will be ignored.
-      reports[tablet_id] = &report;
-      updates[tablet_id] = update;
-      tablet_infos[tablet_id] = tablet;
+      reported_tablets[tablet_id] = ReportedTablet{tablet, &report, update};
     }
   }
 
@@ -4313,9 +4383,110 @@ Status CatalogManager::ProcessTabletReport(TSDescriptor* ts_desc,
         "Report from an orphaned tablet");
   }
 
+  // Split the tablets into shards by table, so each table is locked by a single shard only, and
+  // process the shards in parallel. Tablets keep their ID order within a shard.
+  const size_t num_shards = std::max<size_t>(1, std::min<size_t>(
+      FLAGS_catalog_manager_report_num_shards,
+      reported_tablets.size() / std::max(FLAGS_catalog_manager_report_batch_size, 1)));
+
+  // Shards are claimed one at a time by the calling thread and by the helper tasks submitted to
+  // tablet_report_pool_. So a report is never blocked by the pool being busy with reports from
+  // other tablet servers: in the worst case the calling thread processes all shards by itself,
+  // and a helper task that starts after that just finds nothing to do.
+  struct Shards {
+    std::vector<ReportedTablets> shards;
+    std::mutex mutex;
+    std::condition_variable cond;
+    size_t next_shard = 0;
+    size_t running = 0;
+    Status status;
+
+    explicit Shards(size_t num_shards) : shards(num_shards) {}
+
+    // Returns the next shard to process, or nullptr if all shards are claimed.
+    const ReportedTablets* Claim() {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (next_shard == shards.size()) {
+        return nullptr;
+      }
+      ++running;
+      return &shards[next_shard++];
+    }
+
+    void Finished(const Status& shard_status) {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (status.ok() && !shard_status.ok()) {
+        status = shard_status;
+      }
+      if (--running == 0) {
+        cond.notify_all();
+      }
+    }
+  };
+
+  auto shards = std::make_shared<Shards>(num_shards);
+  std::hash<TableId> table_id_hash;
+  for (auto& id_and_tablet : reported_tablets) {
+    auto& shard =
+        shards->shards[table_id_hash(id_and_tablet.second.tablet->table()->id()) % num_shards];
+    shard.push_back(std::move(id_and_tablet.second));
+  }
+
+  // Helper tasks do not access the report after all shards are claimed, and the calling thread
+  // waits for all claimed shards. So they could reference arguments of this call.
+  auto process_shards = [this, shards, ts_desc, &full_report] {
+    while (auto* shard = shards->Claim()) {
+      shards->Finished(ProcessTabletReportShard(ts_desc, full_report, *shard));
+    }
+  };
+  for (size_t i = 1; i < num_shards; ++i) {
+    auto submit_status = tablet_report_pool_->SubmitFunc(process_shards);
+    if (!submit_status.ok()) {
+      LOG(WARNING) << "Failed to submit tablet report shard: " << submit_status;
+      break;
+    }
+  }
+  process_shards();
+  {
+    std::unique_lock<std::mutex> lock(shards->mutex);
+    shards->cond.wait(lock, [&shards] { return shards->running == 0; });
+    RETURN_NOT_OK(shards->status);
+  }
+
+  if (!full_report.is_incremental() || ts_desc->has_partial_tablet_report()) {
+    const auto num_reported_tablets = ts_desc->AddTabletReportChunk(
+        full_report.updated_tablets_size(), !full_report.is_incremental() /* first_chunk */);
+    if (full_report.remaining_tablet_count() > 0) {
+      VLOG(1) << ts_desc->permanent_uuid() << " has " << full_report.remaining_tablet_count()
+              << " tablets left to report";
+      ts_desc->set_has_tablet_report(false);
+      ts_desc->set_has_partial_tablet_report(true);
+    } else {
+      if (num_reported_tablets == 0) {
+        LOG(INFO) << ts_desc->permanent_uuid() << " sent full tablet report with 0 tablets.";
+      } else if (!ts_desc->has_tablet_report()) {
+        LOG(INFO) << ts_desc->permanent_uuid() << " now has its first full report: "
+                  << num_reported_tablets << " tablets.";
+      }
+      // Do not unset full tablet report missing for ts desc for an incremental case.
+      ts_desc->set_has_tablet_report(true);
+      ts_desc->set_has_partial_tablet_report(false);
+    }
+  }
+
+  // 14. Queue background processing if we had updates.
+  if (full_report.updated_tablets_size() > 0) {
+    background_tasks_->WakeIfHasPendingUpdates();
+  }
+
+  return Status::OK();
+}
+
+Status CatalogManager::ProcessTabletReportShard(
+    TSDescriptor* ts_desc, const TabletReportPB& full_report, const ReportedTablets& tablets) {
   // Doing batched processing with inner 'for' loops.  Ensure we iterate all tablets with 'while'.
-  auto tablet_iter = tablet_infos.begin();
-  while (tablet_iter != tablet_infos.end()) {
+  auto tablet_iter = tablets.begin();
+  while (tablet_iter != tablets.end()) {
     // Keeps track of all RPCs that should be sent when we're done with a single batch.
     vector<shared_ptr<RetryingTSRpcTask>> rpcs;
 
@@ -4328,9 +4499,9 @@ Status CatalogManager::ProcessTabletReport(TSDescriptor* ts_desc,
       auto tablet_iter_for_table_locks = tablet_iter;
       for (auto i = 0;
           i < FLAGS_catalog_manager_report_batch_size
-            && tablet_iter_for_table_locks != tablet_infos.end();
+            && tablet_iter_for_table_locks != tablets.end();
           ++i, ++tablet_iter_for_table_locks) {
-        const scoped_refptr<TabletInfo>& tablet = tablet_iter_for_table_locks->second;
+        const scoped_refptr<TabletInfo>& tablet = tablet_iter_for_table_locks->tablet;
         const scoped_refptr<TableInfo>& table = tablet->table();
         tables_to_lock[table->id()] = table;
       }
@@ -4340,16 +4511,16 @@ Status CatalogManager::ProcessTabletReport(TSDescriptor* ts_desc,
     }
     // 2b. Second Pass.  Process each tablet. This may not be in the order that the tablets
     // appear in 'full_report', but that has no bearing on correctness.
-    vector<TabletInfo*> mutated_tablets; // refcount protected by 'tablet_infos'
+    vector<TabletInfo*> mutated_tablets; // refcount protected by 'tablets'
     auto tablet_iter_for_schema_changes = tablet_iter;
     for (auto i = 0;
-         i < FLAGS_catalog_manager_report_batch_size && tablet_iter != tablet_infos.end();
+         i < FLAGS_catalog_manager_report_batch_size && tablet_iter != tablets.end();
          ++i, ++tablet_iter) {
-      const string& tablet_id = tablet_iter->first;
-      const scoped_refptr<TabletInfo>& tablet = tablet_iter->second;
+      const scoped_refptr<TabletInfo>& tablet = tablet_iter->tablet;
+      const string& tablet_id = tablet->tablet_id();
       const scoped_refptr<TableInfo>& table = tablet->table();
-      const ReportedTabletPB& report = *FindOrDie(reports, tablet_id);
-      ReportedTabletUpdatesPB* update = FindOrDie(updates, tablet_id);
+      const ReportedTabletPB& report = *tablet_iter->report;
+      ReportedTabletUpdatesPB* update = tablet_iter->update;
       // Get tablet lock on demand.  This works in the batch case because the loop is ordered.
       tablet_write_locks[tablet_id] = tablet->LockForWrite();
       auto& table_lock = table_read_locks[table->id()];
@@ -4625,11 +4796,10 @@ Status CatalogManager::ProcessTabletReport(TSDescriptor* ts_desc,
     // (This is separate from tablet state mutations because only table on-disk state is changed.)
     for (auto i = 0;
         i < FLAGS_catalog_manager_report_batch_size
-          && tablet_iter_for_schema_changes != tablet_infos.end();
+          && tablet_iter_for_schema_changes != tablets.end();
         ++i, ++tablet_iter_for_schema_changes) {
-      const string& tablet_id = tablet_iter_for_schema_changes->first;
-      const scoped_refptr<TabletInfo>& tablet = tablet_iter_for_schema_changes->second;
-      const ReportedTabletPB& report = *FindOrDie(reports, tablet_id);
+      const scoped_refptr<TabletInfo>& tablet = tablet_iter_for_schema_changes->tablet;
+      const ReportedTabletPB& report = *tablet_iter_for_schema_changes->report;
       if (report.has_schema_version()) {
         auto leader = tablet->GetLeader();
         if (leader.ok() && leader.get()->permanent_uuid() == ts_desc->permanent_uuid()) {
@@ -4647,22 +4817,6 @@ Status CatalogManager::ProcessTabletReport(TSDescriptor* ts_desc,
     rpcs.clear();
   } // Loop to process the next batch until fully iterated.
 
-  if (!full_report.is_incremental()) {
-    if (full_report.updated_tablets_size() == 0) {
-      LOG(INFO) << ts_desc->permanent_uuid() << " sent full tablet report with 0 tablets.";
-    } else if (!ts_desc->has_tablet_report()) {
-      LOG(INFO) << ts_desc->permanent_uuid() << " now has it's first full report: "
-                << full_report.updated_tablets_size() << " tablets.";
-    }
-    // Do not unset full tablet report missing for ts desc for an incremental case.
-    ts_desc->set_has_tablet_report(true);
-  }
-
-  // 14. Queue background processing if we had updates.
-  if (full_report.updated_tablets_size() > 0) {
-    background_tasks_->WakeIfHasPendingUpdates();
-  }
-
   return Status::OK();
 }
 
@@ -5924,6 +6078,8 @@ void CatalogManager::CreateNewReplicaForLocalMemory(TSDescriptor* ts_desc,
                                       << " - " << replica_state;
     new_replica->role = GetConsensusRole(ts_desc->permanent_uuid(), *consensus_state);
     new_replica->member_type = GetConsensusMemberType(ts_desc->permanent_uuid(), *consensus_state);
+    new_replica->is_witness = IsRaftConfigWitness(
+        ts_desc->permanent_uuid(), consensus_state->config());
   }
   new_replica->state = replica_state;
   new_replica->ts_desc = ts_desc;
@@ -7058,6 +7214,22 @@ Status CatalogManager::GetTableLocations(const GetTableLocationsRequestPB* req,
     }
   }
 
+  if (req->compact_ts_info()) {
+    // Send each tablet server once, instead of once per replica.
+    std::unordered_set<TabletServerId> ts_uuids;
+    for (auto& locs_pb : *resp->mutable_tablet_locations()) {
+      for (auto& replica_pb : *locs_pb.mutable_replicas()) {
+        auto* ts_info = replica_pb.mutable_ts_info();
+        if (ts_uuids.insert(ts_info->permanent_uuid()).second) {
+          *resp->add_ts_infos() = *ts_info;
+        }
+        auto uuid = std::move(*ts_info->mutable_permanent_uuid());
+        ts_info->Clear();
+        ts_info->set_permanent_uuid(std::move(uuid));
+      }
+    }
+  }
+
   resp->set_table_type(l->data().pb.table_type());
   resp->set_partitions_version(l->data().pb.partitions_version());
 
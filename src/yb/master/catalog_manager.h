@@ -55,7 +55,9 @@
 #include "yb/gutil/thread_annotations.h"
 #include "yb/master/async_rpc_tasks.h"
 #include "yb/master/catalog_entity_info.h"
+#include "yb/master/catalog_entry_cache.h"
 #include "yb/master/master_defaults.h"
+#include "yb/master/master_fwd.h"
 #include "yb/master/permissions_manager.h"
 #include "yb/master/sys_catalog_initialization.h"
 #include "yb/master/scoped_leader_shared_lock.h"
@@ -402,6 +404,8 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
 
   SysCatalogTable* sys_catalog() { return sys_catalog_.get(); }
 
+  CatalogEntryCache& catalog_entry_cache() { return catalog_entry_cache_; }
+
   // Dump all of the current state about tables and tablets to the
   // given output stream. This is verbose, meant for debugging.
   virtual void DumpState(std::ostream* out, bool on_disk_dump = false) const;
@@ -651,7 +655,8 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
     return *encryption_manager_;
   }
 
-  CHECKED_STATUS SplitTablet(
+  // Splits tablet at the specified split key. Returns ids of the tablets registered for the split.
+  Result<SplitTabletIds> SplitTablet(
       const TabletId& tablet_id, const std::string& split_encoded_key,
       const std::string& split_partition_key);
 
@@ -667,6 +672,8 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   // TODO(bogdan): Eventually schedule on a threadpool in a followup refactor.
   CHECKED_STATUS ScheduleTask(std::shared_ptr<RetryingTSRpcTask> task);
 
+  Result<scoped_refptr<TabletInfo>> GetTabletInfo(const TabletId& tablet_id);
+
  protected:
   // TODO Get rid of these friend classes and introduce formal interface.
   friend class TableLoader;
@@ -840,6 +847,20 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   CHECKED_STATUS BuildLocationsForTablet(const scoped_refptr<TabletInfo>& tablet,
                                          TabletLocationsPB* locs_pb);
 
+  // Tablet from a tablet report, with its entry in the report and in the report update.
+  struct ReportedTablet {
+    scoped_refptr<TabletInfo> tablet;
+    const ReportedTabletPB* report;
+    ReportedTabletUpdatesPB* update;
+  };
+  typedef std::vector<ReportedTablet> ReportedTablets;
+
+  // Processes reported tablets ordered by tablet id, in batches of
+  // catalog_manager_report_batch_size tablets.
+  CHECKED_STATUS ProcessTabletReportShard(TSDescriptor* ts_desc,
+                                          const TabletReportPB& full_report,
+                                          const ReportedTablets& tablets);
+
   void ReconcileTabletReplicasInLocalMemoryWithReport(
       const scoped_refptr<TabletInfo>& tablet,
       const std::string& sender_uuid,
@@ -1055,9 +1076,7 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   Result<TabletInfo*> RegisterNewTabletForSplit(
       const TabletInfo& source_tablet_info, const PartitionPB& partition);
 
-  Result<scoped_refptr<TabletInfo>> GetTabletInfo(const TabletId& tablet_id);
-
-  CHECKED_STATUS DoSplitTablet(
+  Result<SplitTabletIds> DoSplitTablet(
       const scoped_refptr<TabletInfo>& source_tablet_info, const std::string& split_encoded_key,
       const std::string& split_partition_key);
 
@@ -1086,6 +1105,15 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   template <class Loader>
   CHECKED_STATUS Load(const std::string& title, const int64_t term);
 
+  // Same as Load, but entries are passed to the loader in batches processed in parallel by
+  // catalog_load_pool_.
+  template <class Loader>
+  CHECKED_STATUS LoadInParallel(const std::string& title, const int64_t term);
+
+  // Passes sys catalog entries to the visitor, taking them from catalog_entry_cache_ when it
+  // contains entries of the visitor's type, and scanning the sys catalog otherwise.
+  CHECKED_STATUS VisitCatalogEntries(VisitorBase* visitor);
+
   virtual void Started() {}
 
   // ----------------------------------------------------------------------------------------------
@@ -1183,6 +1211,16 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   // upon closely timed consecutive elections).
   gscoped_ptr<ThreadPool> worker_pool_;
 
+  // Used to process shards of a single tablet report in parallel.
+  std::unique_ptr<ThreadPool> tablet_report_pool_;
+
+  // Used to load tables and tablets from the sys catalog in parallel.
+  std::unique_ptr<ThreadPool> catalog_load_pool_;
+
+  // Tables and tablets replicated to this master, kept up to date while it is a follower, so they
+  // don't have to be read from the sys catalog tablet when it becomes leader.
+  CatalogEntryCache catalog_entry_cache_{{SysRowEntry::TABLE, SysRowEntry::TABLET}};
+
   // This field is updated when a node becomes leader master,
   // waits for all outstanding uncommitted metadata (table and tablet metadata)
   // in the sys catalog to commit, and then reads that metadata into in-memory
@@ -14,6 +14,7 @@
 #include "yb/master/cluster_balance.h"
 
 #include <algorithm>
+#include <cmath>
 #include <memory>
 #include <utility>
 
@@ -23,6 +24,7 @@
 #include "yb/consensus/quorum_util.h"
 #include "yb/master/master.h"
 #include "yb/master/master_error.h"
+#include "yb/util/atomic.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/random_util.h"
 
@@ -90,6 +92,36 @@ DEFINE_test_flag(bool, load_balancer_handle_under_replicated_tablets_only, false
 DEFINE_bool(load_balancer_skip_leader_as_remove_victim, false,
             "Should the LB skip a leader as a possible remove candidate.");
 
+DEFINE_bool(load_balancer_cost_based, false,
+            "Balance the load reported by tablet servers for each tablet, i.e. operations, bytes "
+            "and handler time, instead of just the number of tablets.");
+TAG_FLAG(load_balancer_cost_based, advanced);
+
+DEFINE_double(load_balancer_cost_weight, 1.0,
+              "Weight of the reported tablet load relative to the replica count in cost based "
+              "load balancing.");
+TAG_FLAG(load_balancer_cost_weight, advanced);
+
+DEFINE_double(load_balancer_cost_min_improvement, 0.5,
+              "Minimal reduction of the load variance between two tablet servers, measured in "
+              "replicas, for a move to be done by cost based load balancing.");
+TAG_FLAG(load_balancer_cost_min_improvement, advanced);
+
+DEFINE_int64(load_balancer_cost_bytes_per_op, 4096,
+             "Number of bytes read or written per second that costs as much as one operation per "
+             "second in cost based load balancing. 0 to ignore bytes.");
+TAG_FLAG(load_balancer_cost_bytes_per_op, advanced);
+
+DEFINE_int64(load_balancer_cost_usec_per_op, 100,
+             "Microseconds of RPC handler time per second that cost as much as one operation per "
+             "second in cost based load balancing. 0 to ignore handler time.");
+TAG_FLAG(load_balancer_cost_usec_per_op, advanced);
+
+DEFINE_int32(load_balancer_cost_move_cooldown_secs, 600,
+             "Minimal interval between cost based moves of the same tablet or its leader.");
+TAG_FLAG(load_balancer_cost_move_cooldown_secs, advanced);
+TAG_FLAG(load_balancer_cost_move_cooldown_secs, runtime);
+
 DECLARE_int32(min_leader_stepdown_retry_interval_ms);
 
 namespace yb {
@@ -102,6 +134,16 @@ using std::set;
 using std::vector;
 using strings::Substitute;
 
+namespace {
+
+// Reduction of the load variance between two tablet servers if moved_load is moved from the more
+// loaded one to the other.
+double MoveImprovement(double load_variance, double moved_load) {
+  return load_variance - std::abs(load_variance - 2 * moved_load);
+}
+
+} // namespace
+
 Status ClusterLoadBalancer::UpdateTabletInfo(TabletInfo* tablet) {
   const auto& table_id = tablet->table()->id();
   // Set the placement information on a per-table basis, only once.
@@ -404,6 +446,30 @@ void ClusterLoadBalancer::ReportUnusualLoadBalancerState() const {
 void ClusterLoadBalancer::ResetGlobalState() {
   per_table_states_.clear();
   global_state_ = std::make_unique<GlobalLoadState>();
+
+  for (auto it = last_cost_moves_.begin(); it != last_cost_moves_.end();) {
+    if (IsInCostMoveCooldown(it->first)) {
+      ++it;
+    } else {
+      it = last_cost_moves_.erase(it);
+    }
+  }
+}
+
+bool ClusterLoadBalancer::IsInCostMoveCooldown(const TabletId& tablet_id) const {
+  auto it = last_cost_moves_.find(tablet_id);
+  if (it == last_cost_moves_.end()) {
+    return false;
+  }
+  const auto cooldown = MonoDelta::FromSeconds(
+      GetAtomicFlag(&FLAGS_load_balancer_cost_move_cooldown_secs));
+  return MonoTime::Now() - it->second < cooldown;
+}
+
+void ClusterLoadBalancer::RecordCostMove(const TabletId& tablet_id) {
+  if (state_->options_->kCostBasedBalancing) {
+    last_cost_moves_[tablet_id] = MonoTime::Now();
+  }
 }
 
 void ClusterLoadBalancer::ResetTableStatePtr(const TableId& table_id, Options* options) {
@@ -623,7 +689,7 @@ void ClusterLoadBalancer::DumpSortedLoad() const {
   out << "Table load: ";
   for (int left = 0; left <= last_pos; ++left) {
     const TabletServerId& uuid = state_->sorted_load_[left];
-    int load = state_->GetLoad(uuid);
+    double load = state_->GetBalancingLoad(uuid);
     out << uuid << ":" << load << " ";
   }
   VLOG(1) << out.str();
@@ -660,7 +726,8 @@ Result<bool> ClusterLoadBalancer::GetLoadToMove(
     for (int right = last_pos; right >= 0; --right) {
       const TabletServerId& low_load_uuid = state_->sorted_load_[left];
       const TabletServerId& high_load_uuid = state_->sorted_load_[right];
-      int load_variance = state_->GetLoad(high_load_uuid) - state_->GetLoad(low_load_uuid);
+      double load_variance =
+          state_->GetBalancingLoad(high_load_uuid) - state_->GetBalancingLoad(low_load_uuid);
 
       // Check for state change or end conditions.
       if (left == right || load_variance < state_->options_->kMinLoadVarianceToBalance) {
@@ -674,12 +741,14 @@ Result<bool> ClusterLoadBalancer::GetLoadToMove(
       }
 
       // If we don't find a tablet_id to move between these two TSs, advance the state.
-      if (VERIFY_RESULT(GetTabletToMove(high_load_uuid, low_load_uuid, moving_tablet_id))) {
+      if (VERIFY_RESULT(GetTabletToMove(
+              high_load_uuid, low_load_uuid, load_variance, moving_tablet_id))) {
         // If we got this far, we have the candidate we want, so fill in the output params and
         // return. The tablet_id is filled in from GetTabletToMove.
         *from_ts = high_load_uuid;
         *to_ts = low_load_uuid;
         RETURN_NOT_OK(MoveReplica(*moving_tablet_id, high_load_uuid, low_load_uuid));
+        RecordCostMove(*moving_tablet_id);
         return true;
       }
     }
@@ -712,7 +781,8 @@ Result<bool> ClusterLoadBalancer::ShouldSkipLeaderAsVictim(const TabletId& table
 }
 
 Result<bool> ClusterLoadBalancer::GetTabletToMove(
-    const TabletServerId& from_ts, const TabletServerId& to_ts, TabletId* moving_tablet_id) {
+    const TabletServerId& from_ts, const TabletServerId& to_ts, double load_variance,
+    TabletId* moving_tablet_id) {
   const auto& from_ts_meta = state_->per_ts_meta_[from_ts];
   set<TabletId> non_over_replicated_tablets;
   set<TabletId> all_tablets;
@@ -729,6 +799,10 @@ Result<bool> ClusterLoadBalancer::GetTabletToMove(
       continue;
     }
 
+    if (state_->IsWitnessReplica(tablet_id, from_ts)) {
+      continue;
+    }
+
     if (VERIFY_RESULT(
         state_->CanAddTabletToTabletServer(tablet_id, to_ts, &GetPlacementByTablet(tablet_id)))) {
       non_over_replicated_tablets.insert(tablet_id);
@@ -741,6 +815,11 @@ Result<bool> ClusterLoadBalancer::GetTabletToMove(
   // prioritize moving from non-leaders, keep iterating until we find such a move. Otherwise,
   // return the move from the leader.
   bool found_tablet_move_from_leader = false;
+  // In cost based mode we pick the move that reduces the load variance the most, still preferring
+  // moves from non-leaders.
+  const bool cost_based = state_->options_->kCostBasedBalancing;
+  bool found_tablet_move = false;
+  double best_improvement = 0;
   for (const auto& tablet_id : non_over_replicated_tablets) {
     const auto& placement_info = GetPlacementByTablet(tablet_id);
     // TODO(bogdan): this should be augmented as well to allow dropping by one replica, if still
@@ -756,6 +835,28 @@ Result<bool> ClusterLoadBalancer::GetTabletToMove(
     bool skip_leader = VERIFY_RESULT(ShouldSkipLeaderAsVictim(tablet_id));
     bool moving_from_leader = state_->per_tablet_meta_[tablet_id].leader_uuid == from_ts;
 
+    if (cost_based) {
+      if ((moving_from_leader && skip_leader) || IsInCostMoveCooldown(tablet_id)) {
+        continue;
+      }
+      const double improvement =
+          MoveImprovement(load_variance, state_->GetTabletBalancingLoad(tablet_id));
+      if (improvement < state_->options_->kMinCostImprovementToBalance) {
+        continue;
+      }
+      if (moving_from_leader && found_tablet_move && !found_tablet_move_from_leader) {
+        continue;
+      }
+      if (!found_tablet_move || (found_tablet_move_from_leader && !moving_from_leader) ||
+          improvement > best_improvement) {
+        *moving_tablet_id = tablet_id;
+        found_tablet_move = true;
+        found_tablet_move_from_leader = moving_from_leader;
+        best_improvement = improvement;
+      }
+      continue;
+    }
+
     if (!moving_from_leader) {
       // If we're not moving from a leader, choose this tablet and return true.
       *moving_tablet_id = tablet_id;
@@ -775,6 +876,10 @@ Result<bool> ClusterLoadBalancer::GetTabletToMove(
     }
   }
 
+  if (cost_based) {
+    return found_tablet_move;
+  }
+
   // We couldn't find any moves from a non-leader, so return true if we found a move from a leader.
   return found_tablet_move_from_leader;
 }
@@ -846,8 +951,8 @@ Result<bool> ClusterLoadBalancer::GetLeaderToMove(
       const TabletServerId& high_load_uuid = state_->sorted_leader_load_[right];
       auto high_leader_blacklisted = (state_->leader_blacklisted_servers_.find(high_load_uuid) !=
           state_->leader_blacklisted_servers_.end());
-      int load_variance =
-          state_->GetLeaderLoad(high_load_uuid) - state_->GetLeaderLoad(low_load_uuid);
+      double load_variance = state_->GetBalancingLeaderLoad(high_load_uuid) -
+                             state_->GetBalancingLeaderLoad(low_load_uuid);
 
       // Check for state change or end conditions.
       if (left == right || (load_variance < state_->options_->kMinLeaderLoadVarianceToBalance &&
@@ -870,6 +975,10 @@ Result<bool> ClusterLoadBalancer::GetLeaderToMove(
       std::set_intersection(leaders.begin(), leaders.end(), peers.begin(), peers.end(), itr);
 
       for (const auto& tablet_id : intersection) {
+        // Witness could not serve as leader.
+        if (state_->IsWitnessReplica(tablet_id, low_load_uuid)) {
+          continue;
+        }
         *moving_tablet_id = tablet_id;
         *from_ts = high_load_uuid;
         *to_ts = low_load_uuid;
@@ -895,6 +1004,19 @@ Result<bool> ClusterLoadBalancer::GetLeaderToMove(
           LOG(WARNING) << "Did not find load balancer metadata for tablet " << *moving_tablet_id;
         }
 
+        // In cost based mode, only move leaders that noticeably even out the load, unless the
+        // leader has to be moved off the leader blacklisted TS.
+        if (state_->options_->kCostBasedBalancing && !high_leader_blacklisted) {
+          if (IsInCostMoveCooldown(tablet_id)) {
+            continue;
+          }
+          const double improvement =
+              MoveImprovement(load_variance, state_->GetTabletBalancingLeaderLoad(tablet_id));
+          if (improvement < state_->options_->kMinCostImprovementToBalance) {
+            continue;
+          }
+        }
+
         // Leader movement solely due to leader blacklist.
         if (load_variance < state_->options_->kMinLeaderLoadVarianceToBalance &&
             high_leader_blacklisted) {
@@ -932,6 +1054,15 @@ Result<bool> ClusterLoadBalancer::HandleRemoveReplicas(
       return STATUS_SUBSTITUTE(IllegalState, "No tservers to remove from over-replicated "
                                              "tablet $0", tablet_id);
     }
+    // Witness replicas are never removed by load balancer.
+    sorted_ts.erase(std::remove_if(sorted_ts.begin(), sorted_ts.end(),
+                                   [this, &tablet_id](const TabletServerId& ts_uuid) {
+                                     return state_->IsWitnessReplica(tablet_id, ts_uuid);
+                                   }),
+                    sorted_ts.end());
+    if (sorted_ts.empty()) {
+      continue;
+    }
     // Sort in reverse to first try to remove a replica from the highest loaded TS.
     sort(sorted_ts.rbegin(), sorted_ts.rend(), comparator);
     string remove_candidate = sorted_ts[0];
@@ -971,10 +1102,14 @@ Result<bool> ClusterLoadBalancer::HandleRemoveIfWrongPlacement(
     if (!tablet_meta.blacklisted_tablet_servers.empty()) {
       target_uuid = *tablet_meta.blacklisted_tablet_servers.begin();
     }
-    // If no blacklisted server could be chosen, try the wrong placement ones.
+    // If no blacklisted server could be chosen, try the wrong placement ones. Witness replicas
+    // are placed explicitly, so they are only removed when blacklisted.
     if (target_uuid.empty()) {
-      if (!tablet_meta.wrong_placement_tablet_servers.empty()) {
-        target_uuid = *tablet_meta.wrong_placement_tablet_servers.begin();
+      for (const auto& ts_uuid : tablet_meta.wrong_placement_tablet_servers) {
+        if (!state_->IsWitnessReplica(tablet_id, ts_uuid)) {
+          target_uuid = ts_uuid;
+          break;
+        }
       }
     }
     // If we found a tablet server, choose it.
@@ -993,6 +1128,7 @@ Result<bool> ClusterLoadBalancer::HandleLeaderMoves(
     TabletId* out_tablet_id, TabletServerId* out_from_ts, TabletServerId* out_to_ts) {
   if (VERIFY_RESULT(GetLeaderToMove(out_tablet_id, out_from_ts, out_to_ts))) {
     RETURN_NOT_OK(MoveLeader(*out_tablet_id, *out_from_ts, *out_to_ts));
+    RecordCostMove(*out_tablet_id);
     return true;
   }
   return false;
@@ -71,6 +71,11 @@ namespace master {
 //  leaders and moving some leaders to the servers with less to achieve an even distribution. If
 //  a threshold is set in the configuration, the balancer will just keep the numbers of leaders
 //  on each server below it instead of maintaining an even distribution.
+//
+//  With cost based balancing enabled, the load of a tablet server is the number of replicas plus
+//  the cost reported for each of them, so hot tablets get spread across the cluster. To keep the
+//  balancer from chasing load fluctuations, a move should reduce the load variance by a minimal
+//  amount, and a tablet that was recently moved is not moved again until a cooldown passes.
 class ClusterLoadBalancer {
  public:
   explicit ClusterLoadBalancer(CatalogManager* cm);
@@ -230,10 +235,19 @@ class ClusterLoadBalancer {
       TabletId* moving_tablet_id, TabletServerId* from_ts, TabletServerId* to_ts)
       REQUIRES_SHARED(catalog_manager_->lock_);
 
+  // Pick a tablet to move from from_ts to to_ts, whose loads differ by load_variance.
   Result<bool> GetTabletToMove(
-      const TabletServerId& from_ts, const TabletServerId& to_ts, TabletId* moving_tablet_id)
+      const TabletServerId& from_ts, const TabletServerId& to_ts, double load_variance,
+      TabletId* moving_tablet_id)
       REQUIRES_SHARED(catalog_manager_->lock_);
 
+  // Whether a move of the tablet was recently done for cost based balancing, so it should not be
+  // moved again yet.
+  bool IsInCostMoveCooldown(const TabletId& tablet_id) const;
+
+  // Record a move of the tablet for cost based balancing, if it is enabled.
+  void RecordCostMove(const TabletId& tablet_id);
+
   // Go through sorted_leader_load_ and figure out which leader to rebalance and from which TS
   // that is serving it to which other TS.
   //
@@ -303,6 +317,10 @@ class ClusterLoadBalancer {
 
   std::unique_ptr<GlobalLoadState> global_state_;
 
+  // Times of the recent cost based moves of tablets and their leaders. Unlike the rest of the
+  // state, it is kept between the runs to limit the rate of moves of every tablet.
+  std::unordered_map<TabletId, MonoTime> last_cost_moves_;
+
   // The catalog manager of the Master that actually has the Tablet and TS state. The object is not
   // managed by this class, but by the Master's unique_ptr.
   CatalogManager* catalog_manager_;
@@ -0,0 +1,286 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_MASTER_CLUSTER_BALANCE_SIMULATOR_H
+#define YB_MASTER_CLUSTER_BALANCE_SIMULATOR_H
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/gutil/strings/substitute.h"
+#include "yb/master/cluster_balance_mocked.h"
+#include "yb/master/master.pb.h"
+
+namespace yb {
+namespace master {
+
+// Simulates a cluster driven by the load balancer. Every round reports the configured tablet load
+// to the tablet server descriptors, runs the load balancing algorithm over all tables and applies
+// the requested replica and leader changes immediately, as if they completed before the next run.
+class ClusterLoadBalancerSimulator : public ClusterLoadBalancerMocked {
+ public:
+  // Change requested by the load balancer.
+  struct Change {
+    TabletId tablet_id;
+    TabletServerId ts_uuid;
+    bool is_add;
+    bool should_remove_leader;
+    TabletServerId new_leader_uuid;
+  };
+
+  explicit ClusterLoadBalancerSimulator(Options* options)
+      : ClusterLoadBalancerMocked(options), options_(options) {}
+
+  void AddTabletServer(const TabletServerId& uuid, const std::string& zone) {
+    NodeInstancePB node;
+    node.set_permanent_uuid(uuid);
+
+    TSRegistrationPB reg;
+    reg.mutable_common()->add_private_rpc_addresses()->set_host(uuid);
+    auto ci = reg.mutable_common()->mutable_cloud_info();
+    ci->set_placement_cloud("aws");
+    ci->set_placement_region("us-west-1");
+    ci->set_placement_zone(zone);
+
+    std::shared_ptr<TSDescriptor> ts(new TSDescriptor(uuid));
+    CHECK_OK(ts->Register(node, reg, CloudInfoPB(), nullptr));
+    ts_descs_.push_back(std::move(ts));
+  }
+
+  // Creates a table with num_tablets tablets. Replicas of tablet i are placed on tablet servers
+  // starting from i modulo number of tablet servers, the first of them is the leader.
+  std::vector<TabletId> CreateTable(const TableId& table_id, int num_tablets, int num_replicas) {
+    CHECK_LE(num_replicas, ts_descs_.size());
+    scoped_refptr<TableInfo> table(new TableInfo(table_id));
+    {
+      auto l = table->LockForWrite();
+      l->mutable_data()->pb.mutable_replication_info()->mutable_live_replicas()->set_num_replicas(
+          num_replicas);
+      l->Commit();
+    }
+
+    std::vector<TabletId> result;
+    for (int i = 0; i != num_tablets; ++i) {
+      auto tablet_id = strings::Substitute("$0-tablet-$1", table_id, i);
+      scoped_refptr<TabletInfo> tablet(new TabletInfo(table, tablet_id));
+      {
+        auto l = tablet->LockForWrite();
+        l->mutable_data()->pb.set_state(SysTabletsEntryPB::RUNNING);
+        l->Commit();
+      }
+      table->AddTablet(tablet.get());
+
+      TabletInfo::ReplicaMap replicas;
+      for (int j = 0; j != num_replicas; ++j) {
+        const auto& ts_desc = ts_descs_[(i + j) % ts_descs_.size()];
+        TabletReplica replica;
+        replica.ts_desc = ts_desc.get();
+        replica.state = tablet::RUNNING;
+        replica.role = j == 0 ? consensus::RaftPeerPB::LEADER : consensus::RaftPeerPB::FOLLOWER;
+        InsertOrDie(&replicas, ts_desc->permanent_uuid(), replica);
+      }
+      tablet->SetReplicaLocations(replicas);
+
+      tablet_map_[tablet_id] = tablet;
+      result.push_back(tablet_id);
+    }
+    table_map_[table_id] = table;
+    return result;
+  }
+
+  // Sets the number of operations per second served by every replica of the tablet.
+  void SetTabletLoad(const TabletId& tablet_id, double ops_per_sec) {
+    SetTabletLoad(tablet_id, ops_per_sec, ops_per_sec);
+  }
+
+  // Sets the number of operations per second served by the leader and by each follower of the
+  // tablet.
+  void SetTabletLoad(const TabletId& tablet_id, double leader_ops_per_sec,
+                     double follower_ops_per_sec) {
+    tablet_ops_[tablet_id] = TabletOps{leader_ops_per_sec, follower_ops_per_sec};
+  }
+
+  TabletServerId LeaderOf(const TabletId& tablet_id) const {
+    TabletInfo::ReplicaMap replicas;
+    tablet_map_.at(tablet_id)->GetReplicaLocations(&replicas);
+    for (const auto& replica : replicas) {
+      if (replica.second.role == consensus::RaftPeerPB::LEADER) {
+        return replica.first;
+      }
+    }
+    return TabletServerId();
+  }
+
+  // Executes one round of the simulation and returns the changes requested by the load balancer.
+  Result<std::vector<Change>> RunRound() NO_THREAD_SAFETY_ANALYSIS {
+    ReportLoads();
+
+    changes_.clear();
+    ResetGlobalState();
+    state_ = nullptr;
+    for (const auto& table : table_map_) {
+      ResetTableStatePtr(table.first, options_);
+      RETURN_NOT_OK(AnalyzeTabletsUnlocked(table.first));
+
+      TabletId tablet_id;
+      TabletServerId from_ts, to_ts;
+      for (int i = 0; i != options_->kMaxConcurrentAdds; ++i) {
+        if (!VERIFY_RESULT(HandleAddReplicas(&tablet_id, &from_ts, &to_ts))) {
+          break;
+        }
+      }
+      for (int i = 0; i != options_->kMaxConcurrentRemovals; ++i) {
+        if (!VERIFY_RESULT(HandleRemoveReplicas(&tablet_id, &from_ts))) {
+          break;
+        }
+      }
+      for (int i = 0; i != options_->kMaxConcurrentLeaderMoves; ++i) {
+        if (!VERIFY_RESULT(HandleLeaderMoves(&tablet_id, &from_ts, &to_ts))) {
+          break;
+        }
+      }
+    }
+
+    for (const auto& change : changes_) {
+      ApplyChange(change);
+    }
+    return changes_;
+  }
+
+  // Runs rounds until the load balancer does not request any changes, up to max_rounds rounds.
+  // Returns the total number of changes, or an error if the load balancer did not settle.
+  Result<size_t> RunUntilBalanced(int max_rounds) {
+    size_t result = 0;
+    for (int round = 0; round != max_rounds; ++round) {
+      auto changes = VERIFY_RESULT(RunRound());
+      if (changes.empty()) {
+        return result;
+      }
+      result += changes.size();
+    }
+    return STATUS_FORMAT(TimedOut, "Load balancer did not settle in $0 rounds", max_rounds);
+  }
+
+  // Sum of the operations per second served by replicas on the tablet server.
+  double ServerLoad(const TabletServerId& ts_uuid) const {
+    double result = 0;
+    for (const auto& tablet : tablet_map_) {
+      TabletInfo::ReplicaMap replicas;
+      tablet.second->GetReplicaLocations(&replicas);
+      auto it = replicas.find(ts_uuid);
+      if (it != replicas.end()) {
+        result += ReplicaOps(tablet.first, it->second.role);
+      }
+    }
+    return result;
+  }
+
+  double MaxServerLoad() const {
+    double result = 0;
+    for (const auto& ts_desc : ts_descs_) {
+      result = std::max(result, ServerLoad(ts_desc->permanent_uuid()));
+    }
+    return result;
+  }
+
+  double MinServerLoad() const {
+    double result = std::numeric_limits<double>::max();
+    for (const auto& ts_desc : ts_descs_) {
+      result = std::min(result, ServerLoad(ts_desc->permanent_uuid()));
+    }
+    return result;
+  }
+
+  void SendReplicaChanges(scoped_refptr<TabletInfo> tablet, const TabletServerId& ts_uuid,
+                          const bool is_add, const bool should_remove,
+                          const TabletServerId& new_leader_uuid) override {
+    changes_.push_back(Change{tablet->id(), ts_uuid, is_add, should_remove, new_leader_uuid});
+  }
+
+ private:
+  struct TabletOps {
+    double leader;
+    double follower;
+  };
+
+  double ReplicaOps(const TabletId& tablet_id, consensus::RaftPeerPB::Role role) const {
+    auto it = tablet_ops_.find(tablet_id);
+    if (it == tablet_ops_.end()) {
+      return 0;
+    }
+    return role == consensus::RaftPeerPB::LEADER ? it->second.leader : it->second.follower;
+  }
+
+  void ReportLoads() {
+    for (const auto& ts_desc : ts_descs_) {
+      TServerMetricsPB metrics;
+      for (const auto& tablet : tablet_map_) {
+        TabletInfo::ReplicaMap replicas;
+        tablet.second->GetReplicaLocations(&replicas);
+        auto it = replicas.find(ts_desc->permanent_uuid());
+        if (it == replicas.end()) {
+          continue;
+        }
+        auto* load = metrics.add_tablet_loads();
+        load->set_tablet_id(tablet.first);
+        load->set_is_leader(it->second.role == consensus::RaftPeerPB::LEADER);
+        load->set_write_ops_per_sec(ReplicaOps(tablet.first, it->second.role));
+      }
+      ts_desc->UpdateMetrics(metrics);
+    }
+  }
+
+  void ApplyChange(const Change& change) {
+    auto tablet = tablet_map_.at(change.tablet_id);
+    TabletInfo::ReplicaMap replicas;
+    tablet->GetReplicaLocations(&replicas);
+    if (change.is_add) {
+      for (const auto& ts_desc : ts_descs_) {
+        if (ts_desc->permanent_uuid() == change.ts_uuid) {
+          TabletReplica replica;
+          replica.ts_desc = ts_desc.get();
+          replica.state = tablet::RUNNING;
+          replica.role = consensus::RaftPeerPB::FOLLOWER;
+          InsertOrDie(&replicas, change.ts_uuid, replica);
+        }
+      }
+    } else if (change.should_remove_leader) {
+      auto it = replicas.find(change.ts_uuid);
+      if (it != replicas.end()) {
+        const bool was_leader = it->second.role == consensus::RaftPeerPB::LEADER;
+        replicas.erase(it);
+        if (was_leader && !replicas.empty()) {
+          replicas.begin()->second.role = consensus::RaftPeerPB::LEADER;
+        }
+      }
+    } else {
+      for (auto& replica : replicas) {
+        replica.second.role = replica.first == change.new_leader_uuid
+            ? consensus::RaftPeerPB::LEADER : consensus::RaftPeerPB::FOLLOWER;
+      }
+    }
+    tablet->SetReplicaLocations(replicas);
+  }
+
+  Options* const options_;
+  std::unordered_map<TabletId, TabletOps> tablet_ops_;
+  std::vector<Change> changes_;
+};
+
+} // namespace master
+} // namespace yb
+
+#endif // YB_MASTER_CLUSTER_BALANCE_SIMULATOR_H
@@ -52,6 +52,16 @@ DECLARE_int32(load_balancer_max_concurrent_removals);
 
 DECLARE_int32(load_balancer_max_concurrent_moves);
 
+DECLARE_bool(load_balancer_cost_based);
+
+DECLARE_double(load_balancer_cost_weight);
+
+DECLARE_double(load_balancer_cost_min_improvement);
+
+DECLARE_int64(load_balancer_cost_bytes_per_op);
+
+DECLARE_int64(load_balancer_cost_usec_per_op);
+
 namespace yb {
 namespace master {
 
@@ -125,6 +135,16 @@ struct CBTabletMetadata {
   // Leader stepdown failures. We use this to prevent retrying the same leader stepdown too soon.
   LeaderStepDownFailureTimes leader_stepdown_failures;
 
+  // Cost of serving any replica of this tablet, from the hottest of its followers reported by
+  // tablet servers. Only used for cost based balancing.
+  double raw_cost = 0;
+
+  // Extra cost of serving the leader of this tablet, on top of raw_cost.
+  double leader_raw_cost = 0;
+
+  // Cost of each replica without the leader part, as counted in the load of its tablet server.
+  std::map<TabletServerId, double> replica_raw_costs;
+
   std::string ToString() const {
     return Format("{ running: $0 starting: $1 is_under_replicated: $2 "
                       "under_replicated_placements: $3 is_over_replicated: $4 "
@@ -150,6 +170,15 @@ struct CBTabletServerMetadata {
 
   // The set of tablet leader ids that this tablet server is currently running.
   std::set<TabletId> leaders;
+
+  // The set of tablet ids for which this tablet server hosts a witness replica.
+  std::set<TabletId> witness_tablets;
+
+  // Sum of raw costs of the replicas counted in the load of this tablet server.
+  double raw_cost = 0;
+
+  // Sum of leader raw costs of the tablets counted in the leader load of this tablet server.
+  double leader_raw_cost = 0;
 };
 
 struct Options {
@@ -189,6 +218,18 @@ struct Options {
   // Max number of tablet leaders on tablet servers to move in any one run of the load balancer.
   int kMaxConcurrentLeaderMoves = FLAGS_load_balancer_max_concurrent_moves;
 
+  // Whether to balance the load reported by tablet servers for each tablet, instead of just the
+  // number of tablets. In this mode every replica counts as one plus its tablet's cost relative
+  // to the average tablet of the table, so load variance is still measured in replicas.
+  bool kCostBasedBalancing = FLAGS_load_balancer_cost_based;
+
+  // Weight of the reported tablet cost relative to the replica count.
+  double kCostWeight = FLAGS_load_balancer_cost_weight;
+
+  // Minimal reduction of load variance between two tablet servers a move should give in cost
+  // based mode. Prevents moving tablets back and forth when their load fluctuates.
+  double kMinCostImprovementToBalance = FLAGS_load_balancer_cost_min_improvement;
+
   // TODO(bogdan): add state for leaders starting remote bootstraps, to limit on that end too.
 };
 
@@ -211,8 +252,8 @@ class PerTableLoadState {
 
   // Comparators used for sorting by load.
   bool CompareByUuid(const TabletServerId& a, const TabletServerId& b) {
-    int load_a = GetLoad(a);
-    int load_b = GetLoad(b);
+    double load_a = GetBalancingLoad(a);
+    double load_b = GetBalancingLoad(b);
     if (load_a == load_b) {
       return a < b;
     } else {
@@ -253,7 +294,7 @@ class PerTableLoadState {
       }
 
       // Secondary criteria: tserver leader load.
-      return state_->GetLeaderLoad(a) < state_->GetLeaderLoad(b);
+      return state_->GetBalancingLeaderLoad(a) < state_->GetBalancingLeaderLoad(b);
     }
     PerTableLoadState* state_;
   };
@@ -269,6 +310,105 @@ class PerTableLoadState {
     return per_ts_meta_.at(ts_uuid).leaders.size();
   }
 
+  // Average raw cost of the tablets of this table, used to normalize costs.
+  double AverageRawCost() const {
+    return per_tablet_meta_.empty() ? 0 : total_raw_cost_ / per_tablet_meta_.size();
+  }
+
+  // Convert raw cost to the units of replica count.
+  double NormalizeCost(double raw_cost) const {
+    const double average = AverageRawCost();
+    return average > 0 ? options_->kCostWeight * raw_cost / average : 0;
+  }
+
+  // Load that a replica of the specified tablet adds to the tablet server hosting it.
+  double GetTabletBalancingLoad(const TabletId& tablet_id) const {
+    if (!options_->kCostBasedBalancing) {
+      return 1;
+    }
+    auto it = per_tablet_meta_.find(tablet_id);
+    return 1 + (it != per_tablet_meta_.end() ? NormalizeCost(it->second.raw_cost) : 0);
+  }
+
+  // Load that the leader of the specified tablet adds to the leader load of the tablet server
+  // hosting it.
+  double GetTabletBalancingLeaderLoad(const TabletId& tablet_id) const {
+    if (!options_->kCostBasedBalancing) {
+      return 1;
+    }
+    auto it = per_tablet_meta_.find(tablet_id);
+    return 1 + (it != per_tablet_meta_.end() ? NormalizeCost(it->second.leader_raw_cost) : 0);
+  }
+
+  // Get the load used to balance tablets for a certain TS. Same as GetLoad unless cost based
+  // balancing is enabled.
+  double GetBalancingLoad(const TabletServerId& ts_uuid) const {
+    double result = GetLoad(ts_uuid);
+    if (options_->kCostBasedBalancing) {
+      result += NormalizeCost(per_ts_meta_.at(ts_uuid).raw_cost);
+    }
+    return result;
+  }
+
+  // Get the load used to balance leaders for a certain TS. Same as GetLeaderLoad unless cost based
+  // balancing is enabled.
+  double GetBalancingLeaderLoad(const TabletServerId& ts_uuid) const {
+    double result = GetLeaderLoad(ts_uuid);
+    if (options_->kCostBasedBalancing) {
+      result += NormalizeCost(per_ts_meta_.at(ts_uuid).leader_raw_cost);
+    }
+    return result;
+  }
+
+  // Calculate the cost of serving a tablet replica from the load reported for it. Bytes and
+  // handler time are converted to operations, so the cost is measured in operations per second.
+  static double TabletRawCost(const TSDescriptor::TabletLoad& load) {
+    double result = load.read_ops_per_sec + load.write_ops_per_sec;
+    const auto bytes_per_op = FLAGS_load_balancer_cost_bytes_per_op;
+    if (bytes_per_op > 0) {
+      result += (load.read_bytes_per_sec + load.write_bytes_per_sec) / bytes_per_op;
+    }
+    const auto usec_per_op = FLAGS_load_balancer_cost_usec_per_op;
+    if (usec_per_op > 0) {
+      result += load.handler_usec_per_sec / usec_per_op;
+    }
+    return result;
+  }
+
+  // Split the costs reported for the replicas of a tablet into the cost of any replica and the
+  // extra cost of the leader. Followers apply the same writes as the leader, but only the leader
+  // serves client requests, so that part of the cost moves with leadership rather than with
+  // replicas. Replicas without a report are assumed to cost as much as the hottest follower.
+  void UpdateTabletRawCosts(
+      const TabletId& tablet_id, const TabletInfo::ReplicaMap& replica_map,
+      CBTabletMetadata* tablet_meta) {
+    std::map<TabletServerId, double> reported_costs;
+    double leader_cost = 0;
+    for (const auto& replica : replica_map) {
+      TSDescriptor::TabletLoad load;
+      if (!replica.second.ts_desc->GetTabletLoad(tablet_id, &load)) {
+        continue;
+      }
+      const double cost = TabletRawCost(load);
+      reported_costs.emplace(replica.first, cost);
+      if (replica.second.role == consensus::RaftPeerPB::LEADER) {
+        leader_cost = cost;
+      } else {
+        tablet_meta->raw_cost = std::max(tablet_meta->raw_cost, cost);
+      }
+    }
+    tablet_meta->leader_raw_cost = std::max(leader_cost - tablet_meta->raw_cost, 0.0);
+    for (const auto& replica : replica_map) {
+      auto it = reported_costs.find(replica.first);
+      double cost = it != reported_costs.end() ? it->second : tablet_meta->raw_cost;
+      if (replica.second.role == consensus::RaftPeerPB::LEADER) {
+        cost -= tablet_meta->leader_raw_cost;
+      }
+      tablet_meta->replica_raw_costs[replica.first] = cost;
+    }
+    total_raw_cost_ += tablet_meta->raw_cost + tablet_meta->leader_raw_cost;
+  }
+
   void SetBlacklist(const BlacklistPB& blacklist) { blacklist_ = blacklist; }
   void SetLeaderBlacklist(const BlacklistPB& leader_blacklist) {
     leader_blacklist_ = leader_blacklist;
@@ -286,6 +426,10 @@ class PerTableLoadState {
     // Get replicas for this tablet.
     TabletInfo::ReplicaMap replica_map;
     GetReplicaLocations(tablet, &replica_map);
+
+    if (options_->kCostBasedBalancing) {
+      UpdateTabletRawCosts(tablet_id, replica_map, &tablet_meta);
+    }
     // Set state information for both the tablet and the tablet server replicas.
     for (const auto& replica : replica_map) {
       const auto& ts_uuid = replica.first;
@@ -309,6 +453,11 @@ class PerTableLoadState {
       if (replica.second.role == consensus::RaftPeerPB::LEADER) {
         tablet_meta.leader_uuid = ts_uuid;
         ts_meta_it->second.leaders.insert(tablet_id);
+        ts_meta_it->second.leader_raw_cost += tablet_meta.leader_raw_cost;
+      }
+
+      if (replica.second.is_witness) {
+        ts_meta_it->second.witness_tablets.insert(tablet_id);
       }
 
       const tablet::RaftGroupStatePB& tablet_state = replica.second.state;
@@ -317,12 +466,14 @@ class PerTableLoadState {
                 << " is in state " << RaftGroupStatePB_Name(tablet_state);
       if (tablet_state == tablet::RUNNING) {
         ts_meta_it->second.running_tablets.insert(tablet_id);
+        ts_meta_it->second.raw_cost += tablet_meta.replica_raw_costs[ts_uuid];
         ++tablet_meta.running;
         ++total_running_;
       } else if (!replica_is_stale &&
                  (tablet_state == tablet::BOOTSTRAPPING || tablet_state == tablet::NOT_STARTED)) {
         // Keep track of transitioning state (not running, but not in a stopped or failed state).
         ts_meta_it->second.starting_tablets.insert(tablet_id);
+        ts_meta_it->second.raw_cost += tablet_meta.replica_raw_costs[ts_uuid];
         ++tablet_meta.starting;
         ++total_starting_;
         VLOG(1) << "Increased total_starting to "
@@ -462,6 +613,11 @@ class PerTableLoadState {
     }
   }
 
+  // Witness replicas are placed explicitly, so load balancer does not move them.
+  bool IsWitnessReplica(const TabletId& tablet_id, const TabletServerId& ts_uuid) {
+    return per_ts_meta_[ts_uuid].witness_tablets.count(tablet_id) != 0;
+  }
+
   Result<bool> CanAddTabletToTabletServer(
     const TabletId& tablet_id, const TabletServerId& to_ts,
     const PlacementInfoPB* placement_info = nullptr) {
@@ -577,6 +733,9 @@ class PerTableLoadState {
 
   Status AddReplica(const TabletId& tablet_id, const TabletServerId& to_ts) {
     per_ts_meta_[to_ts].starting_tablets.insert(tablet_id);
+    auto& tablet_meta = per_tablet_meta_[tablet_id];
+    tablet_meta.replica_raw_costs[to_ts] = tablet_meta.raw_cost;
+    per_ts_meta_[to_ts].raw_cost += tablet_meta.raw_cost;
     ++per_tablet_meta_[tablet_id].starting;
     ++total_starting_;
     ++global_state_->total_starting_tablets_;
@@ -588,6 +747,7 @@ class PerTableLoadState {
   Status RemoveReplica(const TabletId& tablet_id, const TabletServerId& from_ts) {
     if (per_ts_meta_[from_ts].running_tablets.count(tablet_id)) {
       per_ts_meta_[from_ts].running_tablets.erase(tablet_id);
+      per_ts_meta_[from_ts].raw_cost -= per_tablet_meta_[tablet_id].replica_raw_costs[from_ts];
       --per_tablet_meta_[tablet_id].running;
       --total_running_;
     }
@@ -621,10 +781,13 @@ class PerTableLoadState {
       return STATUS_SUBSTITUTE(IllegalState, "Tablet $0 has leader $1, but $2 expected.",
                                tablet_id, per_tablet_meta_[tablet_id].leader_uuid, from_ts);
     }
+    const auto raw_cost = per_tablet_meta_[tablet_id].leader_raw_cost;
     per_tablet_meta_[tablet_id].leader_uuid = to_ts;
     per_ts_meta_[from_ts].leaders.erase(tablet_id);
+    per_ts_meta_[from_ts].leader_raw_cost -= raw_cost;
     if (!to_ts.empty()) {
       per_ts_meta_[to_ts].leaders.insert(tablet_id);
+      per_ts_meta_[to_ts].leader_raw_cost += raw_cost;
     }
     SortLeaderLoad();
     return Status::OK();
@@ -702,6 +865,9 @@ class PerTableLoadState {
   // Total number of tablet replicas being started across the cluster.
   int total_starting_ = 0;
 
+  // Sum of raw costs of the tablets of this table, used for cost based balancing.
+  double total_raw_cost_ = 0;
+
   // Set of ts_uuid sorted ascending by load. This is the actual raw data of TS load.
   vector<TabletServerId> sorted_load_;
 
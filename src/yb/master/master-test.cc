@@ -31,6 +31,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <set>
 #include <sstream>
 #include <tuple>
 #include <vector>
@@ -66,6 +67,7 @@ DECLARE_bool(TEST_return_error_if_namespace_not_found);
 DECLARE_bool(TEST_hang_on_namespace_transition);
 DECLARE_bool(TEST_simulate_crash_after_table_marked_deleting);
 DECLARE_int32(TEST_sys_catalog_write_rejection_percentage);
+DECLARE_int32(catalog_manager_report_num_shards);
 
 namespace yb {
 namespace master {
@@ -273,6 +275,126 @@ TEST_F(MasterTest, TestRegisterAndHeartbeat) {
   }
 }
 
+// Full tablet report split into chunks, with tablets of several tables processed in parallel
+// shards.
+TEST_F(MasterTest, TestChunkedTabletReport) {
+  constexpr int kNumTables = 3;
+  const char *kTsUUID = "my-ts-uuid";
+  FLAGS_catalog_manager_report_num_shards = 4;
+
+  TSToMasterCommonPB common;
+  common.mutable_ts_instance()->set_permanent_uuid(kTsUUID);
+  common.mutable_ts_instance()->set_instance_seqno(1);
+
+  {
+    TSHeartbeatRequestPB req;
+    TSHeartbeatResponsePB resp;
+    req.mutable_common()->CopyFrom(common);
+    MakeHostPortPB("localhost", 1000,
+                   req.mutable_registration()->mutable_common()->add_private_rpc_addresses());
+    ASSERT_OK(proxy_->TSHeartbeat(req, &resp, ResetAndGetController()));
+    ASSERT_TRUE(resp.needs_full_tablet_report());
+  }
+
+  const Schema kTableSchema({ ColumnSchema("key", INT32) }, 1);
+  std::set<TableName> table_names;
+  for (int i = 0; i != kNumTables; ++i) {
+    auto table_name = Format("testtb$0", i);
+    ASSERT_OK(CreateTable(table_name, kTableSchema));
+    table_names.insert(table_name);
+  }
+
+  auto* catalog_manager = mini_master_->master()->catalog_manager();
+  std::vector<scoped_refptr<TabletInfo>> tablets;
+  {
+    SharedLock<CatalogManager::LockType> l(catalog_manager->lock_);
+    for (const auto& elem : *catalog_manager->tablet_map_) {
+      if (table_names.count(elem.second->table()->name())) {
+        tablets.push_back(elem.second);
+      }
+    }
+  }
+  ASSERT_GT(tablets.size(), static_cast<size_t>(kNumTables));
+
+  auto add_tablets = [&tablets, kTsUUID](int begin, int end, TabletReportPB* report) {
+    for (auto i = begin; i != end; ++i) {
+      auto* reported = report->add_updated_tablets();
+      reported->set_tablet_id(tablets[i]->tablet_id());
+      reported->set_state(tablet::BOOTSTRAPPING);
+      reported->set_tablet_data_state(tablet::TABLET_DATA_READY);
+      auto* cstate = reported->mutable_committed_consensus_state();
+      cstate->set_current_term(1);
+      cstate->set_leader_uuid(kTsUUID);
+      cstate->mutable_config()->set_opid_index(1);
+      auto* peer = cstate->mutable_config()->add_peers();
+      peer->set_permanent_uuid(kTsUUID);
+      peer->set_member_type(consensus::RaftPeerPB::VOTER);
+    }
+  };
+
+  std::shared_ptr<TSDescriptor> ts_desc;
+  ASSERT_TRUE(mini_master_->master()->ts_manager()->LookupTSByUUID(kTsUUID, &ts_desc));
+  const int first_chunk = tablets.size() / 2;
+  const int num_tablets = tablets.size();
+
+  // First chunk of the full report.
+  {
+    TSHeartbeatRequestPB req;
+    TSHeartbeatResponsePB resp;
+    req.mutable_common()->CopyFrom(common);
+    auto* report = req.mutable_tablet_report();
+    report->set_is_incremental(false);
+    report->set_sequence_number(0);
+    report->set_remaining_tablet_count(num_tablets - first_chunk);
+    add_tablets(0, first_chunk, report);
+    ASSERT_OK(proxy_->TSHeartbeat(req, &resp, ResetAndGetController()));
+
+    ASSERT_FALSE(resp.needs_full_tablet_report());
+    ASSERT_EQ(resp.tablet_report().tablets_size(), first_chunk);
+    ASSERT_TRUE(ts_desc->has_partial_tablet_report());
+    ASSERT_FALSE(ts_desc->has_tablet_report());
+  }
+
+  // The rest of the tablets are sent in an incremental report.
+  {
+    TSHeartbeatRequestPB req;
+    TSHeartbeatResponsePB resp;
+    req.mutable_common()->CopyFrom(common);
+    auto* report = req.mutable_tablet_report();
+    report->set_is_incremental(true);
+    report->set_sequence_number(1);
+    report->set_remaining_tablet_count(0);
+    add_tablets(first_chunk, num_tablets, report);
+    ASSERT_OK(proxy_->TSHeartbeat(req, &resp, ResetAndGetController()));
+
+    ASSERT_FALSE(resp.needs_full_tablet_report());
+    ASSERT_EQ(resp.tablet_report().tablets_size(), num_tablets - first_chunk);
+    ASSERT_FALSE(ts_desc->has_partial_tablet_report());
+    ASSERT_TRUE(ts_desc->has_tablet_report());
+  }
+
+  // Stale incremental report is ignored.
+  {
+    TSHeartbeatRequestPB req;
+    TSHeartbeatResponsePB resp;
+    req.mutable_common()->CopyFrom(common);
+    auto* report = req.mutable_tablet_report();
+    report->set_is_incremental(true);
+    report->set_sequence_number(1);
+    add_tablets(0, 1, report);
+    ASSERT_OK(proxy_->TSHeartbeat(req, &resp, ResetAndGetController()));
+
+    ASSERT_EQ(resp.tablet_report().tablets_size(), 0);
+  }
+
+  // Every reported tablet was processed by one of the shards.
+  for (const auto& tablet : tablets) {
+    TabletInfo::ReplicaMap replicas;
+    tablet->GetReplicaLocations(&replicas);
+    ASSERT_EQ(replicas.count(kTsUUID), 1U) << tablet->ToString();
+  }
+}
+
 TEST_F(MasterTest, TestListTablesWithoutMasterCrash) {
   FLAGS_TEST_simulate_slow_table_create_secs = 10;
 
@@ -54,6 +54,7 @@
 #include "yb/master/master_tablet_service.h"
 #include "yb/master/master-path-handlers.h"
 #include "yb/master/sys_catalog.h"
+#include "yb/master/tablet_split_manager.h"
 #include "yb/master/ts_manager.h"
 #include "yb/rpc/messenger.h"
 #include "yb/rpc/service_if.h"
@@ -133,6 +134,7 @@ Master::Master(const MasterOptions& opts)
     catalog_manager_(new enterprise::CatalogManager(this)),
     path_handlers_(new MasterPathHandlers(this)),
     flush_manager_(new FlushManager(this, catalog_manager())),
+    tablet_split_manager_(new TabletSplitManager(catalog_manager())),
     opts_(opts),
     registration_initialized_(false),
     maintenance_manager_(new MaintenanceManager(MaintenanceManager::DEFAULT_OPTIONS)),
@@ -71,6 +71,7 @@ class CatalogManager;
 class TSManager;
 class MasterPathHandlers;
 class FlushManager;
+class TabletSplitManager;
 
 class Master : public server::RpcAndWebServerBase {
  public:
@@ -100,6 +101,8 @@ class Master : public server::RpcAndWebServerBase {
 
   FlushManager* flush_manager() const { return flush_manager_.get(); }
 
+  TabletSplitManager* tablet_split_manager() const { return tablet_split_manager_.get(); }
+
   scoped_refptr<MetricEntity> metric_entity_cluster() { return metric_entity_cluster_; }
 
   void SetMasterAddresses(std::shared_ptr<server::MasterAddresses> master_addresses) {
@@ -177,6 +180,7 @@ class Master : public server::RpcAndWebServerBase {
   gscoped_ptr<enterprise::CatalogManager> catalog_manager_;
   gscoped_ptr<MasterPathHandlers> path_handlers_;
   gscoped_ptr<FlushManager> flush_manager_;
+  gscoped_ptr<TabletSplitManager> tablet_split_manager_;
 
   // For initializing the catalog manager.
   gscoped_ptr<ThreadPool> init_pool_;
@@ -14,9 +14,11 @@
 #ifndef YB_MASTER_MASTER_FWD_H
 #define YB_MASTER_MASTER_FWD_H
 
+#include <array>
 #include <memory>
 #include <vector>
 
+#include "yb/common/entity_ids.h"
 #include "yb/gutil/ref_counted.h"
 
 namespace yb {
@@ -47,10 +49,15 @@ class SysSnapshotEntryPB;
 class TabletInfo;
 class TSHeartbeatRequestPB;
 class TSHeartbeatResponsePB;
+class TServerMetricsPB;
 
 typedef scoped_refptr<TabletInfo> TabletInfoPtr;
 typedef std::vector<TabletInfoPtr> TabletInfos;
 
+// Number of tablets a tablet is split into.
+constexpr int kNumSplitParts = 2;
+typedef std::array<TabletId, kNumSplitParts> SplitTabletIds;
+
 } // namespace master
 } // namespace yb
 
@@ -43,6 +43,7 @@
 #include "yb/master/flush_manager.h"
 #include "yb/master/master_service_base-internal.h"
 #include "yb/master/master.h"
+#include "yb/master/tablet_split_manager.h"
 #include "yb/master/ts_descriptor.h"
 #include "yb/master/ts_manager.h"
 #include "yb/master/encryption_manager.h"
@@ -56,6 +57,13 @@ DEFINE_int64(tablet_split_size_threshold_bytes, 0,
              "Threshold on tablet size after which tablet should be split. Automated splitting is "
              "disabled if this value is set to 0");
 
+DEFINE_int64(tablet_split_ops_per_sec_threshold, 0,
+             "Threshold on the number of read and write operations per second served by a tablet "
+             "after which tablet should be split. Load based splitting is disabled if this value "
+             "is set to 0");
+TAG_FLAG(tablet_split_ops_per_sec_threshold, advanced);
+TAG_FLAG(tablet_split_ops_per_sec_threshold, runtime);
+
 DEFINE_int32(master_inject_latency_on_tablet_lookups_ms, 0,
              "Number of milliseconds that the master will sleep before responding to "
              "requests for tablet locations.");
@@ -68,6 +76,8 @@ DEFINE_test_flag(bool, master_fail_transactional_tablet_lookups, false,
 DEFINE_double(master_slow_get_registration_probability, 0,
               "Probability of injecting delay in GetMasterRegistration.");
 
+DECLARE_bool(load_balancer_cost_based);
+
 using namespace std::literals;
 
 namespace yb {
@@ -200,17 +210,10 @@ void MasterServiceImpl::TSHeartbeat(const TSHeartbeatRequestPB* req,
     // minimize probability of TSHeartbeat RPC timeout and retry.
     // This will be improved to handle split retries appropriately and then we won't need that
     // check.
-    for (const auto& tablet : req->tablets_for_split()) {
-      LOG(INFO) << "Got tablet to split: " << AsString(tablet);
-      const auto split_status = server_->catalog_manager()->SplitTablet(
-          tablet.tablet_id(), tablet.split_encoded_key(), tablet.split_partition_key());
-      if (!split_status.ok()) {
-        LOG(WARNING) << split_status;
-      }
-    }
+    server_->tablet_split_manager()->ProcessHeartbeat(*ts_desc, *req);
   }
 
-  if (!ts_desc->has_tablet_report()) {
+  if (!ts_desc->has_tablet_report() && !ts_desc->has_partial_tablet_report()) {
     resp->set_needs_full_tablet_report(true);
   }
 
@@ -228,6 +231,12 @@ void MasterServiceImpl::TSHeartbeat(const TSHeartbeatRequestPB* req,
   if (FLAGS_tablet_split_size_threshold_bytes > 0) {
     resp->set_tablet_split_size_threshold_bytes(FLAGS_tablet_split_size_threshold_bytes);
   }
+  if (FLAGS_tablet_split_ops_per_sec_threshold > 0) {
+    resp->set_tablet_split_ops_per_sec_threshold(FLAGS_tablet_split_ops_per_sec_threshold);
+  }
+  if (FLAGS_load_balancer_cost_based) {
+    resp->set_report_tablet_loads(true);
+  }
 
   rpc.RespondSuccess();
 }
@@ -70,6 +70,13 @@ bool MasterTabletServer::LeaderAndReady(const TabletId& tablet_id, bool allow_st
   return tablet_peer->LeaderStatus(allow_stale) == consensus::LeaderStatus::LEADER_AND_READY;
 }
 
+Status MasterTabletServer::GetTransactionStatus(
+    const tserver::GetTransactionStatusRequestPB* req,
+    CoarseTimePoint deadline,
+    tserver::GetTransactionStatusResponsePB* resp) const {
+  return STATUS(NotSupported, "Transaction status is not served by master tserver");
+}
+
 const NodeInstancePB& MasterTabletServer::NodeInstance() const {
   return master_->catalog_manager()->NodeInstance();
 }
@@ -46,6 +46,10 @@ class MasterTabletServer : public tserver::TabletServerIf,
 
   bool LeaderAndReady(const TabletId& tablet_id, bool allow_stale = false) const override;
 
+  CHECKED_STATUS GetTransactionStatus(const tserver::GetTransactionStatusRequestPB* req,
+                                      CoarseTimePoint deadline,
+                                      tserver::GetTransactionStatusResponsePB* resp) const override;
+
   const NodeInstancePB& NodeInstance() const override;
 
   CHECKED_STATUS GetRegistration(ServerRegistrationPB* reg) const override;
@@ -38,6 +38,8 @@
 
 #include "yb/gutil/stl_util.h"
 #include "yb/master/async_rpc_tasks.h"
+#include "yb/master/catalog_loaders.h"
+#include "yb/util/threadpool.h"
 #include "yb/util/net/sockaddr.h"
 #include "yb/util/status.h"
 
@@ -50,6 +52,9 @@ using yb::rpc::MessengerBuilder;
 using yb::rpc::RpcController;
 
 DECLARE_string(cluster_uuid);
+DECLARE_bool(catalog_manager_use_entry_cache);
+
+METRIC_DECLARE_counter(catalog_entry_cache_disabled);
 
 namespace yb {
 namespace master {
@@ -356,6 +361,106 @@ TEST_F(SysCatalogTest, TestSysCatalogTabletsOperations) {
   }
 }
 
+// Loader that could be called concurrently, see ParallelLoadVisitor.
+class TestParallelTabletLoader : public Visitor<PersistentTabletInfo> {
+ public:
+  Status Visit(const std::string& tablet_id, const SysTabletsEntryPB& metadata) override {
+    std::lock_guard<std::mutex> lock(mutex);
+    tablets[tablet_id] = metadata.partition().partition_key_start();
+    return Status::OK();
+  }
+
+  std::mutex mutex;
+  std::map<std::string, std::string> tablets;
+};
+
+TEST_F(SysCatalogTest, TestParallelLoadVisitor) {
+  constexpr int kNumTablets = 100;
+  scoped_refptr<TableInfo> table(master_->catalog_manager()->NewTableInfo("abc"));
+  std::vector<scoped_refptr<TabletInfo>> tablets;
+  std::vector<TabletInfo*> to_add;
+  for (int i = 0; i != kNumTablets; ++i) {
+    auto key = Format("$0", i);
+    tablets.emplace_back(CreateTablet(table.get(), "tablet-" + key, key, key + "~"));
+    to_add.push_back(tablets.back().get());
+  }
+
+  SysCatalogTable* sys_catalog = master_->catalog_manager()->sys_catalog();
+  ASSERT_OK(sys_catalog->AddItems(to_add, kLeaderTerm));
+  for (const auto& tablet : tablets) {
+    tablet->mutable_metadata()->CommitMutation();
+  }
+
+  std::unique_ptr<ThreadPool> pool;
+  ASSERT_OK(ThreadPoolBuilder("test-load").set_max_threads(4).Build(&pool));
+  for (size_t batch_size : {1, 7, 1000}) {
+    TestParallelTabletLoader loader;
+    ParallelLoadVisitor visitor(&loader, pool.get(), batch_size, 3);
+    ASSERT_OK(sys_catalog->Visit(&visitor));
+    ASSERT_OK(visitor.Wait());
+    ASSERT_EQ(kNumTablets + kNumSystemTables, loader.tablets.size());
+    for (int i = 0; i != kNumTablets; ++i) {
+      ASSERT_EQ(Format("$0", i), loader.tablets[Format("tablet-$0", i)]);
+    }
+  }
+  pool->Shutdown();
+}
+
+class SysCatalogEntryCacheTest : public SysCatalogTest {
+ protected:
+  void SetUp() override {
+    FLAGS_catalog_manager_use_entry_cache = true;
+    SysCatalogTest::SetUp();
+  }
+};
+
+// Verify that catalog entry cache follows tablets added, updated and deleted in sys catalog.
+TEST_F(SysCatalogEntryCacheTest, TestCatalogEntryCache) {
+  scoped_refptr<TableInfo> table(master_->catalog_manager()->NewTableInfo("abc"));
+  scoped_refptr<TabletInfo> tablet1(CreateTablet(table.get(), "123", "a", "b"));
+  scoped_refptr<TabletInfo> tablet2(CreateTablet(table.get(), "456", "b", "c"));
+
+  SysCatalogTable* sys_catalog = master_->catalog_manager()->sys_catalog();
+  CatalogEntryCache& cache = master_->catalog_manager()->catalog_entry_cache();
+
+  ASSERT_OK(sys_catalog->AddItems(std::vector<TabletInfo*>{tablet1.get(), tablet2.get()},
+                                  kLeaderTerm));
+  tablet1->mutable_metadata()->CommitMutation();
+  tablet2->mutable_metadata()->CommitMutation();
+
+  {
+    auto l1 = tablet1->LockForWrite();
+    l1->mutable_data()->pb.set_state(SysTabletsEntryPB::RUNNING);
+    ASSERT_OK(sys_catalog->UpdateItem(tablet1.get(), kLeaderTerm));
+    l1->Commit();
+  }
+  ASSERT_OK(sys_catalog->DeleteItem(tablet2.get(), kLeaderTerm));
+
+  TestTabletLoader cache_loader;
+  ASSERT_TRUE(ASSERT_RESULT(cache.Visit(&cache_loader)));
+  ASSERT_EQ(1 + kNumSystemTables, cache_loader.tablets.size());
+  ASSERT_METADATA_EQ(tablet1.get(), cache_loader.tablets[tablet1->id()]);
+  ASSERT_EQ(0, cache_loader.tablets.count(tablet2->id()));
+
+  TestTabletLoader sys_catalog_loader;
+  ASSERT_OK(sys_catalog->Visit(&sys_catalog_loader));
+  ASSERT_EQ(sys_catalog_loader.tablets.size(), cache_loader.tablets.size());
+  for (const auto& p : sys_catalog_loader.tablets) {
+    ASSERT_EQ(1, cache_loader.tablets.count(p.first)) << p.first;
+    ASSERT_METADATA_EQ(p.second, cache_loader.tablets[p.first]);
+  }
+  ASSERT_EQ(cache_loader.tablets.size(), cache.NumEntries(SysRowEntry::TABLET));
+
+  // Cache that failed to apply a write is not used till reload.
+  auto disabled_counter = METRIC_catalog_entry_cache_disabled.Instantiate(
+      master_->metric_entity());
+  ASSERT_EQ(0, disabled_counter->value());
+  ASSERT_NOK(cache.ApplyWritePair("garbage", Slice()));
+  TestTabletLoader failed_cache_loader;
+  ASSERT_FALSE(ASSERT_RESULT(cache.Visit(&failed_cache_loader)));
+  ASSERT_EQ(1, disabled_counter->value());
+}
+
 // Verify that data mutations are not available from metadata() until commit.
 TEST_F(SysCatalogTest, TestTabletInfoCommit) {
   scoped_refptr<TabletInfo> tablet(new TabletInfo(nullptr, "123"));
@@ -116,6 +116,7 @@ METRIC_DEFINE_counter(
   "Number of writes to disk handled by the system catalog.");
 
 DECLARE_int32(master_discovery_timeout_ms);
+DECLARE_bool(catalog_manager_use_entry_cache);
 
 DEFINE_int32(sys_catalog_write_timeout_ms, 60000, "Timeout for writes into system catalog");
 DEFINE_int32(copy_tables_batch_bytes, 500_KB, "Max bytes per batch for copy pg sql tables");
@@ -527,6 +528,8 @@ Status SysCatalogTable::OpenTablet(const scoped_refptr<tablet::RaftGroupMetadata
       .is_sys_catalog = tablet::IsSysCatalogTablet::kTrue,
       .snapshot_coordinator = &master_->catalog_manager()->snapshot_coordinator(),
       .tablet_splitter = nullptr,
+      .sys_catalog_write_listener = FLAGS_catalog_manager_use_entry_cache
+          ? &master_->catalog_manager()->catalog_entry_cache() : nullptr,
   };
   tablet::BootstrapTabletData data = {
       .tablet_init_data = tablet_init_data,
@@ -0,0 +1,225 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/master/tablet_split_manager.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "yb/master/catalog_manager.h"
+#include "yb/master/master.pb.h"
+#include "yb/master/ts_descriptor.h"
+#include "yb/util/atomic.h"
+#include "yb/util/flag_tags.h"
+
+DEFINE_int32(tablet_split_max_outstanding_per_table, 1,
+             "Maximum number of concurrent automatic tablet splits within a single table.");
+TAG_FLAG(tablet_split_max_outstanding_per_table, advanced);
+TAG_FLAG(tablet_split_max_outstanding_per_table, runtime);
+
+DEFINE_int32(tablet_split_max_outstanding_per_tserver, 1,
+             "Maximum number of concurrent automatic tablet splits involving replicas on a single "
+             "tablet server. Split results that were not fully compacted yet count as outstanding "
+             "splits, which throttles post-split compactions.");
+TAG_FLAG(tablet_split_max_outstanding_per_tserver, advanced);
+TAG_FLAG(tablet_split_max_outstanding_per_tserver, runtime);
+
+DEFINE_int32(tablet_split_outstanding_timeout_secs, 300,
+             "Automatic tablet split that did not complete within this time is no longer counted "
+             "as outstanding, so the tablet could be split again.");
+TAG_FLAG(tablet_split_outstanding_timeout_secs, advanced);
+TAG_FLAG(tablet_split_outstanding_timeout_secs, runtime);
+
+DECLARE_int64(tablet_split_size_threshold_bytes);
+DECLARE_int64(tablet_split_ops_per_sec_threshold);
+
+using namespace std::literals;
+
+namespace yb {
+namespace master {
+
+namespace {
+
+// Relative urgency of splitting the tablet, i.e. how far it is over the size and load thresholds.
+double SplitScore(const TabletForSplitPB& candidate) {
+  double result = 0;
+  const auto size_threshold = FLAGS_tablet_split_size_threshold_bytes;
+  if (size_threshold > 0) {
+    result += static_cast<double>(candidate.sst_size_bytes()) / size_threshold;
+  }
+  const auto ops_threshold = FLAGS_tablet_split_ops_per_sec_threshold;
+  if (ops_threshold > 0) {
+    result += (candidate.read_ops_per_sec() + candidate.write_ops_per_sec()) / ops_threshold;
+  }
+  return result;
+}
+
+} // namespace
+
+void TabletSplitManager::ProcessHeartbeat(
+    const TSDescriptor& ts_desc, const TSHeartbeatRequestPB& req) {
+  const auto now = CoarseMonoClock::Now();
+
+  std::vector<const TabletForSplitPB*> reserved;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (req.has_num_post_split_compactions()) {
+      post_split_compactions_[ts_desc.permanent_uuid()] = req.num_post_split_compactions();
+    }
+    CleanupOutstandingSplits(now);
+
+    if (req.tablets_for_split().empty()) {
+      return;
+    }
+
+    std::vector<const TabletForSplitPB*> candidates;
+    candidates.reserve(req.tablets_for_split().size());
+    for (const auto& candidate : req.tablets_for_split()) {
+      candidates.push_back(&candidate);
+    }
+    std::stable_sort(
+        candidates.begin(), candidates.end(), [](const auto* lhs, const auto* rhs) {
+      return SplitScore(*lhs) > SplitScore(*rhs);
+    });
+
+    for (const auto* candidate : candidates) {
+      if (ReserveSplit(*candidate, now)) {
+        reserved.push_back(candidate);
+      }
+    }
+  }
+
+  for (const auto* candidate : reserved) {
+    DoSplit(*candidate);
+  }
+}
+
+bool TabletSplitManager::ReserveSplit(const TabletForSplitPB& candidate, CoarseTimePoint now) {
+  const auto& tablet_id = candidate.tablet_id();
+  if (outstanding_splits_.count(tablet_id)) {
+    VLOG(2) << "Tablet " << tablet_id << " is already being split";
+    return false;
+  }
+
+  auto tablet_info = catalog_manager_->GetTabletInfo(tablet_id);
+  if (!tablet_info.ok()) {
+    LOG(WARNING) << "Failed to find tablet to split: " << tablet_info.status();
+    return false;
+  }
+
+  OutstandingSplit split;
+  split.table_id = (**tablet_info).table()->id();
+  TabletInfo::ReplicaMap replicas;
+  (**tablet_info).GetReplicaLocations(&replicas);
+  for (const auto& replica : replicas) {
+    split.tservers.insert(replica.first);
+  }
+
+  if (!CanSplit(split.table_id, split.tservers)) {
+    VLOG(1) << "Postponing split of tablet " << tablet_id << " because of outstanding splits";
+    return false;
+  }
+
+  split.deadline = now + GetAtomicFlag(&FLAGS_tablet_split_outstanding_timeout_secs) * 1s;
+  outstanding_splits_.emplace(tablet_id, std::move(split));
+  return true;
+}
+
+void TabletSplitManager::DoSplit(const TabletForSplitPB& candidate) {
+  const auto& tablet_id = candidate.tablet_id();
+  LOG(INFO) << "Splitting tablet: " << candidate.ShortDebugString();
+  auto new_tablet_ids = catalog_manager_->SplitTablet(
+      tablet_id, candidate.split_encoded_key(), candidate.split_partition_key());
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = outstanding_splits_.find(tablet_id);
+  if (!new_tablet_ids.ok()) {
+    LOG(WARNING) << "Failed to split tablet " << tablet_id << ": " << new_tablet_ids.status();
+    if (it != outstanding_splits_.end() && !it->second.started) {
+      outstanding_splits_.erase(it);
+    }
+    return;
+  }
+  if (it == outstanding_splits_.end()) {
+    // Reservation expired meanwhile.
+    return;
+  }
+  it->second.new_tablet_ids = *new_tablet_ids;
+  it->second.started = true;
+}
+
+bool TabletSplitManager::CanSplit(
+    const TableId& table_id, const std::unordered_set<TabletServerId>& tservers) {
+  const auto max_per_table = GetAtomicFlag(&FLAGS_tablet_split_max_outstanding_per_table);
+  const auto max_per_tserver = GetAtomicFlag(&FLAGS_tablet_split_max_outstanding_per_tserver);
+
+  int table_splits = 0;
+  std::unordered_map<TabletServerId, int> tserver_splits;
+  for (const auto& tserver : tservers) {
+    auto it = post_split_compactions_.find(tserver);
+    tserver_splits[tserver] = it != post_split_compactions_.end() ? it->second : 0;
+  }
+  for (const auto& p : outstanding_splits_) {
+    if (p.second.table_id == table_id) {
+      ++table_splits;
+    }
+    for (const auto& tserver : p.second.tservers) {
+      auto it = tserver_splits.find(tserver);
+      if (it != tserver_splits.end()) {
+        ++it->second;
+      }
+    }
+  }
+
+  if (table_splits >= max_per_table) {
+    return false;
+  }
+  for (const auto& p : tserver_splits) {
+    if (p.second >= max_per_tserver) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void TabletSplitManager::CleanupOutstandingSplits(CoarseTimePoint now) {
+  for (auto it = outstanding_splits_.begin(); it != outstanding_splits_.end();) {
+    if (now >= it->second.deadline) {
+      LOG(WARNING) << "Split of tablet " << it->first << " did not complete in time";
+      it = outstanding_splits_.erase(it);
+    } else if (it->second.started && IsSplitComplete(it->second)) {
+      LOG(INFO) << "Split of tablet " << it->first << " completed";
+      it = outstanding_splits_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+bool TabletSplitManager::IsSplitComplete(const OutstandingSplit& split) {
+  for (const auto& tablet_id : split.new_tablet_ids) {
+    auto tablet_info = catalog_manager_->GetTabletInfo(tablet_id);
+    if (!tablet_info.ok() || !(**tablet_info).LockForRead()->data().is_running()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t TabletSplitManager::NumOutstandingSplits() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return outstanding_splits_.size();
+}
+
+} // namespace master
+} // namespace yb
@@ -0,0 +1,88 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_MASTER_TABLET_SPLIT_MANAGER_H
+#define YB_MASTER_TABLET_SPLIT_MANAGER_H
+
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <glog/logging.h>
+
+#include "yb/common/entity_ids.h"
+#include "yb/gutil/thread_annotations.h"
+#include "yb/master/master_fwd.h"
+#include "yb/util/monotime.h"
+
+namespace yb {
+namespace master {
+
+class CatalogManager;
+class TabletForSplitPB;
+
+// Decides which of the split candidates reported by tablet servers are split, so that hot and
+// big tablets are split without overloading a table or a tablet server with concurrent splits and
+// the post-split compactions they cause.
+class TabletSplitManager {
+ public:
+  explicit TabletSplitManager(CatalogManager* catalog_manager)
+      : catalog_manager_(DCHECK_NOTNULL(catalog_manager)) {}
+
+  // Processes split candidates from the heartbeat of the tablet server leading them.
+  void ProcessHeartbeat(const TSDescriptor& ts_desc, const TSHeartbeatRequestPB& req);
+
+  // Number of splits started by this manager that did not complete yet.
+  size_t NumOutstandingSplits() const;
+
+ private:
+  struct OutstandingSplit {
+    TableId table_id;
+    // Tablet servers hosting replicas of the source tablet.
+    std::unordered_set<TabletServerId> tservers;
+    SplitTabletIds new_tablet_ids;
+    CoarseTimePoint deadline;
+    // Split was requested from the catalog manager. Until then the entry only reserves a slot, so
+    // concurrent heartbeats do not exceed the limits.
+    bool started = false;
+  };
+
+  // Forgets splits whose new tablets are running, or that did not complete before the deadline.
+  void CleanupOutstandingSplits(CoarseTimePoint now) REQUIRES(mutex_);
+
+  bool IsSplitComplete(const OutstandingSplit& split);
+
+  // Checks that a split of the tablet does not exceed per table and per tablet server limits.
+  bool CanSplit(const TableId& table_id, const std::unordered_set<TabletServerId>& tservers)
+      REQUIRES(mutex_);
+
+  // Reserves a slot for the split of the candidate, if the limits allow it. Returns true when the
+  // tablet should be split.
+  bool ReserveSplit(const TabletForSplitPB& candidate, CoarseTimePoint now) REQUIRES(mutex_);
+
+  // Splits the tablet whose split was reserved. Should be called without holding mutex_, since
+  // the split updates the sys catalog.
+  void DoSplit(const TabletForSplitPB& candidate) EXCLUDES(mutex_);
+
+  CatalogManager* const catalog_manager_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<TabletId, OutstandingSplit> outstanding_splits_ GUARDED_BY(mutex_);
+  // Last reported number of not yet compacted split results per tablet server.
+  std::unordered_map<TabletServerId, int> post_split_compactions_ GUARDED_BY(mutex_);
+};
+
+} // namespace master
+} // namespace yb
+
+#endif // YB_MASTER_TABLET_SPLIT_MANAGER_H
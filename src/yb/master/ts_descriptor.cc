@@ -106,6 +106,8 @@ Status TSDescriptor::RegisterUnlocked(
   latest_seqno = instance.instance_seqno();
   // After re-registering, make the TS re-report its tablets.
   has_tablet_report_ = false;
+  has_partial_tablet_report_ = false;
+  last_tablet_report_seq_ = -1;
 
   ts_information_ = std::make_shared<TSInformationPB>();
   ts_information_->mutable_registration()->CopyFrom(registration);
@@ -167,6 +169,35 @@ void TSDescriptor::set_has_tablet_report(bool has_report) {
   has_tablet_report_ = has_report;
 }
 
+bool TSDescriptor::has_partial_tablet_report() const {
+  SharedLock<decltype(lock_)> l(lock_);
+  return has_partial_tablet_report_;
+}
+
+void TSDescriptor::set_has_partial_tablet_report(bool has_report) {
+  std::lock_guard<decltype(lock_)> l(lock_);
+  has_partial_tablet_report_ = has_report;
+}
+
+int32_t TSDescriptor::AddTabletReportChunk(int32_t num_tablets, bool first_chunk) {
+  std::lock_guard<decltype(lock_)> l(lock_);
+  if (first_chunk) {
+    num_full_report_tablets_ = 0;
+  }
+  num_full_report_tablets_ += num_tablets;
+  return num_full_report_tablets_;
+}
+
+bool TSDescriptor::UpdateTabletReportSequenceNumber(int32_t sequence_number, bool is_incremental) {
+  std::lock_guard<decltype(lock_)> l(lock_);
+  // A full report starts a new sequence, e.g. after the tablet server restarted.
+  if (is_incremental && sequence_number <= last_tablet_report_seq_) {
+    return false;
+  }
+  last_tablet_report_seq_ = sequence_number;
+  return true;
+}
+
 void TSDescriptor::DecayRecentReplicaCreationsUnlocked() {
   // In most cases, we won't have any recent replica creations, so
   // we don't need to bother calling the clock, etc.
@@ -257,6 +288,26 @@ void TSDescriptor::UpdateMetrics(const TServerMetricsPB& metrics) {
   ts_metrics_.read_ops_per_sec = metrics.read_ops_per_sec();
   ts_metrics_.write_ops_per_sec = metrics.write_ops_per_sec();
   ts_metrics_.uptime_seconds = metrics.uptime_seconds();
+  ts_metrics_.tablet_loads.clear();
+  for (const auto& load_pb : metrics.tablet_loads()) {
+    auto& load = ts_metrics_.tablet_loads[load_pb.tablet_id()];
+    load.is_leader = load_pb.is_leader();
+    load.read_ops_per_sec = load_pb.read_ops_per_sec();
+    load.write_ops_per_sec = load_pb.write_ops_per_sec();
+    load.read_bytes_per_sec = load_pb.read_bytes_per_sec();
+    load.write_bytes_per_sec = load_pb.write_bytes_per_sec();
+    load.handler_usec_per_sec = load_pb.handler_usec_per_sec();
+  }
+}
+
+bool TSDescriptor::GetTabletLoad(const TabletId& tablet_id, TabletLoad* load) const {
+  SharedLock<decltype(lock_)> l(lock_);
+  auto it = ts_metrics_.tablet_loads.find(tablet_id);
+  if (it == ts_metrics_.tablet_loads.end()) {
+    return false;
+  }
+  *load = it->second;
+  return true;
 }
 
 void TSDescriptor::GetMetrics(TServerMetricsPB* metrics) {
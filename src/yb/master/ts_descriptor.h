@@ -37,6 +37,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include "yb/gutil/gscoped_ptr.h"
 
@@ -111,6 +112,19 @@ class TSDescriptor {
   bool has_tablet_report() const;
   void set_has_tablet_report(bool has_report);
 
+  // True when the first chunk of a full tablet report was received, but some of the tablets are
+  // yet to be reported by the following incremental reports.
+  bool has_partial_tablet_report() const;
+  void set_has_partial_tablet_report(bool has_report);
+
+  // Accounts tablets of a chunk of a full tablet report, the first chunk starts a new report.
+  // Returns the number of tablets reported by chunks of the current full report so far.
+  int32_t AddTabletReportChunk(int32_t num_tablets, bool first_chunk);
+
+  // Records the sequence number of the tablet report being processed. Returns false if a report
+  // with the same or higher sequence number was already processed, i.e. this one is stale.
+  bool UpdateTabletReportSequenceNumber(int32_t sequence_number, bool is_incremental);
+
   // Returns TSRegistrationPB for this TSDescriptor.
   TSRegistrationPB GetRegistration() const;
 
@@ -240,6 +254,19 @@ class TSDescriptor {
 
   void UpdateMetrics(const TServerMetricsPB& metrics);
 
+  // Load of a tablet replica hosted by this tablet server, as reported in the last metrics.
+  struct TabletLoad {
+    bool is_leader = false;
+    double read_ops_per_sec = 0;
+    double write_ops_per_sec = 0;
+    double read_bytes_per_sec = 0;
+    double write_bytes_per_sec = 0;
+    double handler_usec_per_sec = 0;
+  };
+
+  // Returns false if load of the specified tablet was not reported.
+  bool GetTabletLoad(const TabletId& tablet_id, TabletLoad* load) const;
+
   void GetMetrics(TServerMetricsPB* metrics);
 
   void ClearMetrics() {
@@ -306,6 +333,8 @@ class TSDescriptor {
 
     uint64_t uptime_seconds = 0;
 
+    std::unordered_map<TabletId, TabletLoad> tablet_loads;
+
     void ClearMetrics() {
       total_memory_usage = 0;
       total_sst_file_size = 0;
@@ -314,6 +343,7 @@ class TSDescriptor {
       read_ops_per_sec = 0;
       write_ops_per_sec = 0;
       uptime_seconds = 0;
+      tablet_loads.clear();
     }
   };
 
@@ -330,6 +360,16 @@ class TSDescriptor {
   // Set to true once this instance has reported all of its tablets.
   bool has_tablet_report_;
 
+  // Set to true while this instance is reporting its tablets in several chunks.
+  bool has_partial_tablet_report_ = false;
+
+  // Number of tablets reported by chunks of the current full tablet report.
+  int32_t num_full_report_tablets_ = 0;
+
+  // Sequence number of the last processed tablet report, -1 if there were no reports since
+  // registration.
+  int32_t last_tablet_report_seq_ = -1;
+
   // The number of times this tablet server has recently been selected to create a
   // tablet replica. This value decays back to 0 over time.
   double recent_replica_creations_;
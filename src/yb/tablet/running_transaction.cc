@@ -59,6 +59,26 @@ void RunningTransaction::BatchReplicated(const TransactionalBatchData& value) {
   last_batch_data_ = value;
 }
 
+bool RunningTransaction::ExtendIntentKeyRange(const IntentKeyRange& range) {
+  if (range.end.empty()) {
+    return false;
+  }
+  if (intent_key_range_.end.empty()) {
+    intent_key_range_ = range;
+    return true;
+  }
+  bool result = false;
+  if (range.begin < intent_key_range_.begin) {
+    intent_key_range_.begin = range.begin;
+    result = true;
+  }
+  if (range.end > intent_key_range_.end) {
+    intent_key_range_.end = range.end;
+    result = true;
+  }
+  return result;
+}
+
 void RunningTransaction::SetLocalCommitTime(HybridTime time) {
   local_commit_time_ = time;
 }
@@ -64,6 +64,15 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
     return local_commit_time_;
   }
 
+  // Range of keys that could contain strong intents of this transaction. Empty when transaction
+  // does not have strong intents.
+  const IntentKeyRange& intent_key_range() const {
+    return intent_key_range_;
+  }
+
+  // Extends intent key range to cover specified range. Returns true if range was changed.
+  bool ExtendIntentKeyRange(const IntentKeyRange& range);
+
   void SetLocalCommitTime(HybridTime time);
   void AddReplicatedBatch(
       size_t batch_idx, boost::container::small_vector_base<uint8_t>* encoded_replicated_batches);
@@ -125,6 +134,7 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
   RunningTransactionContext& context_;
   RemoveIntentsTask remove_intents_task_;
   HybridTime local_commit_time_ = HybridTime::kInvalid;
+  IntentKeyRange intent_key_range_;
 
   TransactionStatus last_known_status_ = TransactionStatus::CREATED;
   HybridTime last_known_status_hybrid_time_ = HybridTime::kMin;
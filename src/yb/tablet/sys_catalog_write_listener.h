@@ -0,0 +1,43 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_SYS_CATALOG_WRITE_LISTENER_H
+#define YB_TABLET_SYS_CATALOG_WRITE_LISTENER_H
+
+#include "yb/tablet/tablet_fwd.h"
+
+#include "yb/util/slice.h"
+#include "yb/util/status.h"
+
+namespace yb {
+namespace tablet {
+
+// Interface for tracking contents of the sys catalog tablet on all its replicas, followers
+// included.
+class SysCatalogWriteListener {
+ public:
+  // Invoked during tablet bootstrap, before log replay, to load already flushed entries.
+  virtual CHECKED_STATUS Load(Tablet* tablet) = 0;
+
+  // Invoked for each non transactional write pair applied to the tablet, including pairs applied
+  // during log replay. A failure is only logged and does not fail the write, so the listener
+  // should not rely on its state after returning an error.
+  virtual CHECKED_STATUS ApplyWritePair(const Slice& key, const Slice& value) = 0;
+
+  virtual ~SysCatalogWriteListener() = default;
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_SYS_CATALOG_WRITE_LISTENER_H
@@ -105,6 +105,7 @@
 #include "yb/tablet/tablet_fwd.h"
 #include "yb/tablet/maintenance_manager.h"
 #include "yb/tablet/snapshot_coordinator.h"
+#include "yb/tablet/sys_catalog_write_listener.h"
 #include "yb/tablet/tablet_snapshots.h"
 #include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_retention_policy.h"
@@ -483,6 +484,7 @@ Tablet::Tablet(const TabletInitData& data)
   snapshots_ = std::make_unique<TabletSnapshots>(this);
 
   snapshot_coordinator_ = data.snapshot_coordinator;
+  sys_catalog_write_listener_ = data.sys_catalog_write_listener;
 }
 
 Tablet::~Tablet() {
@@ -1085,7 +1087,8 @@ Status Tablet::PrepareTransactionWriteBatch(
       Slice(encoded_replicated_batch_idx_set.data(), encoded_replicated_batch_idx_set.size()),
       &last_batch_data.write_id);
   last_batch_data.hybrid_time = hybrid_time;
-  transaction_participant()->BatchReplicated(transaction_id, last_batch_data);
+  transaction_participant()->BatchReplicated(
+      transaction_id, last_batch_data, docdb::StrongIntentKeyRange(put_batch));
 
   return Status::OK();
 }
@@ -1116,6 +1119,12 @@ Status Tablet::ApplyKeyValueRowOperations(int64_t batch_idx,
                     "ApplyWritePair failed");
       }
     }
+    if (sys_catalog_write_listener_) {
+      for (const auto& pair : put_batch.write_pairs()) {
+        WARN_NOT_OK(sys_catalog_write_listener_->ApplyWritePair(pair.key(), pair.value()),
+                    "Sys catalog listener ApplyWritePair failed");
+      }
+    }
   }
 
   return Status::OK();
@@ -2603,6 +2612,22 @@ Result<HybridTime> Tablet::OldestMutableMemtableWriteHybridTime() const {
   return result;
 }
 
+Result<size_t> Tablet::MutableMemtableSize() const {
+  ScopedRWOperation scoped_read_operation(&pending_op_counter_);
+  RETURN_NOT_OK(scoped_read_operation);
+
+  size_t result = 0;
+  for (auto* db : { regular_db_.get(), intents_db_.get() }) {
+    if (db) {
+      uint64_t size = 0;
+      if (db->GetIntProperty(rocksdb::DB::Properties::kCurSizeActiveMemTable, &size)) {
+        result += size;
+      }
+    }
+  }
+  return result;
+}
+
 Status Tablet::DebugDump(vector<string> *lines) {
   switch (table_type_) {
     case TableType::PGSQL_TABLE_TYPE: FALLTHROUGH_INTENDED;
@@ -2923,6 +2948,30 @@ void Tablet::ForceRocksDBCompactInTest() {
   }
 }
 
+bool Tablet::MarkPostSplitCompactionTriggered() {
+  if (!key_bounds_.IsInitialized() || metadata_->has_been_fully_compacted()) {
+    return false;
+  }
+  bool expected = false;
+  return post_split_compaction_triggered_.compare_exchange_strong(expected, true);
+}
+
+Status Tablet::ForceFullRocksDBCompact() {
+  ScopedRWOperation scoped_operation(&pending_op_counter_);
+  RETURN_NOT_OK(scoped_operation);
+
+  LOG_WITH_PREFIX(INFO) << "Starting full compaction";
+  if (regular_db_) {
+    docdb::ForceRocksDBCompact(regular_db_.get());
+  }
+  if (intents_db_) {
+    RETURN_NOT_OK(intents_db_->Flush(rocksdb::FlushOptions()));
+    docdb::ForceRocksDBCompact(intents_db_.get());
+  }
+  LOG_WITH_PREFIX(INFO) << "Full compaction completed";
+  return Status::OK();
+}
+
 std::string Tablet::TEST_DocDBDumpStr(IncludeIntents include_intents) {
   if (!regular_db_) return "";
 
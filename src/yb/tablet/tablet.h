@@ -454,6 +454,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // is empty.
   Result<HybridTime> OldestMutableMemtableWriteHybridTime() const;
 
+  // Returns total size of mutable memtables in RocksDB.
+  Result<size_t> MutableMemtableSize() const;
+
   // For non-kudu table type fills key-value batch in transaction state request and updates
   // request in state. Due to acquiring locks it can block the thread.
   void AcquireLocksAndPerformDocOperations(std::unique_ptr<WriteOperation> operation);
@@ -511,6 +514,14 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   void ForceRocksDBCompactInTest();
 
+  // Marks that full compaction of the tablet created by split was requested. Returns true only
+  // for the first call on a tablet that still contains data outside of its key bounds.
+  bool MarkPostSplitCompactionTriggered();
+
+  // Runs full compaction of regular and intents RocksDB, so data of the split parent tablet that
+  // is outside of this tablet key bounds is removed. Blocks until compaction is completed.
+  CHECKED_STATUS ForceFullRocksDBCompact();
+
   docdb::DocDB doc_db() const { return { regular_db_.get(), intents_db_.get(), &key_bounds_ }; }
 
   // Returns approximate middle key for tablet split:
@@ -605,6 +616,10 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
     return snapshot_coordinator_;
   }
 
+  SysCatalogWriteListener* sys_catalog_write_listener() {
+    return sys_catalog_write_listener_;
+  }
+
   // Allows us to add tablet-specific information that will get deref'd when the tablet does.
   void AddAdditionalMetadata(const std::string& key, std::shared_ptr<void> additional_metadata) {
     std::lock_guard<std::mutex> lock(control_path_mutex_);
@@ -810,6 +825,8 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   std::atomic<int64_t> last_committed_write_index_{0};
 
+  std::atomic<bool> post_split_compaction_triggered_{false};
+
   HybridTimeLeaseProvider ht_lease_provider_;
 
   HybridTime DoGetSafeTime(
@@ -860,6 +877,8 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   SnapshotCoordinator* snapshot_coordinator_ = nullptr;
 
+  SysCatalogWriteListener* sys_catalog_write_listener_ = nullptr;
+
   mutable std::mutex control_path_mutex_;
   std::unordered_map<std::string, std::shared_ptr<void>> additional_metadata_
     GUARDED_BY(control_path_mutex_);
@@ -50,6 +50,8 @@ using std::shared_ptr;
 using std::string;
 using std::vector;
 
+DECLARE_bool(bootstrap_log_read_ahead);
+
 namespace yb {
 
 namespace log {
@@ -83,6 +85,14 @@ class BootstrapTest : public LogTestBase {
 
   void SetUp() override {
     LogTestBase::SetUp();
+    ASSERT_OK(ThreadPoolBuilder("log-read-ahead")
+                  .set_max_threads(1)
+                  .Build(&log_read_ahead_pool_));
+  }
+
+  void TearDown() override {
+    log_read_ahead_pool_->Shutdown();
+    LogTestBase::TearDown();
   }
 
   Status LoadTestRaftGroupMetadata(RaftGroupMetadataPtr* meta) {
@@ -140,6 +150,7 @@ class BootstrapTest : public LogTestBase {
       .listener = listener.get(),
       .append_pool = append_pool_.get(),
       .retryable_requests = nullptr,
+      .log_read_ahead_pool = log_read_ahead_pool_.get(),
     };
     RETURN_NOT_OK(BootstrapTablet(data, tablet, &log_, boot_info));
     return Status::OK();
@@ -368,5 +379,34 @@ TEST_F(BootstrapTest, TestBootstrapHighOpIdIndex) {
   ASSERT_OPID_EQ(last_opid, boot_info.last_committed_id);
 }
 
+// Test that entries of all segments are replayed when segments are read ahead of replay.
+TEST_F(BootstrapTest, TestBootstrapLogReadAhead) {
+  constexpr int kNumSegments = 4;
+  constexpr int kOpsPerSegment = 3;
+  ASSERT_TRUE(FLAGS_bootstrap_log_read_ahead);
+
+  BuildLog();
+  int64_t index = 0;
+  for (int segment = 0; segment != kNumSegments; ++segment) {
+    for (int i = 0; i != kOpsPerSegment; ++i) {
+      ++index;
+      const auto op_id = MakeOpId(1, index);
+      AppendReplicateBatch(op_id, op_id, {TupleForAppend(index, segment, "read ahead")});
+    }
+    ASSERT_OK(RollLog());
+  }
+
+  TabletPtr tablet;
+  ConsensusBootstrapInfo boot_info;
+  ASSERT_OK(BootstrapTestTablet(&tablet, &boot_info));
+  ASSERT_EQ(boot_info.orphaned_replicates.size(), 0);
+  ASSERT_OPID_EQ(MakeOpId(1, index), boot_info.last_id);
+  ASSERT_OPID_EQ(MakeOpId(1, index), boot_info.last_committed_id);
+
+  vector<string> results;
+  IterateTabletRows(tablet.get(), &results);
+  ASSERT_EQ(static_cast<size_t>(kNumSegments * kOpsPerSegment), results.size());
+}
+
 } // namespace tablet
 } // namespace yb
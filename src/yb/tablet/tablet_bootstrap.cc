@@ -35,10 +35,14 @@
 #include "yb/consensus/consensus_util.h"
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/log_reader.h"
+#include "yb/consensus/metadata.pb.h"
+#include "yb/consensus/quorum_util.h"
+#include "yb/consensus/raft_consensus.h"
 #include "yb/consensus/retryable_requests.h"
 
 #include "yb/server/hybrid_clock.h"
 #include "yb/tablet/snapshot_coordinator.h"
+#include "yb/tablet/sys_catalog_write_listener.h"
 #include "yb/tablet/tablet_snapshots.h"
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_peer.h"
@@ -86,6 +90,13 @@ DEFINE_bool(skip_flushed_entries, true,
             "Only replay WAL entries that are not flushed to RocksDB or within the retryable "
             "request timeout.");
 
+DEFINE_bool(bootstrap_log_read_ahead, true,
+            "Read and decode the next WAL segment on the log-read-ahead thread pool while "
+            "replaying the entries of the current one during tablet bootstrap. Keeps up to two "
+            "decoded segments in memory per bootstrapping tablet.");
+TAG_FLAG(bootstrap_log_read_ahead, advanced);
+TAG_FLAG(bootstrap_log_read_ahead, runtime);
+
 DECLARE_int32(retryable_request_timeout_secs);
 
 DEFINE_uint64(transaction_status_tablet_log_segment_size_bytes, 4_MB,
@@ -355,6 +366,7 @@ TabletBootstrap::TabletBootstrap(const BootstrapTabletData& data)
       mem_tracker_(data.tablet_init_data.parent_mem_tracker),
       listener_(data.listener),
       append_pool_(data.append_pool),
+      log_read_ahead_pool_(data.log_read_ahead_pool),
       skip_wal_rewrite_(FLAGS_skip_wal_rewrite) {
 }
 
@@ -371,6 +383,8 @@ Status TabletBootstrap::Bootstrap(TabletPtr* rebuilt_tablet,
   RETURN_NOT_OK_PREPEND(ConsensusMetadata::Load(meta_->fs_manager(), tablet_id,
                                                 meta_->fs_manager()->uuid(), &cmeta_),
                         "Unable to load Consensus metadata");
+  is_witness_ = consensus::IsRaftConfigWitness(
+      meta_->fs_manager()->uuid(), cmeta_->active_config());
 
   // Make sure we don't try to locally bootstrap a tablet that was in the middle of a remote
   // bootstrap. It's likely that not all files were copied over successfully.
@@ -391,6 +405,12 @@ Status TabletBootstrap::Bootstrap(TabletPtr* rebuilt_tablet,
 
   bool has_blocks = VERIFY_RESULT(OpenTablet());
 
+  if (tablet_->sys_catalog_write_listener()) {
+    // Load flushed entries before replaying logs, replayed entries are passed to the listener
+    // while they are applied.
+    RETURN_NOT_OK(tablet_->sys_catalog_write_listener()->Load(tablet_.get()));
+  }
+
   bool needs_recovery;
   RETURN_NOT_OK(PrepareToReplay(&needs_recovery));
   if (needs_recovery && !skip_wal_rewrite_) {
@@ -733,6 +753,10 @@ Status TabletBootstrap::HandleReplicateMessage(
 
 Status TabletBootstrap::HandleOperation(consensus::OperationType op_type,
                                         ReplicateMsg* replicate) {
+  if (is_witness_ && consensus::WitnessSkipsOperation(op_type)) {
+    return Status::OK();
+  }
+
   switch (op_type) {
     case consensus::WRITE_OP:
       PlayWriteRequest(replicate);
@@ -879,6 +903,73 @@ void TabletBootstrap::DumpReplayStateToLog() {
   }
 }
 
+yb::OpId TabletBootstrap::LoadRetryableRequests() {
+  if (!data_.retryable_requests) {
+    return yb::OpId();
+  }
+
+  consensus::RetryableRequestsPB pb;
+  auto status = ConsensusMetadata::LoadRetryableRequests(
+      tablet_->metadata()->fs_manager(), tablet_->tablet_id(), &pb);
+  if (status.ok()) {
+    status = CheckRetryableRequestsOpId(yb::OpId::FromPB(pb.last_op_id()));
+  }
+  if (status.ok()) {
+    status = data_.retryable_requests->FromPB(pb);
+  }
+  if (!status.ok()) {
+    if (!status.IsNotFound()) {
+      LOG_WITH_PREFIX(WARNING) << "Failed to restore retryable requests, they will be rebuilt "
+                               << "from the log: " << status;
+    }
+    return yb::OpId();
+  }
+
+  auto result = yb::OpId::FromPB(pb.last_op_id());
+  LOG_WITH_PREFIX(INFO) << "Restored retryable requests up to " << result;
+  return result;
+}
+
+Status TabletBootstrap::CheckRetryableRequestsOpId(const yb::OpId& op_id) {
+  if (op_id.empty()) {
+    return Status::OK();
+  }
+  // The snapshot could be left by another incarnation of this tablet, so it is used only when its
+  // op id is present in the log with the same term.
+  if (op_id.term > cmeta_->current_term()) {
+    return STATUS_FORMAT(
+        IllegalState, "Retryable requests snapshot op id $0 is from a term after current term $1",
+        op_id, cmeta_->current_term());
+  }
+  auto logged_op_id = log_->GetLogReader()->LookupOpId(op_id.index);
+  if (!logged_op_id.ok()) {
+    return STATUS_FORMAT(
+        IllegalState, "Retryable requests snapshot op id $0 is not found in the log: $1",
+        op_id, logged_op_id.status());
+  }
+  if (*logged_op_id != op_id) {
+    return STATUS_FORMAT(
+        IllegalState, "Retryable requests snapshot op id $0 does not match logged op id $1",
+        op_id, *logged_op_id);
+  }
+  return Status::OK();
+}
+
+std::future<log::ReadEntriesResult> TabletBootstrap::ReadEntriesAhead(
+    const scoped_refptr<ReadableLogSegment>& segment) {
+  auto promise = std::make_shared<std::promise<log::ReadEntriesResult>>();
+  auto result = promise->get_future();
+  auto status = log_read_ahead_pool_->SubmitFunc([promise, segment] {
+    promise->set_value(segment->ReadEntries());
+  });
+  if (!status.ok()) {
+    LOG_WITH_PREFIX(WARNING) << "Failed to start reading " << segment->path() << " ahead: "
+                             << status;
+    return std::future<log::ReadEntriesResult>();
+  }
+  return result;
+}
+
 Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
   auto flushed_op_id = VERIFY_RESULT(tablet_->MaxPersistentOpId());
   if (FLAGS_force_recover_flushed_frontier) {
@@ -936,6 +1027,10 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
     }
     LOG(INFO) << "Bootstrap optimizer: op_id_replay_lowest=" << op_id_replay_lowest;
 
+    // Retryable requests replicated up to this op id were restored from the snapshot, so log
+    // entries before it are not needed to rebuild them.
+    yb::OpId retryable_requests_op_id = LoadRetryableRequests();
+
     // Time point of the last WAL entry and
     //    how far back in time from it we should retain other entries
     bool read_last_time = false;
@@ -960,7 +1055,8 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
 
         // Previous segment would have op_id and time less than required,
         // so we can ignore it.
-        if (op_id <= op_id_replay_lowest && time <= last_time - retain_limit) {
+        if (op_id <= op_id_replay_lowest &&
+            (time <= last_time - retain_limit || op_id <= retryable_requests_op_id)) {
           LOG(INFO) << "Bootstrap optimizer, found first mandatory segment op id: " << op_id
                     << ", time: " << time.ToString() << ", last time: " << last_time.ToString()
                     << ", number of segments to be skipped: " << (iter - segments.begin());
@@ -973,10 +1069,26 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
   yb::OpId last_committed_op_id;
   yb::OpId last_read_entry_op_id;
   RestartSafeCoarseTimePoint last_entry_time;
+  // Decoded entries of the segment following the one being replayed.
+  std::future<log::ReadEntriesResult> next_read;
+  // Don't leave the background read running after an early return, so it does not outlive
+  // the bootstrap.
+  auto wait_next_read = ScopeExit([&next_read] {
+    if (next_read.valid()) {
+      next_read.wait();
+    }
+  });
+  stats_.start_time = MonoTime::Now();
   for (; iter != segments.end(); ++iter) {
     const scoped_refptr<ReadableLogSegment>& segment = *iter;
 
-    auto read_result = segment->ReadEntries();
+    auto read_result = next_read.valid() ? next_read.get() : segment->ReadEntries();
+    if (log_read_ahead_pool_ && std::next(iter) != segments.end() &&
+        GetAtomicFlag(&FLAGS_bootstrap_log_read_ahead)) {
+      next_read = ReadEntriesAhead(*std::next(iter));
+    }
+    ++stats_.segments_read;
+    stats_.bytes_read += read_result.end_offset;
     last_committed_op_id = std::max(last_committed_op_id, read_result.committed_op_id);
     if (!read_result.entries.empty()) {
       last_read_entry_op_id = yb::OpId::FromPB(read_result.entries.back()->replicate().id());
@@ -1057,6 +1169,8 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
     }
   }
 
+  LOG_WITH_PREFIX(INFO) << "Finished replaying log segments. " << stats_.ToString();
+
   LOG_WITH_PREFIX(INFO) << "Dumping replay state to log at the end of " << __FUNCTION__;
   DumpReplayStateToLog();
 
@@ -1279,8 +1393,14 @@ void TabletBootstrap::CleanupSnapshots() {
 //  Class TabletBootstrap::Stats.
 // ============================================================================
 string TabletBootstrap::Stats::ToString() const {
-  return Format("Read operations: $0, overwritten operations: $1",
-                ops_read, ops_overwritten);
+  auto elapsed_sec = start_time.Initialized() ? (MonoTime::Now() - start_time).ToSeconds() : 0.0;
+  auto per_sec = [elapsed_sec](double value) {
+    return elapsed_sec > 0 ? static_cast<int64_t>(value / elapsed_sec) : 0;
+  };
+  return Format("Read operations: $0, overwritten operations: $1, read segments: $2, "
+                    "read bytes: $3, replay rate: $4 ops/sec, $5 bytes/sec",
+                ops_read, ops_overwritten, segments_read, bytes_read,
+                per_sec(ops_read), per_sec(bytes_read));
 }
 
 } // namespace tablet
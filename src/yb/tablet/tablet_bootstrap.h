@@ -32,10 +32,14 @@
 #ifndef YB_TABLET_TABLET_BOOTSTRAP_H
 #define YB_TABLET_TABLET_BOOTSTRAP_H
 
+#include <future>
+
 #include "yb/tablet/tablet_bootstrap_if.h"
 #include "yb/consensus/consensus_meta.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/consensus/log_reader.h"
+#include "yb/util/monotime.h"
+#include "yb/util/opid.h"
 #include "yb/util/threadpool.h"
 
 namespace yb {
@@ -109,6 +113,18 @@ class TabletBootstrap {
   // accepting writes from clients.
   CHECKED_STATUS PlaySegments(consensus::ConsensusBootstrapInfo* results);
 
+  // Starts reading entries of the specified segment on log_read_ahead_pool_. Returns invalid
+  // future if the read could not be started.
+  std::future<log::ReadEntriesResult> ReadEntriesAhead(
+      const scoped_refptr<log::ReadableLogSegment>& segment);
+
+  // Restores replicated retryable requests from the snapshot written next to consensus metadata.
+  // Returns op id covered by the snapshot, or the default op id when nothing was restored.
+  yb::OpId LoadRetryableRequests();
+
+  // Checks that op id of the retryable requests snapshot belongs to the log of this tablet.
+  CHECKED_STATUS CheckRetryableRequestsOpId(const yb::OpId& op_id);
+
   void PlayWriteRequest(consensus::ReplicateMsg* replicate_msg);
 
   CHECKED_STATUS PlayUpdateTransactionRequest(
@@ -169,6 +185,9 @@ class TabletBootstrap {
   // Thread pool for append task for bootstrap.
   ThreadPool* append_pool_;
 
+  // Thread pool for reading log segments ahead of replay, could be null.
+  ThreadPool* log_read_ahead_pool_;
+
   // Statistics on the replay of entries in the log.
   struct Stats {
     std::string ToString() const;
@@ -178,12 +197,22 @@ class TabletBootstrap {
 
     // Number of REPLICATE messages which were overwritten by later entries.
     int ops_overwritten = 0;
+
+    // Number of log segments read and their total size in bytes.
+    int segments_read = 0;
+    int64_t bytes_read = 0;
+
+    // Time when log replay started, used to report replay throughput.
+    MonoTime start_time;
   } stats_;
 
   HybridTime rocksdb_last_entry_hybrid_time_ = HybridTime::kMin;
 
   bool skip_wal_rewrite_;
 
+  // Whether the local peer is a witness, so writes are kept in the log only.
+  bool is_witness_ = false;
+
   DISALLOW_COPY_AND_ASSIGN(TabletBootstrap);
 };
 
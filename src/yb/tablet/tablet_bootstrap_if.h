@@ -117,6 +117,9 @@ struct BootstrapTabletData {
   TabletStatusListener* listener = nullptr;
   ThreadPool* append_pool = nullptr;
   consensus::RetryableRequests* retryable_requests = nullptr;
+  // Pool used to read the next log segment while the current one is replayed. Segments are read
+  // one by one when it is not specified.
+  ThreadPool* log_read_ahead_pool = nullptr;
 };
 
 // Bootstraps a tablet, initializing it with the provided metadata. If the tablet
@@ -41,6 +41,7 @@ typedef std::shared_ptr<TabletPeer> TabletPeerPtr;
 class SnapshotCoordinator;
 class SnapshotOperationState;
 class SplitOperationState;
+class SysCatalogWriteListener;
 class TabletSnapshots;
 class TabletSplitter;
 class TabletStatusPB;
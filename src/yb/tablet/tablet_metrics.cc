@@ -134,6 +134,12 @@ METRIC_DEFINE_counter(tablet, restart_read_requests,
   yb::MetricUnit::kRequests,
   "Number of read requests that require restart.");
 
+METRIC_DEFINE_counter(tablet, follower_read_index_reads,
+  "Follower Read Index Reads",
+  yb::MetricUnit::kRequests,
+  "Number of strongly consistent read requests served by this follower using the read index "
+  "of the leader.");
+
 using strings::Substitute;
 
 namespace yb {
@@ -152,6 +158,7 @@ TabletMetrics::TabletMetrics(const scoped_refptr<MetricEntity>& entity)
     MINIT(transaction_conflicts),
     MINIT(expired_transactions),
     MINIT(restart_read_requests),
+    MINIT(follower_read_index_reads),
     MINIT(rows_inserted) {
 }
 #undef MINIT
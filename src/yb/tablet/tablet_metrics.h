@@ -66,6 +66,7 @@ struct TabletMetrics {
   scoped_refptr<Counter> transaction_conflicts;
   scoped_refptr<Counter> expired_transactions;
   scoped_refptr<Counter> restart_read_requests;
+  scoped_refptr<Counter> follower_read_index_reads;
 
   scoped_refptr<Counter> rows_inserted;
 };
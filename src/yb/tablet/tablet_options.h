@@ -30,6 +30,7 @@ class Cache;
 class EventListener;
 class MemoryMonitor;
 class Env;
+class RateLimiter;
 }
 
 namespace yb {
@@ -53,6 +54,9 @@ struct TabletOptions {
   std::vector<std::shared_ptr<rocksdb::EventListener>> listeners;
   yb::Env* env = Env::Default();
   rocksdb::Env* rocksdb_env = rocksdb::Env::Default();
+  // Rate limiter for flushes and compactions shared by all tablets of the tablet server.
+  // When not set, each tablet uses its own rate limiter.
+  std::shared_ptr<rocksdb::RateLimiter> rate_limiter;
 };
 
 struct TabletInitData {
@@ -72,6 +76,7 @@ struct TabletInitData {
   IsSysCatalogTablet is_sys_catalog = IsSysCatalogTablet::kFalse;
   SnapshotCoordinator* snapshot_coordinator = nullptr;
   TabletSplitter* tablet_splitter = nullptr;
+  SysCatalogWriteListener* sys_catalog_write_listener = nullptr;
 };
 
 } // namespace tablet
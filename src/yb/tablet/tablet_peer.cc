@@ -187,7 +187,8 @@ Status TabletPeer::InitTabletPeer(
     ThreadPool* raft_pool,
     ThreadPool* tablet_prepare_pool,
     consensus::RetryableRequests* retryable_requests,
-    const yb::OpId& split_op_id) {
+    const yb::OpId& split_op_id,
+    consensus::MultiRaftManager* multi_raft_manager) {
   DCHECK(tablet) << "A TabletPeer must be provided with a Tablet";
   DCHECK(log) << "A TabletPeer must be provided with a Log";
 
@@ -267,7 +268,8 @@ Status TabletPeer::InitTabletPeer(
         tablet_->table_type(),
         raft_pool,
         retryable_requests,
-        split_op_id);
+        split_op_id,
+        multi_raft_manager);
     has_consensus_.store(true, std::memory_order_release);
 
     tablet_->SetHybridTimeLeaseProvider(std::bind(&TabletPeer::HybridTimeLease, this, _1, _2));
@@ -1065,6 +1067,11 @@ shared_ptr<consensus::Consensus> TabletPeer::shared_consensus() const {
   return consensus_;
 }
 
+shared_ptr<consensus::RaftConsensus> TabletPeer::shared_raft_consensus() const {
+  std::lock_guard<simple_spinlock> lock(lock_);
+  return consensus_;
+}
+
 Result<OperationDriverPtr> TabletPeer::NewLeaderOperationDriver(
     std::unique_ptr<Operation>* operation, int64_t term) {
   return NewOperationDriver(operation, term);
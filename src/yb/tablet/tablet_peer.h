@@ -165,7 +165,8 @@ class TabletPeer : public consensus::ConsensusContext,
       ThreadPool* raft_pool,
       ThreadPool* tablet_prepare_pool,
       consensus::RetryableRequests* retryable_requests,
-      const yb::OpId& split_op_id);
+      const yb::OpId& split_op_id,
+      consensus::MultiRaftManager* multi_raft_manager = nullptr);
 
   // Starts the TabletPeer, making it available for Write()s. If this
   // TabletPeer is part of a consensus configuration this will connect it to other peers
@@ -232,6 +233,7 @@ class TabletPeer : public consensus::ConsensusContext,
   consensus::RaftConsensus* raft_consensus() const;
 
   std::shared_ptr<consensus::Consensus> shared_consensus() const;
+  std::shared_ptr<consensus::RaftConsensus> shared_raft_consensus() const;
 
   Tablet* tablet() const {
     std::lock_guard<simple_spinlock> lock(lock_);
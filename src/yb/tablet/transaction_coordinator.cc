@@ -364,6 +364,15 @@ class TransactionState {
       return TransactionStatusResult(TransactionStatus::COMMITTED, HybridTime::kMax);
     } else if (status_ == TransactionStatus::ABORTED) {
       return TransactionStatusResult::Aborted();
+    } else if (status_ == TransactionStatus::SEALED) {
+      // All batches were replicated, so transaction is committed, even if apply is not done yet.
+      if (tablets_with_not_replicated_batches_ == 0) {
+        return TransactionStatusResult(TransactionStatus::COMMITTED, commit_time_);
+      }
+      // Sealed transaction could not be aborted externally, its fate is decided by replication
+      // of its batches. So just wait until it is resolved.
+      abort_waiters_.emplace_back(std::move(*callback));
+      return TransactionStatusResult(TransactionStatus::PENDING, HybridTime::kMax);
     } else {
       VLOG_WITH_PREFIX(1) << "External abort request";
       CHECK_EQ(TransactionStatus::PENDING, status_);
@@ -405,6 +414,29 @@ class TransactionState {
     SubmitUpdateStatus(TransactionStatus::ABORTED);
   }
 
+  // Whether this transaction was sealed, but some of its batches were not replicated during
+  // avoid_abort_after_sealing_ms. Such transaction should be resolved by checking participants.
+  bool ShouldResolveSealed(CoarseTimePoint now) const {
+    return status_ == TransactionStatus::SEALED && tablets_with_not_replicated_batches_ != 0 &&
+           !replicating_ && now >= next_abort_after_sealing_;
+  }
+
+  // Invoked when participants were requested to abort not replicated batches of this sealed
+  // transaction. So we don't try to do it again until avoid_abort_after_sealing_ms passes.
+  void SealedResolutionStarted(CoarseTimePoint now) {
+    next_abort_after_sealing_ = now + FLAGS_avoid_abort_after_sealing_ms * 1ms;
+  }
+
+  // Aborts sealed transaction, when one of involved tablets aborted it without replicating
+  // all of its batches.
+  void AbortSealed() {
+    if (status_ != TransactionStatus::SEALED || ShouldBeAborted()) {
+      return;
+    }
+    VLOG_WITH_PREFIX(4) << "Abort sealed transaction";
+    SubmitUpdateStatus(TransactionStatus::ABORTED);
+  }
+
   // Returns logs prefix for this transaction.
   const std::string& LogPrefix() {
     return log_prefix_;
@@ -607,7 +639,8 @@ class TransactionState {
 
   CHECKED_STATUS AbortedReplicationFinished(const TransactionCoordinator::ReplicatedData& data) {
     if (status_ != TransactionStatus::ABORTED &&
-        status_ != TransactionStatus::PENDING) {
+        status_ != TransactionStatus::PENDING &&
+        status_ != TransactionStatus::SEALED) {
       LOG_WITH_PREFIX(DFATAL) << "Invalid status of aborted transaction: "
                               << TransactionStatus_Name(status_);
     }
@@ -631,7 +664,6 @@ class TransactionState {
 
     last_touch_ = data.hybrid_time;
     commit_time_ = data.hybrid_time;
-    // TODO(dtxn) Not yet implemented
     next_abort_after_sealing_ = CoarseMonoClock::now() + FLAGS_avoid_abort_after_sealing_ms * 1ms;
     VLOG_WITH_PREFIX(4) << "Seal time: " << commit_time_;
     status_ = TransactionStatus::SEALED;
@@ -696,6 +728,9 @@ class TransactionState {
                         << ", leader: " << context_.leader();
     last_touch_ = data.hybrid_time;
     status_ = TransactionStatus::APPLIED_IN_ALL_INVOLVED_TABLETS;
+    // Sealed transaction could reach this state on a follower, that did not track replication of
+    // its batches, so waiters should be notified here as well.
+    NotifyAbortWaiters(TransactionStatusResult(TransactionStatus::COMMITTED, commit_time_));
     return Status::OK();
   }
 
@@ -1310,6 +1345,7 @@ class TransactionCoordinator::Impl : public TransactionStateContext {
 
     auto leader_term = context_.LeaderTerm();
     PostponedLeaderActions actions;
+    std::vector<std::pair<TransactionId, ExpectedTabletBatches>> sealed_to_resolve;
     {
       std::lock_guard<std::mutex> lock(managed_mutex_);
       postponed_leader_actions_.leader_term = leader_term;
@@ -1329,13 +1365,89 @@ class TransactionCoordinator::Impl : public TransactionStateContext {
         }
       }
       auto now_physical = MonoTime::Now();
+      auto now_coarse = CoarseMonoClock::now();
       for (auto& transaction : managed_transactions_) {
-        const_cast<TransactionState&>(transaction).Poll(
-            leader_term != OpId::kUnknownTerm, now_physical);
+        auto& state = const_cast<TransactionState&>(transaction);
+        state.Poll(leader_term != OpId::kUnknownTerm, now_physical);
+        if (leader_term != OpId::kUnknownTerm && state.ShouldResolveSealed(now_coarse)) {
+          std::vector<ExpectedTabletBatches> expected_tablet_batches;
+          auto status = state.GetStatus(&expected_tablet_batches);
+          if (status.ok() && status->status == TransactionStatus::SEALED) {
+            state.SealedResolutionStarted(now_coarse);
+            for (auto& batches : expected_tablet_batches) {
+              sealed_to_resolve.emplace_back(state.id(), std::move(batches));
+            }
+          }
+        }
       }
       postponed_leader_actions_.Swap(&actions);
     }
     ExecutePostponedLeaderActions(&actions);
+
+    for (const auto& p : sealed_to_resolve) {
+      AbortSealedIfNotReplicated(p.first, p.second);
+    }
+  }
+
+  // Asks participant to abort sealed transaction if it did not replicate all expected batches.
+  // Participant responds with the number of replicated batches, if all of them were replicated,
+  // otherwise it responds that transaction was aborted.
+  void AbortSealedIfNotReplicated(
+      const TransactionId& transaction_id, const ExpectedTabletBatches& expected) {
+    VLOG_WITH_PREFIX(4) << __func__ << ": " << transaction_id << ", " << expected.ToString();
+
+    tserver::GetTransactionStatusAtParticipantRequestPB req;
+    req.set_tablet_id(expected.tablet);
+    req.set_transaction_id(
+        pointer_cast<const char*>(transaction_id.data()), transaction_id.size());
+    req.set_propagated_hybrid_time(context_.clock().Now().ToUint64());
+    req.set_required_num_replicated_batches(expected.batches);
+
+    auto handle = rpcs_.Prepare();
+    if (handle == rpcs_.InvalidHandle()) {
+      return;
+    }
+    *handle = GetTransactionStatusAtParticipant(
+        TransactionRpcDeadline(),
+        nullptr /* remote_tablet */,
+        context_.client_future().get(),
+        &req,
+        [this, handle, transaction_id, expected](
+            const Status& status,
+            const tserver::GetTransactionStatusAtParticipantResponsePB& resp) {
+          client::UpdateClock(resp, &context_);
+          rpcs_.Unregister(handle);
+          if (!status.ok()) {
+            LOG_WITH_PREFIX(WARNING) << "Failed to resolve sealed transaction " << transaction_id
+                                     << " at " << expected.tablet << ": " << status;
+            return;
+          }
+          VLOG_WITH_PREFIX(4)
+              << "Sealed TXN: " << transaction_id << " status at " << expected.tablet << ": "
+              << resp.ShortDebugString();
+          PostponedLeaderActions actions;
+          {
+            std::lock_guard<std::mutex> lock(managed_mutex_);
+            auto it = managed_transactions_.find(transaction_id);
+            if (it == managed_transactions_.end()) {
+              return;
+            }
+            postponed_leader_actions_.leader_term = context_.LeaderTerm();
+            if (resp.aborted()) {
+              managed_transactions_.modify(it, [](TransactionState& state) {
+                state.AbortSealed();
+              });
+            } else if (resp.num_replicated_batches() == expected.batches) {
+              managed_transactions_.modify(it, [&expected, &resp](TransactionState& state) {
+                state.ReplicatedAllBatchesAt(
+                    expected.tablet, HybridTime(resp.status_hybrid_time()));
+              });
+            }
+            postponed_leader_actions_.Swap(&actions);
+          }
+          ExecutePostponedLeaderActions(&actions);
+        });
+    (**handle).SendRpc();
   }
 
   void CheckCompleted(ManagedTransactions::iterator it) {
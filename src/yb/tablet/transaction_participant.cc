@@ -15,6 +15,7 @@
 
 #include "yb/tablet/transaction_participant.h"
 
+#include <map>
 #include <mutex>
 #include <queue>
 
@@ -88,6 +89,10 @@ DEFINE_uint64(max_transactions_in_status_request, 128,
               "Request status for at most specified number of transactions at once. "
                   "0 disables load time transaction status resolution.");
 
+DEFINE_bool(track_intent_key_ranges, false,
+            "Track ranges of keys that have intents of running transactions, so reads could skip "
+            "intents DB outside of them.");
+
 METRIC_DEFINE_simple_counter(
     tablet, transaction_load_attempts,
     "Total number of tries to load transaction metadata from the intents RocksDB",
@@ -118,8 +123,12 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
         log_prefix_(context->LogPrefix()),
         status_resolver_(context, &rpcs_, FLAGS_max_transactions_in_status_request,
                          std::bind(&Impl::TransactionsStatus, this, _1)),
-        last_loaded_(TransactionId::Nil()) {
+        last_loaded_(TransactionId::Nil()),
+        track_intent_key_ranges_(FLAGS_track_intent_key_ranges) {
     LOG_WITH_PREFIX(INFO) << "Create";
+    if (track_intent_key_ranges_) {
+      intent_key_ranges_ = std::make_shared<IntentKeyRanges>();
+    }
     metric_transactions_running_ = METRIC_transactions_running.Instantiate(entity, 0);
     metric_transaction_load_attempts_ = METRIC_transaction_load_attempts.Instantiate(entity);
     metric_transaction_not_found_ = METRIC_transaction_not_found.Instantiate(entity);
@@ -155,6 +164,10 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
       MinRunningNotifier min_running_notifier(nullptr /* applier */);
       std::lock_guard<std::mutex> lock(mutex_);
       transactions_.clear();
+      if (track_intent_key_ranges_) {
+        intent_key_range_boundaries_.clear();
+        PublishIntentKeyRangesUnlocked();
+      }
       TransactionsModifiedUnlocked(&min_running_notifier);
     }
 
@@ -287,7 +300,8 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
     return std::make_pair(transaction.metadata().isolation, transaction.last_batch_data());
   }
 
-  void BatchReplicated(const TransactionId& id, const TransactionalBatchData& data) {
+  void BatchReplicated(const TransactionId& id, const TransactionalBatchData& data,
+                       const IntentKeyRange& intent_key_range) {
     std::lock_guard<std::mutex> lock(mutex_);
     auto it = transactions_.find(id);
     if (it == transactions_.end()) {
@@ -296,6 +310,16 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
       return;
     }
     (**it).BatchReplicated(data);
+    if (track_intent_key_ranges_) {
+      ExtendIntentKeyRangeUnlocked(*it, intent_key_range);
+    }
+  }
+
+  IntentKeyRangesPtr LiveIntentKeyRanges() {
+    if (!track_intent_key_ranges_ || !all_loaded_.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    return std::atomic_load(&intent_key_ranges_);
   }
 
   void RequestStatusAt(const StatusRequest& request) {
@@ -567,9 +591,21 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
       int64_t term,
       tserver::GetTransactionStatusAtParticipantResponsePB* response,
       rpc::RpcContext* context) {
+    if (required_num_replicated_batches != 0) {
+      WaitLoaded(transaction_id);
+    }
+    MinRunningNotifier min_running_notifier(&applier_);
     std::lock_guard<std::mutex> lock(mutex_);
     auto it = transactions_.find(transaction_id);
     if (it == transactions_.end()) {
+      if (required_num_replicated_batches != 0) {
+        // Coordinator resolves sealed transaction, and we did not receive any of its batches.
+        // So abort it, to prevent batches that are still in flight from being accepted.
+        VLOG_WITH_PREFIX(2) << "Abort sealed transaction without batches: " << transaction_id;
+        MarkAbortedUnlocked(transaction_id, &min_running_notifier);
+        response->set_aborted(true);
+        return;
+      }
       response->set_num_replicated_batches(0);
       response->set_status_hybrid_time(0);
     } else {
@@ -577,6 +613,15 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
         response->set_aborted(true);
         return;
       }
+      if ((**it).num_replicated_batches() < required_num_replicated_batches) {
+        VLOG_WITH_PREFIX(2)
+            << "Abort sealed transaction " << transaction_id << ", replicated batches: "
+            << (**it).num_replicated_batches() << ", required: "
+            << required_num_replicated_batches;
+        (**it).Aborted();
+        response->set_aborted(true);
+        return;
+      }
       response->set_num_replicated_batches((**it).num_replicated_batches());
       response->set_status_hybrid_time((**it).last_batch_data().hybrid_time.ToUint64());
     }
@@ -1154,8 +1199,12 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
       std::lock_guard<std::mutex> lock(mutex_);
       last_loaded_ = metadata->transaction_id;
       status_resolver_.Add(metadata->status_tablet, metadata->transaction_id);
-      transactions_.insert(std::make_shared<RunningTransaction>(
-          std::move(*metadata), last_batch_data, std::move(replicated_batches), this));
+      auto it = transactions_.insert(std::make_shared<RunningTransaction>(
+          std::move(*metadata), last_batch_data, std::move(replicated_batches), this)).first;
+      if (track_intent_key_ranges_) {
+        // Keys of intents written before restart are unknown.
+        ExtendIntentKeyRangeUnlocked(*it, docdb::WholeIntentKeyRange());
+      }
       TransactionsModifiedUnlocked(&min_running_notifier);
     }
     load_cond_.notify_all();
@@ -1189,10 +1238,57 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
     LOG_IF_WITH_PREFIX(DFATAL, !recently_removed_transactions_.insert(transaction.id()).second)
         << "Transaction removed twice: " << transaction.id();
     VLOG_WITH_PREFIX(4) << "Remove transaction: " << transaction.id();
+    if (track_intent_key_ranges_ && !transaction.intent_key_range().end.empty()) {
+      UpdateIntentKeyRangeBoundariesUnlocked(transaction.intent_key_range(), -1);
+      PublishIntentKeyRangesUnlocked();
+    }
     transactions_.erase(it);
     TransactionsModifiedUnlocked(min_running_notifier);
   }
 
+  void ExtendIntentKeyRangeUnlocked(
+      const RunningTransactionPtr& transaction, const IntentKeyRange& range) REQUIRES(mutex_) {
+    auto old_range = transaction->intent_key_range();
+    if (!transaction->ExtendIntentKeyRange(range)) {
+      return;
+    }
+    if (!old_range.end.empty()) {
+      UpdateIntentKeyRangeBoundariesUnlocked(old_range, -1);
+    }
+    UpdateIntentKeyRangeBoundariesUnlocked(transaction->intent_key_range(), 1);
+    PublishIntentKeyRangesUnlocked();
+  }
+
+  void UpdateIntentKeyRangeBoundariesUnlocked(const IntentKeyRange& range, ssize_t delta)
+      REQUIRES(mutex_) {
+    for (const auto& boundary : {std::make_pair(&range.begin, delta),
+                                 std::make_pair(&range.end, -delta)}) {
+      auto it = intent_key_range_boundaries_.emplace(*boundary.first, 0).first;
+      it->second += boundary.second;
+      if (it->second == 0) {
+        intent_key_range_boundaries_.erase(it);
+      }
+    }
+  }
+
+  // Builds merged ranges from the already sorted boundaries and publishes them to readers.
+  void PublishIntentKeyRangesUnlocked() REQUIRES(mutex_) {
+    auto merged = std::make_shared<IntentKeyRanges>();
+    ssize_t depth = 0;
+    for (const auto& boundary : intent_key_range_boundaries_) {
+      if (depth == 0) {
+        merged->push_back(IntentKeyRange{boundary.first, std::string()});
+      }
+      depth += boundary.second;
+      if (depth == 0) {
+        merged->back().end = boundary.first;
+      }
+    }
+    LOG_IF_WITH_PREFIX(DFATAL, depth != 0) << "Unbalanced intent key range boundaries: " << depth;
+    VLOG_WITH_PREFIX(4) << "Intent key ranges: " << AsString(*merged);
+    std::atomic_store(&intent_key_ranges_, IntentKeyRangesPtr(std::move(merged)));
+  }
+
   void CleanupRecentlyRemovedTransactions(CoarseTimePoint now) {
     while (!recently_removed_transactions_cleanup_queue_.empty() &&
            recently_removed_transactions_cleanup_queue_.front().time <= now) {
@@ -1281,6 +1377,12 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
   CHECKED_STATUS ReplicatedAborted(const TransactionId& id, const ReplicatedData& data) {
     MinRunningNotifier min_running_notifier(&applier_);
     std::lock_guard<std::mutex> lock(mutex_);
+    MarkAbortedUnlocked(id, &min_running_notifier);
+    return Status::OK();
+  }
+
+  void MarkAbortedUnlocked(const TransactionId& id, MinRunningNotifier* min_running_notifier)
+      REQUIRES(mutex_) {
     auto it = transactions_.find(id);
     if (it == transactions_.end()) {
       TransactionMetadata metadata = {
@@ -1291,13 +1393,11 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
       };
       it = transactions_.insert(std::make_shared<RunningTransaction>(
           metadata, TransactionalBatchData(), OneWayBitmap(), this)).first;
-      TransactionsModifiedUnlocked(&min_running_notifier);
+      TransactionsModifiedUnlocked(min_running_notifier);
     }
 
     // TODO(dtxn) store this fact to rocksdb.
     (**it).Aborted();
-
-    return Status::OK();
   }
 
   struct CleanupQueueEntry {
@@ -1362,6 +1462,17 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
   CountDownLatch start_latch_{1};
 
   std::atomic<HybridTime> min_running_ht_{HybridTime::kInvalid};
+
+  const bool track_intent_key_ranges_;
+
+  // Number of running transaction intent key ranges starting at key minus number of ones ending
+  // at it. Zero counts are not stored, so ranges could be merged with a single pass.
+  // Guarded by RunningTransactionContext::mutex_
+  std::map<std::string, ssize_t> intent_key_range_boundaries_;
+
+  // Merged intent key ranges of running transactions, republished by writers every time they
+  // change. Accessed using std::atomic_load/std::atomic_store.
+  IntentKeyRangesPtr intent_key_ranges_;
   std::atomic<CoarseTimePoint> next_check_min_running_{CoarseTimePoint()};
   HybridTime waiting_for_min_running_ht_ = HybridTime::kMax;
   std::atomic<bool> shutdown_done_{false};
@@ -1400,8 +1511,9 @@ boost::optional<std::pair<IsolationLevel, TransactionalBatchData>>
 }
 
 void TransactionParticipant::BatchReplicated(
-    const TransactionId& id, const TransactionalBatchData& data) {
-  return impl_->BatchReplicated(id, data);
+    const TransactionId& id, const TransactionalBatchData& data,
+    const IntentKeyRange& intent_key_range) {
+  return impl_->BatchReplicated(id, data, intent_key_range);
 }
 
 HybridTime TransactionParticipant::LocalCommitTime(const TransactionId& id) {
@@ -1474,6 +1586,10 @@ HybridTime TransactionParticipant::MinRunningHybridTime() const {
   return impl_->MinRunningHybridTime();
 }
 
+IntentKeyRangesPtr TransactionParticipant::LiveIntentKeyRanges() const {
+  return impl_->LiveIntentKeyRanges();
+}
+
 void TransactionParticipant::WaitMinRunningHybridTime(HybridTime ht) {
   impl_->WaitMinRunningHybridTime(ht);
 }
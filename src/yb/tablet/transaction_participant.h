@@ -167,7 +167,10 @@ class TransactionParticipant : public TransactionStatusManager {
       const TransactionId& id, size_t batch_idx,
       boost::container::small_vector_base<uint8_t>* encoded_replicated_batches);
 
-  void BatchReplicated(const TransactionId& id, const TransactionalBatchData& data);
+  // Updates last batch data of specified transaction. intent_key_range should cover all strong
+  // intents written by this batch, it should be provided before intents are written to the DB.
+  void BatchReplicated(const TransactionId& id, const TransactionalBatchData& data,
+                       const IntentKeyRange& intent_key_range);
 
   HybridTime LocalCommitTime(const TransactionId& id) override;
 
@@ -212,6 +215,8 @@ class TransactionParticipant : public TransactionStatusManager {
 
   HybridTime MinRunningHybridTime() const override;
 
+  IntentKeyRangesPtr LiveIntentKeyRanges() const override;
+
   // When minimal start hybrid time of running transaction will be at least `ht` applier
   // method `MinRunningHybridTimeSatisfied` will be invoked.
   void WaitMinRunningHybridTime(HybridTime ht);
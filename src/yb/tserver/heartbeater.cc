@@ -166,6 +166,9 @@ class Heartbeater::Thread {
   // True once at least one heartbeat has been sent.
   bool has_heartbeated_ = false;
 
+  // Number of tablets that did not fit into the last acknowledged tablet report.
+  int remaining_tablet_count_ = 0;
+
   // The number of heartbeats which have failed in a row.
   // This is tracked so as to back-off heartbeating.
   int consecutive_failed_heartbeats_ = 0;
@@ -336,6 +339,11 @@ int Heartbeater::Thread::GetMillisUntilNextHeartbeat() const {
     return GetMinimumHeartbeatMillis();
   }
 
+  // Send the rest of the tablet report without waiting for the heartbeat interval.
+  if (remaining_tablet_count_ > 0) {
+    return GetMinimumHeartbeatMillis();
+  }
+
   return FLAGS_heartbeat_interval_ms;
 }
 
@@ -446,6 +454,10 @@ Status Heartbeater::Thread::TryHeartbeat() {
 
   // TODO: Handle TSHeartbeatResponsePB (e.g. deleted tablets and schema changes)
   server_->tablet_manager()->MarkTabletReportAcknowledged(req.tablet_report());
+  remaining_tablet_count_ = req.tablet_report().remaining_tablet_count();
+  if (remaining_tablet_count_ > 0) {
+    VLOG_WITH_PREFIX(1) << remaining_tablet_count_ << " tablets remain to be reported";
+  }
 
   // Update the master's YSQL catalog version (i.e. if there were schema changes for YSQL objects).
   if (last_hb_response_.has_ysql_catalog_version()) {
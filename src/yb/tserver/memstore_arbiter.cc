@@ -0,0 +1,146 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/memstore_arbiter.h"
+
+#include <algorithm>
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/format.h"
+#include "yb/util/size_literals.h"
+
+DEFINE_double(global_memstore_flush_size_weight, 1.0,
+              "Weight of memtable size when picking the tablet to flush on reaching the global "
+              "memstore limit.");
+TAG_FLAG(global_memstore_flush_size_weight, advanced);
+TAG_FLAG(global_memstore_flush_size_weight, runtime);
+
+DEFINE_double(global_memstore_flush_age_weight, 0.5,
+              "Weight of the age of the oldest memtable write when picking the tablet to flush on "
+              "reaching the global memstore limit.");
+TAG_FLAG(global_memstore_flush_age_weight, advanced);
+TAG_FLAG(global_memstore_flush_age_weight, runtime);
+
+DEFINE_double(global_memstore_flush_wal_weight, 0.5,
+              "Weight of the retained WAL size when picking the tablet to flush on reaching the "
+              "global memstore limit.");
+TAG_FLAG(global_memstore_flush_wal_weight, advanced);
+TAG_FLAG(global_memstore_flush_wal_weight, runtime);
+
+DEFINE_double(global_memstore_flush_compaction_debt_weight, 0.25,
+              "Weight of the penalty for tablets having more SST files than required to trigger "
+              "compaction, when picking the tablet to flush on reaching the global memstore "
+              "limit.");
+TAG_FLAG(global_memstore_flush_compaction_debt_weight, advanced);
+TAG_FLAG(global_memstore_flush_compaction_debt_weight, runtime);
+
+DEFINE_int32(global_memstore_flush_max_age_sec, 0,
+             "Tablets whose oldest memtable write is older than this are flushed before others on "
+             "reaching the global memstore limit, regardless of their score. 0 to disable.");
+TAG_FLAG(global_memstore_flush_max_age_sec, advanced);
+TAG_FLAG(global_memstore_flush_max_age_sec, runtime);
+
+DEFINE_int64(global_memstore_flush_max_pinned_wal_mb, 0,
+             "Tablets whose memtables prevent garbage collection of more than this amount of WAL "
+             "are flushed before others on reaching the global memstore limit, regardless of "
+             "their score. 0 to disable.");
+TAG_FLAG(global_memstore_flush_max_pinned_wal_mb, advanced);
+TAG_FLAG(global_memstore_flush_max_pinned_wal_mb, runtime);
+
+DECLARE_int32(rocksdb_level0_file_num_compaction_trigger);
+
+using namespace yb::size_literals;
+
+namespace yb {
+namespace tserver {
+
+namespace {
+
+double Ratio(double value, double max_value) {
+  return max_value > 0 ? value / max_value : 0.0;
+}
+
+// Compaction debt in [0, 1]: 0 until the number of files reaches the compaction trigger, 1 when it
+// is twice the trigger.
+double CompactionDebt(uint64_t num_sst_files) {
+  const auto trigger = FLAGS_rocksdb_level0_file_num_compaction_trigger;
+  if (trigger <= 0 || num_sst_files <= static_cast<uint64_t>(trigger)) {
+    return 0.0;
+  }
+  return std::min(1.0, static_cast<double>(num_sst_files - trigger) / trigger);
+}
+
+// Whether the candidate exceeds absolute age or pinned WAL limits.
+bool ExceedsLimits(const MemstoreFlushCandidate& candidate) {
+  const auto max_age_sec = FLAGS_global_memstore_flush_max_age_sec;
+  if (max_age_sec > 0 && candidate.memtable_age > MonoDelta::FromSeconds(max_age_sec)) {
+    return true;
+  }
+  const auto max_pinned_wal_mb = FLAGS_global_memstore_flush_max_pinned_wal_mb;
+  return max_pinned_wal_mb > 0 &&
+         candidate.wal_bytes > static_cast<uint64_t>(max_pinned_wal_mb) * 1_MB;
+}
+
+} // namespace
+
+std::string MemstoreFlushCandidate::ToString() const {
+  return Format(
+      "{ tablet_id: $0 memtable_bytes: $1 memtable_age: $2 wal_bytes: $3 num_sst_files: $4 }",
+      tablet_id, memtable_bytes, memtable_age, wal_bytes, num_sst_files);
+}
+
+double MemstoreArbiter::Score(
+    const MemstoreFlushCandidate& candidate, const MemstoreFlushCandidate& max_values) {
+  return FLAGS_global_memstore_flush_size_weight *
+             Ratio(candidate.memtable_bytes, max_values.memtable_bytes) +
+         FLAGS_global_memstore_flush_age_weight *
+             Ratio(candidate.memtable_age.ToSeconds(), max_values.memtable_age.ToSeconds()) +
+         FLAGS_global_memstore_flush_wal_weight *
+             Ratio(candidate.wal_bytes, max_values.wal_bytes) -
+         FLAGS_global_memstore_flush_compaction_debt_weight *
+             CompactionDebt(candidate.num_sst_files);
+}
+
+const MemstoreFlushCandidate* MemstoreArbiter::PickFlushCandidate(
+    const std::vector<MemstoreFlushCandidate>& candidates) {
+  MemstoreFlushCandidate max_values;
+  for (const auto& candidate : candidates) {
+    max_values.memtable_bytes = std::max(max_values.memtable_bytes, candidate.memtable_bytes);
+    max_values.memtable_age = std::max(max_values.memtable_age, candidate.memtable_age);
+    max_values.wal_bytes = std::max(max_values.wal_bytes, candidate.wal_bytes);
+  }
+
+  // Candidates exceeding absolute limits are picked first, the score orders them among themselves.
+  const MemstoreFlushCandidate* result = nullptr;
+  bool result_exceeds_limits = false;
+  double best_score = 0;
+  for (const auto& candidate : candidates) {
+    auto exceeds_limits = ExceedsLimits(candidate);
+    if (result && exceeds_limits != result_exceeds_limits) {
+      if (!exceeds_limits) {
+        continue;
+      }
+      result = nullptr;
+    }
+    auto score = Score(candidate, max_values);
+    if (!result || score > best_score) {
+      result = &candidate;
+      result_exceeds_limits = exceeds_limits;
+      best_score = score;
+    }
+  }
+  return result;
+}
+
+} // namespace tserver
+} // namespace yb
@@ -0,0 +1,62 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TSERVER_MEMSTORE_ARBITER_H
+#define YB_TSERVER_MEMSTORE_ARBITER_H
+
+#include <string>
+#include <vector>
+
+#include "yb/common/entity_ids.h"
+#include "yb/util/monotime.h"
+
+namespace yb {
+namespace tserver {
+
+// State of a tablet with non empty memtable, that could be flushed to free memstore memory.
+struct MemstoreFlushCandidate {
+  TabletId tablet_id;
+  // Size of mutable memtables, i.e. memory freed by the flush.
+  size_t memtable_bytes = 0;
+  // Time since the oldest write to mutable memtables.
+  MonoDelta memtable_age = MonoDelta::kZero;
+  // Size of WAL retained on disk only because of unflushed memtables, i.e. that could be garbage
+  // collected after the flush.
+  uint64_t wal_bytes = 0;
+  // Number of SST files, the flush adds one more file to compact.
+  uint64_t num_sst_files = 0;
+
+  std::string ToString() const;
+};
+
+// Picks the tablet to flush when the global memstore limit is exceeded. Each candidate is scored
+// by a weighted sum of its memtable size, memtable age and retained WAL size, normalized by the
+// maximum among all candidates, minus a penalty for compaction debt. So big memtables of hot
+// tablets are flushed first, giving fewer and bigger SST files, while memtables of cold tablets
+// can stay in memory until they get old or retain too much WAL. Candidates exceeding the absolute
+// age or pinned WAL limits are flushed before all others.
+class MemstoreArbiter {
+ public:
+  // Returns the candidate with the highest score, or nullptr if there are no candidates.
+  static const MemstoreFlushCandidate* PickFlushCandidate(
+      const std::vector<MemstoreFlushCandidate>& candidates);
+
+  // Score of the candidate, relative to maximum values among all candidates.
+  static double Score(
+      const MemstoreFlushCandidate& candidate, const MemstoreFlushCandidate& max_values);
+};
+
+} // namespace tserver
+} // namespace yb
+
+#endif // YB_TSERVER_MEMSTORE_ARBITER_H
@@ -255,6 +255,9 @@ Status RemoteBootstrapClient::Start(const string& bootstrap_peer_uuid,
 
   downloader_.Start(
       proxy_, resp.session_id(), MonoDelta::FromMilliseconds(resp.session_idle_timeout_millis()));
+  if (ts_manager != nullptr) {
+    downloader_.SetIORateLimiter(ts_manager->io_rate_limiter());
+  }
   LOG_WITH_PREFIX(INFO) << "Began remote bootstrap session " << session_id();
 
   superblock_.reset(resp.release_superblock());
@@ -296,6 +299,10 @@ Status RemoteBootstrapClient::Start(const string& bootstrap_peer_uuid,
                       last_logged_term,
                       bootstrap_peer_uuid));
     }
+    // Retryable requests snapshot of the tombstoned replica does not match the WAL that will be
+    // downloaded. It is normally deleted during tombstoning, but could be left by a crash.
+    RETURN_NOT_OK(ConsensusMetadata::DeleteRetryableRequests(&fs_manager(), tablet_id_));
+
     // Replace rocksdb_dir in the received superblock with our rocksdb_dir.
     kv_store->set_rocksdb_dir(meta_->rocksdb_dir());
 
@@ -644,14 +651,8 @@ Status RemoteBootstrapClient::DownloadRocksDBFiles() {
 
   DataIdPB data_id;
   data_id.set_type(DataIdPB::ROCKSDB_FILE);
-  for (auto const& file_pb : new_superblock_.kv_store().rocksdb_files()) {
-    auto start = MonoTime::Now();
-    RETURN_NOT_OK(downloader_.DownloadFile(file_pb, rocksdb_dir, &data_id));
-    auto elapsed = MonoTime::Now().GetDeltaSince(start);
-    LOG_WITH_PREFIX(INFO)
-        << "Downloaded file " << file_pb.name() << " of size " << file_pb.size_bytes()
-        << " in " << elapsed.ToSeconds() << " seconds";
-  }
+  RETURN_NOT_OK(downloader_.DownloadFiles(
+      new_superblock_.kv_store().rocksdb_files(), rocksdb_dir, data_id));
 
   // To avoid adding new file type to remote bootstrap we move intents as subdir of regular DB.
   auto intents_tmp_dir = JoinPathSegments(rocksdb_dir, tablet::kIntentsSubdir);
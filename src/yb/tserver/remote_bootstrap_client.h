@@ -89,7 +89,7 @@ class RemoteBootstrapComponent {
 // This class is not thread-safe.
 //
 // TODO:
-// * Parallelize download of blocks and WAL segments.
+// * Parallelize download of WAL segments.
 //
 class RemoteBootstrapClient {
  public:
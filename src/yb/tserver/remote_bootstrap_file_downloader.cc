@@ -13,18 +13,27 @@
 
 #include "yb/tserver/remote_bootstrap_file_downloader.h"
 
+#include <unordered_set>
+
 #include "yb/common/wire_protocol.h"
 
 #include "yb/fs/fs_manager.h"
 
+#include "yb/rocksdb/rate_limiter.h"
+
 #include "yb/rpc/rpc_controller.h"
 
 #include "yb/tserver/remote_bootstrap.proxy.h"
 
+#include "yb/util/atomic.h"
+#include "yb/util/countdown_latch.h"
 #include "yb/util/crc.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
+#include "yb/util/random_util.h"
+#include "yb/util/scope_exit.h"
 #include "yb/util/size_literals.h"
+#include "yb/util/threadpool.h"
 #include "yb/util/net/rate_limiter.h"
 
 using namespace yb::size_literals;
@@ -49,9 +58,26 @@ DEFINE_int32(bytes_remote_bootstrap_durable_write_mb, 8,
              "Explicitly call fsync after downloading the specified amount of data in MB "
              "during a remote bootstrap session. If 0 fsync() is not called.");
 
-// RETURN_NOT_OK_PREPEND() with a remote-error unwinding step.
-#define RETURN_NOT_OK_UNWIND_PREPEND(status, controller, msg) \
-  RETURN_NOT_OK_PREPEND(UnwindRemoteError(status, controller), msg)
+DEFINE_int32(remote_bootstrap_max_parallel_file_downloads, 4,
+             "Maximum number of files downloaded at the same time by a single remote bootstrap "
+             "session.");
+TAG_FLAG(remote_bootstrap_max_parallel_file_downloads, advanced);
+TAG_FLAG(remote_bootstrap_max_parallel_file_downloads, runtime);
+
+DEFINE_int32(remote_bootstrap_fetch_data_max_retries, 5,
+             "Number of times a chunk of remote bootstrap data is requested again after a "
+             "transient failure, before failing the remote bootstrap.");
+TAG_FLAG(remote_bootstrap_fetch_data_max_retries, advanced);
+TAG_FLAG(remote_bootstrap_fetch_data_max_retries, runtime);
+
+DEFINE_int32(remote_bootstrap_fetch_data_retry_delay_ms, 500,
+             "Delay before requesting a chunk of remote bootstrap data again after a transient "
+             "failure. Multiplied by the number of the attempt.");
+TAG_FLAG(remote_bootstrap_fetch_data_retry_delay_ms, advanced);
+TAG_FLAG(remote_bootstrap_fetch_data_retry_delay_ms, runtime);
+
+DEFINE_test_flag(double, fault_inject_fetch_data_error, 0.0,
+                 "Probability of failing a received remote bootstrap chunk with a network error.");
 
 namespace yb {
 namespace tserver {
@@ -73,15 +99,29 @@ CHECKED_STATUS ExtractRemoteError(
           " from remote service");
 }
 
-} // namespace
+// Whether a failed chunk request could succeed if sent again.
+bool IsTransientFetchError(const Status& status) {
+  return status.IsNetworkError() || status.IsTimedOut() || status.IsServiceUnavailable() ||
+         status.IsTryAgain() || status.IsCorruption();
+}
 
-extern std::atomic<int32_t> remote_bootstrap_clients_started_;
+// Number of files being downloaded by all remote bootstrap sessions of this process. Used to split
+// remote_bootstrap_rate_limit_bytes_per_sec between them.
+std::atomic<int32_t> active_file_downloads{0};
+
+} // namespace
 
 RemoteBootstrapFileDownloader::RemoteBootstrapFileDownloader(
     const std::string* log_prefix, FsManager* fs_manager)
     : log_prefix_(*log_prefix), fs_manager_(*fs_manager) {
 }
 
+RemoteBootstrapFileDownloader::~RemoteBootstrapFileDownloader() {
+  if (download_pool_) {
+    download_pool_->Shutdown();
+  }
+}
+
 void RemoteBootstrapFileDownloader::Start(
     std::shared_ptr<RemoteBootstrapServiceProxy> proxy, std::string session_id,
     MonoDelta session_idle_timeout) {
@@ -100,16 +140,23 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
   RETURN_NOT_OK(env().CreateDirs(DirName(file_path)));
 
   if (file_pb.inode() != 0) {
-    auto it = inode2file_.find(file_pb.inode());
-    if (it != inode2file_.end()) {
+    std::string linked_file_path;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = inode2file_.find(file_pb.inode());
+      if (it != inode2file_.end()) {
+        linked_file_path = it->second;
+      }
+    }
+    if (!linked_file_path.empty()) {
       VLOG_WITH_PREFIX(2) << "File with the same inode already found: " << file_path
-                          << " => " << it->second;
-      auto link_status = env().LinkFile(it->second, file_path);
+                          << " => " << linked_file_path;
+      auto link_status = env().LinkFile(linked_file_path, file_path);
       if (link_status.ok()) {
         return Status::OK();
       }
       // TODO fallback to copy.
-      LOG_WITH_PREFIX(ERROR) << "Failed to link file: " << file_path << " => " << it->second
+      LOG_WITH_PREFIX(ERROR) << "Failed to link file: " << file_path << " => " << linked_file_path
                              << ": " << link_status;
     }
   }
@@ -126,12 +173,108 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
   VLOG_WITH_PREFIX(2) << "Downloaded file " << file_path;
 
   if (file_pb.inode() != 0) {
+    std::lock_guard<std::mutex> lock(mutex_);
     inode2file_.emplace(file_pb.inode(), file_path);
   }
 
   return Status::OK();
 }
 
+Status RemoteBootstrapFileDownloader::DownloadFiles(
+    const google::protobuf::RepeatedPtrField<tablet::FilePB>& files, const std::string& dir,
+    const DataIdPB& data_id) {
+  // Files sharing inode with a file downloaded before are hard linked to it, so they are processed
+  // after all parallel downloads complete.
+  std::vector<const tablet::FilePB*> files_to_download;
+  std::vector<const tablet::FilePB*> files_to_link;
+  std::unordered_set<uint64_t> inodes;
+  for (const auto& file_pb : files) {
+    if (file_pb.inode() != 0 && !inodes.insert(file_pb.inode()).second) {
+      files_to_link.push_back(&file_pb);
+    } else {
+      files_to_download.push_back(&file_pb);
+    }
+  }
+
+  auto download = [this, &dir, &data_id](const tablet::FilePB& file_pb) {
+    auto start = MonoTime::Now();
+    DataIdPB file_data_id = data_id;
+    RETURN_NOT_OK(DownloadFile(file_pb, dir, &file_data_id));
+    LOG_WITH_PREFIX(INFO)
+        << "Downloaded file " << file_pb.name() << " of size " << file_pb.size_bytes()
+        << " in " << (MonoTime::Now() - start).ToSeconds() << " seconds";
+    return Status::OK();
+  };
+
+  const auto max_parallel_flag =
+      std::max(GetAtomicFlag(&FLAGS_remote_bootstrap_max_parallel_file_downloads), 1);
+  const auto max_parallel = std::min<size_t>(max_parallel_flag, files_to_download.size());
+  if (max_parallel <= 1) {
+    for (const auto* file_pb : files_to_download) {
+      RETURN_NOT_OK(download(*file_pb));
+    }
+  } else {
+    if (!download_pool_) {
+      RETURN_NOT_OK(ThreadPoolBuilder("rb-download")
+                        .set_max_threads(max_parallel_flag)
+                        .Build(&download_pool_));
+    }
+    // Each worker downloads files one by one, till all files are claimed or a download fails.
+    std::mutex status_mutex;
+    Status status;
+    std::atomic<size_t> next_file{0};
+    auto worker = [&download, &files_to_download, &status_mutex, &status, &next_file] {
+      for (;;) {
+        {
+          std::lock_guard<std::mutex> lock(status_mutex);
+          if (!status.ok()) {
+            return;
+          }
+        }
+        const auto idx = next_file.fetch_add(1, std::memory_order_acq_rel);
+        if (idx >= files_to_download.size()) {
+          return;
+        }
+        auto download_status = download(*files_to_download[idx]);
+        if (!download_status.ok()) {
+          std::lock_guard<std::mutex> lock(status_mutex);
+          if (status.ok()) {
+            status = download_status;
+          }
+        }
+      }
+    };
+    for (size_t i = 0; i != max_parallel; ++i) {
+      auto submit_status = download_pool_->SubmitFunc(worker);
+      if (!submit_status.ok()) {
+        std::lock_guard<std::mutex> lock(status_mutex);
+        status = submit_status;
+        break;
+      }
+    }
+    download_pool_->Wait();
+    RETURN_NOT_OK(status);
+  }
+
+  for (const auto* file_pb : files_to_link) {
+    RETURN_NOT_OK(download(*file_pb));
+  }
+  return Status::OK();
+}
+
+void RemoteBootstrapFileDownloader::ChargeIORateLimiter(size_t bytes) {
+  if (!io_rate_limiter_) {
+    return;
+  }
+  // Single request cannot exceed the burst size of the rate limiter.
+  const size_t burst = std::max<int64_t>(io_rate_limiter_->GetSingleBurstBytes(), 1);
+  while (bytes > 0) {
+    const auto request = std::min(bytes, burst);
+    io_rate_limiter_->Request(request, rocksdb::Env::IO_HIGH);
+    bytes -= request;
+  }
+}
+
 template<class Appendable>
 Status RemoteBootstrapFileDownloader::DownloadFile(
     const DataIdPB& data_id, Appendable* appendable) {
@@ -143,37 +286,56 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
   int32_t max_length = std::min(FLAGS_remote_bootstrap_max_chunk_size,
                                 FLAGS_rpc_max_message_size - kBytesReservedForMessageHeaders);
 
+  active_file_downloads.fetch_add(1, std::memory_order_acq_rel);
+  auto se = ScopeExit([] {
+    active_file_downloads.fetch_sub(1, std::memory_order_acq_rel);
+  });
+
   std::unique_ptr<RateLimiter> rate_limiter;
 
   if (FLAGS_remote_bootstrap_rate_limit_bytes_per_sec > 0) {
     static auto rate_updater = []() {
-      auto remote_bootstrap_clients_started =
-          remote_bootstrap_clients_started_.load(std::memory_order_acquire);
-      if (remote_bootstrap_clients_started < 1) {
-        YB_LOG_EVERY_N(ERROR, 100) << "Invalid number of remote bootstrap sessions: "
-                                   << remote_bootstrap_clients_started;
+      auto num_downloads = active_file_downloads.load(std::memory_order_acquire);
+      if (num_downloads < 1) {
+        YB_LOG_EVERY_N(ERROR, 100) << "Invalid number of remote bootstrap file downloads: "
+                                   << num_downloads;
         return static_cast<uint64_t>(FLAGS_remote_bootstrap_rate_limit_bytes_per_sec);
       }
       return static_cast<uint64_t>(
-          FLAGS_remote_bootstrap_rate_limit_bytes_per_sec / remote_bootstrap_clients_started);
+          FLAGS_remote_bootstrap_rate_limit_bytes_per_sec / num_downloads);
     };
 
     rate_limiter = std::make_unique<RateLimiter>(rate_updater);
+    rate_limiter->Init();
   } else {
     // Inactive RateLimiter.
     rate_limiter = std::make_unique<RateLimiter>();
   }
 
-  rpc::RpcController controller;
-  controller.set_timeout(session_idle_timeout_);
-  FetchDataRequestPB req;
-
-  bool done = false;
-  while (!done) {
-    controller.Reset();
-    req.set_session_id(session_id_);
-    req.mutable_data_id()->CopyFrom(data_id);
-    req.set_offset(offset);
+  // Chunk request in flight. Two of them are used, so the next chunk could be requested before
+  // the current one is written.
+  struct Fetch {
+    FetchDataRequestPB req;
+    FetchDataResponsePB resp;
+    rpc::RpcController controller;
+    std::shared_ptr<CountDownLatch> latch;
+  };
+  Fetch fetches[2];
+  Fetch* in_flight = nullptr;
+  // Response buffers could not be released while the RPC is in progress.
+  auto wait_se = ScopeExit([&in_flight] {
+    if (in_flight) {
+      in_flight->latch->Wait();
+    }
+  });
+
+  auto send = [this, &data_id, &max_length, &rate_limiter, &in_flight](
+      Fetch* fetch, uint64_t fetch_offset) {
+    fetch->controller.Reset();
+    fetch->controller.set_timeout(session_idle_timeout_);
+    fetch->req.set_session_id(session_id_);
+    *fetch->req.mutable_data_id() = data_id;
+    fetch->req.set_offset(fetch_offset);
     if (rate_limiter->active()) {
       auto max_size = rate_limiter->GetMaxSizeForNextTransmission();
       if (max_size > std::numeric_limits<decltype(max_length)>::max()) {
@@ -181,35 +343,78 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
       }
       max_length = std::min(max_length, decltype(max_length)(max_size));
     }
-    req.set_max_length(max_length);
+    fetch->req.set_max_length(max_length);
+    fetch->resp.Clear();
+    auto latch = std::make_shared<CountDownLatch>(1);
+    fetch->latch = latch;
+    in_flight = fetch;
+    proxy_->FetchDataAsync(
+        fetch->req, &fetch->resp, &fetch->controller, [latch] { latch->CountDown(); });
+  };
+
+  Fetch* fetch = &fetches[0];
+  send(fetch, offset);
+  int attempt = 0;
+  for (;;) {
+    fetch->latch->Wait();
+    in_flight = nullptr;
+
+    auto status = UnwindRemoteError(fetch->controller.status(), fetch->controller);
+    if (status.ok()) {
+      DCHECK_LE(fetch->resp.chunk().data().size(), max_length);
+      // Sanity-check for corruption.
+      status = VerifyData(offset, fetch->resp.chunk());
+    }
+    if (status.ok() && RandomActWithProbability(FLAGS_TEST_fault_inject_fetch_data_error)) {
+      status = STATUS(NetworkError, "Injected fetch data error");
+    }
+    if (!status.ok()) {
+      if (IsTransientFetchError(status) &&
+          attempt < GetAtomicFlag(&FLAGS_remote_bootstrap_fetch_data_max_retries)) {
+        ++attempt;
+        LOG_WITH_PREFIX(WARNING)
+            << "Failed to fetch " << data_id.ShortDebugString() << " at offset " << offset
+            << ", attempt " << attempt << ": " << status;
+        SleepFor(MonoDelta::FromMilliseconds(
+            attempt * GetAtomicFlag(&FLAGS_remote_bootstrap_fetch_data_retry_delay_ms)));
+        send(fetch, offset);
+        continue;
+      }
+      return status.CloneAndPrepend(Format("Unable to fetch data item $0 from remote", data_id));
+    }
+    attempt = 0;
 
-    FetchDataResponsePB resp;
-    auto status = rate_limiter->SendOrReceiveData([this, &req, &resp, &controller]() {
-      return proxy_->FetchData(req, &resp, &controller);
-    }, [&resp]() { return resp.ByteSize(); });
-    RETURN_NOT_OK_UNWIND_PREPEND(status, controller, "Unable to fetch data from remote");
-    DCHECK_LE(resp.chunk().data().size(), max_length);
+    const auto& chunk = fetch->resp.chunk();
+    const auto chunk_size = chunk.data().size();
+    if (rate_limiter->active()) {
+      rate_limiter->UpdateDataSizeAndMaybeSleep(fetch->resp.ByteSize());
+    }
+    VLOG_WITH_PREFIX(3)
+        << "resp size: " << fetch->resp.ByteSize() << ", chunk size: " << chunk_size;
 
-    // Sanity-check for corruption.
-    RETURN_NOT_OK_PREPEND(VerifyData(offset, resp.chunk()),
-                          Format("Error validating data item $0", data_id));
+    const bool done = offset + chunk_size == chunk.total_data_length();
+    Fetch* next = nullptr;
+    if (!done) {
+      next = fetch == &fetches[0] ? &fetches[1] : &fetches[0];
+      send(next, offset + chunk_size);
+    }
 
     // Write the data.
-    RETURN_NOT_OK(appendable->Append(resp.chunk().data()));
-    VLOG_WITH_PREFIX(3)
-        << "resp size: " << resp.ByteSize() << ", chunk size: " << resp.chunk().data().size();
+    ChargeIORateLimiter(chunk_size);
+    RETURN_NOT_OK(appendable->Append(chunk.data()));
 
-    if (offset + resp.chunk().data().size() == resp.chunk().total_data_length()) {
-      done = true;
-    }
-    offset += resp.chunk().data().size();
+    offset += chunk_size;
     if (FLAGS_bytes_remote_bootstrap_durable_write_mb != 0) {
-      periodic_sync_unsynced_bytes += resp.chunk().data().size();
+      periodic_sync_unsynced_bytes += chunk_size;
       if (periodic_sync_unsynced_bytes > FLAGS_bytes_remote_bootstrap_durable_write_mb * 1_MB) {
         RETURN_NOT_OK(appendable->Sync());
         periodic_sync_unsynced_bytes = 0;
       }
     }
+    if (done) {
+      break;
+    }
+    fetch = next;
   }
 
   VLOG_WITH_PREFIX(2) << "Transmission rate: " << rate_limiter->GetRate();
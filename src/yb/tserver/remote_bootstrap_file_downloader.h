@@ -15,9 +15,14 @@
 #define YB_TSERVER_REMOTE_BOOTSTRAP_FILE_DOWNLOADER_H
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
+#include <google/protobuf/repeated_field.h>
+
+#include "yb/gutil/thread_annotations.h"
+
 #include "yb/rpc/rpc_fwd.h"
 
 #include "yb/tablet/metadata.pb.h"
@@ -27,11 +32,18 @@
 #include "yb/util/monotime.h"
 #include "yb/util/status.h"
 
+namespace rocksdb {
+
+class RateLimiter;
+
+} // namespace rocksdb
+
 namespace yb {
 
 class Env;
 class FsManager;
 class MonoDelta;
+class ThreadPool;
 
 namespace tserver {
 
@@ -40,17 +52,34 @@ class RemoteBootstrapServiceProxy;
 class RemoteBootstrapFileDownloader {
  public:
   RemoteBootstrapFileDownloader(const std::string* log_prefix, FsManager* fs_manager);
+  ~RemoteBootstrapFileDownloader();
 
   void Start(
       std::shared_ptr<RemoteBootstrapServiceProxy> proxy, std::string session_id,
       MonoDelta session_idle_timeout);
 
+  // Sets the tablet server wide rate limiter, that downloaded bytes are charged to together with
+  // flushes and compactions.
+  void SetIORateLimiter(std::shared_ptr<rocksdb::RateLimiter> io_rate_limiter) {
+    io_rate_limiter_ = std::move(io_rate_limiter);
+  }
+
   CHECKED_STATUS DownloadFile(
       const tablet::FilePB& file_pb, const std::string& dir, DataIdPB* data_id);
 
+  // Download files to the specified dir, up to remote_bootstrap_max_parallel_file_downloads
+  // files at a time. data_id is used as a template for requests, its file name is overwritten.
+  CHECKED_STATUS DownloadFiles(
+      const google::protobuf::RepeatedPtrField<tablet::FilePB>& files, const std::string& dir,
+      const DataIdPB& data_id);
+
   // Download a single remote file. The block and WAL implementations delegate
   // to this method when downloading files.
   //
+  // The next chunk is requested before the received one is written, so network transfer overlaps
+  // with disk writes. Chunks that failed with a transient error are requested again from the same
+  // offset, so the download resumes where it stopped.
+  //
   // An Appendable is typically a WritableFile (WAL).
   //
   // Only used in one compilation unit, otherwise the implementation would
@@ -69,6 +98,9 @@ class RemoteBootstrapFileDownloader {
  private:
   CHECKED_STATUS VerifyData(uint64_t offset, const DataChunkPB& resp);
 
+  // Waits until the tablet server wide rate limiter allows to write the specified number of bytes.
+  void ChargeIORateLimiter(size_t bytes);
+
   const std::string& LogPrefix() const {
     return log_prefix_;
   }
@@ -81,7 +113,13 @@ class RemoteBootstrapFileDownloader {
   std::shared_ptr<RemoteBootstrapServiceProxy> proxy_;
   std::string session_id_;
   MonoDelta session_idle_timeout_ = MonoDelta::kZero;
-  std::unordered_map<uint64_t, std::string> inode2file_;
+  std::shared_ptr<rocksdb::RateLimiter> io_rate_limiter_;
+
+  // Runs parallel file downloads, created by the first DownloadFiles that needs it.
+  std::unique_ptr<ThreadPool> download_pool_;
+
+  std::mutex mutex_;
+  std::unordered_map<uint64_t, std::string> inode2file_ GUARDED_BY(mutex_);
 };
 
 CHECKED_STATUS UnwindRemoteError(const Status& status, const rpc::RpcController& controller);
@@ -17,6 +17,11 @@
 
 #include "yb/tserver/remote_bootstrap_client-test.h"
 
+DECLARE_int32(remote_bootstrap_max_chunk_size);
+DECLARE_int32(remote_bootstrap_max_parallel_file_downloads);
+DECLARE_int32(remote_bootstrap_fetch_data_max_retries);
+DECLARE_int32(remote_bootstrap_fetch_data_retry_delay_ms);
+DECLARE_double(TEST_fault_inject_fetch_data_error);
 
 using std::shared_ptr;
 
@@ -31,6 +36,10 @@ using tablet::TabletStatusListener;
 class RemoteBootstrapRocksDBClientTest : public RemoteBootstrapClientTest {
  public:
   RemoteBootstrapRocksDBClientTest() : RemoteBootstrapClientTest(YQL_TABLE_TYPE) {}
+
+ protected:
+  // Downloads all files and checks that they match the files of the checkpoint on the leader.
+  void DownloadAndVerifyRocksDBFiles();
 };
 
 // Basic begin / end remote bootstrap session.
@@ -40,8 +49,7 @@ TEST_F(RemoteBootstrapRocksDBClientTest, TestBeginEndSession) {
   ASSERT_OK(client_->Finish());
 }
 
-// Basic RocksDB files download unit test.
-TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles) {
+void RemoteBootstrapRocksDBClientTest::DownloadAndVerifyRocksDBFiles() {
   TabletStatusListener listener(meta_);
   ASSERT_OK(client_->FetchAll(&listener));
   auto tablet_peer_checkpoint_dir =
@@ -81,5 +89,21 @@ TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles) {
   }
 }
 
+// Basic RocksDB files download unit test.
+TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles) {
+  DownloadAndVerifyRocksDBFiles();
+}
+
+// Downloads files in parallel using small chunks, while some of the chunks fail and are requested
+// again.
+TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFilesWithRetries) {
+  FLAGS_remote_bootstrap_max_chunk_size = 1024;
+  FLAGS_remote_bootstrap_max_parallel_file_downloads = 4;
+  FLAGS_remote_bootstrap_fetch_data_max_retries = 100;
+  FLAGS_remote_bootstrap_fetch_data_retry_delay_ms = 1;
+  FLAGS_TEST_fault_inject_fetch_data_error = 0.1;
+  DownloadAndVerifyRocksDBFiles();
+}
+
 } // namespace tserver
 } // namespace yb
@@ -42,6 +42,7 @@
 
 #include "yb/common/wire_protocol.h"
 #include "yb/consensus/log.h"
+#include "yb/consensus/raft_consensus.h"
 #include "yb/fs/fs_manager.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/gutil/map-util.h"
@@ -156,6 +157,14 @@ void RemoteBootstrapServiceImpl::BeginRemoteBootstrapSession(
   RPC_RETURN_NOT_OK(tablet_peer->CheckRunning(),
                     RemoteBootstrapErrorPB::TABLET_NOT_FOUND,
                     Substitute("Tablet is not running yet: $0", tablet_id));
+  // Witness keeps writes only in its WAL, its tablet does not have the data.
+  auto consensus = tablet_peer->raft_consensus();
+  if (consensus && consensus->IsWitness()) {
+    RPC_RETURN_APP_ERROR(
+        RemoteBootstrapErrorPB::INVALID_REMOTE_BOOTSTRAP_REQUEST,
+        Substitute("Tablet replica is a witness: $0", tablet_id),
+        STATUS(IllegalState, "Witness could not be a remote bootstrap source"));
+  }
 
   scoped_refptr<RemoteBootstrapSession> session;
   {
@@ -246,7 +255,7 @@ void RemoteBootstrapServiceImpl::FetchData(const FetchDataRequestPB* req,
 
   MAYBE_FAULT(FLAGS_TEST_fault_crash_on_handle_rb_fetch_data);
 
-  int64_t rate_limit = session->rate_limiter().GetMaxSizeForNextTransmission();
+  int64_t rate_limit = session->GetMaxSizeForNextTransmission();
   VLOG(3) << " rate limiter max len: " << rate_limit;
   GetDataPieceInfo info = {
     .offset = req->offset(),
@@ -262,7 +271,7 @@ void RemoteBootstrapServiceImpl::FetchData(const FetchDataRequestPB* req,
   RPC_RETURN_NOT_OK(session->GetDataPiece(data_id, &info),
                     info.error_code, "Unable to get piece of data file");
 
-  session->rate_limiter().UpdateDataSizeAndMaybeSleep(info.data.size());
+  session->UpdateRateLimiter(info.data.size());
   uint32_t crc32 = Crc32c(info.data.data(), info.data.length());
 
   DataChunkPB* data_chunk = resp->mutable_chunk();
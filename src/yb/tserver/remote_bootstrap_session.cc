@@ -571,11 +571,29 @@ bool RemoteBootstrapSession::Succeeded() {
 }
 
 void RemoteBootstrapSession::EnsureRateLimiterIsInitialized() {
+  std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
   if (!rate_limiter_.IsInitialized()) {
     InitRateLimiter();
   }
 }
 
+uint64_t RemoteBootstrapSession::GetMaxSizeForNextTransmission() {
+  std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
+  return rate_limiter_.GetMaxSizeForNextTransmission();
+}
+
+void RemoteBootstrapSession::UpdateRateLimiter(uint64_t data_size) {
+  MonoDelta sleep_time;
+  {
+    std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
+    sleep_time = rate_limiter_.UpdateDataSize(data_size);
+  }
+  // Don't block other FetchData calls of this session while sleeping.
+  if (sleep_time > MonoDelta::kZero) {
+    SleepFor(sleep_time);
+  }
+}
+
 
 void RemoteBootstrapSession::InitRateLimiter() {
   if (FLAGS_remote_bootstrap_rate_limit_bytes_per_sec > 0 && nsessions_) {
@@ -128,11 +128,13 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
   // Change the peer's role to VOTER.
   CHECKED_STATUS ChangeRole();
 
-  void InitRateLimiter();
-
   void EnsureRateLimiterIsInitialized();
 
-  RateLimiter& rate_limiter() { return rate_limiter_; }
+  // Rate limiter is shared by all FetchData calls of this session, which could be executed
+  // concurrently when the client downloads several files in parallel.
+  uint64_t GetMaxSizeForNextTransmission();
+
+  void UpdateRateLimiter(uint64_t data_size);
 
   static const std::string kCheckpointsDir;
 
@@ -216,8 +218,12 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
   // Time when this session was initialized.
   MonoTime start_time_;
 
+  void InitRateLimiter() REQUIRES(rate_limiter_mutex_);
+
+  std::mutex rate_limiter_mutex_;
+
   // Used to limit the transmission rate.
-  RateLimiter rate_limiter_;
+  RateLimiter rate_limiter_ GUARDED_BY(rate_limiter_mutex_);
 
   // Pointer to the counter for of the number of sessions in RemoteBootstrapService. Used to
   // calculate the rate for the rate limiter.
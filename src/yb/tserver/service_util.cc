@@ -14,6 +14,7 @@
 #include "yb/tserver/service_util.h"
 
 #include "yb/consensus/consensus.h"
+#include "yb/consensus/raft_consensus.h"
 
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_metrics.h"
@@ -51,6 +52,14 @@ Result<int64_t> LeaderTerm(const tablet::TabletPeer& tablet_peer) {
 
   if (!leader_state.ok()) {
     typedef consensus::LeaderStatus LeaderStatus;
+    if (leader_state.status == LeaderStatus::LEADER_BUT_NO_MAJORITY_REPLICATED_LEASE) {
+      // Lease heartbeats to quiescent peers could be lost, so resume regular heartbeats to
+      // acquire the lease before the client retries.
+      auto raft_consensus = tablet_peer.shared_raft_consensus();
+      if (raft_consensus) {
+        raft_consensus->WakeFromQuiescence();
+      }
+    }
     auto status = leader_state.CreateStatus();
     switch (leader_state.status) {
       case LeaderStatus::NOT_LEADER: FALLTHROUGH_INTENDED;
@@ -0,0 +1,113 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/tablet_location_changes.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/random_util.h"
+
+DEFINE_int32(tablet_location_changes_max_size, 1000,
+             "Max number of recent tablet location changes kept by the tablet server to be sent "
+             "to clients.");
+TAG_FLAG(tablet_location_changes_max_size, advanced);
+TAG_FLAG(tablet_location_changes_max_size, runtime);
+
+DEFINE_int32(tablet_location_changes_max_per_response, 100,
+             "Max number of tablet location changes piggybacked on a single response. When there "
+             "are more, only the latest ones are sent.");
+TAG_FLAG(tablet_location_changes_max_per_response, advanced);
+TAG_FLAG(tablet_location_changes_max_per_response, runtime);
+
+namespace yb {
+namespace tserver {
+
+TabletLocationChanges::TabletLocationChanges()
+    : instance_id_(RandomUniformInt<uint64_t>(0, std::numeric_limits<uint64_t>::max())) {}
+
+void TabletLocationChanges::LeaderChanged(
+    const TabletId& tablet_id, const std::string& leader_uuid) {
+  if (leader_uuid.empty()) {
+    return;
+  }
+  TabletLocationChangePB change;
+  change.set_tablet_id(tablet_id);
+  change.set_leader_uuid(leader_uuid);
+  Add(std::move(change));
+}
+
+void TabletLocationChanges::TabletSplit(const TabletId& tablet_id) {
+  TabletLocationChangePB change;
+  change.set_tablet_id(tablet_id);
+  change.set_split(true);
+  Add(std::move(change));
+}
+
+void TabletLocationChanges::Add(TabletLocationChangePB change) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto sequence_number = last_sequence_number_.load(std::memory_order_relaxed) + 1;
+  change.set_sequence_number(sequence_number);
+  changes_.push_back(std::move(change));
+  last_sequence_number_.store(sequence_number, std::memory_order_release);
+  const size_t max_size = std::max(FLAGS_tablet_location_changes_max_size, 1);
+  while (changes_.size() > max_size) {
+    changes_.pop_front();
+  }
+}
+
+void TabletLocationChanges::Fill(
+    const TabletLocationChangesRequestPB& req, TabletLocationChangesPB* out) const {
+  out->set_instance_id(instance_id_);
+  // A client that did not receive changes from any instance yet has fresh locations from the
+  // master, so it only needs the current sequence number.
+  if (!req.has_instance_id()) {
+    out->set_last_sequence_number(last_sequence_number_.load(std::memory_order_acquire));
+    return;
+  }
+  // Changes observed by the previous instance of this tablet server are lost.
+  if (req.instance_id() != instance_id_) {
+    out->set_last_sequence_number(last_sequence_number_.load(std::memory_order_acquire));
+    out->set_overflow(true);
+    return;
+  }
+  // Most of the requests come from clients that are up to date, so don't lock for them.
+  auto last_sequence_number = last_sequence_number_.load(std::memory_order_acquire);
+  if (req.last_sequence_number() >= last_sequence_number) {
+    out->set_last_sequence_number(last_sequence_number);
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  last_sequence_number = last_sequence_number_.load(std::memory_order_acquire);
+  out->set_last_sequence_number(last_sequence_number);
+  const int64_t first_sequence_number = std::max<int64_t>(
+      req.last_sequence_number() + 1,
+      last_sequence_number - std::max(FLAGS_tablet_location_changes_max_per_response, 1) + 1);
+  if (changes_.empty() || first_sequence_number > req.last_sequence_number() + 1 ||
+      changes_.front().sequence_number() > first_sequence_number) {
+    out->set_overflow(true);
+  }
+  if (changes_.empty()) {
+    return;
+  }
+  auto it = changes_.begin() + std::max<int64_t>(
+      0, first_sequence_number - changes_.front().sequence_number());
+  for (; it != changes_.end(); ++it) {
+    *out->add_changes() = *it;
+  }
+}
+
+} // namespace tserver
+} // namespace yb
@@ -0,0 +1,59 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TSERVER_TABLET_LOCATION_CHANGES_H
+#define YB_TSERVER_TABLET_LOCATION_CHANGES_H
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+
+#include "yb/common/entity_ids.h"
+#include "yb/gutil/thread_annotations.h"
+#include "yb/tserver/tserver.pb.h"
+
+namespace yb {
+namespace tserver {
+
+// Keeps recent tablet location changes observed by the tablet server, i.e. leader elections and
+// splits of its tablets. Changes are numbered, and clients subscribe to them by sending the number
+// of the last change they know with read and write requests. New changes are piggybacked on the
+// responses, so clients update cached tablet locations without waiting for requests to fail.
+class TabletLocationChanges {
+ public:
+  TabletLocationChanges();
+
+  void LeaderChanged(const TabletId& tablet_id, const std::string& leader_uuid);
+
+  void TabletSplit(const TabletId& tablet_id);
+
+  // Fills out with changes not yet known to the client that sent req. Sets overflow when some of
+  // them are no longer available.
+  void Fill(const TabletLocationChangesRequestPB& req, TabletLocationChangesPB* out) const;
+
+ private:
+  void Add(TabletLocationChangePB change);
+
+  const uint64_t instance_id_;
+
+  mutable std::mutex mutex_;
+  std::deque<TabletLocationChangePB> changes_ GUARDED_BY(mutex_);
+  // Modified under mutex_, read without it to answer clients that are up to date.
+  std::atomic<int64_t> last_sequence_number_{0};
+};
+
+} // namespace tserver
+} // namespace yb
+
+#endif // YB_TSERVER_TABLET_LOCATION_CHANGES_H
@@ -0,0 +1,156 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/tablet_open_scheduler.h"
+
+#include <algorithm>
+
+#include <glog/logging.h>
+
+#include "yb/util/threadpool.h"
+
+namespace yb {
+namespace tserver {
+
+TabletOpenScheduler::TabletOpenScheduler(
+    ThreadPool* pool, size_t max_concurrent, size_t max_per_dir)
+    : pool_(pool), max_concurrent_(std::max<size_t>(max_concurrent, 1)),
+      max_per_dir_(std::max<size_t>(max_per_dir, 1)) {}
+
+void TabletOpenScheduler::Add(Task task) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& group = groups_[task.data_root_dir + "|" + task.wal_root_dir];
+  group.data_root_dir = task.data_root_dir;
+  group.wal_root_dir = task.wal_root_dir;
+  auto it = std::upper_bound(
+      group.tasks.begin(), group.tasks.end(), task.priority,
+      [](TabletOpenPriority priority, const Task& rhs) { return priority < rhs.priority; });
+  group.tasks.insert(it, std::move(task));
+  ++total_;
+}
+
+Status TabletOpenScheduler::Start() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  start_time_ = MonoTime::Now();
+  LOG(INFO) << "Opening " << total_ << " tablets from " << groups_.size()
+            << " directory groups, max concurrent: " << max_concurrent_
+            << ", max per directory: " << max_per_dir_;
+  if (total_ == 0) {
+    finish_time_ = start_time_;
+  }
+  return ScheduleUnlocked();
+}
+
+bool TabletOpenScheduler::HasCapacity(const Group& group) const {
+  for (const auto* dir : {&group.data_root_dir, &group.wal_root_dir}) {
+    auto it = dir_in_progress_.find(*dir);
+    if (it != dir_in_progress_.end() && it->second >= max_per_dir_) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void TabletOpenScheduler::ChangeInProgress(const Group& group, int delta) {
+  dir_in_progress_[group.data_root_dir] += delta;
+  if (group.wal_root_dir != group.data_root_dir) {
+    dir_in_progress_[group.wal_root_dir] += delta;
+  }
+}
+
+Status TabletOpenScheduler::ScheduleUnlocked() {
+  while (in_progress_.size() < max_concurrent_) {
+    // Pick the most important tablet among directories that could take more load, preferring
+    // the least loaded directories when priorities are equal.
+    std::string best_key;
+    Group* best = nullptr;
+    size_t best_load = 0;
+    for (auto& p : groups_) {
+      auto& group = p.second;
+      if (group.tasks.empty() || !HasCapacity(group)) {
+        continue;
+      }
+      const size_t load = std::max(dir_in_progress_[group.data_root_dir],
+                                   dir_in_progress_[group.wal_root_dir]);
+      if (!best || group.tasks.front().priority < best->tasks.front().priority ||
+          (group.tasks.front().priority == best->tasks.front().priority && load < best_load)) {
+        best_key = p.first;
+        best = &group;
+        best_load = load;
+      }
+    }
+    if (!best) {
+      return Status::OK();
+    }
+
+    auto task = std::move(best->tasks.front());
+    best->tasks.pop_front();
+    ChangeInProgress(*best, 1);
+    in_progress_.emplace(task.tablet_id, MonoTime::Now());
+    VLOG(1) << "Opening tablet " << task.tablet_id << " with priority "
+            << ToString(task.priority) << " from " << best_key;
+
+    auto tablet_id = task.tablet_id;
+    auto status = pool_->SubmitFunc([this, task = std::move(task), best_key] {
+      task.open();
+      Opened(task.tablet_id, best_key);
+    });
+    if (!status.ok()) {
+      in_progress_.erase(tablet_id);
+      ChangeInProgress(*best, -1);
+      return status;
+    }
+  }
+  return Status::OK();
+}
+
+void TabletOpenScheduler::Opened(const TabletId& tablet_id, const std::string& group_key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  in_progress_.erase(tablet_id);
+  ChangeInProgress(groups_[group_key], -1);
+  ++opened_;
+  if (opened_ == total_) {
+    finish_time_ = MonoTime::Now();
+    LOG(INFO) << "Opened " << total_ << " tablets in " << finish_time_ - start_time_;
+  }
+  WARN_NOT_OK(ScheduleUnlocked(), "Failed to schedule tablet open");
+}
+
+TabletOpenScheduler::Progress TabletOpenScheduler::GetProgress() const {
+  Progress result;
+  const auto now = MonoTime::Now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  result.total = total_;
+  result.opened = opened_;
+  if (start_time_.Initialized()) {
+    result.elapsed = (finish_time_.Initialized() ? finish_time_ : now) - start_time_;
+  }
+  for (const auto& p : in_progress_) {
+    result.in_progress.emplace_back(p.first, now - p.second);
+  }
+  for (const auto& p : groups_) {
+    const auto& group = p.second;
+    result.pending += group.tasks.size();
+    result.dirs[group.data_root_dir].pending += group.tasks.size();
+    if (group.wal_root_dir != group.data_root_dir) {
+      result.dirs[group.wal_root_dir].pending += group.tasks.size();
+    }
+  }
+  for (const auto& p : dir_in_progress_) {
+    result.dirs[p.first].in_progress = p.second;
+  }
+  return result;
+}
+
+} // namespace tserver
+} // namespace yb
@@ -0,0 +1,122 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TSERVER_TABLET_OPEN_SCHEDULER_H
+#define YB_TSERVER_TABLET_OPEN_SCHEDULER_H
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/common/entity_ids.h"
+#include "yb/gutil/thread_annotations.h"
+#include "yb/util/enums.h"
+#include "yb/util/monotime.h"
+#include "yb/util/status.h"
+
+namespace yb {
+
+class ThreadPool;
+
+namespace tserver {
+
+// Order in which tablets are opened during startup, tablets with lower value are opened first.
+YB_DEFINE_ENUM(TabletOpenPriority,
+               // Tablets of transaction status tables, needed by all transactional tablets.
+               (kSystem)
+               // Tablets that were led by this tablet server before restart.
+               (kRecentLeader)
+               (kRegular));
+
+// Opens tablets during tablet server startup. Tablets are grouped by data and WAL directories,
+// and the number of tablets opened at the same time using the same directory is limited, so each
+// disk is kept busy without being oversubscribed. Within each disk tablets are opened in priority
+// order.
+class TabletOpenScheduler {
+ public:
+  struct Task {
+    TabletId tablet_id;
+    std::string data_root_dir;
+    std::string wal_root_dir;
+    TabletOpenPriority priority = TabletOpenPriority::kRegular;
+    std::function<void()> open;
+  };
+
+  struct DirProgress {
+    size_t in_progress = 0;
+    size_t pending = 0;
+  };
+
+  struct Progress {
+    size_t total = 0;
+    size_t opened = 0;
+    size_t pending = 0;
+    MonoDelta elapsed;
+    // Tablets being opened, with time elapsed since their open was started.
+    std::vector<std::pair<TabletId, MonoDelta>> in_progress;
+    std::map<std::string, DirProgress> dirs;
+  };
+
+  // Tablets are opened on the specified pool. At most max_concurrent tablets are opened at the same
+  // time, and at most max_per_dir of them use the same data or WAL directory.
+  TabletOpenScheduler(ThreadPool* pool, size_t max_concurrent, size_t max_per_dir);
+
+  // Should be called before Start.
+  void Add(Task task);
+
+  // Starts opening added tablets. Completion of tablet open schedules the next ones, so pool
+  // remains busy until all tablets are opened.
+  CHECKED_STATUS Start();
+
+  Progress GetProgress() const;
+
+ private:
+  // Tablets sharing data and WAL directories.
+  struct Group {
+    std::string data_root_dir;
+    std::string wal_root_dir;
+    // Ordered by priority.
+    std::deque<Task> tasks;
+  };
+
+  // Submits tablets to the pool while limits allow.
+  CHECKED_STATUS ScheduleUnlocked() REQUIRES(mutex_);
+
+  bool HasCapacity(const Group& group) const REQUIRES(mutex_);
+
+  void ChangeInProgress(const Group& group, int delta) REQUIRES(mutex_);
+
+  void Opened(const TabletId& tablet_id, const std::string& group_key);
+
+  ThreadPool* const pool_;
+  const size_t max_concurrent_;
+  const size_t max_per_dir_;
+
+  mutable std::mutex mutex_;
+  std::map<std::string, Group> groups_ GUARDED_BY(mutex_);
+  std::unordered_map<std::string, size_t> dir_in_progress_ GUARDED_BY(mutex_);
+  std::unordered_map<TabletId, MonoTime> in_progress_ GUARDED_BY(mutex_);
+  size_t total_ GUARDED_BY(mutex_) = 0;
+  size_t opened_ GUARDED_BY(mutex_) = 0;
+  MonoTime start_time_ GUARDED_BY(mutex_);
+  MonoTime finish_time_ GUARDED_BY(mutex_);
+};
+
+} // namespace tserver
+} // namespace yb
+
+#endif // YB_TSERVER_TABLET_OPEN_SCHEDULER_H
@@ -30,7 +30,12 @@
 // under the License.
 //
 
+#include <thread>
+
+#include "yb/consensus/consensus.proxy.h"
 #include "yb/consensus/log-test-base.h"
+#include "yb/consensus/multi_raft_batcher.h"
+#include "yb/consensus/raft_consensus.h"
 
 #include "yb/common/ql_value.h"
 
@@ -54,6 +59,7 @@
 #include "yb/tserver/ts_tablet_manager.h"
 #include "yb/tserver/tserver_admin.proxy.h"
 
+#include "yb/util/countdown_latch.h"
 #include "yb/util/crc.h"
 #include "yb/util/curl_util.h"
 #include "yb/util/url-coding.h"
@@ -71,6 +77,8 @@ using std::shared_ptr;
 using std::string;
 using strings::Substitute;
 
+using namespace std::literals;
+
 DEFINE_int32(single_threaded_insert_latency_bench_warmup_rows, 100,
              "Number of rows to insert in the warmup phase of the single threaded"
              " tablet server insert latency micro-benchmark");
@@ -84,6 +92,9 @@ DECLARE_int32(metrics_retirement_age_ms);
 DECLARE_string(block_manager);
 DECLARE_string(rpc_bind_addresses);
 DECLARE_bool(disable_clock_sync_error);
+DECLARE_int32(multi_raft_batch_size);
+DECLARE_int32(multi_raft_heartbeat_interval_ms);
+DECLARE_int32(multi_raft_update_consensus_max_latency_ms);
 
 // Declare these metrics prototypes for simpler unit testing of their behavior.
 METRIC_DECLARE_counter(rows_inserted);
@@ -895,5 +906,107 @@ TEST_F(TabletServerTest, TestChecksumScan) {
   ASSERT_EQ(first_crc, resp.checksum());
 }
 
+namespace {
+
+// Heartbeat from a leader of an earlier term, so it is rejected by the tablet without side effects.
+consensus::ConsensusRequestPB MakeStaleHeartbeat(
+    const std::string& dest_uuid, const std::string& tablet_id) {
+  consensus::ConsensusRequestPB req;
+  req.set_dest_uuid(dest_uuid);
+  req.set_tablet_id(tablet_id);
+  req.set_caller_uuid("fake-leader");
+  req.set_caller_term(0);
+  req.mutable_committed_op_id()->set_term(0);
+  req.mutable_committed_op_id()->set_index(0);
+  return req;
+}
+
+} // namespace
+
+TEST_F(TabletServerTest, TestMultiRaftUpdateConsensus) {
+  const auto uuid = mini_server_->server()->fs_manager()->uuid();
+  consensus::MultiRaftConsensusRequestPB req;
+  *req.add_consensus_request() = MakeStaleHeartbeat(uuid, kTabletId);
+  *req.add_consensus_request() = MakeStaleHeartbeat("wrong-uuid", kTabletId);
+  *req.add_consensus_request() = MakeStaleHeartbeat(uuid, "unknown-tablet");
+
+  consensus::MultiRaftConsensusResponsePB resp;
+  RpcController controller;
+  ASSERT_OK(consensus_proxy_->MultiRaftUpdateConsensus(req, &resp, &controller));
+  SCOPED_TRACE(resp.DebugString());
+  ASSERT_EQ(3, resp.consensus_response_size());
+  const auto& tablet_resp = resp.consensus_response(0);
+  ASSERT_FALSE(tablet_resp.has_error());
+  ASSERT_EQ(uuid, tablet_resp.responder_uuid());
+  ASSERT_EQ(consensus::ConsensusErrorPB::INVALID_TERM, tablet_resp.status().error().code());
+  ASSERT_EQ(TabletServerErrorPB::WRONG_SERVER_UUID, resp.consensus_response(1).error().code());
+  ASSERT_EQ(TabletServerErrorPB::TABLET_NOT_FOUND, resp.consensus_response(2).error().code());
+}
+
+// A tablet that is busy with a slow update should not delay the whole batch.
+TEST_F(TabletServerTest, TestMultiRaftUpdateConsensusLatency) {
+  FLAGS_multi_raft_update_consensus_max_latency_ms = 500;
+  const auto uuid = mini_server_->server()->fs_manager()->uuid();
+  auto* raft_consensus = down_cast<consensus::RaftConsensus*>(tablet_peer_->consensus());
+
+  raft_consensus->TEST_DelayUpdate(5s);
+  std::thread slow_update([this, &uuid] {
+    consensus::ConsensusResponsePB resp;
+    RpcController controller;
+    controller.set_timeout(30s);
+    EXPECT_OK(consensus_proxy_->UpdateConsensus(
+        MakeStaleHeartbeat(uuid, kTabletId), &resp, &controller));
+  });
+  // Wait until the slow update holds the update lock.
+  std::this_thread::sleep_for(1s);
+  raft_consensus->TEST_DelayUpdate(0s);
+
+  consensus::MultiRaftConsensusRequestPB req;
+  *req.add_consensus_request() = MakeStaleHeartbeat(uuid, kTabletId);
+  consensus::MultiRaftConsensusResponsePB resp;
+  RpcController controller;
+  auto start = CoarseMonoClock::now();
+  auto status = consensus_proxy_->MultiRaftUpdateConsensus(req, &resp, &controller);
+  auto elapsed = CoarseMonoClock::now() - start;
+  slow_update.join();
+
+  ASSERT_OK(status);
+  SCOPED_TRACE(resp.DebugString());
+  ASSERT_LT(elapsed, 3s);
+  ASSERT_EQ(1, resp.consensus_response_size());
+  ASSERT_TRUE(StatusFromPB(resp.consensus_response(0).error().status()).IsTimedOut());
+}
+
+TEST_F(TabletServerTest, TestMultiRaftHeartbeatBatcher) {
+  // The first two heartbeats are sent as soon as the batch is full, the last one by timer.
+  FLAGS_multi_raft_batch_size = 2;
+  FLAGS_multi_raft_heartbeat_interval_ms = 100;
+  constexpr int kNumHeartbeats = 3;
+  const auto uuid = mini_server_->server()->fs_manager()->uuid();
+
+  auto batcher = std::make_shared<consensus::MultiRaftHeartbeatBatcher>(
+      HostPort::FromBoundEndpoint(mini_server_->bound_rpc_addr()), proxy_cache_.get(),
+      client_messenger_.get());
+  std::vector<consensus::ConsensusResponsePB> responses(kNumHeartbeats);
+  std::vector<Status> statuses(kNumHeartbeats);
+  CountDownLatch latch(kNumHeartbeats);
+  for (int i = 0; i != kNumHeartbeats; ++i) {
+    ASSERT_TRUE(batcher->AddRequestToBatch(
+        MakeStaleHeartbeat(uuid, kTabletId), &responses[i],
+        [&statuses, &latch, i](const Status& status) {
+      statuses[i] = status;
+      latch.CountDown();
+    }));
+  }
+  ASSERT_TRUE(latch.WaitFor(10s));
+
+  for (int i = 0; i != kNumHeartbeats; ++i) {
+    ASSERT_OK(statuses[i]);
+    SCOPED_TRACE(responses[i].DebugString());
+    ASSERT_EQ(uuid, responses[i].responder_uuid());
+    ASSERT_EQ(consensus::ConsensusErrorPB::INVALID_TERM, responses[i].status().error().code());
+  }
+}
+
 } // namespace tserver
 } // namespace yb
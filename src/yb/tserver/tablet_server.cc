@@ -35,6 +35,7 @@
 #include <algorithm>
 #include <list>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include <glog/logging.h>
@@ -49,6 +50,8 @@
 #include "yb/server/rpc_server.h"
 #include "yb/server/webserver.h"
 #include "yb/tablet/maintenance_manager.h"
+#include "yb/tablet/tablet.h"
+#include "yb/tablet/transaction_coordinator.h"
 #include "yb/tserver/heartbeater_factory.h"
 #include "yb/tserver/metrics_snapshotter.h"
 #include "yb/tserver/tablet_service.h"
@@ -367,14 +370,46 @@ void TabletServer::Shutdown() {
   LOG(INFO) << "TabletServer shut down complete. Bye!";
 }
 
+namespace {
+
+bool SameTServerInstances(const std::vector<master::TSInformationPB>& lhs,
+                          const google::protobuf::RepeatedPtrField<master::TSInformationPB>& rhs) {
+  if (lhs.size() != static_cast<size_t>(rhs.size())) {
+    return false;
+  }
+  std::unordered_map<std::string, int64_t> instances;
+  for (const auto& ts : lhs) {
+    const auto& instance = ts.tserver_instance();
+    instances.emplace(instance.permanent_uuid(), instance.instance_seqno());
+  }
+  for (const auto& ts : rhs) {
+    auto it = instances.find(ts.tserver_instance().permanent_uuid());
+    if (it == instances.end() || it->second != ts.tserver_instance().instance_seqno()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
 Status TabletServer::PopulateLiveTServers(const master::TSHeartbeatResponsePB& heartbeat_resp) {
-  std::lock_guard<simple_spinlock> l(lock_);
-  // We reset the list each time, since we want to keep the tservers that are live from the
-  // master's perspective.
-  // TODO: In the future, we should enhance the logic here to keep track information retrieved
-  // from the master and compare it with information stored here. Based on this information, we
-  // can only send diff updates CQL clients about whether a node came up or went down.
-  live_tservers_.assign(heartbeat_resp.tservers().begin(), heartbeat_resp.tservers().end());
+  bool liveness_changed;
+  {
+    std::lock_guard<simple_spinlock> l(lock_);
+    liveness_changed = !live_tservers_.empty() &&
+                       !SameTServerInstances(live_tservers_, heartbeat_resp.tservers());
+    // We reset the list each time, since we want to keep the tservers that are live from the
+    // master's perspective.
+    // TODO: In the future, we should enhance the logic here to keep track information retrieved
+    // from the master and compare it with information stored here. Based on this information, we
+    // can only send diff updates CQL clients about whether a node came up or went down.
+    live_tservers_.assign(heartbeat_resp.tservers().begin(), heartbeat_resp.tservers().end());
+  }
+  // Quiescent Raft groups rely on liveness reported by the master to detect leader failures.
+  if (liveness_changed) {
+    tablet_manager_->WakeQuiescentTablets();
+  }
   return Status::OK();
 }
 
@@ -397,6 +432,31 @@ bool TabletServer::LeaderAndReady(const TabletId& tablet_id, bool allow_stale) c
   return peer->LeaderStatus(allow_stale) == consensus::LeaderStatus::LEADER_AND_READY;
 }
 
+Status TabletServer::GetTransactionStatus(const GetTransactionStatusRequestPB* req,
+                                          CoarseTimePoint deadline,
+                                          GetTransactionStatusResponsePB* resp) const {
+  server::UpdateClock(*req, clock_.get());
+
+  tablet::TabletPeerPtr peer;
+  if (!tablet_manager_->LookupTablet(req->tablet_id(), &peer)) {
+    return STATUS(NotFound, "Tablet not found", req->tablet_id());
+  }
+  // Coordinator state could be used only by the leader that holds a valid lease, the same check
+  // that is performed for GetTransactionStatus RPC.
+  if (peer->LeaderStatus() != consensus::LeaderStatus::LEADER_AND_READY) {
+    return STATUS(IllegalState, "Not the leader", req->tablet_id());
+  }
+  auto tablet = peer->shared_tablet();
+  auto* transaction_coordinator = tablet ? tablet->transaction_coordinator() : nullptr;
+  if (!transaction_coordinator) {
+    return STATUS_FORMAT(InvalidArgument, "No transaction coordinator at tablet $0",
+                         req->tablet_id());
+  }
+  RETURN_NOT_OK(transaction_coordinator->GetStatus(req->transaction_id(), deadline, resp));
+  resp->set_propagated_hybrid_time(clock_->Now().ToUint64());
+  return Status::OK();
+}
+
 Status TabletServer::SetUniverseKeyRegistry(
     const yb::UniverseKeyRegistryPB& universe_key_registry) {
   return Status::OK();
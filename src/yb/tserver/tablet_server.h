@@ -148,6 +148,10 @@ class TabletServer : public server::RpcAndWebServerBase, public TabletServerIf {
 
   bool LeaderAndReady(const TabletId& tablet_id, bool allow_stale = false) const override;
 
+  CHECKED_STATUS GetTransactionStatus(const GetTransactionStatusRequestPB* req,
+                                      CoarseTimePoint deadline,
+                                      GetTransactionStatusResponsePB* resp) const override;
+
   const std::string& permanent_uuid() const { return fs_manager_->uuid(); }
 
   // Returns the proxy to call this tablet server locally.
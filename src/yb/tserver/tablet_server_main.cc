@@ -100,6 +100,8 @@ DECLARE_int32(cql_proxy_webserver_port);
 DECLARE_string(pgsql_proxy_bind_address);
 DECLARE_bool(start_pgsql_proxy);
 DECLARE_bool(enable_ysql);
+DECLARE_bool(ysql_enable_pipelined_commit);
+DECLARE_bool(enable_transaction_sealing);
 
 DECLARE_int64(remote_bootstrap_rate_limit_bytes_per_sec);
 
@@ -127,6 +129,15 @@ void SetProxyAddress(std::string* flag, const std::string& name, uint16_t port)
   }
 }
 
+// Pipelined commit of YSQL transactions relies on transaction sealing.
+Status ValidateTransactionFlags() {
+  if (FLAGS_ysql_enable_pipelined_commit && !FLAGS_enable_transaction_sealing) {
+    return STATUS(InvalidArgument,
+                  "--ysql_enable_pipelined_commit requires --enable_transaction_sealing");
+  }
+  return Status::OK();
+}
+
 // Helper function to set the proxy rpc addresses based on rpc_bind_addresses.
 void SetProxyAddresses() {
   LOG(INFO) << "Using parsed rpc = " << FLAGS_rpc_bind_addresses;
@@ -157,6 +168,7 @@ int TabletServerMain(int argc, char** argv) {
   }
   LOG_AND_RETURN_FROM_MAIN_NOT_OK(log::ModifyDurableWriteFlagIfNotODirect());
   LOG_AND_RETURN_FROM_MAIN_NOT_OK(InitYB(TabletServerOptions::kServerType, argv[0]));
+  LOG_AND_RETURN_FROM_MAIN_NOT_OK(ValidateTransactionFlags());
 
   LOG(INFO) << "NumCPUs determined to be: " << base::NumCPUs();
 
@@ -37,6 +37,7 @@
 #include <string>
 #include <vector>
 
+#include "yb/client/client.h"
 #include "yb/client/transaction.h"
 #include "yb/client/transaction_pool.h"
 
@@ -44,6 +45,8 @@
 #include "yb/common/row_mark.h"
 #include "yb/common/schema.h"
 #include "yb/common/wire_protocol.h"
+#include "yb/consensus/consensus.proxy.h"
+#include "yb/consensus/consensus_meta.h"
 #include "yb/consensus/leader_lease.h"
 #include "yb/consensus/raft_consensus.h"
 
@@ -144,6 +147,20 @@ DEFINE_int32(max_stale_read_bound_time_ms, 0, "If we are allowed to read from fo
 TAG_FLAG(max_stale_read_bound_time_ms, evolving);
 TAG_FLAG(max_stale_read_bound_time_ms, runtime);
 
+DEFINE_bool(follower_read_index, false,
+            "When set, a follower serves strongly consistent non-transactional reads by asking "
+            "the leader for its read index and waiting for the local safe time to reach it, "
+            "instead of rejecting the read and redirecting the client to the leader.");
+TAG_FLAG(follower_read_index, advanced);
+TAG_FLAG(follower_read_index, runtime);
+
+DEFINE_int32(multi_raft_update_consensus_max_latency_ms, 200,
+             "Maximum time MultiRaftUpdateConsensus waits for update locks of tablets in the "
+             "batch. After it passes, tablets that are busy with other updates are responded with "
+             "an error instead of delaying heartbeats of the remaining tablets.");
+TAG_FLAG(multi_raft_update_consensus_max_latency_ms, advanced);
+TAG_FLAG(multi_raft_update_consensus_max_latency_ms, runtime);
+
 DEFINE_uint64(sst_files_soft_limit, 24,
               "When majority SST files number is greater that this limit, we will start rejecting "
               "part of write requests. The higher the number of SST files, the higher probability "
@@ -234,6 +251,8 @@ using consensus::ConsensusResponsePB;
 using consensus::GetLastOpIdRequestPB;
 using consensus::GetNodeInstanceRequestPB;
 using consensus::GetNodeInstanceResponsePB;
+using consensus::GetReadIndexRequestPB;
+using consensus::GetReadIndexResponsePB;
 using consensus::LeaderStepDownRequestPB;
 using consensus::LeaderStepDownResponsePB;
 using consensus::LeaderLeaseStatus;
@@ -263,6 +282,19 @@ using tablet::WriteOperationState;
 
 namespace {
 
+// Piggybacks recent tablet location changes on the response, if the client subscribed to them.
+template <class Req, class Resp>
+void FillLocationChanges(TabletServerIf* server, const Req& req, Resp* resp) {
+  if (!req.has_location_changes()) {
+    return;
+  }
+  auto* tablet_manager = server->tablet_manager();
+  if (tablet_manager) {
+    tablet_manager->location_changes().Fill(
+        req.location_changes(), resp->mutable_location_changes());
+  }
+}
+
 template<class RespClass>
 bool GetConsensusOrRespond(const TabletPeerPtr& tablet_peer,
                            RespClass* resp,
@@ -309,6 +341,25 @@ bool RejectWrite(tablet::TabletPeer* tablet_peer, const std::string& message, do
   return false;
 }
 
+// Whether a strongly consistent read that reached a follower could be served by it using the
+// read index of the leader.
+template <class Req>
+bool CanServeWithReadIndex(const Req& req) {
+  return false;
+}
+
+bool CanServeWithReadIndex(const ReadRequestPB& req) {
+  return FLAGS_follower_read_index &&
+         req.consistency_level() == YBConsistencyLevel::STRONG &&
+         !req.has_transaction() && !req.has_read_time();
+}
+
+// Witness does not have the data, so it could not serve reads.
+bool IsWitness(const tablet::TabletPeer& tablet_peer) {
+  auto consensus = tablet_peer.raft_consensus();
+  return consensus && consensus->IsWitness();
+}
+
 void AdjustYsqlOperationTransactionality(
     size_t ysql_batch_size,
     const TabletPeer* tablet_peer,
@@ -1334,6 +1385,7 @@ void TabletServiceImpl::Write(const WriteRequestPB* req,
                "tablet_id", req->tablet_id());
   VLOG(2) << "Received Write RPC: " << req->DebugString();
   UpdateClock(*req, server_->Clock());
+  FillLocationChanges(server_, *req, resp);
 
   auto tablet = LookupLeaderTabletOrRespond(
       server_->tablet_peer_lookup(), req->tablet_id(), resp, &context);
@@ -1508,7 +1560,7 @@ bool TabletServiceImpl::DoGetTabletOrRespond(
     }
 
     s = CheckPeerIsLeader(*tablet_peer);
-    if (PREDICT_FALSE(!s.ok())) {
+    if (PREDICT_FALSE(!s.ok()) && (!CanServeWithReadIndex(*req) || IsWitness(*tablet_peer))) {
       SetupErrorAndRespond(resp->mutable_error(), s, context);
       return false;
     }
@@ -1518,6 +1570,13 @@ bool TabletServiceImpl::DoGetTabletOrRespond(
     // Peer is not the leader, so check that the time since it last heard from the leader is less
     // than FLAGS_max_stale_read_bound_time_ms.
     if (PREDICT_FALSE(!s.ok())) {
+      if (PREDICT_FALSE(IsWitness(*tablet_peer))) {
+        // Witness does not have the data, let the client try another replica.
+        SetupErrorAndRespond(resp->mutable_error(),
+                             STATUS(IllegalState, "Witness replica does not serve reads"),
+                             TabletServerErrorPB::STALE_FOLLOWER, context);
+        return false;
+      }
       if (FLAGS_max_stale_read_bound_time_ms > 0) {
         shared_ptr <consensus::Consensus> consensus = tablet_peer->shared_consensus();
         if (consensus->TimeSinceLastMessageFromLeader() != MonoTime::kUninitialized) {
@@ -1620,6 +1679,24 @@ struct ReadContext {
   }
 };
 
+// Strongly consistent read served by a follower, while it waits for the read index of the
+// leader.
+struct ReadIndexCall {
+  ReadIndexCall(ReadContext&& read_context_, std::shared_ptr<rpc::RpcContext> context_)
+      : read_context(std::move(read_context_)), context(std::move(context_)) {
+    read_context.context = context.get();
+  }
+
+  ReadContext read_context;
+  std::shared_ptr<rpc::RpcContext> context;
+  HostPortPB host_port_pb;
+
+  std::unique_ptr<consensus::ConsensusServiceProxy> proxy;
+  GetReadIndexRequestPB req;
+  GetReadIndexResponsePB resp;
+  rpc::RpcController controller;
+};
+
 // Used when we write intents during read, i.e. for serializable isolation.
 // We cannot proceed with read from ReadOperationCompletionCallback, to avoid holding
 // replica state lock for too long.
@@ -1698,6 +1775,7 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
   TRACE_EVENT1("tserver", "TabletServiceImpl::Read",
       "tablet_id", req->tablet_id());
   VLOG(2) << "Received Read RPC: " << req->DebugString();
+  FillLocationChanges(server_, *req, resp);
 
   // Unfortunately, determining the isolation level is not as straightforward as it seems. All but
   // the first request to a given tablet by a particular transaction assume that the tablet already
@@ -1765,6 +1843,9 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
 
   LeaderTabletPeer leader_peer;
   ReadContext read_context = {req, resp, &context};
+  // Set when this peer is a follower serving a strongly consistent read using the read index of
+  // the leader.
+  TabletPeerPtr read_index_peer;
 
   if (serializable_isolation || has_row_mark) {
     // At this point we expect that we don't have pure read serializable transactions, and
@@ -1780,9 +1861,17 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
     }
     read_context.tablet = leader_peer.peer->shared_tablet();
   } else {
-    if (!GetTabletOrRespond(req, resp, &context, &read_context.tablet, std::move(tablet_peer))) {
+    const bool can_serve_with_read_index = CanServeWithReadIndex(*req);
+    if (can_serve_with_read_index && !tablet_peer) {
+      tablet_peer = VERIFY_RESULT_OR_RETURN(LookupTabletPeerOrRespond(
+          server_->tablet_peer_lookup(), req->tablet_id(), resp, &context));
+    }
+    if (!GetTabletOrRespond(req, resp, &context, &read_context.tablet, tablet_peer)) {
       return;
     }
+    if (can_serve_with_read_index && !CheckPeerIsLeader(*tablet_peer).ok()) {
+      read_index_peer = std::move(tablet_peer);
+    }
     leader_peer.leader_term = yb::OpId::kUnknownTerm;
   }
 
@@ -1808,6 +1897,28 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
       req->consistency_level() == YBConsistencyLevel::STRONG);
   // TODO: should check all the tables referenced by the requests to decide if it is transactional.
   const bool transactional = read_context.transactional();
+  if (read_index_peer) {
+    // Transactional reads need an uncertainty window derived from the leader clock, so they are
+    // left to the leader. STALE_FOLLOWER makes the client retry without marking this replica as
+    // failed.
+    if (transactional) {
+      SetupErrorAndRespond(
+          resp->mutable_error(),
+          STATUS(IllegalState, "Transactional strong reads are served only by the leader"),
+          TabletServerErrorPB::STALE_FOLLOWER, &context);
+      return;
+    }
+    // The read continues in ReadAtLeaderReadIndex when the leader responds.
+    auto call = std::make_shared<ReadIndexCall>(
+        std::move(read_context), std::make_shared<RpcContext>(std::move(context)));
+    auto status = RequestLeaderReadIndex(*read_index_peer, call);
+    if (!status.ok()) {
+      SetupErrorAndRespond(
+          resp->mutable_error(), status, TabletServerErrorPB::STALE_FOLLOWER,
+          call->context.get());
+    }
+    return;
+  }
   // Should not pick read time for serializable isolation, since it is picked after read intents
   // are added. Also conflict resolution for serializable isolation should be done without read time
   // specified. So we use max hybrid time for conflict resolution in such case.
@@ -1875,9 +1986,83 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
   CompleteRead(&read_context);
 }
 
+Status TabletServiceImpl::RequestLeaderReadIndex(
+    const TabletPeer& tablet_peer, const std::shared_ptr<ReadIndexCall>& call) {
+  auto tablet_consensus = tablet_peer.shared_consensus();
+  if (!tablet_consensus) {
+    return STATUS(IllegalState, "Consensus unavailable. Tablet not running");
+  }
+  auto cstate = tablet_consensus->ConsensusState(CONSENSUS_CONFIG_ACTIVE);
+  if (!cstate.has_leader_uuid() || cstate.leader_uuid().empty()) {
+    return STATUS(IllegalState, "Leader is not known");
+  }
+  const RaftPeerPB* leader = nullptr;
+  for (const auto& peer : cstate.config().peers()) {
+    if (peer.permanent_uuid() == cstate.leader_uuid()) {
+      leader = &peer;
+      break;
+    }
+  }
+  if (!leader) {
+    return STATUS_FORMAT(IllegalState, "Leader $0 is not in active config", cstate.leader_uuid());
+  }
+
+  auto* client = server_->client();
+  call->proxy = std::make_unique<consensus::ConsensusServiceProxy>(
+      &client->proxy_cache(),
+      HostPortFromPB(consensus::DesiredHostPort(*leader, client->cloud_info())));
+  call->req.set_dest_uuid(leader->permanent_uuid());
+  call->req.set_tablet_id(tablet_peer.tablet_id());
+  call->controller.set_deadline(call->context->GetClientDeadline());
+  // Callback is invoked in the thread pool, so it could wait for safe time.
+  call->proxy->GetReadIndexAsync(
+      call->req, &call->resp, &call->controller, [this, call] {
+    ReadAtLeaderReadIndex(call.get());
+  });
+  return Status::OK();
+}
+
+void TabletServiceImpl::ReadAtLeaderReadIndex(ReadIndexCall* call) {
+  auto& read_context = call->read_context;
+  auto status = call->controller.status();
+  if (status.ok() && call->resp.has_error()) {
+    status = StatusFromPB(call->resp.error().status());
+  }
+  if (!status.ok()) {
+    SetupErrorAndRespond(
+        read_context.resp->mutable_error(), status, TabletServerErrorPB::STALE_FOLLOWER,
+        call->context.get());
+    return;
+  }
+
+  HybridTime read_index(call->resp.read_ht());
+  VLOG(3) << "Read index: " << read_index;
+  // Leader lease was already checked by the leader, so we just wait for local safe time to
+  // reach the read index. Operations below it stay pending in MVCC till they are applied here,
+  // so this also waits for them to be applied.
+  read_context.read_time = ReadHybridTime::SingleTime(read_index);
+  read_context.require_lease = tablet::RequireLease::kFalse;
+  status = read_context.PickReadTime(server_->Clock());
+  if (!status.ok()) {
+    SetupErrorAndRespond(
+        read_context.resp->mutable_error(), status, TabletServerErrorPB::UNKNOWN_ERROR,
+        call->context.get());
+    return;
+  }
+
+  const auto& remote_address = call->context->remote_address();
+  call->host_port_pb.set_host(remote_address.address().to_string());
+  call->host_port_pb.set_port(remote_address.port());
+  read_context.host_port_pb = &call->host_port_pb;
+
+  down_cast<Tablet*>(read_context.tablet.get())->metrics()->follower_read_index_reads->Increment();
+  CompleteRead(&read_context);
+}
+
 void TabletServiceImpl::CompleteRead(ReadContext* read_context) {
   for (;;) {
     read_context->resp->Clear();
+    FillLocationChanges(server_, *read_context->req, read_context->resp);
     read_context->context->ResetRpcSidecars();
     VLOG(1) << "Read time: " << read_context->read_time
             << ", safe: " << read_context->safe_ht_to_read;
@@ -1902,6 +2087,7 @@ void TabletServiceImpl::CompleteRead(ReadContext* read_context) {
       // The read time is specified, than we read as part of transaction. So we should restart
       // whole transaction. In this case we report restart time and abort reading.
       read_context->resp->Clear();
+      FillLocationChanges(server_, *read_context->req, read_context->resp);
       auto restart_read_time = read_context->resp->mutable_restart_read_time();
       restart_read_time->set_read_ht(read_context->read_time.read.ToUint64());
       restart_read_time->set_local_limit_ht(read_context->read_time.local_limit.ToUint64());
@@ -2101,28 +2287,54 @@ void ConsensusServiceImpl::UpdateConsensus(const ConsensusRequestPB* req,
   if (!CheckUuidMatchOrRespond(tablet_manager_, "UpdateConsensus", req, resp, &context)) {
     return;
   }
-  auto tablet_peer = VERIFY_RESULT_OR_RETURN(LookupTabletPeerOrRespond(
-      tablet_manager_, req->tablet_id(), resp, &context));
-
-  // Submit the update directly to the TabletPeer's Consensus instance.
-  shared_ptr<Consensus> consensus;
-  if (!GetConsensusOrRespond(tablet_peer, resp, &context, &consensus)) return;
 
   // Unfortunately, we have to use const_cast here, because the protobuf-generated interface only
   // gives us a const request, but we need to be able to move messages out of the request for
   // efficiency.
-  Status s = consensus->Update(
-      const_cast<ConsensusRequestPB*>(req), resp, context.GetClientDeadline());
+  TabletServerErrorPB::Code error_code = TabletServerErrorPB::UNKNOWN_ERROR;
+  Status s = DoUpdateConsensus(
+      const_cast<ConsensusRequestPB*>(req), resp, context.GetClientDeadline(), &error_code);
+  if (PREDICT_FALSE(!s.ok())) {
+    SetupErrorAndRespond(resp->mutable_error(), s, error_code, &context);
+    return;
+  }
+
+  context.RespondSuccess();
+}
+
+Status ConsensusServiceImpl::DoUpdateConsensus(
+    ConsensusRequestPB* req, ConsensusResponsePB* resp, CoarseTimePoint deadline,
+    TabletServerErrorPB::Code* error_code) {
+  std::shared_ptr<tablet::TabletPeer> tablet_peer;
+  Status s = tablet_manager_->GetTabletPeer(req->tablet_id(), &tablet_peer);
+  if (PREDICT_FALSE(!s.ok())) {
+    *error_code = s.IsServiceUnavailable() ? TabletServerErrorPB::UNKNOWN_ERROR
+                                           : TabletServerErrorPB::TABLET_NOT_FOUND;
+    return s;
+  }
+
+  tablet::RaftGroupStatePB state = tablet_peer->state();
+  if (PREDICT_FALSE(state != tablet::RUNNING)) {
+    *error_code = TabletServerErrorPB::TABLET_NOT_RUNNING;
+    return STATUS(IllegalState, "Tablet not RUNNING", tablet::RaftGroupStateError(state))
+        .CloneAndAddErrorCode(TabletServerError(*error_code));
+  }
+
+  // Submit the update directly to the TabletPeer's Consensus instance.
+  shared_ptr<Consensus> consensus = tablet_peer->shared_consensus();
+  if (!consensus) {
+    *error_code = TabletServerErrorPB::TABLET_NOT_RUNNING;
+    return STATUS(ServiceUnavailable, "Consensus unavailable. Tablet not running");
+  }
+
+  s = consensus->Update(req, resp, deadline);
   if (PREDICT_FALSE(!s.ok())) {
     // Clear the response first, since a partially-filled response could
     // result in confusing a caller, or in having missing required fields
     // in embedded optional messages.
     resp->Clear();
-
-    SetupErrorAndRespond(resp->mutable_error(), s,
-                         TabletServerErrorPB::UNKNOWN_ERROR,
-                         &context);
-    return;
+    *error_code = TabletServerErrorPB::UNKNOWN_ERROR;
+    return s;
   }
 
   auto tablet = tablet_peer->shared_tablet();
@@ -2131,6 +2343,41 @@ void ConsensusServiceImpl::UpdateConsensus(const ConsensusRequestPB* req,
   }
 
   resp->set_propagated_hybrid_time(tablet_peer->clock().Now().ToUint64());
+  return Status::OK();
+}
+
+void ConsensusServiceImpl::MultiRaftUpdateConsensus(
+    const consensus::MultiRaftConsensusRequestPB* req,
+    consensus::MultiRaftConsensusResponsePB* resp,
+    rpc::RpcContext context) {
+  DVLOG(3) << "Received Multi Raft Consensus Update RPC with "
+           << req->consensus_request_size() << " requests";
+  // Requests are processed serially, so a tablet whose update lock is held by a slow operation
+  // could delay heartbeats of all other tablets in the batch. Waiting for the lock is limited by
+  // the batch deadline, after it passes only tablets whose lock is free are updated.
+  auto deadline = std::min(
+      context.GetClientDeadline(),
+      CoarseMonoClock::now() + FLAGS_multi_raft_update_consensus_max_latency_ms * 1ms);
+  const auto& local_uuid = tablet_manager_->NodeInstance().permanent_uuid();
+  for (int i = 0; i != req->consensus_request_size(); ++i) {
+    // See UpdateConsensus for const_cast explanation.
+    auto* consensus_req = const_cast<ConsensusRequestPB*>(&req->consensus_request(i));
+    auto* consensus_resp = resp->add_consensus_response();
+    TabletServerErrorPB::Code error_code = TabletServerErrorPB::WRONG_SERVER_UUID;
+    Status s;
+    if (PREDICT_FALSE(consensus_req->dest_uuid() != local_uuid)) {
+      s = STATUS_FORMAT(InvalidArgument,
+                        "MultiRaftUpdateConsensus: Wrong destination UUID requested. "
+                        "Local UUID: $0. Requested UUID: $1",
+                        local_uuid, consensus_req->dest_uuid());
+    } else {
+      s = DoUpdateConsensus(consensus_req, consensus_resp, deadline, &error_code);
+    }
+    if (PREDICT_FALSE(!s.ok())) {
+      StatusToPB(s, consensus_resp->mutable_error()->mutable_status());
+      consensus_resp->mutable_error()->set_code(error_code);
+    }
+  }
   context.RespondSuccess();
 }
 
@@ -2328,6 +2575,42 @@ void ConsensusServiceImpl::GetLastOpId(const consensus::GetLastOpIdRequestPB *re
   context.RespondSuccess();
 }
 
+void ConsensusServiceImpl::GetReadIndex(const consensus::GetReadIndexRequestPB* req,
+                                        consensus::GetReadIndexResponsePB* resp,
+                                        rpc::RpcContext context) {
+  DVLOG(3) << "Received GetReadIndex RPC: " << req->DebugString();
+  if (!CheckUuidMatchOrRespond(tablet_manager_, "GetReadIndex", req, resp, &context)) {
+    return;
+  }
+  auto tablet_peer = VERIFY_RESULT_OR_RETURN(LookupTabletPeerOrRespond(
+      tablet_manager_, req->tablet_id(), resp, &context));
+
+  // Leader with a majority replicated lease is required, otherwise a newer leader could already
+  // commit operations that are not reflected in our safe time.
+  auto leader_term = LeaderTerm(*tablet_peer);
+  if (!leader_term.ok()) {
+    SetupErrorAndRespond(resp->mutable_error(), leader_term.status(), &context);
+    return;
+  }
+  auto tablet = tablet_peer->shared_tablet();
+  if (!tablet) {
+    SetupErrorAndRespond(resp->mutable_error(),
+                         STATUS(ServiceUnavailable, "Tablet is not running"),
+                         TabletServerErrorPB::TABLET_NOT_RUNNING, &context);
+    return;
+  }
+  auto safe_time = tablet->SafeTime(
+      tablet::RequireLease::kTrue, HybridTime::kMin, context.GetClientDeadline());
+  if (!safe_time.is_valid()) {
+    SetupErrorAndRespond(resp->mutable_error(),
+                         STATUS(TimedOut, "Timed out waiting for safe time"),
+                         TabletServerErrorPB::UNKNOWN_ERROR, &context);
+    return;
+  }
+  resp->set_read_ht(safe_time.ToUint64());
+  context.RespondSuccess();
+}
+
 void ConsensusServiceImpl::GetConsensusState(const consensus::GetConsensusStateRequestPB *req,
                                              consensus::GetConsensusStateResponsePB *resp,
                                              rpc::RpcContext context) {
@@ -59,6 +59,7 @@ class TabletPeerLookupIf;
 class TabletServer;
 
 struct ReadContext;
+struct ReadIndexCall;
 
 YB_STRONGLY_TYPED_BOOL(AllowSplitTablet);
 
@@ -173,6 +174,14 @@ class TabletServiceImpl : public TabletServerServiceIf {
   template <class Req, class Resp, class F>
   void PerformAtLeader(const Req& req, Resp* resp, rpc::RpcContext* context, const F& f);
 
+  // Asynchronously asks the leader of the tablet for its read index, i.e. the hybrid time up to
+  // which this follower should wait for safe time before serving a strongly consistent read.
+  // The read is completed by ReadAtLeaderReadIndex, unless an error is returned.
+  CHECKED_STATUS RequestLeaderReadIndex(
+      const tablet::TabletPeer& tablet_peer, const std::shared_ptr<ReadIndexCall>& call);
+
+  void ReadAtLeaderReadIndex(ReadIndexCall* call);
+
   // Read implementation. If restart is required returns restart time, in case of success
   // returns invalid ReadHybridTime. Otherwise returns error status.
   Result<ReadHybridTime> DoRead(ReadContext* read_context);
@@ -264,6 +273,10 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
                                consensus::ConsensusResponsePB *resp,
                                rpc::RpcContext context) override;
 
+  void MultiRaftUpdateConsensus(const consensus::MultiRaftConsensusRequestPB* req,
+                                consensus::MultiRaftConsensusResponsePB* resp,
+                                rpc::RpcContext context) override;
+
   virtual void RequestConsensusVote(const consensus::VoteRequestPB* req,
                                     consensus::VoteResponsePB* resp,
                                     rpc::RpcContext context) override;
@@ -292,6 +305,10 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
                            consensus::GetLastOpIdResponsePB *resp,
                            rpc::RpcContext context) override;
 
+  virtual void GetReadIndex(const consensus::GetReadIndexRequestPB* req,
+                            consensus::GetReadIndexResponsePB* resp,
+                            rpc::RpcContext context) override;
+
   virtual void GetConsensusState(const consensus::GetConsensusStateRequestPB *req,
                                  consensus::GetConsensusStateResponsePB *resp,
                                  rpc::RpcContext context) override;
@@ -301,6 +318,13 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
                                     rpc::RpcContext context) override;
 
  private:
+  // Applies consensus update to the tablet, shared by UpdateConsensus and
+  // MultiRaftUpdateConsensus. On failure fills error_code for the response.
+  CHECKED_STATUS DoUpdateConsensus(consensus::ConsensusRequestPB* req,
+                                   consensus::ConsensusResponsePB* resp,
+                                   CoarseTimePoint deadline,
+                                   TabletServerErrorPB::Code* error_code);
+
   TabletPeerLookupIf* tablet_manager_;
 };
 
@@ -15,16 +15,25 @@
 
 #include "yb/master/master.pb.h"
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tserver/service_util.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
+#include "yb/util/threadpool.h"
 
 DEFINE_int32(tablet_split_monitor_heartbeat_interval_ms, 5000,
              "Interval (in milliseconds) at which tserver check tablets and sends a list of "
              "tablets to split in a heartbeat to master.");
 
+DEFINE_double(tablet_split_ops_rate_smoothing_factor, 0.3,
+              "Weight of the last interval in the exponentially smoothed tablet operation rate "
+              "used to detect hot tablets. 1 means that only the last interval is used.");
+TAG_FLAG(tablet_split_ops_rate_smoothing_factor, advanced);
+TAG_FLAG(tablet_split_ops_rate_smoothing_factor, runtime);
+
 using namespace std::literals;
 
 namespace yb {
@@ -36,45 +45,100 @@ TabletSplitHeartbeatDataProvider::TabletSplitHeartbeatDataProvider(TabletServer*
 
 void TabletSplitHeartbeatDataProvider::DoAddData(
     const master::TSHeartbeatResponsePB& last_resp, master::TSHeartbeatRequestPB* req) {
-  if (!last_resp.has_tablet_split_size_threshold_bytes()) {
-    return;
-  }
   const auto split_size_threshold = last_resp.tablet_split_size_threshold_bytes();
-  VLOG_WITH_FUNC(2) << "split_size_threshold: " << split_size_threshold;
-  if (split_size_threshold <= 0) {
+  const auto split_ops_threshold = last_resp.tablet_split_ops_per_sec_threshold();
+  VLOG_WITH_FUNC(2) << "split_size_threshold: " << split_size_threshold
+                    << ", split_ops_threshold: " << split_ops_threshold;
+  if (split_size_threshold <= 0 && split_ops_threshold <= 0) {
+    prev_tablet_ops_.clear();
     return;
   }
 
+  const auto now = CoarseMonoClock::Now();
+  const double elapsed_sec = prev_run_time() == CoarseTimePoint()
+      ? 0 : MonoDelta(now - prev_run_time()).ToSeconds();
+  std::unordered_map<TabletId, TabletOps> tablet_ops;
+  int32_t num_post_split_compactions = 0;
+  const double smoothing_factor =
+      std::min(std::max(FLAGS_tablet_split_ops_rate_smoothing_factor, 0.0), 1.0);
+
   const auto tablet_peers = server().tablet_manager()->GetTabletPeers();
 
   for (const auto& tablet_peer : tablet_peers) {
-    if (!tablet_peer->CheckRunning().ok() || !LeaderTerm(*tablet_peer).ok()) {
+    if (!tablet_peer->CheckRunning().ok()) {
+      continue;
+    }
+    const auto& tablet = tablet_peer->shared_tablet();
+    if (!tablet || !tablet->metadata()) {
+      continue;
+    }
+    const bool compacting_after_split = tablet->doc_db().key_bounds->IsInitialized() &&
+                                        !tablet->metadata()->has_been_fully_compacted();
+    if (compacting_after_split) {
+      // Master does not schedule new splits involving this tserver while it still compacts the
+      // results of previous splits.
+      ++num_post_split_compactions;
+      if (tablet->MarkPostSplitCompactionTriggered()) {
+        auto status = server().tablet_manager()->post_split_compaction_pool()->SubmitFunc(
+            [tablet] {
+          WARN_NOT_OK(tablet->ForceFullRocksDBCompact(),
+                      Format("T $0: Post split compaction failed", tablet->tablet_id()));
+        });
+        WARN_NOT_OK(status, "Failed to submit post split compaction");
+      }
+    }
+    if (!LeaderTerm(*tablet_peer).ok()) {
       // Only check tablets for which current tserver is leader.
       VLOG_WITH_FUNC(3) << Format("Skipping tablet: $0 (non leader)", tablet_peer->tablet_id());
       continue;
     }
-    const auto& tablet = tablet_peer->shared_tablet();
-    if (!tablet || !tablet->metadata() ||
-        tablet->table_type() == TableType::TRANSACTION_STATUS_TABLE_TYPE ||
+
+    const auto& tablet_id = tablet->tablet_id();
+    auto* metrics = tablet->metrics();
+    auto& ops = tablet_ops[tablet_id];
+    if (metrics) {
+      ops.reads = metrics->ql_read_latency->TotalCount() +
+                  metrics->redis_read_latency->TotalCount();
+      ops.writes = metrics->write_lock_latency->TotalCount();
+    }
+    auto prev_it = prev_tablet_ops_.find(tablet_id);
+    if (prev_it != prev_tablet_ops_.end()) {
+      ops.read_ops_per_sec = prev_it->second.read_ops_per_sec;
+      ops.write_ops_per_sec = prev_it->second.write_ops_per_sec;
+      if (elapsed_sec > 0) {
+        // Exponential smoothing, so a single burst does not make a tablet look hot.
+        const double reads = (ops.reads - std::min(ops.reads, prev_it->second.reads)) / elapsed_sec;
+        const double writes =
+            (ops.writes - std::min(ops.writes, prev_it->second.writes)) / elapsed_sec;
+        ops.read_ops_per_sec += smoothing_factor * (reads - ops.read_ops_per_sec);
+        ops.write_ops_per_sec += smoothing_factor * (writes - ops.write_ops_per_sec);
+      }
+    }
+    const double read_ops_per_sec = ops.read_ops_per_sec;
+    const double write_ops_per_sec = ops.write_ops_per_sec;
+
+    const auto sst_size = tablet->GetCurrentVersionSstFilesSize();
+    const bool too_big = split_size_threshold > 0 && sst_size >= split_size_threshold;
+    const bool too_hot = split_ops_threshold > 0 &&
+                         read_ops_per_sec + write_ops_per_sec >= split_ops_threshold;
+    if (tablet->table_type() == TableType::TRANSACTION_STATUS_TABLE_TYPE ||
         // TODO(tsplit): Tablet splitting for colocated tables is not supported.
         tablet->metadata()->colocated() ||
         tablet->metadata()->tablet_data_state() != tablet::TabletDataState::TABLET_DATA_READY ||
-        tablet->GetCurrentVersionSstFilesSize() < split_size_threshold ||
+        (!too_big && !too_hot) ||
         // TODO(tsplit): We don't split not yet fully compacted post-split tablets for now, since
         // detecting effective middle key and tablet size for such tablets is not yet implemented.
-        (tablet->doc_db().key_bounds->IsInitialized() &&
-         !tablet->metadata()->has_been_fully_compacted())) {
+        compacting_after_split) {
       VLOG_WITH_FUNC(3) << Format(
-          "Skipping tablet: $0, data state: $1, SST files size: $2, has key bounds: $3, has been "
-          "fully compacted: $4",
-          tablet->tablet_id(),
-          tablet->metadata() ? AsString(tablet->metadata()->tablet_data_state()) : "NONE",
-          tablet->GetCurrentVersionSstFilesSize(), tablet->doc_db().key_bounds->IsInitialized(),
+          "Skipping tablet: $0, data state: $1, SST files size: $2, ops per sec: $3, "
+          "has key bounds: $4, has been fully compacted: $5",
+          tablet_id, AsString(tablet->metadata()->tablet_data_state()), sst_size,
+          read_ops_per_sec + write_ops_per_sec, tablet->doc_db().key_bounds->IsInitialized(),
           tablet->metadata()->has_been_fully_compacted());
       continue;
     }
 
-    const auto& tablet_id = tablet->tablet_id();
+    // Middle key of the largest SST file, so the split follows the actual key distribution.
     const auto split_encoded_key = tablet->GetEncodedMiddleSplitKey();
     if (!split_encoded_key.ok()) {
       LOG(WARNING) << Format(
@@ -100,13 +164,17 @@ void TabletSplitHeartbeatDataProvider::DoAddData(
     } else {
       tablet_for_split->set_split_partition_key(*split_encoded_key);
     }
+    tablet_for_split->set_sst_size_bytes(sst_size);
+    tablet_for_split->set_read_ops_per_sec(read_ops_per_sec);
+    tablet_for_split->set_write_ops_per_sec(write_ops_per_sec);
     VLOG_WITH_FUNC(1) << Format(
-        "Found tablet to split: $0, size: $1", tablet->tablet_id(),
-        tablet->GetCurrentVersionSstFilesSize());
-    // TODO(tsplit): remove this return after issue with splitting more than one tablet "at once"
-    // is fixed.
-    return;
+        "Found tablet to split: $0, size: $1, read ops per sec: $2, write ops per sec: $3",
+        tablet_id, sst_size, read_ops_per_sec, write_ops_per_sec);
   }
+
+  // Master limits the number of concurrent splits, so all candidates are reported.
+  req->set_num_post_split_compactions(num_post_split_compactions);
+  prev_tablet_ops_ = std::move(tablet_ops);
 }
 
 } // namespace tserver
@@ -15,6 +15,9 @@
 #define YB_TSERVER_TABLET_SPLIT_HEARTBEAT_DATA_PROVIDER_H
 
 #include <memory>
+#include <unordered_map>
+
+#include "yb/common/entity_ids.h"
 
 #include "yb/tserver/heartbeater.h"
 
@@ -28,6 +31,18 @@ class TabletSplitHeartbeatDataProvider : public PeriodicalHeartbeatDataProvider
  private:
   void DoAddData(
       const master::TSHeartbeatResponsePB& last_resp, master::TSHeartbeatRequestPB* req) override;
+
+  struct TabletOps {
+    uint64_t reads = 0;
+    uint64_t writes = 0;
+    // Exponentially smoothed operation rates.
+    double read_ops_per_sec = 0;
+    double write_ops_per_sec = 0;
+  };
+
+  // Operation counters and rates of leader tablets at the previous run, used to calculate
+  // operation rates.
+  std::unordered_map<TabletId, TabletOps> prev_tablet_ops_;
 };
 
 } // namespace tserver
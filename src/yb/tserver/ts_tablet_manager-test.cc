@@ -32,6 +32,7 @@
 
 #include "yb/tserver/ts_tablet_manager.h"
 
+#include <set>
 #include <string>
 
 #include <gtest/gtest.h>
@@ -46,10 +47,14 @@
 #include "yb/master/master.pb.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tablet/tablet-test-util.h"
+#include "yb/tserver/memstore_arbiter.h"
 #include "yb/tserver/mini_tablet_server.h"
+#include "yb/tserver/tablet_location_changes.h"
+#include "yb/tserver/tablet_open_scheduler.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/util/test_util.h"
 #include "yb/util/format.h"
+#include "yb/util/size_literals.h"
 
 #define ASSERT_REPORT_HAS_UPDATED_TABLET(report, tablet_id) \
   ASSERT_NO_FATALS(AssertReportHasUpdatedTablet(report, tablet_id))
@@ -58,6 +63,15 @@
   ASSERT_NO_FATALS(AssertMonotonicReportSeqno(report_seqno, tablet_report))
 
 DECLARE_bool(TEST_pretend_memory_exceeded_enforce_flush);
+DECLARE_int32(rocksdb_level0_file_num_compaction_trigger);
+DECLARE_int32(global_memstore_flush_max_age_sec);
+DECLARE_int64(global_memstore_flush_max_pinned_wal_mb);
+DECLARE_int32(tablet_location_changes_max_per_response);
+DECLARE_int32(tablet_location_changes_max_size);
+DECLARE_int32(tablet_report_limit);
+
+using namespace std::literals;
+using namespace yb::size_literals;
 
 namespace yb {
 namespace tserver {
@@ -416,5 +430,226 @@ TEST_F(TsTabletManagerTest, TestTabletReports) {
   ASSERT_MONOTONIC_REPORT_SEQNO(&seqno, report);
 }
 
+TEST_F(TsTabletManagerTest, TestTabletReportLimit) {
+  constexpr int kNumTablets = 5;
+  constexpr int kReportLimit = 2;
+
+  for (int i = 0; i != kNumTablets; ++i) {
+    ASSERT_OK(CreateNewTablet(Format("tablet-$0", i), schema_, nullptr));
+  }
+  FLAGS_tablet_report_limit = kReportLimit;
+
+  TabletReportPB report;
+  int64_t seqno = -1;
+  tablet_manager_->GenerateFullTabletReport(&report);
+  ASSERT_FALSE(report.is_incremental());
+  ASSERT_EQ(kReportLimit, report.updated_tablets().size());
+  ASSERT_EQ(kNumTablets - kReportLimit, report.remaining_tablet_count());
+  ASSERT_MONOTONIC_REPORT_SEQNO(&seqno, report);
+
+  std::set<TabletId> reported;
+  for (const auto& reported_tablet : report.updated_tablets()) {
+    reported.insert(reported_tablet.tablet_id());
+  }
+  tablet_manager_->MarkTabletReportAcknowledged(report);
+
+  // The rest of tablets are reported by incremental reports, that also respect the limit.
+  while (report.remaining_tablet_count() > 0) {
+    tablet_manager_->GenerateIncrementalTabletReport(&report);
+    ASSERT_TRUE(report.is_incremental());
+    ASSERT_LE(report.updated_tablets().size(), kReportLimit);
+    ASSERT_MONOTONIC_REPORT_SEQNO(&seqno, report);
+    for (const auto& reported_tablet : report.updated_tablets()) {
+      reported.insert(reported_tablet.tablet_id());
+    }
+    tablet_manager_->MarkTabletReportAcknowledged(report);
+  }
+  ASSERT_EQ(kNumTablets, reported.size());
+}
+
+TEST(TabletOpenSchedulerTest, PriorityAndDirLimits) {
+  constexpr int kNumDirs = 3;
+  constexpr int kTabletsPerDir = 20;
+  constexpr size_t kMaxPerDir = 2;
+
+  std::unique_ptr<ThreadPool> pool;
+  ASSERT_OK(ThreadPoolBuilder("test-open").set_max_threads(8).Build(&pool));
+  TabletOpenScheduler scheduler(pool.get(), 8, kMaxPerDir);
+
+  std::mutex mutex;
+  std::map<std::string, size_t> dir_in_progress;
+  size_t max_dir_in_progress = 0;
+  std::map<std::string, std::vector<TabletOpenPriority>> open_order;
+
+  for (int dir = 0; dir != kNumDirs; ++dir) {
+    for (int i = 0; i != kTabletsPerDir; ++i) {
+      auto dir_name = Format("/data$0", dir);
+      auto priority = i % 5 == 0 ? TabletOpenPriority::kSystem
+                    : i % 5 == 1 ? TabletOpenPriority::kRecentLeader
+                    : TabletOpenPriority::kRegular;
+      scheduler.Add(TabletOpenScheduler::Task {
+        .tablet_id = Format("tablet-$0-$1", dir, i),
+        .data_root_dir = dir_name,
+        .wal_root_dir = dir_name,
+        .priority = priority,
+        .open = [&, dir_name, priority] {
+          {
+            std::lock_guard<std::mutex> lock(mutex);
+            open_order[dir_name].push_back(priority);
+            max_dir_in_progress = std::max(max_dir_in_progress, ++dir_in_progress[dir_name]);
+          }
+          SleepFor(MonoDelta::FromMilliseconds(5));
+          std::lock_guard<std::mutex> lock(mutex);
+          --dir_in_progress[dir_name];
+        },
+      });
+    }
+  }
+
+  ASSERT_OK(scheduler.Start());
+  ASSERT_OK(WaitFor([&scheduler] {
+    return scheduler.GetProgress().opened == kNumDirs * kTabletsPerDir;
+  }, 30s, "All tablets opened"));
+  pool->Wait();
+
+  auto progress = scheduler.GetProgress();
+  ASSERT_EQ(progress.total, kNumDirs * kTabletsPerDir);
+  ASSERT_EQ(progress.pending, 0);
+  ASSERT_TRUE(progress.in_progress.empty());
+  ASSERT_LE(max_dir_in_progress, kMaxPerDir);
+
+  // Each directory opens its tablets in priority order.
+  ASSERT_EQ(open_order.size(), kNumDirs);
+  for (const auto& p : open_order) {
+    ASSERT_EQ(p.second.size(), kTabletsPerDir);
+    ASSERT_TRUE(std::is_sorted(p.second.begin(), p.second.end())) << p.first;
+  }
+}
+
+TEST(MemstoreArbiterTest, PickFlushCandidate) {
+  FlagSaver flag_saver;
+  FLAGS_rocksdb_level0_file_num_compaction_trigger = 5;
+
+  auto make_candidate = [](const TabletId& tablet_id, size_t memtable_mb, int age_secs,
+                           uint64_t wal_mb, uint64_t num_sst_files) {
+    MemstoreFlushCandidate candidate;
+    candidate.tablet_id = tablet_id;
+    candidate.memtable_bytes = memtable_mb * 1_MB;
+    candidate.memtable_age = MonoDelta::FromSeconds(age_secs);
+    candidate.wal_bytes = wal_mb * 1_MB;
+    candidate.num_sst_files = num_sst_files;
+    return candidate;
+  };
+
+  ASSERT_EQ(MemstoreArbiter::PickFlushCandidate({}), nullptr);
+
+  // Big memtable of a hot tablet is preferred to the tiny oldest memtable of a cold tablet.
+  std::vector<MemstoreFlushCandidate> candidates = {
+    make_candidate("cold", 1, 600, 10, 1),
+    make_candidate("hot", 100, 60, 100, 1),
+    make_candidate("warm", 10, 300, 20, 1),
+  };
+  ASSERT_EQ(MemstoreArbiter::PickFlushCandidate(candidates)->tablet_id, "hot");
+
+  // Cold tablet retaining a lot of WAL is flushed, even if its memtable is smaller.
+  candidates[0].memtable_bytes = 20_MB;
+  candidates[0].wal_bytes = 1000_MB;
+  ASSERT_EQ(MemstoreArbiter::PickFlushCandidate(candidates)->tablet_id, "cold");
+
+  // Tablet with compaction debt loses to a tablet with similar memtable.
+  candidates = {
+    make_candidate("debt", 100, 60, 100, 10),
+    make_candidate("no-debt", 95, 60, 95, 1),
+  };
+  ASSERT_EQ(MemstoreArbiter::PickFlushCandidate(candidates)->tablet_id, "no-debt");
+
+  // Tablets exceeding absolute limits are flushed first, regardless of the score.
+  candidates = {
+    make_candidate("hot", 100, 60, 10, 1),
+    make_candidate("old", 1, 600, 1, 1),
+    make_candidate("pinning", 1, 60, 60, 1),
+  };
+  ASSERT_EQ(MemstoreArbiter::PickFlushCandidate(candidates)->tablet_id, "hot");
+  FLAGS_global_memstore_flush_max_age_sec = 300;
+  ASSERT_EQ(MemstoreArbiter::PickFlushCandidate(candidates)->tablet_id, "old");
+  FLAGS_global_memstore_flush_max_age_sec = 0;
+  FLAGS_global_memstore_flush_max_pinned_wal_mb = 50;
+  ASSERT_EQ(MemstoreArbiter::PickFlushCandidate(candidates)->tablet_id, "pinning");
+
+  // Score orders tablets exceeding limits.
+  FLAGS_global_memstore_flush_max_pinned_wal_mb = 5;
+  ASSERT_EQ(MemstoreArbiter::PickFlushCandidate(candidates)->tablet_id, "hot");
+}
+
+TEST(TabletLocationChangesTest, Fill) {
+  google::FlagSaver flag_saver;
+  FLAGS_tablet_location_changes_max_per_response = 3;
+  TabletLocationChanges changes;
+  TabletLocationChangesRequestPB req;
+  TabletLocationChangesPB resp;
+
+  // The first request only gets the current sequence number.
+  changes.LeaderChanged("tablet-0", "ts-0");
+  changes.Fill(req, &resp);
+  ASSERT_EQ(1, resp.last_sequence_number());
+  ASSERT_EQ(0, resp.changes_size());
+  ASSERT_FALSE(resp.overflow());
+
+  req.set_instance_id(resp.instance_id());
+  req.set_last_sequence_number(resp.last_sequence_number());
+  changes.LeaderChanged("tablet-1", "ts-1");
+  changes.TabletSplit("tablet-2");
+  resp.Clear();
+  changes.Fill(req, &resp);
+  ASSERT_EQ(3, resp.last_sequence_number());
+  ASSERT_EQ(2, resp.changes_size());
+  ASSERT_EQ("tablet-1", resp.changes(0).tablet_id());
+  ASSERT_EQ("ts-1", resp.changes(0).leader_uuid());
+  ASSERT_EQ("tablet-2", resp.changes(1).tablet_id());
+  ASSERT_TRUE(resp.changes(1).split());
+  ASSERT_FALSE(resp.overflow());
+
+  // Up to date client gets no changes.
+  req.set_last_sequence_number(resp.last_sequence_number());
+  resp.Clear();
+  changes.Fill(req, &resp);
+  ASSERT_EQ(3, resp.last_sequence_number());
+  ASSERT_EQ(0, resp.changes_size());
+  ASSERT_FALSE(resp.overflow());
+
+  // Only the latest changes are sent to a client that is far behind.
+  for (int i = 0; i != 10; ++i) {
+    changes.LeaderChanged(Format("tablet-$0", i), "ts-2");
+  }
+  resp.Clear();
+  changes.Fill(req, &resp);
+  ASSERT_EQ(13, resp.last_sequence_number());
+  ASSERT_EQ(FLAGS_tablet_location_changes_max_per_response, resp.changes_size());
+  ASSERT_EQ(11, resp.changes(0).sequence_number());
+  ASSERT_EQ("tablet-9", resp.changes(2).tablet_id());
+  ASSERT_TRUE(resp.overflow());
+
+  // Changes evicted from the log are reported as overflow.
+  FLAGS_tablet_location_changes_max_size = 5;
+  FLAGS_tablet_location_changes_max_per_response = 100;
+  req.set_last_sequence_number(13);
+  for (int i = 0; i != 10; ++i) {
+    changes.LeaderChanged(Format("tablet-$0", i), "ts-3");
+  }
+  resp.Clear();
+  changes.Fill(req, &resp);
+  ASSERT_EQ(23, resp.last_sequence_number());
+  ASSERT_EQ(5, resp.changes_size());
+  ASSERT_EQ(19, resp.changes(0).sequence_number());
+  ASSERT_TRUE(resp.overflow());
+
+  // Client of another instance only gets the current sequence number and overflow.
+  req.set_instance_id(req.instance_id() + 1);
+  resp.Clear();
+  changes.Fill(req, &resp);
+  ASSERT_EQ(0, resp.changes_size());
+  ASSERT_TRUE(resp.overflow());
+}
+
 } // namespace tserver
 } // namespace yb
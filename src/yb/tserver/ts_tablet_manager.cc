@@ -33,6 +33,7 @@
 #include "yb/tserver/ts_tablet_manager.h"
 
 #include <algorithm>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -50,6 +51,7 @@
 #include "yb/consensus/log.h"
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/metadata.pb.h"
+#include "yb/consensus/multi_raft_batcher.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/consensus/quorum_util.h"
 #include "yb/consensus/retryable_requests.h"
@@ -68,9 +70,12 @@
 #include "yb/master/sys_catalog.h"
 
 #include "yb/rocksdb/memory_monitor.h"
+#include "yb/rocksdb/rate_limiter.h"
 
 #include "yb/rpc/messenger.h"
 
+#include "yb/server/clock.h"
+
 #include "yb/tablet/metadata.pb.h"
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet.pb.h"
@@ -82,6 +87,7 @@
 #include "yb/tablet/operations/split_operation.h"
 
 #include "yb/tserver/heartbeater.h"
+#include "yb/tserver/memstore_arbiter.h"
 #include "yb/tserver/remote_bootstrap_client.h"
 #include "yb/tserver/remote_bootstrap_session.h"
 #include "yb/tserver/remote_bootstrap_snapshots.h"
@@ -115,6 +121,18 @@ DEFINE_int32(num_tablets_to_open_simultaneously, 0,
              "may make sense to manually tune this.");
 TAG_FLAG(num_tablets_to_open_simultaneously, advanced);
 
+DEFINE_int32(num_tablets_to_open_simultaneously_per_dir, 0,
+             "Maximum number of tablets opened at the same time during startup that use the same "
+             "data or WAL directory. If this is set to 0 (the default), the threads available to "
+             "open tablets are divided evenly between the directories.");
+TAG_FLAG(num_tablets_to_open_simultaneously_per_dir, advanced);
+
+DEFINE_bool(prioritize_recent_leaders_on_startup, true,
+            "Whether tablets that were led by this tablet server before restart are opened before "
+            "other tablets during startup. Requires reading consensus metadata of all tablets "
+            "before opening them.");
+TAG_FLAG(prioritize_recent_leaders_on_startup, advanced);
+
 DEFINE_int32(tablet_start_warn_threshold_ms, 500,
              "If a tablet takes more than this number of millis to start, issue "
              "a warning with a trace.");
@@ -189,6 +207,12 @@ DEFINE_int64(global_memstore_size_mb_max, 2048,
              "Global memstore size is determined as a percentage of the available "
              "memory. However, this flag limits it in absolute size. Value of 0 "
              "means no limit on the value obtained by the percentage. Default is 2048.");
+DEFINE_bool(global_memstore_cost_based_flush, false,
+            "When the global memstore limit is reached, pick the tablet to flush by its memtable "
+            "size, memtable age, retained WAL size and compaction debt. Otherwise the tablet "
+            "with the oldest memtable write is flushed.");
+TAG_FLAG(global_memstore_cost_based_flush, advanced);
+TAG_FLAG(global_memstore_cost_based_flush, runtime);
 
 DEFINE_int64(db_block_cache_size_bytes, kDbCacheSizeUsePercentage,
              "Size of cross-tablet shared RocksDB block cache (in bytes). "
@@ -200,6 +224,19 @@ DEFINE_int32(db_block_cache_size_percentage, 50,
              "Default percentage of total available memory to use as block cache size, if not "
              "asking for a raw number, through FLAGS_db_block_cache_size_bytes.");
 
+DEFINE_int64(tablet_server_io_rate_limit_bytes_per_sec, 0,
+             "Limit on the disk write rate of the tablet server, shared by flushes and compactions "
+             "of all tablets and by files downloaded during remote bootstrap. Overrides "
+             "rocksdb_compact_flush_rate_limit_bytes_per_sec when set. 0 means no limit.");
+TAG_FLAG(tablet_server_io_rate_limit_bytes_per_sec, advanced);
+
+DEFINE_int32(tablet_report_limit, 1000,
+             "Max number of tablets reported to the master in a single heartbeat. Remaining "
+             "tablets are reported in the following heartbeats, sent without waiting for the "
+             "heartbeat interval. 0 means no limit.");
+TAG_FLAG(tablet_report_limit, advanced);
+TAG_FLAG(tablet_report_limit, runtime);
+
 DEFINE_int32(read_pool_max_threads, 128,
              "The maximum number of threads allowed for read_pool_. This pool is used "
              "to run multiple read operations, that are part of the same tablet rpc, "
@@ -209,6 +246,11 @@ DEFINE_int32(read_pool_max_queue_size, 128,
              "is used to run multiple read operations, that are part of the same tablet rpc, "
              "in parallel.");
 
+DEFINE_int32(post_split_compaction_pool_max_threads, 1,
+             "The maximum number of threads used to run full compactions of tablets created by "
+             "split, that remove data of the parent tablet outside of their key bounds.");
+TAG_FLAG(post_split_compaction_pool_max_threads, advanced);
+
 DEFINE_test_flag(int32, sleep_after_tombstoning_tablet_secs, 0,
                  "Whether we sleep in LogAndTombstone after calling DeleteTabletData.");
 
@@ -218,6 +260,8 @@ DEFINE_int32(tserver_yb_client_default_timeout_ms, kTServerYbClientDefaultTimeou
              "Default timeout for the YBClient embedded into the tablet server that is used "
              "for distributed transactions.");
 
+DECLARE_int32(heartbeat_interval_ms);
+
 namespace yb {
 namespace tserver {
 
@@ -314,7 +358,9 @@ void TSTabletManager::MaybeFlushTablet() {
     if (tablet_to_flush) {
       LOG(INFO)
           << TabletLogPrefix(tablet_to_flush->tablet_id())
-          << "Flushing tablet with oldest memstore write at "
+          << "Flushing tablet with memstore size "
+          << tablet_to_flush->tablet()->MutableMemtableSize()
+          << " and oldest memstore write at "
           << tablet_to_flush->tablet()->OldestMutableMemtableWriteHybridTime();
       WARN_NOT_OK(
           tablet_to_flush->tablet()->Flush(
@@ -327,9 +373,14 @@ void TSTabletManager::MaybeFlushTablet() {
   }
 }
 
-// Return the tablet with the oldest write in memstore, or nullptr if all tablet memstores are
-// empty or about to flush.
+// Return the tablet whose flush is picked by the memstore arbiter, or the tablet with the oldest
+// write in memstore when cost based flush is disabled. Returns nullptr if all tablet memstores
+// are empty or about to flush.
 TabletPeerPtr TSTabletManager::TabletToFlush() {
+  if (GetAtomicFlag(&FLAGS_global_memstore_cost_based_flush)) {
+    return TabletToFlushByCost();
+  }
+
   SharedLock<RWMutex> lock(mutex_); // For using the tablet map
   HybridTime oldest_write_in_memstores = HybridTime::kMax;
   TabletPeerPtr tablet_to_flush;
@@ -354,6 +405,85 @@ TabletPeerPtr TSTabletManager::TabletToFlush() {
 
 namespace {
 
+// Returns size of WAL segments that could be garbage collected only after mutable memtables of
+// the tablet are flushed.
+Result<uint64_t> MemstorePinnedWalBytes(const tablet::Tablet& tablet, log::Log* log) {
+  auto flushed_op_ids = VERIFY_RESULT(tablet.MaxPersistentOpId());
+  auto flushed_index = flushed_op_ids.regular.index;
+  if (flushed_op_ids.intents.valid()) {
+    flushed_index = std::min(flushed_index, flushed_op_ids.intents.index);
+  }
+  int64_t gcable_bytes = 0;
+  RETURN_NOT_OK(log->GetGCableDataSize(std::max<int64_t>(flushed_index + 1, 0), &gcable_bytes));
+  int64_t gcable_bytes_after_flush = 0;
+  RETURN_NOT_OK(log->GetGCableDataSize(
+      log->GetLatestEntryOpId().index + 1, &gcable_bytes_after_flush));
+  return std::max<int64_t>(gcable_bytes_after_flush - gcable_bytes, 0);
+}
+
+} // namespace
+
+TabletPeerPtr TSTabletManager::TabletToFlushByCost() {
+  const auto now = server_->clock()->Now();
+  std::vector<MemstoreFlushCandidate> candidates;
+  std::unordered_map<TabletId, TabletPeerPtr> peers;
+  {
+    SharedLock<RWMutex> lock(mutex_); // For using the tablet map
+    for (const TabletMap::value_type& entry : tablet_map_) {
+      const auto tablet = entry.second->shared_tablet();
+      if (!tablet) {
+        continue;
+      }
+      const auto ht = tablet->OldestMutableMemtableWriteHybridTime();
+      if (!ht.ok()) {
+        YB_LOG_EVERY_N_SECS(WARNING, 5) << Format(
+            "Failed to get oldest mutable memtable write ht for tablet $0: $1",
+            tablet->tablet_id(), ht.status());
+        continue;
+      }
+      if (*ht == HybridTime::kMax) {
+        // Memtable is empty.
+        continue;
+      }
+      const auto memtable_size = tablet->MutableMemtableSize();
+      if (!memtable_size.ok()) {
+        continue;
+      }
+
+      MemstoreFlushCandidate candidate;
+      candidate.tablet_id = entry.first;
+      candidate.memtable_bytes = *memtable_size;
+      if (now > *ht) {
+        candidate.memtable_age = MonoDelta::FromMicroseconds(
+            now.GetPhysicalValueMicros() - ht->GetPhysicalValueMicros());
+      }
+      if (entry.second->log_available()) {
+        auto wal_bytes = MemstorePinnedWalBytes(*tablet, entry.second->log());
+        if (wal_bytes.ok()) {
+          candidate.wal_bytes = *wal_bytes;
+        } else {
+          YB_LOG_EVERY_N_SECS(WARNING, 5) << Format(
+              "Failed to get WAL size pinned by memtables of tablet $0: $1",
+              tablet->tablet_id(), wal_bytes.status());
+        }
+      }
+      candidate.num_sst_files = tablet->GetCurrentVersionNumSSTFiles();
+      candidates.push_back(std::move(candidate));
+      peers.emplace(entry.first, entry.second);
+    }
+  }
+
+  const auto* candidate = MemstoreArbiter::PickFlushCandidate(candidates);
+  if (!candidate) {
+    return nullptr;
+  }
+  VLOG_WITH_PREFIX(1) << "Picked tablet to flush: " << candidate->ToString()
+                      << " among " << candidates.size() << " candidates";
+  return peers[candidate->tablet_id];
+}
+
+namespace {
+
 class LRUCacheGC : public GarbageCollector {
  public:
   explicit LRUCacheGC(std::shared_ptr<rocksdb::Cache> cache) : cache_(std::move(cache)) {}
@@ -436,6 +566,9 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
                .set_max_queue_size(FLAGS_read_pool_max_queue_size)
                .set_metrics(std::move(read_metrics))
                .Build(&read_pool_));
+  CHECK_OK(ThreadPoolBuilder("post-split-compaction")
+               .set_max_threads(std::max(FLAGS_post_split_compaction_pool_max_threads, 1))
+               .Build(&post_split_compaction_pool_));
 
   int64_t block_cache_size_bytes = FLAGS_db_block_cache_size_bytes;
   int64_t total_ram_avail = MemTracker::GetRootTracker()->limit();
@@ -493,6 +626,11 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
         std::function<void()>([this](){
                                 YB_WARN_NOT_OK(background_task_->Wake(), "Wakeup error"); }));
   }
+
+  if (FLAGS_tablet_server_io_rate_limit_bytes_per_sec > 0) {
+    tablet_options_.rate_limiter.reset(
+        rocksdb::NewGenericRateLimiter(FLAGS_tablet_server_io_rate_limit_bytes_per_sec));
+  }
 }
 
 TSTabletManager::~TSTabletManager() {
@@ -501,6 +639,9 @@ TSTabletManager::~TSTabletManager() {
 Status TSTabletManager::Init() {
   CHECK_EQ(state(), MANAGER_INITIALIZING);
 
+  multi_raft_manager_ = std::make_unique<consensus::MultiRaftManager>(
+      server_->messenger(), &server_->proxy_cache());
+
   async_client_init_.emplace(
       "tserver_client", 0 /* num_reactors */,
       FLAGS_tserver_yb_client_default_timeout_ms / 1000, server_->permanent_uuid(),
@@ -540,6 +681,10 @@ Status TSTabletManager::Init() {
                 .set_max_threads(max_bootstrap_threads)
                 .set_metrics(std::move(metrics))
                 .Build(&open_tablet_pool_));
+  // Each bootstrapping tablet reads at most one log segment ahead.
+  RETURN_NOT_OK(ThreadPoolBuilder("log-read-ahead")
+                .set_max_threads(max_bootstrap_threads)
+                .Build(&log_read_ahead_pool_));
 
   CleanupCheckpoints();
 
@@ -550,6 +695,7 @@ Status TSTabletManager::Init() {
   InitLocalRaftPeerPB();
 
   vector<RaftGroupMetadataPtr> metas;
+  std::unordered_set<std::string> dirs;
 
   // First, load all of the tablet metadata. We do this before we start
   // submitting the actual OpenTablet() tasks so that we don't have to compete
@@ -566,22 +712,37 @@ Status TSTabletManager::Init() {
     RegisterDataAndWalDir(
         fs_manager_, meta->table_id(), meta->raft_group_id(), meta->data_root_dir(),
         meta->wal_root_dir());
+    dirs.insert(meta->data_root_dir());
+    dirs.insert(meta->wal_root_dir());
     metas.push_back(meta);
   }
   MonoDelta elapsed = MonoTime::Now().GetDeltaSince(start);
   LOG(INFO) << "Loaded metadata for " << tablet_ids.size() << " tablet in "
             << elapsed.ToMilliseconds() << " ms";
 
-  // Now submit the "Open" task for each.
+  int max_per_dir = FLAGS_num_tablets_to_open_simultaneously_per_dir;
+  if (max_per_dir <= 0) {
+    max_per_dir = (max_bootstrap_threads + dirs.size() - 1) / std::max<size_t>(dirs.size(), 1);
+  }
+  open_tablet_scheduler_ = std::make_unique<TabletOpenScheduler>(
+      open_tablet_pool_.get(), max_bootstrap_threads, max_per_dir);
+
+  // Now schedule the "Open" task for each.
   for (const RaftGroupMetadataPtr& meta : metas) {
     scoped_refptr<TransitionInProgressDeleter> deleter;
     RETURN_NOT_OK(StartTabletStateTransition(
         meta->raft_group_id(), "opening tablet", &deleter));
 
     TabletPeerPtr tablet_peer = VERIFY_RESULT(CreateAndRegisterTabletPeer(meta, NEW_PEER));
-    RETURN_NOT_OK(open_tablet_pool_->SubmitFunc(
-        std::bind(&TSTabletManager::OpenTablet, this, meta, deleter)));
+    open_tablet_scheduler_->Add(TabletOpenScheduler::Task {
+      .tablet_id = meta->raft_group_id(),
+      .data_root_dir = meta->data_root_dir(),
+      .wal_root_dir = meta->wal_root_dir(),
+      .priority = GetOpenPriority(*meta),
+      .open = std::bind(&TSTabletManager::OpenTablet, this, meta, deleter),
+    });
   }
+  RETURN_NOT_OK(open_tablet_scheduler_->Start());
 
   {
     std::lock_guard<RWMutex> lock(mutex_);
@@ -595,6 +756,36 @@ Status TSTabletManager::Init() {
   return Status::OK();
 }
 
+TabletOpenPriority TSTabletManager::GetOpenPriority(const RaftGroupMetadata& meta) {
+  if (meta.table_type() == TableType::TRANSACTION_STATUS_TABLE_TYPE) {
+    return TabletOpenPriority::kSystem;
+  }
+  if (!FLAGS_prioritize_recent_leaders_on_startup) {
+    return TabletOpenPriority::kRegular;
+  }
+  // Consensus metadata does not store the leader, but a leader always votes for itself in its
+  // term, so the vote of the last known term is a good approximation.
+  std::unique_ptr<ConsensusMetadata> cmeta;
+  auto status = ConsensusMetadata::Load(
+      fs_manager_, meta.raft_group_id(), fs_manager_->uuid(), &cmeta);
+  if (!status.ok()) {
+    VLOG_WITH_PREFIX(1) << "Failed to load consensus metadata of " << meta.raft_group_id()
+                        << ": " << status;
+    return TabletOpenPriority::kRegular;
+  }
+  if (cmeta->has_voted_for() && cmeta->voted_for() == fs_manager_->uuid()) {
+    return TabletOpenPriority::kRecentLeader;
+  }
+  return TabletOpenPriority::kRegular;
+}
+
+TabletOpenScheduler::Progress TSTabletManager::GetStartupProgress() const {
+  if (!open_tablet_scheduler_) {
+    return TabletOpenScheduler::Progress();
+  }
+  return open_tablet_scheduler_->GetProgress();
+}
+
 void TSTabletManager::CleanupCheckpoints() {
   for (const auto& data_root : fs_manager_->GetDataRootDirs()) {
     auto tables_dir = JoinPathSegments(data_root, FsManager::kRocksDBDirName);
@@ -927,6 +1118,7 @@ Status TSTabletManager::ApplyTabletSplit(tablet::SplitOperationState* op_state)
 
   meta.set_tablet_data_state(tablet::TABLET_DATA_SPLIT_COMPLETED);
   RETURN_NOT_OK(meta.Flush());
+  location_changes_.TabletSplit(tablet_id);
 
   for (auto& tcmeta : tcmetas) {
     // Call CreatePeerAndOpenTablet asynchronously to avoid write-locking TSTabletManager::mutex_
@@ -1376,6 +1568,7 @@ void TSTabletManager::OpenTablet(const RaftGroupMetadataPtr& meta,
       .listener = tablet_peer->status_listener(),
       .append_pool = append_pool(),
       .retryable_requests = &retryable_requests,
+      .log_read_ahead_pool = log_read_ahead_pool_.get(),
     };
     s = BootstrapTablet(data, &tablet, &log, &bootstrap_info);
     if (!s.ok()) {
@@ -1399,7 +1592,8 @@ void TSTabletManager::OpenTablet(const RaftGroupMetadataPtr& meta,
         raft_pool(),
         tablet_prepare_pool(),
         &retryable_requests,
-        yb::OpId::FromPB(bootstrap_info.split_op_id));
+        yb::OpId::FromPB(bootstrap_info.split_op_id),
+        multi_raft_manager_.get());
 
     if (!s.ok()) {
       LOG(ERROR) << kLogPrefix << "Tablet failed to init: "
@@ -1485,6 +1679,10 @@ void TSTabletManager::StartShutdown() {
 
   // Shut down the bootstrap pool, so new tablets are registered after this point.
   open_tablet_pool_->Shutdown();
+  // Bootstraps waiting for segments read ahead have completed at this point, so no read is lost.
+  if (log_read_ahead_pool_) {
+    log_read_ahead_pool_->Shutdown();
+  }
 
   // Take a snapshot of the peers list -- that way we don't have to hold
   // on to the lock while shutting them down, which might cause a lock
@@ -1513,6 +1711,9 @@ void TSTabletManager::CompleteShutdown() {
   if (append_pool_) {
     append_pool_->Shutdown();
   }
+  if (post_split_compaction_pool_) {
+    post_split_compaction_pool_->Shutdown();
+  }
 
   {
     std::lock_guard<RWMutex> l(mutex_);
@@ -1652,6 +1853,9 @@ void TSTabletManager::ApplyChange(const string& tablet_id,
 
 void TSTabletManager::MarkTabletDirty(const TabletId& tablet_id,
                                       std::shared_ptr<consensus::StateChangeContext> context) {
+  if (context->reason == consensus::StateChangeReason::NEW_LEADER_ELECTED) {
+    location_changes_.LeaderChanged(tablet_id, context->new_leader_uuid);
+  }
   std::lock_guard<RWMutex> lock(mutex_);
   MarkDirtyUnlocked(tablet_id, context);
 }
@@ -1773,6 +1977,27 @@ int TSTabletManager::GetLeaderCount() const {
   return count;
 }
 
+void TSTabletManager::WakeQuiescentTablets() {
+  // Leaders of quiescent groups hosted by this server could learn about the change only at their
+  // next heartbeat to the master, so give them time to resume heartbeats before followers start
+  // an election.
+  const auto follower_fd_delay = FLAGS_heartbeat_interval_ms * 2ms;
+  int num_woken = 0;
+  for (const auto& peer : GetTabletPeers()) {
+    auto consensus = peer->shared_raft_consensus();
+    if (!consensus) {
+      continue;
+    }
+    if (consensus->quiescent()) {
+      ++num_woken;
+    }
+    consensus->WakeFromQuiescence(follower_fd_delay);
+  }
+  if (num_woken) {
+    LOG_WITH_PREFIX(INFO) << "Woke up " << num_woken << " quiescent followers";
+  }
+}
+
 void TSTabletManager::MarkDirtyUnlocked(const TabletId& tablet_id,
                                         std::shared_ptr<consensus::StateChangeContext> context) {
   TabletReportState* state = FindOrNull(dirty_tablets_, tablet_id);
@@ -1829,7 +2054,9 @@ void TSTabletManager::GenerateIncrementalTabletReport(TabletReportPB* report) {
   vector<std::shared_ptr<TabletPeer>> to_report;
   vector<TabletId> tablet_ids;
   {
-    SharedLock<RWMutex> shared_lock(mutex_);
+    // Exclusive lock, since change sequence of the tablets that do not fit into this report is
+    // updated.
+    std::lock_guard<RWMutex> lock(mutex_);
     tablet_ids.reserve(dirty_tablets_.size() + tablets_being_remote_bootstrapped_.size());
     to_report.reserve(dirty_tablets_.size() + tablets_being_remote_bootstrapped_.size());
     report->set_sequence_number(next_report_seq_++);
@@ -1842,6 +2069,19 @@ void TSTabletManager::GenerateIncrementalTabletReport(TabletReportPB* report) {
       tablet_ids.push_back(tablet_id);
     }
 
+    const size_t limit = TabletReportLimit();
+    if (tablet_ids.size() > limit) {
+      // Tablets that do not fit into this report stay dirty after it is acknowledged.
+      for (auto it = tablet_ids.begin() + limit; it != tablet_ids.end(); ++it) {
+        TabletReportState* state = FindOrNull(dirty_tablets_, *it);
+        if (state != nullptr) {
+          state->change_seq = next_report_seq_;
+        }
+      }
+      report->set_remaining_tablet_count(tablet_ids.size() - limit);
+      tablet_ids.resize(limit);
+    }
+
     for (auto const& tablet_id : tablet_ids) {
       TabletPeerPtr* tablet_peer = FindOrNull(tablet_map_, tablet_id);
       if (tablet_peer) {
@@ -1872,12 +2112,31 @@ void TSTabletManager::GenerateFullTabletReport(TabletReportPB* report) {
     report->set_sequence_number(next_report_seq_++);
     GetTabletPeersUnlocked(&to_report);
   }
+
+  // A full report is split into chunks of limited size, the first chunk is sent as the full
+  // report and the rest of tablets are sent as incremental reports.
+  vector<std::shared_ptr<TabletPeer>> remaining;
+  const size_t limit = TabletReportLimit();
+  if (to_report.size() > limit) {
+    remaining.assign(to_report.begin() + limit, to_report.end());
+    to_report.resize(limit);
+    report->set_remaining_tablet_count(remaining.size());
+  }
+
   for (const auto& replica : to_report) {
     CreateReportedTabletPB(replica, report->add_updated_tablets());
   }
 
   std::lock_guard<RWMutex> l(mutex_);
   dirty_tablets_.clear();
+  for (const auto& replica : remaining) {
+    dirty_tablets_[replica->tablet_id()].change_seq = next_report_seq_;
+  }
+}
+
+size_t TSTabletManager::TabletReportLimit() const {
+  const auto limit = FLAGS_tablet_report_limit;
+  return limit > 0 ? limit : std::numeric_limits<size_t>::max();
 }
 
 void TSTabletManager::MarkTabletReportAcknowledged(const TabletReportPB& report) {
@@ -2230,6 +2489,10 @@ Status DeleteTabletData(const RaftGroupMetadataPtr& meta,
       meta->fs_manager()->uuid()));
   MAYBE_FAULT(FLAGS_TEST_fault_crash_after_wal_deleted);
 
+  // Retryable requests snapshot refers to the deleted WAL.
+  RETURN_NOT_OK(ConsensusMetadata::DeleteRetryableRequests(
+      meta->fs_manager(), meta->raft_group_id()));
+
   // We do not delete the superblock or the consensus metadata when tombstoning
   // a tablet.
   if (data_state == TABLET_DATA_TOMBSTONED) {
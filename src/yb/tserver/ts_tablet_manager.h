@@ -56,6 +56,8 @@
 #include "yb/tablet/tablet_fwd.h"
 #include "yb/tablet/tablet_options.h"
 #include "yb/tablet/tablet_splitter.h"
+#include "yb/tserver/tablet_location_changes.h"
+#include "yb/tserver/tablet_open_scheduler.h"
 #include "yb/tserver/tablet_peer_lookup.h"
 #include "yb/tserver/tserver.pb.h"
 #include "yb/tserver/tserver_admin.pb.h"
@@ -145,6 +147,9 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
   // the first tablet whose bootstrap failed.
   CHECKED_STATUS WaitForAllBootstrapsToFinish();
 
+  // Progress of opening tablets found on disk during startup.
+  TabletOpenScheduler::Progress GetStartupProgress() const;
+
   // Starts shutdown process.
   void StartShutdown();
   // Completes shutdown process and waits for it's completeness.
@@ -153,6 +158,7 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
   ThreadPool* tablet_prepare_pool() const { return tablet_prepare_pool_.get(); }
   ThreadPool* raft_pool() const { return raft_pool_.get(); }
   ThreadPool* read_pool() const { return read_pool_.get(); }
+  ThreadPool* post_split_compaction_pool() const { return post_split_compaction_pool_.get(); }
   ThreadPool* append_pool() const { return append_pool_.get(); }
 
   // Create a new tablet and register it with the tablet manager. The new tablet
@@ -231,6 +237,8 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
   void GenerateIncrementalTabletReport(master::TabletReportPB* report);
 
   // Generate a full tablet report and reset any incremental state tracking.
+  // When there are more tablets than fit into a single report, the full report contains only
+  // some of them, the rest are marked dirty and reported by the following incremental reports.
   void GenerateFullTabletReport(master::TabletReportPB* report);
 
   // Mark that the master successfully received and processed the given
@@ -268,6 +276,10 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
   // Return the number of tablets for which this ts is a leader.
   int GetLeaderCount() const;
 
+  // Wakes up all quiescent Raft groups hosted by this tablet server. Called when the set of live
+  // tablet servers known to the master changes.
+  void WakeQuiescentTablets();
+
   // Set the number of tablets which are waiting to be bootstrapped and can go to RUNNING
   // state in the response proto. Also set the total number of runnable tablets on this tserver.
   // If the tablet manager itself is not initialized, then INT_MAX is set for both.
@@ -302,6 +314,15 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
 
   MemoryMonitor* memory_monitor() { return tablet_options_.memory_monitor.get(); }
 
+  // Rate limiter shared by flushes, compactions and remote bootstrap downloads, null if the
+  // tablet server does not limit disk writes.
+  const std::shared_ptr<rocksdb::RateLimiter>& io_rate_limiter() const {
+    return tablet_options_.rate_limiter;
+  }
+
+  // Recent leader changes and splits of tablets hosted by this tablet server, sent to clients.
+  const TabletLocationChanges& location_changes() const { return location_changes_; }
+
   // Flush some tablet if the memstore memory limit is exceeded
   void MaybeFlushTablet();
 
@@ -339,6 +360,9 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
   };
   typedef std::unordered_map<std::string, TabletReportState> DirtyMap;
 
+  // Max number of tablets in a single tablet report.
+  size_t TabletReportLimit() const;
+
   // Returns Status::OK() iff state_ == MANAGER_RUNNING.
   CHECKED_STATUS CheckRunningUnlocked(boost::optional<TabletServerErrorPB::Code>* error_code) const;
 
@@ -434,9 +458,12 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
       const tablet::RaftGroupMetadataPtr& meta,
       const scoped_refptr<TransitionInProgressDeleter>& deleter);
 
-  // Return the tablet with oldest write still in its memstore
+  // Return the tablet to flush when the global memstore limit is exceeded.
   std::shared_ptr<tablet::TabletPeer> TabletToFlush();
 
+  // Returns the tablet picked by MemstoreArbiter among tablets with non empty memtables.
+  std::shared_ptr<tablet::TabletPeer> TabletToFlushByCost();
+
   TSTabletManagerStatePB state() const {
     SharedLock<RWMutex> lock(mutex_);
     return state_;
@@ -456,6 +483,9 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
 
   void CleanupCheckpoints();
 
+  // Priority of opening the tablet during startup.
+  TabletOpenPriority GetOpenPriority(const tablet::RaftGroupMetadata& meta);
+
   void LogCacheGC(MemTracker* log_cache_mem_tracker, size_t required);
 
   const CoarseTimePoint start_time_;
@@ -504,9 +534,18 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
 
   TSTabletManagerStatePB state_;
 
+  TabletLocationChanges location_changes_;
+
+  // Orders tablets opened during startup. Declared before open_tablet_pool_, so the pool is shut
+  // down before the scheduler is destroyed.
+  std::unique_ptr<TabletOpenScheduler> open_tablet_scheduler_;
+
   // Thread pool used to open the tablets async, whether bootstrap is required or not.
   std::unique_ptr<ThreadPool> open_tablet_pool_;
 
+  // Thread pool used by bootstrapping tablets to read log segments ahead of replay.
+  std::unique_ptr<ThreadPool> log_read_ahead_pool_;
+
   // Thread pool for preparing transactions, shared between all tablets.
   std::unique_ptr<ThreadPool> tablet_prepare_pool_;
 
@@ -519,9 +558,15 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
   // Thread pool for appender threads, shared between all tablets.
   std::unique_ptr<ThreadPool> append_pool_;
 
+  // Combines Raft heartbeats of tablets hosted by this server.
+  std::unique_ptr<consensus::MultiRaftManager> multi_raft_manager_;
+
   // Thread pool for read ops, that are run in parallel, shared between all tablets.
   std::unique_ptr<ThreadPool> read_pool_;
 
+  // Thread pool for full compactions of tablets created by split, shared between all tablets.
+  std::unique_ptr<ThreadPool> post_split_compaction_pool_;
+
   // Used for scheduling flushes
   std::unique_ptr<BackgroundTask> background_task_;
 
@@ -366,6 +366,10 @@ Status TabletServerPathHandlers::Register(Webserver* server) {
       "/api/v1/health-check", "TServer Health Check",
       std::bind(&TabletServerPathHandlers::HandleHealthCheck, this, _1, _2),
       false /* styled */, false /* is_on_nav_bar */);
+  server->RegisterPathHandler(
+      "/api/v1/startup-progress", "TServer Startup Progress",
+      std::bind(&TabletServerPathHandlers::HandleStartupProgress, this, _1, _2),
+      false /* styled */, false /* is_on_nav_bar */);
 
   return Status::OK();
 }
@@ -756,5 +760,47 @@ void TabletServerPathHandlers::HandleHealthCheck(const Webserver::WebRequest& re
   jw.EndObject();
 }
 
+void TabletServerPathHandlers::HandleStartupProgress(const Webserver::WebRequest& req,
+                                                     Webserver::WebResponse* resp) {
+  std::stringstream *output = &resp->output;
+  JsonWriter jw(output, JsonWriter::COMPACT);
+  auto progress = tserver_->tablet_manager()->GetStartupProgress();
+
+  jw.StartObject();
+  jw.String("total_tablets");
+  jw.Uint64(progress.total);
+  jw.String("opened_tablets");
+  jw.Uint64(progress.opened);
+  jw.String("pending_tablets");
+  jw.Uint64(progress.pending);
+  jw.String("elapsed_ms");
+  jw.Int64(progress.elapsed.Initialized() ? progress.elapsed.ToMilliseconds() : 0);
+  jw.String("opening_tablets");
+  jw.StartArray();
+  for (const auto& tablet : progress.in_progress) {
+    jw.StartObject();
+    jw.String("tablet_id");
+    jw.String(tablet.first);
+    jw.String("elapsed_ms");
+    jw.Int64(tablet.second.ToMilliseconds());
+    jw.EndObject();
+  }
+  jw.EndArray();
+  jw.String("dirs");
+  jw.StartArray();
+  for (const auto& dir : progress.dirs) {
+    jw.StartObject();
+    jw.String("path");
+    jw.String(dir.first);
+    jw.String("opening_tablets");
+    jw.Uint64(dir.second.in_progress);
+    jw.String("pending_tablets");
+    jw.Uint64(dir.second.pending);
+    jw.EndObject();
+  }
+  jw.EndArray();
+  jw.EndObject();
+}
+
 }  // namespace tserver
 }  // namespace yb
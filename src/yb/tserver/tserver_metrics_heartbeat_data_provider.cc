@@ -15,7 +15,9 @@
 
 #include "yb/master/master.pb.h"
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_peer.h"
+#include "yb/tserver/service_util.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
 #include "yb/util/logging.h"
@@ -87,12 +89,64 @@ void TServerMetricsHeartbeatDataProvider::DoAddData(
 
   metrics->set_uptime_seconds(uptime_seconds);
 
+  if (last_resp.report_tablet_loads()) {
+    AddTabletLoads(div, metrics);
+  } else {
+    prev_tablet_counters_.clear();
+  }
+
   VLOG_WITH_PREFIX(4) << "Read Ops per second: " << rops_per_sec;
   VLOG_WITH_PREFIX(4) << "Write Ops per second: " << wops_per_sec;
   VLOG_WITH_PREFIX(4) << "Total SST File Sizes: "<< total_file_sizes;
   VLOG_WITH_PREFIX(4) << "Uptime seconds: "<< uptime_seconds;
 }
 
+void TServerMetricsHeartbeatDataProvider::AddTabletLoads(
+    double elapsed_sec, master::TServerMetricsPB* metrics) {
+  auto rate = [elapsed_sec](uint64_t value, uint64_t prev_value) {
+    return elapsed_sec > 0 && value > prev_value ? (value - prev_value) / elapsed_sec : 0.0;
+  };
+
+  std::unordered_map<TabletId, TabletCounters> tablet_counters;
+  for (const auto& tablet_peer : server().tablet_manager()->GetTabletPeers()) {
+    auto tablet = tablet_peer ? tablet_peer->shared_tablet() : nullptr;
+    if (!tablet || !tablet->metrics()) {
+      continue;
+    }
+    const auto* tablet_metrics = tablet->metrics();
+    auto& counters = tablet_counters[tablet->tablet_id()];
+    counters.reads = tablet_metrics->ql_read_latency->TotalCount() +
+                     tablet_metrics->redis_read_latency->TotalCount();
+    counters.writes = tablet_metrics->write_lock_latency->TotalCount();
+    counters.handler_usec = tablet_metrics->ql_read_latency->histogram()->TotalSum() +
+                            tablet_metrics->redis_read_latency->histogram()->TotalSum() +
+                            tablet_metrics->write_lock_latency->histogram()->TotalSum();
+    const auto& statistics = tablet->rocksdb_statistics();
+    if (statistics) {
+      counters.read_bytes = statistics->getTickerCount(rocksdb::BYTES_READ) +
+                            statistics->getTickerCount(rocksdb::ITER_BYTES_READ);
+      counters.write_bytes = statistics->getTickerCount(rocksdb::BYTES_WRITTEN);
+    }
+
+    auto it = prev_tablet_counters_.find(tablet->tablet_id());
+    if (it == prev_tablet_counters_.end()) {
+      // Rates are not known until the next run.
+      continue;
+    }
+    const auto& prev = it->second;
+    auto* load = metrics->add_tablet_loads();
+    load->set_tablet_id(tablet->tablet_id());
+    load->set_is_leader(LeaderTerm(*tablet_peer).ok());
+    load->set_read_ops_per_sec(rate(counters.reads, prev.reads));
+    load->set_write_ops_per_sec(rate(counters.writes, prev.writes));
+    load->set_read_bytes_per_sec(rate(counters.read_bytes, prev.read_bytes));
+    load->set_write_bytes_per_sec(rate(counters.write_bytes, prev.write_bytes));
+    load->set_handler_usec_per_sec(rate(counters.handler_usec, prev.handler_usec));
+  }
+  prev_tablet_counters_ = std::move(tablet_counters);
+  VLOG_WITH_PREFIX(4) << "Reported load of " << metrics->tablet_loads_size() << " tablets";
+}
+
 uint64_t TServerMetricsHeartbeatDataProvider::CalculateUptime() {
   MonoDelta delta = MonoTime::Now().GetDeltaSince(start_time_);
   uint64_t uptime_seconds = static_cast<uint64_t>(delta.ToSeconds());
@@ -15,7 +15,9 @@
 #define YB_TSERVER_TSERVER_METRICS_HEARTBEAT_DATA_PROVIDER_H
 
 #include <memory>
+#include <unordered_map>
 
+#include "yb/common/entity_ids.h"
 #include "yb/tserver/heartbeater.h"
 
 namespace yb {
@@ -31,11 +33,25 @@ class TServerMetricsHeartbeatDataProvider : public PeriodicalHeartbeatDataProvid
 
   uint64_t CalculateUptime();
 
+  // Adds load of each tablet replica since the previous run to metrics.
+  void AddTabletLoads(double elapsed_sec, master::TServerMetricsPB* metrics);
+
   MonoTime start_time_;
 
   // Stores the total read and writes ops for computing iops.
   uint64_t prev_reads_ = 0;
   uint64_t prev_writes_ = 0;
+
+  struct TabletCounters {
+    uint64_t reads = 0;
+    uint64_t writes = 0;
+    uint64_t read_bytes = 0;
+    uint64_t write_bytes = 0;
+    uint64_t handler_usec = 0;
+  };
+
+  // Counters of each tablet at the previous run, used to calculate per tablet load.
+  std::unordered_map<TabletId, TabletCounters> prev_tablet_counters_;
 };
 
 } // namespace tserver
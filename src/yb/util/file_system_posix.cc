@@ -28,10 +28,15 @@
 #include <sys/syscall.h>
 #endif // __linux__
 
+#include <algorithm>
+
+#include <glog/logging.h>
+
 #include "yb/util/coding.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/errno.h"
 #include "yb/util/malloc.h"
+#include "yb/util/scope_exit.h"
 #include "yb/util/thread_restrictions.h"
 
 DECLARE_bool(suicide_on_eio);
@@ -265,4 +270,117 @@ Status PosixRandomAccessFile::InvalidateCache(size_t offset, size_t length) {
 #endif
 }
 
+Status PosixMmapRandomAccessFile::Open(const std::string& fname, size_t readahead_bytes,
+                                       std::unique_ptr<RandomAccessFile>* result) {
+  TRACE_EVENT1("io", "PosixMmapRandomAccessFile::Open", "path", fname);
+  ThreadRestrictions::AssertIOAllowed();
+  int fd;
+  do {
+    fd = open(fname.c_str(), O_RDONLY);
+  } while (fd < 0 && errno == EINTR);
+  if (fd < 0) {
+    return STATUS_IO_ERROR(fname, errno);
+  }
+  // The mapping stays valid after the descriptor is closed.
+  auto se = ScopeExit([fd] { close(fd); });
+
+  struct stat st;
+  if (fstat(fd, &st) == -1) {
+    return STATUS_IO_ERROR(fname, errno);
+  }
+  if (st.st_size == 0) {
+    return STATUS_FORMAT(InvalidArgument, "Cannot map empty file $0", fname);
+  }
+  void* base = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  if (base == MAP_FAILED) {
+    return STATUS_IO_ERROR(fname, errno);
+  }
+  result->reset(new PosixMmapRandomAccessFile(
+      fname, static_cast<uint8_t*>(base), st.st_size, st.st_ino, readahead_bytes));
+  return Status::OK();
+}
+
+PosixMmapRandomAccessFile::PosixMmapRandomAccessFile(
+    const std::string& fname, uint8_t* base, size_t length, uint64_t inode,
+    size_t readahead_bytes)
+    : filename_(fname), base_(base), length_(length), inode_(inode),
+      readahead_bytes_(readahead_bytes) {
+}
+
+PosixMmapRandomAccessFile::~PosixMmapRandomAccessFile() {
+  if (munmap(base_, length_) != 0) {
+    LOG(WARNING) << "Failed to unmap " << filename_ << ": " << ErrnoToString(errno);
+  }
+}
+
+Status PosixMmapRandomAccessFile::Read(uint64_t offset, size_t n, Slice* result,
+                                       uint8_t* scratch) const {
+  if (offset > length_) {
+    *result = Slice();
+    return STATUS_IO_ERROR(filename_, EINVAL);
+  }
+  n = std::min<uint64_t>(n, length_ - offset);
+  *result = Slice(base_ + offset, n);
+
+  // Sequential readers (follower catch-up, CDC) touch the mapping in order, so keep a window of
+  // pages ahead of them in flight instead of faulting each page in on access.
+  if (readahead_bytes_ != 0) {
+    size_t end = offset + n;
+    size_t readahead_end = readahead_end_.load(std::memory_order_acquire);
+    if (end + readahead_bytes_ / 2 > readahead_end && readahead_end < length_) {
+      size_t start = std::max(end, readahead_end);
+      size_t new_end = std::min(end + readahead_bytes_, length_);
+      if (readahead_end_.compare_exchange_strong(readahead_end, new_end)) {
+        Advise(start, new_end - start, MADV_WILLNEED);
+      }
+    }
+  }
+  return Status::OK();
+}
+
+void PosixMmapRandomAccessFile::Advise(size_t offset, size_t length, int advice) const {
+  static const size_t kPageSize = sysconf(_SC_PAGESIZE);
+  size_t aligned_offset = offset / kPageSize * kPageSize;
+  if (madvise(base_ + aligned_offset, length + offset - aligned_offset, advice) != 0) {
+    VLOG(1) << "madvise failed for " << filename_ << ": " << ErrnoToString(errno);
+  }
+}
+
+size_t PosixMmapRandomAccessFile::memory_footprint() const {
+  return malloc_usable_size(this) + filename_.capacity();
+}
+
+void PosixMmapRandomAccessFile::Hint(AccessPattern pattern) {
+  switch (pattern) {
+    case NORMAL:
+      Advise(0, length_, MADV_NORMAL);
+      break;
+    case RANDOM:
+      Advise(0, length_, MADV_RANDOM);
+      break;
+    case SEQUENTIAL:
+      Advise(0, length_, MADV_SEQUENTIAL);
+      break;
+    case WILLNEED:
+      Advise(0, length_, MADV_WILLNEED);
+      break;
+    case DONTNEED:
+      Advise(0, length_, MADV_DONTNEED);
+      break;
+    default:
+      assert(false);
+      break;
+  }
+}
+
+Status PosixMmapRandomAccessFile::InvalidateCache(size_t offset, size_t length) {
+  if (length == 0) {
+    length = offset < length_ ? length_ - offset : 0;
+  }
+  if (offset < length_ && length != 0) {
+    Advise(offset, std::min(length, length_ - offset), MADV_DONTNEED);
+  }
+  return Status::OK();
+}
+
 } // namespace yb
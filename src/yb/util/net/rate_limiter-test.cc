@@ -78,6 +78,22 @@ TEST(RateLimiter, TestUpdateDataSize) {
   ASSERT_LE(diff, max_allowed_rate_diff);
 }
 
+TEST(RateLimiter, TestUpdateDataSizeWithoutSleep) {
+  RateLimiter rate_limiter([]() { return kRate; });
+  rate_limiter.Init();
+  auto start = MonoTime::Now();
+  auto first_sleep_time = rate_limiter.UpdateDataSize(kRate);
+  // The second transmission should wait for the first one to finish sleeping.
+  auto second_sleep_time = rate_limiter.UpdateDataSize(kRate);
+  auto elapsed = MonoTime::Now().GetDeltaSince(start);
+  ASSERT_LE(elapsed.ToMilliseconds(), 100);
+  ASSERT_LE(GetDifference(first_sleep_time.ToMilliseconds(), MonoTime::kMillisecondsPerSecond),
+            100);
+  ASSERT_LE(GetDifference(second_sleep_time.ToMilliseconds(),
+                          2 * MonoTime::kMillisecondsPerSecond),
+            100);
+}
+
 TEST(RateLimiter, TestSendRequest) {
   MonoDelta local_sleep_time(3s);
   RateLimiter rate_limiter([]() { return kRate; });
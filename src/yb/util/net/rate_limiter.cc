@@ -58,39 +58,55 @@ uint64_t RateLimiter::GetRate() {
 }
 
 void RateLimiter::UpdateDataSizeAndMaybeSleep(uint64_t data_size) {
+  auto sleep_time = UpdateDataSize(data_size);
+  if (sleep_time > MonoDelta::kZero) {
+    SleepFor(sleep_time);
+  }
+}
+
+MonoDelta RateLimiter::UpdateDataSize(uint64_t data_size) {
   auto now = MonoTime::Now();
-  auto elapsed = now.GetDeltaSince(end_time_);
-  end_time_ = now;
+  // end_time_ could be in the future if another caller did not finish its sleep yet.
+  auto elapsed = now - end_time_;
+  end_time_ = std::max(now, end_time_);
   total_bytes_ += data_size;
   UpdateRate();
-  UpdateTimeSlotSizeAndMaybeSleep(data_size, elapsed);
+  return UpdateTimeSlotSize(data_size, elapsed);
 }
 
 void RateLimiter::UpdateTimeSlotSizeAndMaybeSleep(uint64_t data_size, MonoDelta elapsed) {
+  auto sleep_time = UpdateTimeSlotSize(data_size, elapsed);
+  if (sleep_time > MonoDelta::kZero) {
+    SleepFor(sleep_time);
+  }
+}
+
+MonoDelta RateLimiter::UpdateTimeSlotSize(uint64_t data_size, MonoDelta elapsed) {
   if (!active()) {
-    return;
+    return MonoDelta::kZero;
   }
 
   // If the rate is greater than target_rate_, sleep until both rates are equal.
-  if (MonoTime::kMillisecondsPerSecond * data_size > target_rate_ * elapsed.ToMilliseconds()) {
-    auto sleep_time =
-        MonoTime::kMillisecondsPerSecond * data_size / target_rate_ - elapsed.ToMilliseconds();
+  const int64_t elapsed_ms = elapsed.ToMilliseconds();
+  const int64_t transmission_ms = MonoTime::kMillisecondsPerSecond * data_size / target_rate_;
+  if (transmission_ms > elapsed_ms) {
+    auto sleep_time = MonoDelta::FromMilliseconds(transmission_ms - elapsed_ms);
     VLOG(1) << " target_rate_=" << target_rate_
-            << " elapsed=" << elapsed.ToMilliseconds()
+            << " elapsed=" << elapsed_ms
             << " received size=" << data_size
-            << " and sleeping for=" << sleep_time;
-    SleepFor(MonoDelta::FromMilliseconds(sleep_time));
+            << " and sleeping for=" << sleep_time.ToMilliseconds();
 #if defined(OS_MACOSX)
-    total_time_slept_ += MonoDelta::FromMilliseconds(sleep_time);
+    total_time_slept_ += sleep_time;
 #endif
-    end_time_ = MonoTime::Now();
+    end_time_ += sleep_time;
     // If we slept for more than 80% of time_slot_ms_, reduce the size of this time slot.
-    if (sleep_time > time_slot_ms_ * 80 / 100) {
+    if (static_cast<uint64_t>(sleep_time.ToMilliseconds()) > time_slot_ms_ * 80 / 100) {
       time_slot_ms_ = std::max(min_time_slot_, time_slot_ms_ / 2);
     }
-  } else {
-    time_slot_ms_ = std::min(max_time_slot_, time_slot_ms_ * 2);
+    return sleep_time;
   }
+  time_slot_ms_ = std::min(max_time_slot_, time_slot_ms_ * 2);
+  return MonoDelta::kZero;
 }
 
 void RateLimiter::UpdateRate() {
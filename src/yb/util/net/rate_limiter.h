@@ -58,6 +58,12 @@ class RateLimiter {
   // than the rate provided by target_rate_updater_.
   void UpdateDataSizeAndMaybeSleep(uint64_t data_size);
 
+  // Same as UpdateDataSizeAndMaybeSleep, but returns the time the caller should sleep instead of
+  // sleeping. Allows a caller that shares this object between threads to sleep without holding
+  // the lock that protects it. Stats are updated as if the caller had already slept, so
+  // concurrent callers get their sleeps queued behind each other.
+  MonoDelta UpdateDataSize(uint64_t data_size);
+
   void Init();
 
   // We can only have an active rate limiter if the user has provided a function to update the rate.
@@ -82,6 +88,7 @@ class RateLimiter {
  private:
   void UpdateRate();
   void UpdateTimeSlotSizeAndMaybeSleep(uint64_t data_size, MonoDelta elapsed);
+  MonoDelta UpdateTimeSlotSize(uint64_t data_size, MonoDelta elapsed);
   uint64_t GetSizeForNextTimeSlot();
 
   bool init_ = false;
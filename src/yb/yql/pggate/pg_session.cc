@@ -275,7 +275,7 @@ Status PgSession::RunHelper::Apply(std::shared_ptr<client::YBPgsqlOp> op,
       RETURN_NOT_OK(pg_session_.FlushBufferedOperationsImpl());
       buffered_keys.insert(RowIdentifier(wop));
     }
-    buffered_ops_.push_back({std::move(op), relation_id});
+    buffered_ops_.push_back({std::move(op), relation_id, pg_session_.statement_serial_no_});
     // Flush buffers in case limit of operations in single RPC exceeded.
     return PREDICT_TRUE(buffered_keys.size() < FLAGS_ysql_session_max_batch_size)
         ? Status::OK()
@@ -760,20 +760,34 @@ void PgSession::InvalidateTableCache(const PgObjectId& table_id) {
 
 void PgSession::StartOperationsBuffering() {
   DCHECK(!buffering_enabled_);
-  DCHECK(buffered_keys_.empty());
+  DCHECK(buffered_ops_.empty());
+  DCHECK(FLAGS_ysql_enable_txn_write_buffering || buffered_txn_ops_.empty());
   buffering_enabled_ = true;
+  ++statement_serial_no_;
 }
 
 Status PgSession::StopOperationsBuffering() {
   DCHECK(buffering_enabled_);
   buffering_enabled_ = false;
+  // Transactional writes don't have to be flushed at the end of the statement, since they are
+  // not visible outside of the transaction before commit. And any read flushes them before being
+  // performed, so the transaction observes its own writes. Their errors are reported by the
+  // statement that flushes them, see BufferedOperationsFlushed.
+  if (FLAGS_ysql_enable_txn_write_buffering && buffered_ops_.empty() &&
+      !pg_txn_manager_->IsDdlMode()) {
+    VLOG_IF(2, !buffered_txn_ops_.empty())
+        << "Keep " << buffered_txn_ops_.size() << " transactional operations buffered";
+    return Status::OK();
+  }
   return FlushBufferedOperationsImpl();
 }
 
 Status PgSession::ResetOperationsBuffering() {
-  SCHECK(buffered_keys_.empty(),
+  const auto num_pending = FLAGS_ysql_enable_txn_write_buffering
+      ? buffered_ops_.size() : buffered_keys_.size();
+  SCHECK(num_pending == 0,
          IllegalState,
-         Format("Pending operations are not expected, $0 found", buffered_keys_.size()));
+         Format("Pending operations are not expected, $0 found", num_pending));
   buffering_enabled_ = false;
   return Status::OK();
 }
@@ -858,6 +872,12 @@ Result<bool> PgSession::IsInitDbDone() {
 }
 
 Status PgSession::FlushBufferedOperationsImpl(const PgsqlOpBuffer& ops, bool transactional) {
+  auto session = VERIFY_RESULT(ApplyBufferedOperations(ops, transactional));
+  return BufferedOperationsFlushed(ops, session, session->FlushFuture().get());
+}
+
+Result<YBSession*> PgSession::ApplyBufferedOperations(
+    const PgsqlOpBuffer& ops, bool transactional) {
   DCHECK(ops.size() > 0 && ops.size() <= FLAGS_ysql_session_max_batch_size);
   auto session = VERIFY_RESULT(GetSession(transactional, false /* read_only_op */));
   if (session != session_.get()) {
@@ -874,15 +894,55 @@ Status PgSession::FlushBufferedOperationsImpl(const PgsqlOpBuffer& ops, bool tra
         << ", initdb mode: " << YBCIsInitDbModeEnvVarSet();
     RETURN_NOT_OK(session->Apply(op));
   }
-  const auto status = session->FlushFuture().get();
-  RETURN_NOT_OK(CombineErrorsToStatus(session->GetPendingErrors(), status));
+  return session;
+}
+
+Status PgSession::BufferedOperationsFlushed(
+    const PgsqlOpBuffer& ops, YBSession* session, const Status& flush_status) {
+  RETURN_NOT_OK(CombineErrorsToStatus(session->GetPendingErrors(), flush_status));
 
   for (const auto& buffered_op : ops) {
-    RETURN_NOT_OK(HandleResponse(*buffered_op.operation, buffered_op.relation_id));
+    auto status = HandleResponse(*buffered_op.operation, buffered_op.relation_id);
+    if (PREDICT_FALSE(!status.ok())) {
+      // Error of a write kept buffered after its statement has ended is reported by a later
+      // statement of the same transaction, so point the user at the statement that caused it.
+      const auto statements_ago = statement_serial_no_ - buffered_op.statement_serial_no;
+      if (statements_ago != 0) {
+        return status.CloneAndAppend(Format(
+            "caused by a buffered write of the statement executed $0 statement(s) earlier in "
+            "this transaction", statements_ago));
+      }
+      return status;
+    }
   }
   return Status::OK();
 }
 
+Status PgSession::CommitTransaction() {
+  if (!FLAGS_ysql_enable_pipelined_commit || buffered_txn_ops_.empty() ||
+      pg_txn_manager_->IsDdlMode()) {
+    RETURN_NOT_OK(FlushBufferedOperationsImpl());
+    return pg_txn_manager_->CommitTransaction();
+  }
+
+  auto ops = std::move(buffered_ops_);
+  auto txn_ops = std::move(buffered_txn_ops_);
+  buffered_keys_.clear();
+  buffered_ops_.clear();
+  buffered_txn_ops_.clear();
+  if (!ops.empty()) {
+    RETURN_NOT_OK(FlushBufferedOperationsImpl(ops, false /* transactional */));
+  }
+
+  // Last batch of transactional writes is not waited before commit, transaction seal record
+  // is replicated in parallel with it.
+  auto session = VERIFY_RESULT(ApplyBufferedOperations(txn_ops, true /* transactional */));
+  auto flush_future = session->FlushFuture();
+  return pg_txn_manager_->CommitTransaction([this, session, &txn_ops, &flush_future] {
+    return BufferedOperationsFlushed(txn_ops, session, flush_future.get());
+  });
+}
+
 Result<uint64_t> PgSession::GetSharedCatalogVersion() {
   if (tserver_shared_object_) {
     return (**tserver_shared_object_).ysql_catalog_version();
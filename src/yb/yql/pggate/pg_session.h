@@ -45,6 +45,9 @@ struct BufferableOperation {
   // Postgres's relation id. Required to resolve constraint name in case
   // operation will fail with PGSQL_STATUS_DUPLICATE_KEY_ERROR.
   PgObjectId relation_id;
+  // Serial number of the statement that buffered the operation. Used to tell the user that
+  // the error was caused by an earlier statement of the transaction.
+  uint64_t statement_serial_no;
 };
 
 typedef std::vector<BufferableOperation> PgsqlOpBuffer;
@@ -188,9 +191,12 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   void StartOperationsBuffering();
   // Flush all pending buffered operation and stop further buffering.
   // Buffering must be in progress.
+  // If ysql_enable_txn_write_buffering is set, then transactional operations are kept in buffer
+  // till commit, next read or batch size limit.
   CHECKED_STATUS StopOperationsBuffering();
   // Stop further buffering. Buffering may be in any state,
-  // but pending buffered operations are not allowed.
+  // but pending buffered operations are not allowed, except transactional operations kept
+  // by StopOperationsBuffering.
   CHECKED_STATUS ResetOperationsBuffering();
 
   // Flush all pending buffered operations. Buffering mode remain unchanged.
@@ -198,6 +204,11 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   // Drop all pending buffered operations. Buffering mode remain unchanged.
   void DropBufferedOperations();
 
+  // Flush all pending buffered operations and commit current transaction.
+  // If ysql_enable_pipelined_commit is set, then buffered transactional writes are flushed in
+  // parallel with replication of the transaction seal record.
+  CHECKED_STATUS CommitTransaction();
+
   // Run (apply + flush) the given operation to read and write database content.
   // Template is used here to handle all kind of derived operations
   // (shared_ptr<YBPgsqlReadOp>, shared_ptr<YBPgsqlWriteOp>)
@@ -313,6 +324,13 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   CHECKED_STATUS FlushBufferedOperationsImpl();
   CHECKED_STATUS FlushBufferedOperationsImpl(const PgsqlOpBuffer& ops, bool transactional);
 
+  // Applies buffered operations to the appropriate session, that should be flushed after it.
+  Result<client::YBSession*> ApplyBufferedOperations(const PgsqlOpBuffer& ops, bool transactional);
+
+  // Handles responses of buffered operations that were flushed with the specified status.
+  CHECKED_STATUS BufferedOperationsFlushed(
+      const PgsqlOpBuffer& ops, client::YBSession* session, const Status& flush_status);
+
   // Helper class to run multiple operations on single session.
   // This class allows to keep implementation of RunAsync template method simple
   // without moving its implementation details into header file.
@@ -373,6 +391,8 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
 
   // Should write operations be buffered?
   bool buffering_enabled_ = false;
+  // Serial number of the last statement that started buffering.
+  uint64_t statement_serial_no_ = 0;
   PgsqlOpBuffer buffered_ops_;
   PgsqlOpBuffer buffered_txn_ops_;
   std::unordered_set<RowIdentifier, boost::hash<RowIdentifier>> buffered_keys_;
@@ -19,6 +19,7 @@
 #include "yb/client/transaction.h"
 
 #include "yb/common/common.pb.h"
+#include "yb/common/transaction_error.h"
 #include "yb/common/transaction_priority.h"
 
 #include "yb/tserver/tserver_shared_mem.h"
@@ -124,6 +125,22 @@ Status PgTxnManager::SetDeferrable(bool deferrable) {
   return Status::OK();
 }
 
+Status PgTxnManager::SetReadOnlyStmt(bool read_only_stmt) {
+  if (!read_only_stmt) {
+    // Nested statements of the read-only statement are checked when they try to write.
+    read_only_stmt_disabled_ = read_only_stmt_disabled_ || !read_only_stmt_;
+    return Status::OK();
+  }
+  // Only serializable transactions require distributed transaction for reads.
+  if (!FLAGS_ysql_enable_read_only_stmt_fast_path || read_only_stmt_disabled_ || txn_ ||
+      ddl_txn_ || read_only_ || isolation_level_ != PgIsolationLevel::SERIALIZABLE) {
+    return Status::OK();
+  }
+  VLOG(2) << "Using read-only statement fast path";
+  read_only_stmt_ = true;
+  return Status::OK();
+}
+
 void PgTxnManager::StartNewSession() {
   session_ = std::make_shared<YBSession>(async_client_init_->client(), clock_);
   session_->SetReadPoint(client::Restart::kFalse);
@@ -139,10 +156,27 @@ Status PgTxnManager::BeginWriteTransactionIfNecessary(bool read_only_op,
   VLOG(2) << "BeginWriteTransactionIfNecessary: txn_in_progress_="
           << txn_in_progress_ << ", txn_=" << txn_.get();
 
+  if (read_only_stmt_ && !read_only_op) {
+    // Statement that was expected to be read-only is going to write. Statements that call volatile
+    // functions are not marked read-only, so this is only a safety net for writes the executor
+    // could not predict. Reads that were already done at the snapshot read point do not provide
+    // serializable guarantees, so the statement has to be restarted in a regular transaction.
+    VLOG(2) << "Write in read-only statement, has reads: " << read_only_stmt_has_reads_;
+    read_only_stmt_ = false;
+    read_only_stmt_disabled_ = true;
+    if (read_only_stmt_has_reads_) {
+      read_only_stmt_restart_required_ = true;
+      return STATUS(TryAgain, "Restart required for write in read-only statement", Slice(),
+                    TransactionError(TransactionErrorCode::kReadRestartRequired));
+    }
+  }
+
   // Using Postgres isolation_level_, read_only_, and deferrable_, determine the internal isolation
-  // level and defer effect.
-  IsolationLevel isolation = (isolation_level_ == PgIsolationLevel::SERIALIZABLE) && !read_only_
-      ? IsolationLevel::SERIALIZABLE_ISOLATION : IsolationLevel::SNAPSHOT_ISOLATION;
+  // level and defer effect. Read-only statements executed outside of an explicit transaction
+  // block use consistent snapshot, that is enough to provide serializable guarantees for them.
+  IsolationLevel isolation =
+      (isolation_level_ == PgIsolationLevel::SERIALIZABLE) && !read_only_ && !read_only_stmt_
+          ? IsolationLevel::SERIALIZABLE_ISOLATION : IsolationLevel::SNAPSHOT_ISOLATION;
   bool defer = read_only_ && deferrable_;
 
   if (txn_) {
@@ -151,6 +185,7 @@ Status PgTxnManager::BeginWriteTransactionIfNecessary(bool read_only_op,
       return STATUS(IllegalState, "Changing txn isolation level in the middle of a transaction");
     }
   } else if (read_only_op && isolation == IsolationLevel::SNAPSHOT_ISOLATION) {
+    read_only_stmt_has_reads_ = read_only_stmt_has_reads_ || read_only_stmt_;
     if (defer) {
       // This call is idempotent, meaning it has no affect after the first call.
       session_->DeferReadPoint();
@@ -198,6 +233,13 @@ Status PgTxnManager::BeginWriteTransactionIfNecessary(bool read_only_op,
 }
 
 Status PgTxnManager::RestartTransaction() {
+  if (read_only_stmt_restart_required_) {
+    // Statement is restarted from scratch, so reads will be performed in a regular transaction.
+    read_only_stmt_restart_required_ = false;
+    read_only_stmt_has_reads_ = false;
+    StartNewSession();
+    return Status::OK();
+  }
   if (!txn_in_progress_ || !txn_) {
     CHECK_NOTNULL(session_);
     if (!session_->IsRestartRequired()) {
@@ -217,19 +259,33 @@ Status PgTxnManager::RestartTransaction() {
   return Status::OK();
 }
 
-Status PgTxnManager::CommitTransaction() {
+Status PgTxnManager::CommitTransaction(const std::function<Status()>& wait_flush) {
   if (!txn_in_progress_) {
     VLOG(2) << "No transaction in progress, nothing to commit.";
-    return Status::OK();
+    return wait_flush ? wait_flush() : Status::OK();
   }
 
   if (!txn_) {
     VLOG(2) << "This was a read-only transaction, nothing to commit.";
+    auto status = wait_flush ? wait_flush() : Status::OK();
     ResetTxnAndSession();
-    return Status::OK();
+    return status;
+  }
+  Status status;
+  if (wait_flush) {
+    VLOG(2) << "Committing transaction with pipelined writes.";
+    // The transaction is committed when both the seal record and all batches are replicated.
+    auto commit_future = txn_->CommitFuture(CoarseTimePoint(), client::SealOnly::kTrue);
+    status = wait_flush();
+    // If the last batch failed, then the transaction will not be committed. And commit future
+    // could be never ready, because the seal record might be not even sent.
+    if (status.ok()) {
+      status = commit_future.get();
+    }
+  } else {
+    VLOG(2) << "Committing transaction.";
+    status = txn_->CommitFuture().get();
   }
-  VLOG(2) << "Committing transaction.";
-  Status status = txn_->CommitFuture().get();
   VLOG(2) << "Transaction commit status: " << status;
   ResetTxnAndSession();
   return status;
@@ -285,6 +341,10 @@ void PgTxnManager::ResetTxnAndSession() {
   txn_in_progress_ = false;
   session_ = nullptr;
   txn_ = nullptr;
+  read_only_stmt_ = false;
+  read_only_stmt_disabled_ = false;
+  read_only_stmt_has_reads_ = false;
+  read_only_stmt_restart_required_ = false;
   can_restart_.store(true, std::memory_order_release);
 }
 
@@ -16,6 +16,7 @@
 #ifndef YB_YQL_PGGATE_PG_TXN_MANAGER_H_
 #define YB_YQL_PGGATE_PG_TXN_MANAGER_H_
 
+#include <functional>
 #include <mutex>
 
 #include "yb/client/client_fwd.h"
@@ -54,11 +55,18 @@ class PgTxnManager : public RefCountedThreadSafe<PgTxnManager> {
 
   CHECKED_STATUS BeginTransaction();
   CHECKED_STATUS RestartTransaction();
-  CHECKED_STATUS CommitTransaction();
+  // Commits current transaction. When wait_flush is specified, the last batch of writes is still
+  // in flight, so the seal record is sent in parallel with it and wait_flush is used to wait for
+  // the batch to complete.
+  CHECKED_STATUS CommitTransaction(const std::function<Status()>& wait_flush = nullptr);
   CHECKED_STATUS AbortTransaction();
   CHECKED_STATUS SetIsolationLevel(int isolation);
   CHECKED_STATUS SetReadOnly(bool read_only);
   CHECKED_STATUS SetDeferrable(bool deferrable);
+  // Called when a statement is started outside of an explicit transaction block. When the
+  // statement is known to be read-only, it is served from a consistent snapshot without creating
+  // a distributed transaction.
+  CHECKED_STATUS SetReadOnlyStmt(bool read_only_stmt);
   CHECKED_STATUS EnterSeparateDdlTxnMode();
   CHECKED_STATUS ExitSeparateDdlTxnMode(bool success);
 
@@ -95,6 +103,16 @@ class PgTxnManager : public RefCountedThreadSafe<PgTxnManager> {
   bool read_only_ = false;
   bool deferrable_ = false;
 
+  // Whether the read-only statement fast path is used by the current transaction.
+  bool read_only_stmt_ = false;
+  // Set when the statement marked as read-only tried to write. The fast path is not used till the
+  // end of the transaction in this case.
+  bool read_only_stmt_disabled_ = false;
+  // Whether any read was performed using the read-only statement fast path.
+  bool read_only_stmt_has_reads_ = false;
+  // Whether the statement should be restarted, because of disabled read-only statement fast path.
+  bool read_only_stmt_restart_required_ = false;
+
   client::YBTransactionPtr ddl_txn_;
   client::YBSessionPtr ddl_session_;
 
@@ -1061,7 +1061,7 @@ Status PgApiImpl::RestartTransaction() {
 
 Status PgApiImpl::CommitTransaction() {
   pg_session_->InvalidateForeignKeyReferenceCache();
-  return pg_txn_manager_->CommitTransaction();
+  return pg_session_->CommitTransaction();
 }
 
 Status PgApiImpl::AbortTransaction() {
@@ -1081,6 +1081,10 @@ Status PgApiImpl::SetTransactionDeferrable(bool deferrable) {
   return pg_txn_manager_->SetDeferrable(deferrable);
 }
 
+Status PgApiImpl::SetTransactionReadOnlyStmt(bool read_only_stmt) {
+  return pg_txn_manager_->SetReadOnlyStmt(read_only_stmt);
+}
+
 Status PgApiImpl::EnterSeparateDdlTxnMode() {
   // Flush all buffered operations as ddl txn use its own transaction session.
   RETURN_NOT_OK(pg_session_->FlushBufferedOperations());
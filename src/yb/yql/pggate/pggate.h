@@ -409,6 +409,7 @@ class PgApiImpl {
   CHECKED_STATUS SetTransactionIsolationLevel(int isolation);
   CHECKED_STATUS SetTransactionReadOnly(bool read_only);
   CHECKED_STATUS SetTransactionDeferrable(bool deferrable);
+  CHECKED_STATUS SetTransactionReadOnlyStmt(bool read_only_stmt);
   CHECKED_STATUS EnterSeparateDdlTxnMode();
   CHECKED_STATUS ExitSeparateDdlTxnMode(bool success);
 
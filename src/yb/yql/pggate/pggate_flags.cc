@@ -58,6 +58,23 @@ DEFINE_int32(ysql_session_max_batch_size, 512,
              "Maximum batch size for buffered writes between PostgreSQL server and YugaByte DocDB "
              "services");
 
+DEFINE_bool(ysql_enable_pipelined_commit, false,
+            "Send the transaction seal record in parallel with the last batch of buffered writes "
+            "during commit, and acknowledge commit as soon as both of them are replicated. "
+            "Requires enable_transaction_sealing to be set on tablet servers.");
+
+DEFINE_bool(ysql_enable_read_only_stmt_fast_path, false,
+            "Execute read-only statements outside of an explicit transaction block at a consistent "
+            "snapshot read point, without creating a distributed transaction, even when "
+            "serializable isolation is used.");
+
+DEFINE_bool(ysql_enable_txn_write_buffering, false,
+            "Keep buffered transactional writes across statements of a transaction. They are "
+            "flushed on commit, before the next read, before a savepoint or when "
+            "ysql_session_max_batch_size is reached. Errors caused by such writes, i.e. duplicate "
+            "key, are reported by the statement that flushes them and name how many statements "
+            "earlier the failed write was made.");
+
 DEFINE_bool(ysql_non_txn_copy, false,
             "Execute COPY inserts non-transactionally.");
 
@@ -27,6 +27,9 @@ DECLARE_int32(ysql_request_limit);
 DECLARE_int32(ysql_prefetch_limit);
 DECLARE_double(ysql_backward_prefetch_scale_factor);
 DECLARE_int32(ysql_session_max_batch_size);
+DECLARE_bool(ysql_enable_pipelined_commit);
+DECLARE_bool(ysql_enable_read_only_stmt_fast_path);
+DECLARE_bool(ysql_enable_txn_write_buffering);
 DECLARE_bool(ysql_non_txn_copy);
 DECLARE_int32(ysql_max_read_restart_attempts);
 DECLARE_int32(ysql_output_buffer_size);
@@ -738,6 +738,10 @@ YBCStatus YBCPgSetTransactionDeferrable(bool deferrable) {
   return ToYBCStatus(pgapi->SetTransactionDeferrable(deferrable));
 }
 
+YBCStatus YBCPgSetTransactionReadOnlyStmt(bool read_only_stmt) {
+  return ToYBCStatus(pgapi->SetTransactionReadOnlyStmt(read_only_stmt));
+}
+
 YBCStatus YBCPgEnterSeparateDdlTxnMode() {
   return ToYBCStatus(pgapi->EnterSeparateDdlTxnMode());
 }
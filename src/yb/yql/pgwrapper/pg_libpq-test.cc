@@ -1860,5 +1860,269 @@ TEST_F_EX(PgLibPqTest,
   }
 }
 
+class PgLibPqTxnWriteBufferingTest : public PgLibPqTest {
+  void UpdateMiniClusterOptions(ExternalMiniClusterOptions* options) override {
+    options->extra_tserver_flags.push_back("--ysql_enable_txn_write_buffering=true");
+  }
+};
+
+namespace {
+
+// Checks that status is a duplicate key error, caused by a write of the statement executed
+// statements_ago statements earlier.
+void AssertDuplicateKey(const Status& status, int statements_ago = 0) {
+  ASSERT_NOK(status);
+  auto msg = status.message().ToBuffer();
+  ASSERT_TRUE(msg.find("duplicate key value") != std::string::npos) << status;
+  if (statements_ago) {
+    ASSERT_TRUE(msg.find(Format("executed $0 statement(s) earlier", statements_ago)) !=
+                std::string::npos) << status;
+  } else {
+    ASSERT_TRUE(msg.find("statement(s) earlier") == std::string::npos) << status;
+  }
+}
+
+} // namespace
+
+// Check that errors of buffered writes name the statement that caused them, and can be caught by
+// an exception block.
+TEST_F_EX(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(TxnWriteBuffering),
+          PgLibPqTxnWriteBufferingTest) {
+  constexpr int kNumRows = 100;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (key INT PRIMARY KEY, value INT)"));
+
+  ASSERT_OK(conn.Execute("BEGIN TRANSACTION ISOLATION LEVEL SERIALIZABLE"));
+  for (int i = 0; i != kNumRows; ++i) {
+    ASSERT_OK(conn.ExecuteFormat("INSERT INTO t (key, value) VALUES ($0, $0)", i));
+  }
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t")), kNumRows);
+  ASSERT_OK(conn.Execute("COMMIT"));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t")), kNumRows);
+
+  // Write of a statement in a transaction block is flushed by the next read.
+  ASSERT_OK(conn.Execute("BEGIN"));
+  ASSERT_OK(conn.ExecuteFormat("INSERT INTO t (key, value) VALUES ($0, $0)", kNumRows));
+  ASSERT_OK(conn.Execute("INSERT INTO t (key, value) VALUES (1, 1)"));
+  AssertDuplicateKey(ResultToStatus(conn.Fetch("SELECT value FROM t WHERE key = 2")), 1);
+  ASSERT_OK(conn.Execute("ROLLBACK"));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t")), kNumRows);
+
+  // Or by the commit.
+  ASSERT_OK(conn.Execute("BEGIN"));
+  ASSERT_OK(conn.Execute("INSERT INTO t (key, value) VALUES (1, 1)"));
+  ASSERT_OK(conn.ExecuteFormat("INSERT INTO t (key, value) VALUES ($0, $0)", kNumRows));
+  AssertDuplicateKey(conn.Execute("COMMIT"), 2);
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t")), kNumRows);
+
+  // Statement committed right after it ends.
+  AssertDuplicateKey(conn.Execute("INSERT INTO t (key, value) VALUES (1, 1)"));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t")), kNumRows);
+
+  // Several statements in one query string are executed in an implicit transaction block.
+  AssertDuplicateKey(conn.ExecuteFormat(
+      "INSERT INTO t (key, value) VALUES ($0, $0); INSERT INTO t (key, value) VALUES (1, 1)",
+      kNumRows));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t")), kNumRows);
+
+  // Error of a write buffered in an exception block is caught by the block.
+  for (bool txn_block : {false, true}) {
+    SCOPED_TRACE(Format("Transaction block: $0", txn_block));
+    if (txn_block) {
+      ASSERT_OK(conn.Execute("BEGIN"));
+    }
+    ASSERT_OK(conn.Execute(
+        "DO $$ BEGIN "
+        "  BEGIN "
+        "    INSERT INTO t (key, value) VALUES (1, 1); "
+        "  EXCEPTION WHEN unique_violation THEN "
+        "    UPDATE t SET value = -1 WHERE key = 1; "
+        "  END; "
+        "END $$"));
+    if (txn_block) {
+      ASSERT_OK(conn.Execute("COMMIT"));
+    }
+    ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int32_t>("SELECT value FROM t WHERE key = 1")), -1);
+    ASSERT_OK(conn.Execute("UPDATE t SET value = 1 WHERE key = 1"));
+  }
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t")), kNumRows);
+}
+
+class PgLibPqPipelinedCommitTest : public PgLibPqTest {
+  void UpdateMiniClusterOptions(ExternalMiniClusterOptions* options) override {
+    options->extra_tserver_flags.push_back("--enable_transaction_sealing=true");
+    options->extra_tserver_flags.push_back("--ysql_enable_pipelined_commit=true");
+    options->extra_tserver_flags.push_back("--ysql_enable_txn_write_buffering=true");
+  }
+};
+
+// Check that writes flushed together with the transaction seal record are committed atomically.
+// Writes of a transaction block are sent with the commit too.
+TEST_F_EX(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(PipelinedCommit), PgLibPqPipelinedCommitTest) {
+  constexpr int kNumRows = 100;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t1 (key INT PRIMARY KEY, value INT)"));
+  ASSERT_OK(conn.Execute("CREATE TABLE t2 (key INT PRIMARY KEY, value INT)"));
+
+  // Single statement writing to both tables, its writes are sent with the commit.
+  for (int i = 0; i != kNumRows; ++i) {
+    ASSERT_OK(conn.ExecuteFormat(
+        "WITH i AS (INSERT INTO t1 (key, value) VALUES ($0, $0)) "
+        "INSERT INTO t2 (key, value) VALUES ($0, $0)", i));
+  }
+
+  // Transaction blocks, writes of several statements are sent with the commit.
+  for (int txn = 1; txn != 3; ++txn) {
+    ASSERT_OK(conn.Execute("BEGIN"));
+    for (int i = 0; i != kNumRows; ++i) {
+      auto key = txn * kNumRows + i;
+      ASSERT_OK(conn.ExecuteFormat("INSERT INTO t1 (key, value) VALUES ($0, $0)", key));
+      ASSERT_OK(conn.ExecuteFormat("INSERT INTO t2 (key, value) VALUES ($0, $0)", key));
+    }
+    ASSERT_OK(conn.Execute("COMMIT"));
+  }
+
+  for (const auto* table : {"t1", "t2"}) {
+    ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>(Format("SELECT COUNT(*) FROM $0", table))),
+              3 * kNumRows);
+  }
+
+  // Error of a write sent with the commit is reported by the statement, and nothing is committed.
+  AssertDuplicateKey(conn.ExecuteFormat(
+      "WITH i AS (INSERT INTO t1 (key, value) VALUES ($0, $0)) "
+      "INSERT INTO t2 (key, value) VALUES (0, 0)", 3 * kNumRows));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t1")), 3 * kNumRows);
+
+  // Error of a write of an earlier statement is reported by COMMIT, and nothing is committed.
+  ASSERT_OK(conn.Execute("BEGIN"));
+  ASSERT_OK(conn.ExecuteFormat("INSERT INTO t1 (key, value) VALUES ($0, $0)", 3 * kNumRows));
+  ASSERT_OK(conn.Execute("INSERT INTO t2 (key, value) VALUES (0, 0)"));
+  AssertDuplicateKey(conn.Execute("COMMIT"), 1);
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t1")), 3 * kNumRows);
+
+  // Rolled back transaction does not send seal record.
+  ASSERT_OK(conn.Execute("BEGIN"));
+  ASSERT_OK(conn.ExecuteFormat("INSERT INTO t1 (key, value) VALUES ($0, $0)", 3 * kNumRows));
+  ASSERT_OK(conn.Execute("ROLLBACK"));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t1")), 3 * kNumRows);
+}
+
+class PgLibPqReadOnlyStmtFastPathTest : public PgLibPqTest {
+  void UpdateMiniClusterOptions(ExternalMiniClusterOptions* options) override {
+    options->extra_tserver_flags.push_back("--ysql_enable_read_only_stmt_fast_path=true");
+  }
+
+ protected:
+  Result<PGConn> ConnectSerializable() {
+    auto conn = VERIFY_RESULT(Connect());
+    RETURN_NOT_OK(conn.Execute(
+        "SET SESSION CHARACTERISTICS AS TRANSACTION ISOLATION LEVEL SERIALIZABLE"));
+    return conn;
+  }
+};
+
+// Check that read-only statements served from a snapshot are restarted when they observe
+// concurrently written records, and still see every committed write.
+TEST_F_EX(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(ReadOnlyStmtFastPathReadRestart),
+          PgLibPqReadOnlyStmtFastPathTest) {
+  auto conn = ASSERT_RESULT(ConnectSerializable());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (key INT PRIMARY KEY)"));
+
+  std::atomic<bool> stop(false);
+  std::atomic<int> last_written(0);
+
+  std::thread write_thread([this, &stop, &last_written] {
+    auto write_conn = ASSERT_RESULT(ConnectSerializable());
+    int write_key = 1;
+    while (!stop.load(std::memory_order_acquire)) {
+      SCOPED_TRACE(Format("Writing: $0", write_key));
+      auto status = write_conn.ExecuteFormat("INSERT INTO t (key) VALUES ($0)", write_key);
+      if (status.ok()) {
+        last_written.store(write_key, std::memory_order_release);
+        ++write_key;
+      } else {
+        LOG(INFO) << "Write " << write_key << " failed: " << status;
+      }
+    }
+  });
+
+  auto se = ScopeExit([&stop, &write_thread] {
+    stop.store(true, std::memory_order_release);
+    write_thread.join();
+  });
+
+  auto deadline = CoarseMonoClock::now() + 30s;
+  int64_t last_count = 0;
+
+  while (CoarseMonoClock::now() < deadline) {
+    int read_key = last_written.load(std::memory_order_acquire);
+    if (read_key == 0) {
+      std::this_thread::sleep_for(100ms);
+      continue;
+    }
+
+    SCOPED_TRACE(Format("Reading: $0", read_key));
+
+    auto res = ASSERT_RESULT(conn.FetchFormat("SELECT * FROM t WHERE key = $0", read_key));
+    ASSERT_EQ(1, PQntuples(res.get()));
+    ASSERT_EQ(read_key, ASSERT_RESULT(GetInt32(res.get(), 0, 0)));
+
+    auto count = ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t"));
+    ASSERT_GE(count, read_key);
+    ASSERT_GE(count, last_count);
+    last_count = count;
+  }
+
+  ASSERT_GE(last_written.load(std::memory_order_acquire), 100);
+}
+
+// Check that a statement that started as read-only, but writes, is re-executed in a regular
+// transaction, and that writes after a read-only statement of the same transaction are applied.
+TEST_F_EX(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(ReadOnlyStmtFastPathWrite),
+          PgLibPqReadOnlyStmtFastPathTest) {
+  constexpr int kNumRows = 10;
+
+  auto conn = ASSERT_RESULT(ConnectSerializable());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (key INT PRIMARY KEY)"));
+  ASSERT_OK(conn.Execute("CREATE TABLE t_log (key INT PRIMARY KEY)"));
+  ASSERT_OK(conn.Execute(
+      "CREATE FUNCTION log_key(k INT) RETURNS INT AS "
+      "$$ INSERT INTO t_log (key) VALUES (k) RETURNING key $$ LANGUAGE SQL VOLATILE"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t (key) SELECT generate_series(1, $0)", kNumRows));
+
+  // The statement calls a volatile function, so it is executed in a regular transaction. Duplicate
+  // writes, e.g. from a restart after rows of t were read, would violate the primary key of t_log.
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(log_key(key)) FROM t")),
+            kNumRows);
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t_log")), kNumRows);
+
+  // Statements that call only non-volatile functions use the fast path, such functions are not
+  // allowed to write.
+  ASSERT_OK(conn.Execute(
+      "CREATE FUNCTION stable_log_key(k INT) RETURNS INT AS "
+      "$$ INSERT INTO t_log (key) VALUES (k) RETURNING key $$ LANGUAGE SQL STABLE"));
+  auto status = ResultToStatus(conn.Fetch("SELECT stable_log_key(key) FROM t"));
+  ASSERT_NOK(status);
+  ASSERT_STR_CONTAINS(status.ToString(), "not allowed in a non-volatile function");
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t_log")), kNumRows);
+
+  // Both statements are executed in the same implicit transaction block, so the fast path is not
+  // used for the read.
+  ASSERT_OK(conn.ExecuteFormat(
+      "SELECT COUNT(*) FROM t; INSERT INTO t_log (key) VALUES ($0)", kNumRows + 1));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t_log")),
+            kNumRows + 1);
+
+  // Same for the explicit transaction block.
+  ASSERT_OK(conn.Execute("BEGIN"));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t")), kNumRows);
+  ASSERT_OK(conn.ExecuteFormat("INSERT INTO t (key) VALUES ($0)", kNumRows + 1));
+  ASSERT_OK(conn.Execute("COMMIT"));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t")), kNumRows + 1);
+}
+
 } // namespace pgwrapper
 } // namespace yb